@@ -115,6 +115,13 @@ void Actions::createActions(App * app)
     //_dataResetSort->setShortcut(
     //            QKeySequence(Qt::ALT + Qt::Key_S)); // TODO
 
+    // -------------------------------------------------------------------------
+    _dataExport = new QAction(
+                QIcon(":/icons/table_save.png"),
+                tr("Export grid rows..."), this);
+    _dataExport->setStatusTip(
+        tr("Save rows of the grid as CSV, JSON, SQL or columnar file"));
+
     // -------------------------------------------------------------------------
     // -------------------------------------------------------------------------
 
@@ -127,6 +134,10 @@ void Actions::createActions(App * app)
                               tr("Export database as SQL"), this);
     _exportDatabase->setStatusTip(tr("Dump database objects to an SQL file"));
 
+    _importCSV = new QAction(QIcon(":/icons/page_white_put.png"),
+                             tr("Import CSV file..."), this);
+    _importCSV->setStatusTip(tr("Load rows of a CSV file into the table"));
+
 }
 
 } // namespace meow
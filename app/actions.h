@@ -34,10 +34,12 @@ public:
     QAction * dataResetSort() const {
         return _dataResetSort;
     }
+    QAction * dataExport() const { return _dataExport; }
 
     QAction * logClear() const { return _logClear; }
 
     QAction * exportDatabase() const { return _exportDatabase; }
+    QAction * importCSV() const { return _importCSV; }
 
 private:
 
@@ -58,10 +60,12 @@ private:
     QAction * _dataDuplicateRowWithoutKeys;
     QAction * _dataDuplicateRowWithKeys;
     QAction * _dataResetSort;
+    QAction * _dataExport;
 
     QAction * _logClear;
 
     QAction * _exportDatabase;
+    QAction * _importCSV;
 };
 
 } // namespace meow
@@ -1,15 +1,22 @@
 #include "log.h"
 #include <QDebug>
+#include <QTimer>
 #include "db/connection.h"
-#include "threads/helpers.h"
 
 namespace meow {
 
+namespace {
+
+// sinks receive messages at most this often
+const int FLUSH_INTERVAL_MS = 1000 / 30;
+
+} // namespace
+
 Log::ISink::~ISink() {}
 
 Log::Log(QObject * parent) : QObject(parent)
 {
-    qRegisterMetaType<Category>("Category");
+
 }
 
 void Log::message(
@@ -17,37 +24,14 @@ void Log::message(
         Category category,
         const db::Connection * connection)
 {
-    // We expect all sinks want to receive messages in main thread.
-    // Otherwise change the logic here.
+    bool isSQL = category == Log::Category::SQL
+            || category == Log::Category::UserSQL;
 
+#ifndef NDEBUG
     QString sessionName;
     if (connection) {
         sessionName = connection->connectionParams()->sessionName();
     }
-
-    if (threads::isCurrentThreadMain()) {
-        messageMainThread(msg, category, sessionName);
-    } else {
-        QMetaObject::invokeMethod(
-                    this,
-                    "messageMainThread",
-                    Qt::QueuedConnection,
-                    Q_ARG(QString, msg),
-                    Q_ARG(Category, category),
-                    Q_ARG(QString, sessionName));
-    }
-}
-
-void Log::messageMainThread(
-        const QString & msg,
-        Category category,
-        const QString & sessionName)
-{
-    bool isSQL = category == Log::Category::SQL
-            || category == Log::Category::UserSQL;
-
-
-#ifndef NDEBUG
     if (!sessionName.isEmpty()) {
         QString logLabel
             = '[' + sessionName + ']';
@@ -64,7 +48,7 @@ void Log::messageMainThread(
         }
     }
 #endif
-    Q_UNUSED(sessionName);
+    Q_UNUSED(connection);
 
     bool doLog = false;
 
@@ -93,10 +77,39 @@ void Log::messageMainThread(
         messageFormatted = "/* " + messageFormatted + " */"; // TODO: escape?
     }
 
+    // We expect all sinks want to receive messages in main thread.
+    // Otherwise change the logic here.
+    if (_pending.push(std::move(messageFormatted))) {
+        // the first one since the last flush, others join it
+        QMetaObject::invokeMethod(this, "scheduleFlush", Qt::QueuedConnection);
+    }
+}
+
+void Log::scheduleFlush()
+{
+    QTimer::singleShot(FLUSH_INTERVAL_MS, this, &Log::flush);
+}
+
+void Log::flush()
+{
+    _flushed.clear();
+    _pending.takeAll(&_flushed);
+
+    if (_flushed.empty()) {
+        return;
+    }
+
+    QStringList messages;
+    messages.reserve(static_cast<int>(_flushed.size()));
+    for (const QString & message : _flushed) {
+        messages.append(message); // shared, not copied
+    }
+    _flushed.clear();
+
     QMutexLocker locker(&_mutex);
 
     for (auto & sink : _sinks) {
-        sink->onLogMessage(messageFormatted);
+        sink->onLogMessages(messages);
     }
 }
 
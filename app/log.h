@@ -1,10 +1,13 @@
 #ifndef MEOW_LOG_H
 #define MEOW_LOG_H
 
+#include <vector>
 #include <QString>
+#include <QStringList>
 #include <QList>
 #include <QMutex>
 #include <QObject>
+#include "helpers/mpsc_queue.h"
 
 namespace meow {
 
@@ -14,6 +17,9 @@ namespace db {
 
 
 // Intent: Central log entry
+// Any thread pushes messages into a lock-free queue, the main thread takes
+// them at a fixed frame rate and gives sinks all messages of a frame at once,
+// so thousands of statements per second don't flood the event loop
 class Log : public QObject
 {
     Q_OBJECT
@@ -31,7 +37,8 @@ public:
     class ISink
     {
     public:
-        virtual void onLogMessage(const QString & msg) = 0;
+        // main thread, messages in order of logging
+        virtual void onLogMessages(const QStringList & messages) = 0;
         virtual ~ISink();
     };
 
@@ -49,10 +56,12 @@ public:
     void removeSink(ISink * sink);
 
 private:
-    Q_SLOT void messageMainThread(
-            const QString & msg,
-            Category category = Category::Debug,
-            const QString & sessionName = QString());
+    // main thread
+    Q_SLOT void scheduleFlush();
+    void flush();
+
+    helpers::MPSCQueue<QString> _pending;
+    std::vector<QString> _flushed; // reused by flush()
 
     mutable QMutex _mutex;
     QList<ISink *> _sinks;
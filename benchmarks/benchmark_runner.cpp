@@ -0,0 +1,236 @@
+#include "benchmark_runner.h"
+#include "db/exception.h"
+#include <algorithm>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QTextStream>
+
+namespace meow {
+namespace benchmarks {
+
+namespace {
+
+const int REPORT_FORMAT_VERSION = 1;
+
+QTextStream & out()
+{
+    static QTextStream stream(stdout);
+    return stream;
+}
+
+QString formatNs(qint64 ns)
+{
+    if (ns >= 1000 * 1000 * 1000) {
+        return QString("%1 s").arg(ns / 1e9, 0, 'f', 3);
+    } else if (ns >= 1000 * 1000) {
+        return QString("%1 ms").arg(ns / 1e6, 0, 'f', 3);
+    } else if (ns >= 1000) {
+        return QString("%1 us").arg(ns / 1e3, 0, 'f', 2);
+    }
+    return QString("%1 ns").arg(ns);
+}
+
+QString resultKey(const QString & backend, const QString & name)
+{
+    return backend + '/' + name;
+}
+
+QJsonObject resultToJson(const BenchmarkResult & result)
+{
+    QJsonObject json;
+    json["name"] = result.name;
+    json["backend"] = result.backend;
+    json["unit"] = result.unit;
+    json["items_per_iteration"] = result.itemsPerIteration;
+    json["iterations"] = result.iterations;
+    json["min_ns"] = result.minNs;
+    json["median_ns"] = result.medianNs;
+    json["p95_ns"] = result.p95Ns;
+    json["mean_ns"] = result.meanNs;
+    json["items_per_second"] = result.itemsPerSecond;
+    if (!result.extra.isEmpty()) {
+        json["extra"] = result.extra;
+    }
+    return json;
+}
+
+} // namespace
+
+Runner::Runner(const Options & options)
+    : _options(options)
+{
+
+}
+
+bool Runner::isSelected(const QString & name) const
+{
+    if (_options.filter.pattern().isEmpty()) {
+        return true;
+    }
+    return _options.filter.match(name).hasMatch();
+}
+
+BenchmarkResult * Runner::run(const QString & name,
+                              const QString & backend,
+                              const QString & unit,
+                              const Iteration & iteration)
+{
+    if (!isSelected(name)) {
+        return nullptr;
+    }
+
+    std::vector<qint64> samples;
+    qint64 items = 0;
+
+    try {
+        iteration(); // warm up caches, prepared statements, etc
+
+        QElapsedTimer total;
+        QElapsedTimer timer;
+        total.start();
+
+        const qint64 minTimeNs = static_cast<qint64>(_options.minTimeMs)
+                * 1000 * 1000;
+
+        while (samples.size() < static_cast<size_t>(_options.maxIterations)) {
+            timer.start();
+            items = iteration();
+            samples.push_back(timer.nsecsElapsed());
+
+            if (total.nsecsElapsed() >= minTimeNs
+                && samples.size()
+                    >= static_cast<size_t>(_options.minIterations)) {
+                break;
+            }
+        }
+    } catch (meow::db::Exception & ex) {
+        skip(resultKey(backend, name), ex.message());
+        return nullptr;
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    qint64 sum = 0;
+    for (qint64 sample : samples) {
+        sum += sample;
+    }
+
+    BenchmarkResult result;
+    result.name = name;
+    result.backend = backend;
+    result.unit = unit;
+    result.itemsPerIteration = items;
+    result.iterations = static_cast<qint64>(samples.size());
+    result.minNs = samples.front();
+    result.medianNs = samples[samples.size() / 2];
+    result.p95Ns = samples[std::min(samples.size() - 1,
+                                    samples.size() * 95 / 100)];
+    result.meanNs = sum / result.iterations;
+    if (result.medianNs > 0) {
+        result.itemsPerSecond = items * 1e9 / result.medianNs;
+    }
+
+    out() << QString("%1 %2: median %3, p95 %4, %5 %6/s (%7 iterations)")
+             .arg(backend, -10)
+             .arg(name, -36)
+             .arg(formatNs(result.medianNs))
+             .arg(formatNs(result.p95Ns))
+             .arg(result.itemsPerSecond, 0, 'f', 0)
+             .arg(unit)
+             .arg(result.iterations)
+          << endl;
+
+    _results.push_back(result);
+    return &_results.back();
+}
+
+void Runner::skip(const QString & name, const QString & reason)
+{
+    out() << "skipped " << name << ": " << reason << endl;
+}
+
+QJsonObject Runner::report() const
+{
+    QJsonArray results;
+    for (const BenchmarkResult & result : _results) {
+        results.append(resultToJson(result));
+    }
+
+    QJsonObject report;
+    report["format"] = REPORT_FORMAT_VERSION;
+    report["version"] = QString(MEOW_BENCHMARK_VERSION);
+    report["qt"] = QString(qVersion());
+    report["timestamp"] = QDateTime::currentDateTimeUtc()
+            .toString(Qt::ISODate);
+    report["min_time_ms"] = _options.minTimeMs;
+    report["rows"] = _options.rows;
+    report["results"] = results;
+    return report;
+}
+
+bool Runner::writeReport(const QString & fileName) const
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        out() << "unable to write " << fileName << ": "
+              << file.errorString() << endl;
+        return false;
+    }
+    file.write(QJsonDocument(report()).toJson());
+    return true;
+}
+
+int Runner::compareWithBaseline(const QString & fileName) const
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        out() << "unable to read " << fileName << ": "
+              << file.errorString() << endl;
+        return 0;
+    }
+
+    const QJsonArray baselineResults = QJsonDocument::fromJson(file.readAll())
+            .object().value("results").toArray();
+
+    QHash<QString, qint64> baselineMedians;
+    for (const QJsonValue & value : baselineResults) {
+        QJsonObject json = value.toObject();
+        baselineMedians.insert(
+            resultKey(json["backend"].toString(), json["name"].toString()),
+            static_cast<qint64>(json["median_ns"].toDouble()));
+    }
+
+    int regressions = 0;
+
+    out() << endl << "Compared to " << fileName << ":" << endl;
+
+    for (const BenchmarkResult & result : _results) {
+        QString key = resultKey(result.backend, result.name);
+        qint64 baselineNs = baselineMedians.value(key, 0);
+        if (baselineNs <= 0) {
+            continue; // new case
+        }
+        double change = (result.medianNs - baselineNs) * 100.0 / baselineNs;
+        bool regressed = change > _options.maxRegressionPercent;
+        if (regressed) {
+            ++regressions;
+        }
+        out() << QString("%1 %2 -> %3 %4%5 %%6")
+                 .arg(key, -47)
+                 .arg(formatNs(baselineNs))
+                 .arg(formatNs(result.medianNs))
+                 .arg(change >= 0 ? "+" : "")
+                 .arg(change, 0, 'f', 1)
+                 .arg(regressed ? "  REGRESSION" : "")
+              << endl;
+    }
+
+    return regressions;
+}
+
+} // namespace benchmarks
+} // namespace meow
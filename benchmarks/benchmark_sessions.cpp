@@ -0,0 +1,178 @@
+#include "benchmark_sessions.h"
+#include "benchmark_runner.h"
+#include "app/app.h"
+#include "db/connection.h"
+#include "db/exception.h"
+#include <QDateTime>
+#include <QUrl>
+
+namespace meow {
+namespace benchmarks {
+
+namespace {
+
+const int INSERT_ROWS_PER_BATCH = 10000;
+
+void setServerParams(meow::db::ConnectionParameters & params,
+                     const QUrl & url,
+                     quint16 defaultPort)
+{
+    params.setHostName(url.host().isEmpty() ? QString("127.0.0.1")
+                                            : url.host());
+    params.setPort(static_cast<quint16>(url.port(defaultPort)));
+    params.setUserName(url.userName());
+    params.setPassword(url.password());
+    params.setDatabases(url.path().mid(1)); // w/o leading /
+}
+
+bool openSession(Runner & runner,
+                 const QString & backend,
+                 meow::db::ConnectionParameters & params,
+                 std::vector<BenchmarkSession> * sessions)
+{
+    auto manager = meow::app()->dbConnectionsManager();
+
+    BenchmarkSession session;
+    session.backend = backend;
+
+    try {
+        manager->openDBConnection(params);
+        session.session = manager->sessions().last().get();
+        meow::db::Connection * connection = session.connection();
+        if (params.serverType() == meow::db::ServerType::SQLite) {
+            session.database = "main";
+        } else {
+            session.database = params.databases();
+            if (session.database.isEmpty()) {
+                session.database = connection->database();
+            }
+            if (params.serverType() == meow::db::ServerType::MySQL) {
+                connection->setDatabase(session.database);
+            }
+        }
+    } catch (meow::db::Exception & ex) {
+        runner.skip(backend, ex.message());
+        return false;
+    }
+
+    sessions->push_back(session);
+    return true;
+}
+
+QString rowsTableCreateSQL(const BenchmarkSession & session)
+{
+    meow::db::Connection * connection = session.connection();
+
+    QString dateTimeType = "DATETIME";
+    QString decimalType = "DECIMAL(12,2)";
+    if (session.backend == "postgresql") {
+        dateTimeType = "TIMESTAMP";
+        decimalType = "NUMERIC(12,2)";
+    }
+
+    return QString("CREATE TABLE %1 (%2 INTEGER NOT NULL PRIMARY KEY, "
+                   "%3 VARCHAR(64) NOT NULL, %4 %5, %6 %7, %8 TEXT)")
+            .arg(connection->quoteIdentifier(ROWS_TABLE))
+            .arg(connection->quoteIdentifier("id"))
+            .arg(connection->quoteIdentifier("name"))
+            .arg(connection->quoteIdentifier("amount"))
+            .arg(decimalType)
+            .arg(connection->quoteIdentifier("created"))
+            .arg(dateTimeType)
+            .arg(connection->quoteIdentifier("payload"));
+}
+
+void appendBulkRow(int id, meow::db::BulkRows * rows)
+{
+    static const QByteArray text
+        = "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do "
+          "eiusmod tempor incididunt ut labore et dolore magna aliqua. Ut "
+          "enim ad minim veniam, quis nostrud exercitation ullamco laboris";
+    static const QDateTime firstCreated(QDate(2020, 1, 1), QTime(0, 0));
+
+    QByteArray & data = rows->data;
+
+    data += QByteArray::number(id);
+    data += '\t';
+    data += "name_" + QByteArray::number(id);
+    data += '\t';
+    data += QByteArray::number(id % 100000) + '.'
+            + QByteArray::number(10 + id % 90);
+    data += '\t';
+    data += firstCreated.addSecs(id * 37).toString("yyyy-MM-dd hh:mm:ss")
+            .toLatin1();
+    data += '\t';
+    if (id % 10 == 0) {
+        data += "\\N";
+    } else {
+        data += text.left(20 + id % (text.size() - 20));
+    }
+    data += '\n';
+
+    ++rows->count;
+}
+
+} // namespace
+
+meow::db::DataBaseEntity * BenchmarkSession::databaseEntity() const
+{
+    session->childCount(); // loads databases once
+    return session->databaseByName(database);
+}
+
+std::vector<BenchmarkSession> openSessions(Runner & runner)
+{
+    const Options & options = runner.options();
+
+    std::vector<BenchmarkSession> sessions;
+
+    meow::db::ConnectionParameters sqliteParams;
+    sqliteParams.setNetworkType(meow::db::NetworkType::SQLite3_File);
+    sqliteParams.setFileName(options.sqliteFileName);
+    openSession(runner, "sqlite", sqliteParams, &sessions);
+
+#ifdef WITH_MYSQL
+    if (!options.mysqlURL.isEmpty()) {
+        meow::db::ConnectionParameters params;
+        params.setNetworkType(meow::db::NetworkType::MySQL_TCPIP);
+        setServerParams(params, QUrl(options.mysqlURL), 3306);
+        openSession(runner, "mysql", params, &sessions);
+    }
+#endif
+
+#ifdef WITH_POSTGRESQL
+    if (!options.postgresURL.isEmpty()) {
+        meow::db::ConnectionParameters params;
+        params.setNetworkType(meow::db::NetworkType::PG_TCPIP);
+        setServerParams(params, QUrl(options.postgresURL), 5432);
+        openSession(runner, "postgresql", params, &sessions);
+    }
+#endif
+
+    return sessions;
+}
+
+void prepareRowsTable(const BenchmarkSession & session, int rowCount)
+{
+    meow::db::Connection * connection = session.connection();
+
+    const QString quotedTable = connection->quoteIdentifier(ROWS_TABLE);
+
+    connection->query("DROP TABLE IF EXISTS " + quotedTable);
+    connection->query(rowsTableCreateSQL(session));
+
+    const QStringList quotedColumns = connection->quoteIdentifiers(
+        {"id", "name", "amount", "created", "payload"});
+
+    meow::db::BulkRows rows;
+    for (int id = 1; id <= rowCount; ++id) {
+        appendBulkRow(id, &rows);
+        if (rows.count == INSERT_ROWS_PER_BATCH || id == rowCount) {
+            connection->bulkInsert(quotedTable, quotedColumns, rows);
+            rows = meow::db::BulkRows();
+        }
+    }
+}
+
+} // namespace benchmarks
+} // namespace meow
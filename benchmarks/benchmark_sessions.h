@@ -0,0 +1,39 @@
+#ifndef BENCHMARKS_BENCHMARK_SESSIONS_H
+#define BENCHMARKS_BENCHMARK_SESSIONS_H
+
+#include <vector>
+#include <QString>
+#include "db/entity/session_entity.h"
+
+namespace meow {
+namespace benchmarks {
+
+class Runner;
+
+// Table of ~100 bytes rows of common types: id, name, amount, created, payload
+const char * const ROWS_TABLE = "meow_bench_rows";
+
+// Intent: opened connection to run benchmarks against
+struct BenchmarkSession
+{
+    QString backend; // sqlite, mysql, postgresql
+    meow::db::SessionEntity * session = nullptr;
+    QString database;
+
+    meow::db::Connection * connection() const {
+        return session->connection();
+    }
+    meow::db::DataBaseEntity * databaseEntity() const;
+};
+
+// SQLite file is always opened, MySQL and PostgreSQL if set in options.
+// Failed connections are reported and skipped
+std::vector<BenchmarkSession> openSessions(Runner & runner);
+
+// (Re)creates ROWS_TABLE with rowCount rows. Throws db::Exception
+void prepareRowsTable(const BenchmarkSession & session, int rowCount);
+
+} // namespace benchmarks
+} // namespace meow
+
+#endif // BENCHMARKS_BENCHMARK_SESSIONS_H
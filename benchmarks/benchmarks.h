@@ -0,0 +1,31 @@
+#ifndef BENCHMARKS_BENCHMARKS_H
+#define BENCHMARKS_BENCHMARKS_H
+
+#include "benchmark_runner.h"
+#include "benchmark_sessions.h"
+
+// Case names are "<suite>/<case>", see --filter
+
+namespace meow {
+namespace benchmarks {
+
+// decode/*: NativeQueryResult receiving of ROWS_TABLE (must exist)
+void runDecodeBenchmarks(Runner & runner, const BenchmarkSession & session);
+
+// grid/*: BaseDataTableModel::data() of visible page while scrolling
+void runGridBenchmarks(Runner & runner, const BenchmarkSession & session);
+
+// seek/*: NativeQueryResult::seekRecNo() over appended chunks, no db
+void runSeekBenchmarks(Runner & runner);
+
+// parser/*, highlighter/*: SQL text processing, no db
+void runParserBenchmarks(Runner & runner);
+
+// structure/*: TableStructureParser of large CREATE TABLE
+void runTableStructureBenchmarks(Runner & runner,
+                                 const BenchmarkSession & session);
+
+} // namespace benchmarks
+} // namespace meow
+
+#endif // BENCHMARKS_BENCHMARKS_H
@@ -0,0 +1,93 @@
+#include "benchmarks.h"
+#include "db/connection.h"
+#include "db/query_results.h"
+
+namespace meow {
+namespace benchmarks {
+
+namespace {
+
+QString selectRowsSQL(const BenchmarkSession & session)
+{
+    return "SELECT * FROM " + session.connection()->quoteIdentifier(ROWS_TABLE);
+}
+
+void addTimings(BenchmarkResult * result,
+                const meow::db::QueryTimings & timings)
+{
+    if (!result) {
+        return;
+    }
+    // of the last iteration, to see which phase dominates
+    result->extra["exec_us"] = static_cast<qint64>(timings.exec.count());
+    result->extra["fetch_us"] = static_cast<qint64>(timings.fetch.count());
+    result->extra["decode_us"] = static_cast<qint64>(timings.decode.count());
+}
+
+} // namespace
+
+void runDecodeBenchmarks(Runner & runner, const BenchmarkSession & session)
+{
+    meow::db::Connection * connection = session.connection();
+    const QString SQL = selectRowsSQL(session);
+
+    meow::db::QueryTimings timings;
+
+    // whole result at once (H: FetchAll)
+    addTimings(runner.run("decode/buffered", session.backend, "rows", [&]() {
+        meow::db::QueryResults results = connection->query(SQL, true);
+        timings = results.timings();
+        return static_cast<qint64>(results.front()->recordCount());
+    }), timings);
+
+    // as the grid receives rows: DATA_ROWS_PER_STEP per fetch
+    addTimings(runner.run("decode/streaming", session.backend, "rows", [&]() {
+        meow::db::QueryResults results = connection->queryStreaming(SQL);
+        meow::db::QueryResultPt result = results.front();
+        while (result->canFetchMore()
+               && result->fetchMore(meow::db::DATA_ROWS_PER_STEP) > 0) {
+        }
+        timings = results.timings();
+        timings += result->timings();
+        return static_cast<qint64>(result->recordCount());
+    }), timings);
+
+    // binary protocol if backend has one
+    addTimings(runner.run("decode/prepared", session.backend, "rows", [&]() {
+        meow::db::QueryResults results = connection->queryPrepared(
+            SQL + " WHERE " + connection->quoteIdentifier("id") + " > ?",
+            QStringList("0"), true);
+        timings = results.timings();
+        return static_cast<qint64>(results.front()->recordCount());
+    }), timings);
+
+    // reading of decoded cells as the grid does
+    if (runner.isSelected("decode/read_cells")) {
+        meow::db::QueryResultPt result = connection->query(SQL, true).front();
+        const std::size_t columnCount = result->columnCount();
+
+        qint64 chars = 0;
+
+        BenchmarkResult * readResult = runner.run(
+            "decode/read_cells", session.backend, "cells", [&]() {
+                qint64 cells = 0;
+                chars = 0;
+                const db::ulonglong rows = result->recordCount();
+                for (db::ulonglong row = 0; row < rows; ++row) {
+                    result->seekRecNo(row);
+                    for (std::size_t col = 0; col < columnCount; ++col) {
+                        chars += result->curRowColumnView(col).length();
+                        ++cells;
+                    }
+                }
+                return cells;
+        });
+
+        if (readResult) {
+            readResult->extra["chars"] = chars;
+        }
+    }
+}
+
+} // namespace benchmarks
+} // namespace meow
@@ -0,0 +1,84 @@
+#include "benchmarks.h"
+#include "db/connection.h"
+#include "db/query.h"
+#include "ui/models/base_data_table_model.h"
+#include <algorithm>
+#include <random>
+
+namespace meow {
+namespace benchmarks {
+
+namespace {
+
+const int PAGE_ROWS = 40; // visible rows of a maximized grid
+
+// Roles the view asks for every visible cell on repaint
+const int PAGE_ROLES[] = { Qt::DisplayRole, Qt::ForegroundRole };
+
+qint64 paintPage(const QAbstractItemModel & model, int firstRow)
+{
+    const int lastRow = std::min(firstRow + PAGE_ROWS, model.rowCount());
+    const int columnCount = model.columnCount();
+
+    qint64 cells = 0;
+    for (int row = firstRow; row < lastRow; ++row) {
+        for (int column = 0; column < columnCount; ++column) {
+            QModelIndex index = model.index(row, column);
+            for (int role : PAGE_ROLES) {
+                model.data(index, role);
+            }
+            ++cells;
+        }
+    }
+    return cells;
+}
+
+} // namespace
+
+void runGridBenchmarks(Runner & runner, const BenchmarkSession & session)
+{
+    if (!runner.isSelected("grid/scroll_sequential")
+            && !runner.isSelected("grid/scroll_random")) {
+        return;
+    }
+
+    meow::db::Connection * connection = session.connection();
+
+    meow::db::QueryPtr query = connection->createQuery();
+    query->setSQL("SELECT * FROM " + connection->quoteIdentifier(ROWS_TABLE));
+    query->execute();
+
+    auto queryData = std::make_shared<meow::db::QueryData>();
+    queryData->setQueryPtr(query);
+
+    // data() of DataTableModel is this one, w/o table entity and loading
+    meow::ui::models::BaseDataTableModel model(queryData);
+    model.setRowCount(-1); // from queryData
+    model.setColumnCount(-1);
+
+    const int rowCount = model.rowCount();
+    if (rowCount == 0) {
+        return;
+    }
+
+    // one iteration is one repaint, so percentiles are of page latency
+    int firstRow = 0;
+    runner.run("grid/scroll_sequential", session.backend, "cells", [&]() {
+        qint64 cells = paintPage(model, firstRow);
+        firstRow += PAGE_ROWS;
+        if (firstRow >= rowCount) {
+            firstRow = 0;
+        }
+        return cells;
+    });
+
+    // jumps with scrollbar, defeats locality of the current row
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int> rows(0, rowCount - 1);
+    runner.run("grid/scroll_random", session.backend, "cells", [&]() {
+        return paintPage(model, rows(random));
+    });
+}
+
+} // namespace benchmarks
+} // namespace meow
@@ -0,0 +1,269 @@
+#include "benchmarks.h"
+#include "db/connection.h"
+#include "db/entity/entity_factory.h"
+#include "db/entity/table_entity.h"
+#include "db/exception.h"
+#include "db/user_query/sentences_parser.h"
+#include "ui/common/sql_syntax_highlighter.h"
+#include "utils/sql_parser/sqlite/sqlite_parser.h"
+#include <QTextDocument>
+
+namespace meow {
+namespace benchmarks {
+
+namespace {
+
+const int SCRIPT_STATEMENTS = 20000;
+const int HIGHLIGHTED_STATEMENTS = 2000;
+const int WIDE_TABLE_COLUMNS = 300;
+// indexes are limited by 64 per table, a foreign key takes one
+const int MYSQL_INDEXES = 20;
+const int MYSQL_FOREIGN_KEYS = 20;
+const char * const WIDE_TABLE = "meow_bench_wide";
+const char * const PARENT_TABLE = "meow_bench_parent";
+
+// A dump-like script: comments, strings and identifiers with delimiters
+// inside, DELIMITER blocks
+QString generateScript(int statementCount)
+{
+    QString script;
+    script.reserve(statementCount * 120);
+
+    script += "-- generated; script\n";
+
+    for (int i = 0; i < statementCount; ++i) {
+        switch (i % 5) {
+        case 0:
+            script += QString("INSERT INTO `orders` (`id`, `note`) VALUES "
+                              "(%1, 'paid; \\'cash\\''), (%2, NULL);\n")
+                    .arg(i).arg(i + 1);
+            break;
+        case 1:
+            script += QString("/* report %1; multi\n line */ "
+                              "SELECT `id`, \"name;\" FROM `users` "
+                              "WHERE `id` > %1 # tail;\n;\n").arg(i);
+            break;
+        case 2:
+            script += QString("UPDATE `users` SET `name` = 'user %1' "
+                              "WHERE `id` = %1;\n").arg(i);
+            break;
+        case 3:
+            script += QString("DELIMITER $$\nCREATE PROCEDURE p%1() BEGIN "
+                              "SELECT 1; SELECT 'a;b'; END$$\nDELIMITER ;\n")
+                    .arg(i);
+            break;
+        default:
+            script += QString("DELETE FROM `log` WHERE `created` < "
+                              "'2020-01-01'; -- cleanup %1\n").arg(i);
+            break;
+        }
+    }
+
+    return script;
+}
+
+// Covers every rule of SQLite CREATE TABLE grammar
+std::string generateSQLiteCreateTable(int columnCount)
+{
+    std::string sql = "CREATE TABLE \"" + std::string(WIDE_TABLE) + "\" (\n"
+                      "  id INTEGER PRIMARY KEY AUTOINCREMENT";
+
+    for (int i = 1; i < columnCount; ++i) {
+        const std::string name = "c" + std::to_string(i);
+        sql += ",\n  ";
+        switch (i % 6) {
+        case 0:
+            sql += name + " VARCHAR(64) NOT NULL DEFAULT 'value'";
+            break;
+        case 1:
+            sql += '`' + name + "` INTEGER DEFAULT -1";
+            break;
+        case 2:
+            sql += name + " DECIMAL(10,2) DEFAULT (0.5)";
+            break;
+        case 3:
+            sql += "[" + name + "] UNSIGNED BIG INT UNIQUE ON CONFLICT REPLACE";
+            break;
+        case 4:
+            sql += name + " DATETIME DEFAULT CURRENT_TIMESTAMP";
+            break;
+        default:
+            sql += name + " INTEGER REFERENCES " + PARENT_TABLE + "(id) "
+                          "ON DELETE CASCADE ON UPDATE SET NULL";
+            break;
+        }
+    }
+
+    sql += ",\n  CONSTRAINT fk_parent FOREIGN KEY (c1, c2) REFERENCES "
+           + std::string(PARENT_TABLE) + " (id, code) ON DELETE RESTRICT"
+           ",\n  UNIQUE (c3, c4)\n)";
+
+    return sql;
+}
+
+// Options of every kind TableStructureParser has a regexp for
+QString generateMySQLCreateTable(int columnCount)
+{
+    QStringList definitions;
+    QStringList keys;
+    int indexes = 0;
+    int foreignKeys = 0;
+
+    definitions << "`id` INT(10) UNSIGNED NOT NULL AUTO_INCREMENT";
+    keys << "PRIMARY KEY (`id`)";
+
+    for (int i = 1; i < columnCount; ++i) {
+        const QString name = QString("c%1").arg(i);
+        switch (i % 6) {
+        case 0:
+            definitions << QString("`%1` VARCHAR(16) CHARACTER SET utf8mb4 "
+                                   "COLLATE utf8mb4_unicode_ci NOT NULL "
+                                   "DEFAULT 'value' COMMENT 'column %1'")
+                           .arg(name);
+            break;
+        case 1:
+            definitions << QString("`%1` INT(11) DEFAULT NULL").arg(name);
+            if (indexes < MYSQL_INDEXES) {
+                keys << QString("KEY `idx_%1` (`%1`)").arg(name);
+                ++indexes;
+            }
+            break;
+        case 2:
+            definitions << QString("`%1` DECIMAL(10,2) NOT NULL "
+                                   "DEFAULT '0.50'").arg(name);
+            break;
+        case 3:
+            definitions << QString("`%1` DATETIME(6) DEFAULT "
+                                   "CURRENT_TIMESTAMP(6) ON UPDATE "
+                                   "CURRENT_TIMESTAMP(6)").arg(name);
+            break;
+        case 4:
+            definitions << QString("`%1` ENUM('a','b','c') DEFAULT 'a'")
+                           .arg(name);
+            break;
+        default:
+            definitions << QString("`%1` INT(10) UNSIGNED DEFAULT NULL")
+                           .arg(name);
+            if (foreignKeys < MYSQL_FOREIGN_KEYS) {
+                keys << QString("CONSTRAINT `fk_%1` FOREIGN KEY (`%1`) "
+                                "REFERENCES `%2` (`id`) ON DELETE CASCADE "
+                                "ON UPDATE SET NULL").arg(name, PARENT_TABLE);
+                ++foreignKeys;
+            }
+            break;
+        }
+    }
+
+    keys << "UNIQUE KEY `uk_c1_c2` (`c1`, `c2`)";
+
+    return QString("CREATE TABLE `%1` (\n  %2\n) ENGINE=InnoDB "
+                   "DEFAULT CHARSET=utf8mb4 COMMENT='wide table'")
+            .arg(WIDE_TABLE)
+            .arg((definitions + keys).join(",\n  "));
+}
+
+void createWideTable(const BenchmarkSession & session)
+{
+    meow::db::Connection * connection = session.connection();
+
+    connection->query(QString("DROP TABLE IF EXISTS %1")
+                      .arg(connection->quoteIdentifier(WIDE_TABLE)));
+    connection->query(QString("DROP TABLE IF EXISTS %1")
+                      .arg(connection->quoteIdentifier(PARENT_TABLE)));
+
+    if (session.backend == "sqlite") {
+        // foreign tables are not checked
+        connection->query(QString::fromStdString(
+            generateSQLiteCreateTable(WIDE_TABLE_COLUMNS)));
+    } else {
+        connection->query(QString("CREATE TABLE `%1` (`id` INT(10) UNSIGNED "
+                                  "NOT NULL PRIMARY KEY) ENGINE=InnoDB")
+                          .arg(PARENT_TABLE));
+        connection->query(generateMySQLCreateTable(WIDE_TABLE_COLUMNS));
+    }
+}
+
+} // namespace
+
+void runParserBenchmarks(Runner & runner)
+{
+    const QString script = generateScript(SCRIPT_STATEMENTS);
+
+    // query tab splits whole editor text on every run
+    int statementCount = 0;
+    BenchmarkResult * splitResult = runner.run(
+        "parser/split_sentences", "none", "chars", [&]() {
+            meow::db::user_query::SentencesParser parser;
+            statementCount = parser.parseByDelimiter(script).size();
+            return static_cast<qint64>(script.length());
+    });
+    if (splitResult) {
+        splitResult->extra["statements"] = statementCount;
+    }
+
+    if (runner.isSelected("highlighter/rehighlight")) {
+        QTextDocument document(generateScript(HIGHLIGHTED_STATEMENTS));
+        meow::ui::common::SQLSyntaxHighlighter highlighter(&document);
+
+        runner.run("highlighter/rehighlight", "none", "lines", [&]() {
+            highlighter.rehighlight();
+            return static_cast<qint64>(document.blockCount());
+        });
+    }
+
+    const std::string createTable
+            = generateSQLiteCreateTable(WIDE_TABLE_COLUMNS);
+
+    runner.run("parser/sqlite_create_table", "none", "chars", [&]() {
+        meow::utils::sql_parser::SQLiteParser parser;
+        if (!parser.parseCreateTable(createTable)) {
+            throw meow::db::Exception(
+                QString::fromStdString(parser._lastError));
+        }
+        return static_cast<qint64>(createTable.size());
+    });
+}
+
+void runTableStructureBenchmarks(Runner & runner,
+                                 const BenchmarkSession & session)
+{
+    const QString name = "structure/wide_table";
+
+    if (!runner.isSelected(name)) {
+        return;
+    }
+
+    // PG structure is built by queries, its parser is a formality
+    if (session.backend != "sqlite" && session.backend != "mysql") {
+        return;
+    }
+
+    meow::db::DataBaseEntity * database = session.databaseEntity();
+    if (!database) {
+        runner.skip(session.backend + '/' + name,
+                    "no database " + session.database);
+        return;
+    }
+
+    std::shared_ptr<meow::db::TableEntity> table;
+
+    BenchmarkResult * result = runner.run(
+        name, session.backend, "columns", [&]() {
+            if (!table) { // in warm up, create code is cached after
+                createWideTable(session);
+                table = meow::db::EntityFactory::createTable(WIDE_TABLE,
+                                                             database);
+            }
+            session.connection()->parseTableStructure(table.get(), true);
+            return static_cast<qint64>(table->structure()->columns().size());
+    });
+
+    if (result) {
+        result->extra["create_code_chars"] = table->createCode().length();
+        result->extra["foreign_keys"]
+                = table->structure()->foreignKeys().size();
+    }
+}
+
+} // namespace benchmarks
+} // namespace meow
@@ -0,0 +1,106 @@
+#include "benchmarks.h"
+#include "db/native_query_result.h"
+#include "db/common.h"
+#include <algorithm>
+#include <random>
+
+namespace meow {
+namespace benchmarks {
+
+namespace {
+
+const int SEEKS_PER_ITERATION = 1000;
+const int SMALL_ROW_COUNT = 100 * 1000;
+const int MEDIUM_ROW_COUNT = 1000 * 1000;
+
+// Intent: result filled in memory, as a backend fills it from native rows
+class SyntheticQueryResult : public meow::db::NativeQueryResult
+{
+public:
+    SyntheticQueryResult(db::ulonglong firstId, int rowCount)
+    {
+        _columns.push_back(meow::db::QueryColumn("id"));
+        _columnarData.reset(_columns.size());
+        _columnarData.reserveRows(static_cast<std::size_t>(rowCount));
+        for (int i = 0; i < rowCount; ++i) {
+            _columnarData.appendCell(0, QString::number(firstId + i));
+            _columnarData.commitRow();
+        }
+        _recordCount = static_cast<db::ulonglong>(rowCount);
+    }
+};
+
+// Result of rowCount rows in DATA_ROWS_PER_STEP chunks, like a result
+// which was scrolled (appended) till the end
+meow::db::QueryResultPt createChunkedResult(int rowCount)
+{
+    const int chunkRows = meow::db::DATA_ROWS_PER_STEP;
+
+    auto result = std::make_shared<SyntheticQueryResult>(
+        0, std::min(chunkRows, rowCount));
+
+    for (int firstId = chunkRows; firstId < rowCount; firstId += chunkRows) {
+        result->appendResultData(std::make_shared<SyntheticQueryResult>(
+            firstId, std::min(chunkRows, rowCount - firstId)));
+    }
+
+    return result;
+}
+
+} // namespace
+
+void runSeekBenchmarks(Runner & runner)
+{
+    std::vector<int> rowCounts;
+    for (int rowCount : { SMALL_ROW_COUNT, MEDIUM_ROW_COUNT,
+                          runner.options().seekRows }) {
+        if (rowCount <= runner.options().seekRows
+                && (rowCounts.empty() || rowCounts.back() < rowCount)) {
+            rowCounts.push_back(rowCount);
+        }
+    }
+
+    double firstNsPerSeek = 0;
+
+    // cost of a seek must not grow with row count
+    for (int rowCount : rowCounts) {
+
+        const QString name = QString("seek/random_%1_rows").arg(rowCount);
+        if (!runner.isSelected(name)) {
+            continue;
+        }
+
+        meow::db::QueryResultPt result = createChunkedResult(rowCount);
+
+        std::mt19937 random(42);
+        std::uniform_int_distribution<db::ulonglong> recNos(0, rowCount - 1);
+        qint64 chars = 0;
+
+        BenchmarkResult * seekResult = runner.run(
+            name, "none", "seeks", [&]() {
+                for (int i = 0; i < SEEKS_PER_ITERATION; ++i) {
+                    result->seekRecNo(recNos(random));
+                    chars += result->curRowColumnView(0).length();
+                }
+                return static_cast<qint64>(SEEKS_PER_ITERATION);
+        });
+
+        if (seekResult) {
+            double nsPerSeek = static_cast<double>(seekResult->medianNs)
+                    / SEEKS_PER_ITERATION;
+            if (firstNsPerSeek == 0) {
+                firstNsPerSeek = nsPerSeek;
+            }
+            seekResult->extra["rows"] = rowCount;
+            seekResult->extra["chunks"] = static_cast<qint64>(
+                (rowCount + meow::db::DATA_ROWS_PER_STEP - 1)
+                    / meow::db::DATA_ROWS_PER_STEP);
+            seekResult->extra["ns_per_seek"] = nsPerSeek;
+            seekResult->extra["vs_smallest"] = nsPerSeek / firstNsPerSeek;
+            seekResult->extra["chars_read"] = chars;
+        }
+    }
+}
+
+} // namespace benchmarks
+} // namespace meow
@@ -0,0 +1,143 @@
+#include "columnar_result_data.h"
+
+#include <cstring>
+
+namespace meow {
+namespace db {
+
+namespace {
+// in UTF-16 code units, cells longer than a block get a block of their own
+const int ARENA_BLOCK_SIZE = 32 * 1024;
+// empty cells are not null, they point here
+const QChar EMPTY_CELL[1] = { QChar() };
+}
+
+ColumnarResultData::ColumnarResultData()
+    : _rowCount(0)
+    , _arenaBytes(0)
+{
+
+}
+
+void ColumnarResultData::reset(std::size_t columnCount)
+{
+    _columns.clear();
+    _columns.resize(columnCount);
+    _rowCount = 0;
+    _arenaBytes = 0;
+}
+
+void ColumnarResultData::reserveRows(std::size_t count)
+{
+    for (Column & column : _columns) {
+        column.cells.reserve(count);
+        column.lengths.reserve(count);
+        column.nulls.reserve(count);
+        if (column.nativeType != NativeValueType::None) {
+            column.nativeValues.reserve(count);
+        }
+    }
+}
+
+std::size_t ColumnarResultData::memoryUsage() const
+{
+    std::size_t bytes = _arenaBytes;
+    for (const Column & column : _columns) {
+        bytes += column.cells.capacity() * sizeof(const QChar *)
+               + column.lengths.capacity() * sizeof(int)
+               + column.nulls.capacity() / 8
+               + column.nativeValues.capacity() * sizeof(NativeValue);
+    }
+    return bytes;
+}
+
+void ColumnarResultData::appendCell(std::size_t column, const QString & value)
+{
+    Column & col = _columns[column];
+    Q_ASSERT(col.nativeType == NativeValueType::None);
+
+    if (value.isNull()) {
+        appendNull(column);
+        return;
+    }
+
+    appendText(col, value);
+}
+
+void ColumnarResultData::appendCell(std::size_t column,
+                                    const QString & value,
+                                    NativeValue nativeValue)
+{
+    Column & col = _columns[column];
+    Q_ASSERT(col.nativeType != NativeValueType::None);
+    Q_ASSERT(!value.isNull());
+
+    appendText(col, value);
+    col.nativeValues.push_back(nativeValue);
+}
+
+void ColumnarResultData::appendNull(std::size_t column)
+{
+    Column & col = _columns[column];
+    Q_ASSERT(col.cells.size() == _rowCount);
+
+    col.cells.push_back(nullptr);
+    col.lengths.push_back(0);
+    col.nulls.push_back(true);
+    if (col.nativeType != NativeValueType::None) {
+        col.nativeValues.push_back(NativeValue{0});
+    }
+}
+
+void ColumnarResultData::commitRow()
+{
+    ++_rowCount;
+#ifndef QT_NO_DEBUG
+    for (const Column & column : _columns) {
+        Q_ASSERT(column.cells.size() == _rowCount);
+    }
+#endif
+}
+
+void ColumnarResultData::appendText(Column & col, const QString & value)
+{
+    Q_ASSERT(col.cells.size() == _rowCount);
+
+    int length = value.length();
+
+    if (length == 0) {
+        col.cells.push_back(EMPTY_CELL);
+    } else {
+        ushort * data = allocate(col, length);
+        std::memcpy(data, value.utf16(), sizeof(ushort) * length);
+        col.cells.push_back(reinterpret_cast<const QChar *>(data));
+    }
+    col.lengths.push_back(length);
+    col.nulls.push_back(false);
+}
+
+ushort * ColumnarResultData::allocate(Column & column, int length)
+{
+    // uninitialized, cells are written right after allocation
+    if (length > ARENA_BLOCK_SIZE / 4) {
+        // big cell: own block, keep the current one for small cells
+        column.blocks.emplace_back(new ushort[static_cast<std::size_t>(length)]);
+        _arenaBytes += sizeof(ushort) * static_cast<std::size_t>(length);
+        return column.blocks.back().get();
+    }
+
+    if (column.block == nullptr
+            || ARENA_BLOCK_SIZE - column.blockUsed < length) {
+        column.blocks.emplace_back(new ushort[ARENA_BLOCK_SIZE]);
+        _arenaBytes += sizeof(ushort) * ARENA_BLOCK_SIZE;
+        column.block = column.blocks.back().get();
+        column.blockUsed = 0;
+    }
+
+    ushort * data = column.block + column.blockUsed;
+    column.blockUsed += length;
+    return data;
+}
+
+} // namespace db
+} // namespace meow
@@ -0,0 +1,144 @@
+#ifndef DB_COLUMNAR_RESULT_DATA_H
+#define DB_COLUMNAR_RESULT_DATA_H
+
+#include <memory>
+#include <vector>
+#include <QString>
+#include <QtGlobal>
+#include "db/common.h"
+
+namespace meow {
+namespace db {
+
+// Type of optional native (binary protocol) values kept next to the text
+enum class NativeValueType
+{
+    None,
+    Int,
+    UInt,
+    Double,
+    DateTime // packed as YYYYMMDDhhmmssffffff, see packDateTime()
+};
+
+union NativeValue
+{
+    qint64 asInt;
+    quint64 asUInt;
+    double asDouble;
+};
+
+inline qint64 packDateTime(int year, int month, int day,
+                           int hour, int minute, int second,
+                           int microsecond)
+{
+    qint64 date = (static_cast<qint64>(year) * 100 + month) * 100 + day;
+    qint64 time = (static_cast<qint64>(hour) * 100 + minute) * 100 + second;
+    return (date * 1000000 + time) * 1000000 + microsecond;
+}
+
+// Intent: read-only storage of query result cells, filled once from native
+// result. Cells are decoded to UTF-16 and kept column by column in arenas
+// of big blocks that never move, so a cell can be viewed without a copy.
+class ColumnarResultData
+{
+public:
+    ColumnarResultData();
+
+    ColumnarResultData(const ColumnarResultData &) = delete;
+    ColumnarResultData & operator=(const ColumnarResultData &) = delete;
+
+    void reset(std::size_t columnCount);
+    void clear() { reset(0); }
+
+    std::size_t columnCount() const { return _columns.size(); }
+    db::ulonglong rowCount() const { return _rowCount; }
+
+    void reserveRows(std::size_t count);
+
+    // Approximate heap size of cells and their index, bytes
+    std::size_t memoryUsage() const;
+
+    // Typed columns keep a native value of every cell for sorting etc,
+    // set before the first row
+    void setNativeType(std::size_t column, NativeValueType type) {
+        _columns[column].nativeType = type;
+    }
+    NativeValueType nativeType(std::size_t column) const {
+        return _columns[column].nativeType;
+    }
+
+    // Fill a row with appendCell()/appendNull() for every column from left
+    // to right, then commitRow()
+    void appendCell(std::size_t column, const QString & value);
+    // for typed columns
+    void appendCell(std::size_t column,
+                    const QString & value,
+                    NativeValue nativeValue);
+    void appendNull(std::size_t column);
+    void commitRow();
+
+    inline bool isNull(db::ulonglong row, std::size_t column) const {
+        return _columns[column].nulls[row];
+    }
+
+    inline int length(db::ulonglong row, std::size_t column) const {
+        return _columns[column].lengths[row];
+    }
+
+    // Zero-copy: shares the arena memory, use it for display only and don't
+    // keep it longer than this data lives
+    inline QString cellView(db::ulonglong row, std::size_t column) const {
+        const Column & col = _columns[column];
+        if (col.nulls[row]) {
+            return QString();
+        }
+        return QString::fromRawData(col.cells[row], col.lengths[row]);
+    }
+
+    // Raw UTF-16 of cell (see length()), nullptr for NULL, thread-safe
+    inline const QChar * cellData(db::ulonglong row,
+                                  std::size_t column) const {
+        return _columns[column].cells[row];
+    }
+
+    // Typed columns only, undefined for NULL
+    inline NativeValue nativeValue(db::ulonglong row,
+                                   std::size_t column) const {
+        return _columns[column].nativeValues[row];
+    }
+
+    // Deep copy
+    inline QString cell(db::ulonglong row, std::size_t column) const {
+        const Column & col = _columns[column];
+        if (col.nulls[row]) {
+            return QString();
+        }
+        return QString(col.cells[row], col.lengths[row]);
+    }
+
+private:
+
+    struct Column
+    {
+        std::vector<std::unique_ptr<ushort[]>> blocks; // arena
+        ushort * block = nullptr; // current block for small cells
+        int blockUsed = 0;
+        std::vector<const QChar *> cells; // row -> start in arena
+        std::vector<int> lengths; // row -> length in QChars
+        std::vector<bool> nulls; // bitmap
+        NativeValueType nativeType = NativeValueType::None;
+        std::vector<NativeValue> nativeValues; // row -> value if typed
+    };
+
+    void appendText(Column & col, const QString & value);
+    ushort * allocate(Column & column, int length);
+
+    std::vector<Column> _columns;
+    db::ulonglong _rowCount;
+    std::size_t _arenaBytes;
+};
+
+} // namespace db
+} // namespace meow
+
+#endif // DB_COLUMNAR_RESULT_DATA_H
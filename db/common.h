@@ -16,6 +16,12 @@ const int DATA_MAX_ROWS = 100 * 1000;
 const int DATA_MAX_LOAD_TEXT_LEN = 256;
 const int FOREIGN_MAX_ROWS = 10000;
 const int DEFAULT_KEEP_ALIVE_TIMEOUT = 20; // seconds
+const int PARALLEL_QUERIES_CONNECTIONS = 4; // including the main one
+const int PREPARED_STATEMENTS_CACHE_SIZE = 64; // per connection
+// Virtual scrolling of data, see RowWindowCache
+const int DATA_WINDOW_ROWS = 1000;
+const int DATA_WINDOWS_PREFETCH = 2; // ahead of scrolling direction
+const int DATA_WINDOWS_MEMORY_BUDGET_MB = 256;
 
 } // namespace db
 } // namespace meow
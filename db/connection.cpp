@@ -1,6 +1,7 @@
 #include "connection.h"
 #include "query.h"
 #include "entity/entities_fetcher.h"
+#include "entity/entities_disk_cache.h"
 #include "table_editor.h"
 #include "view_editor.h"
 #include "routine_editor.h"
@@ -19,22 +20,71 @@
 #include "db_thread_initializer.h"
 #include "connection_query_killer.h"
 
+#include <algorithm>
 #include <QDebug>
 
 namespace meow {
 namespace db {
 
+namespace {
+
+// old SQLite can't bind more (SQLITE_MAX_VARIABLE_NUMBER)
+const int MAX_BULK_INSERT_PARAMS = 999;
+
+// Appends values of the line of BulkRows at pos, returns next line
+int decodeBulkRow(const QByteArray & data, int pos, QStringList * values)
+{
+    QByteArray value;
+    bool isNull = false;
+    const int size = data.size();
+
+    for (;;) {
+        char c = pos < size ? data.at(pos) : '\n';
+        ++pos;
+        if (c == '\t' || c == '\n') {
+            if (isNull) {
+                *values << QString();
+            } else if (value.isEmpty()) {
+                *values << QString(""); // not NULL
+            } else {
+                *values << QString::fromUtf8(value);
+            }
+            if (c == '\n') {
+                return pos;
+            }
+            value.clear();
+            isNull = false;
+        } else if (c == '\\' && pos < size) {
+            char escaped = data.at(pos++);
+            switch (escaped) {
+            case 'N': isNull = true; break;
+            case 't': value += '\t'; break;
+            case 'n': value += '\n'; break;
+            case 'r': value += '\r'; break;
+            case '0': value += '\0'; break;
+            default: value += escaped; break;
+            }
+        } else {
+            value += c;
+        }
+    }
+}
+
+} // namespace
+
 Connection::Connection(const ConnectionParameters & params)
     : _mutex(!params.supportsMultithreading(), params.supportsMultithreading())
     , _active(false)
     , _identifierQuote('`')
     , _connectionIdOnServer(-1)
+    , _isWorkerConnection(false)
     , _connectionParams(params)
     , _characterSet()
     , _isUnicode(false)
     , _useAllDatabases(true)
 {
     _keepAliveTimer.setInterval(params.keepAliveTimeoutSeconds() * 1000);
+    _entitiesDiskCache.reset(new EntitiesDiskCache(params));
     connect(&_keepAliveTimer, &QTimer::timeout,
             this, &Connection::keepAliveTimeout);
 }
@@ -52,7 +102,9 @@ void Connection::doBeforeConnect()
 
 void Connection::doAfterConnect()
 {
-    _keepAliveTimer.start();
+    if (!_isWorkerConnection) { // timer can't be started from other thread
+        _keepAliveTimer.start();
+    }
 }
 
 QStringList Connection::allDatabases(bool refresh /*= false */)
@@ -106,6 +158,28 @@ QList<EntityPtr> Connection::getDbEntities(const QString & dbName,
     }
 }
 
+void Connection::fetchDbEntities(
+        const QString & dbName,
+        const std::function<void(const QList<EntityPtr> &)> & onBatch)
+{
+    std::unique_ptr<DataBaseEntitiesFetcher> fetcher(
+                createDbEntitiesFetcher());
+    fetcher->run(dbName, onBatch);
+}
+
+QString Connection::fetchDbEntitiesSignature(const QString & dbName)
+{
+    std::unique_ptr<DataBaseEntitiesFetcher> fetcher(
+                createDbEntitiesFetcher());
+    return fetcher->fetchSignature(dbName);
+}
+
+void Connection::cacheDbEntities(const QString & dbName,
+                                 const QList<EntityPtr> & entities)
+{
+    _databaseEntitiesCache.insert(dbName, entities);
+}
+
 bool Connection::deleteAllCachedEntitiesInDatabase(const QString & dbName)
 {
     if (_databaseEntitiesCache.contains(dbName)) {
@@ -120,6 +194,201 @@ void Connection::setCharacterSet(const QString & characterSet)
    _characterSet = characterSet;
 }
 
+QueryResults Connection::queryStreaming(const QString & SQL)
+{
+    return query(SQL, true); // default: fully buffered
+}
+
+void Connection::streamRawRows(const QString & SQL,
+                               const RawColumnsCallback & onColumns,
+                               const RawRowCallback & onRow)
+{
+    // default: rows come through result and are converted back to text
+    QueryResults results = queryStreaming(SQL);
+    if (results.isEmpty()) {
+        return;
+    }
+    QueryResultPt result = results.list().front();
+
+    const std::size_t columnCount = result->columnCount();
+
+    std::vector<RawColumn> columns(columnCount);
+    for (std::size_t i = 0; i < columnCount; ++i) {
+        columns[i].name = result->columnName(i);
+        const DataTypePtr & type = result->column(i).dataType;
+        if (type) {
+            columns[i].isNumeric
+                = type->categoryIndex == DataTypeCategoryIndex::Integer
+                || type->categoryIndex == DataTypeCategoryIndex::Float;
+            columns[i].isBinary
+                = type->categoryIndex == DataTypeCategoryIndex::Binary;
+        }
+    }
+    onColumns(columns);
+
+    std::vector<QByteArray> values(columnCount);
+    std::vector<const char *> pointers(columnCount);
+    std::vector<unsigned long> lengths(columnCount);
+
+    db::ulonglong recNo = 0;
+
+    do {
+        for (; recNo < result->recordCount(); ++recNo) {
+            result->seekRecNo(recNo);
+            for (std::size_t i = 0; i < columnCount; ++i) {
+                if (result->isNull(i)) {
+                    pointers[i] = nullptr;
+                    lengths[i] = 0;
+                    continue;
+                }
+                values[i] = result->curRowColumn(i).toUtf8();
+                pointers[i] = values[i].constData();
+                lengths[i] = static_cast<unsigned long>(values[i].size());
+            }
+            if (!onRow(pointers.data(), lengths.data())) {
+                result->abandonFetch();
+                return;
+            }
+        }
+    } while (result->canFetchMore()
+             && result->fetchMore(DATA_ROWS_PER_STEP) > 0);
+}
+
+db::ulonglong Connection::bulkInsert(const QString & quotedTable,
+                                     const QStringList & quotedColumns,
+                                     const BulkRows & rows,
+                                     db::ulonglong * warningCount)
+{
+    // default: multi-row prepared INSERTs in a transaction
+
+    if (warningCount) {
+        *warningCount = 0;
+    }
+
+    const int columnCount = quotedColumns.size();
+    if (columnCount == 0 || rows.count == 0) {
+        return 0;
+    }
+    const int rowsPerInsert = std::max(1,
+                                       MAX_BULK_INSERT_PARAMS / columnCount);
+
+    const QString rowPlaceholders
+        = '(' + QString("?,").repeated(columnCount - 1) + "?)";
+    const QString insertPrefix = "INSERT INTO " + quotedTable
+        + " (" + quotedColumns.join(", ") + ") VALUES ";
+
+    db::ulonglong inserted = 0;
+
+    query("BEGIN");
+
+    try {
+        int pos = 0;
+        int rowsLeft = rows.count;
+        QStringList params;
+
+        while (rowsLeft > 0) {
+            int insertRows = std::min(rowsLeft, rowsPerInsert);
+
+            params.clear();
+            for (int i = 0; i < insertRows; ++i) {
+                int valuesBefore = params.size();
+                pos = decodeBulkRow(rows.data, pos, &params);
+                while (params.size() - valuesBefore < columnCount) {
+                    params << QString(); // NULL
+                }
+                while (params.size() - valuesBefore > columnCount) {
+                    params.removeLast();
+                }
+            }
+
+            // same SQL for full inserts, the statement is prepared once
+            QString SQL = insertPrefix + rowPlaceholders;
+            for (int i = 1; i < insertRows; ++i) {
+                SQL += ',' + rowPlaceholders;
+            }
+
+            QueryResults results = queryPrepared(SQL, params);
+            inserted += results.rowsAffected();
+            if (warningCount) {
+                *warningCount += results.warningsCount();
+            }
+            rowsLeft -= insertRows;
+        }
+
+        query("COMMIT");
+
+    } catch(meow::db::Exception & ex) {
+        Q_UNUSED(ex);
+        try {
+            query("ROLLBACK");
+        } catch(meow::db::Exception & rollbackEx) {
+            Q_UNUSED(rollbackEx); // the first error is the reason
+        }
+        throw;
+    }
+
+    return inserted;
+}
+
+QueryResults Connection::queryPrepared(const QString & SQL,
+                                       const QStringList & params,
+                                       bool storeResult)
+{
+    // default: no statements on server, just escape
+    QString boundSQL = replacePlaceholders(SQL, [&](int index) {
+        if (index >= params.size() || params[index].isNull()) {
+            return QString("NULL");
+        }
+        return escapeString(params[index]);
+    });
+    return query(boundSQL, storeResult);
+}
+
+QString Connection::replacePlaceholders(
+        const QString & SQL,
+        const std::function<QString(int index)> & replacement)
+{
+    QString result;
+    result.reserve(SQL.length());
+
+    int placeholderIndex = 0;
+    QChar quote; // null when not in literal/identifier
+    int length = SQL.length();
+
+    for (int i = 0; i < length; ++i) {
+        QChar ch = SQL[i];
+
+        if (!quote.isNull()) {
+            result += ch;
+            if (ch == QLatin1Char('\\') && quote != QLatin1Char('`')
+                    && i + 1 < length) {
+                result += SQL[++i];
+            } else if (ch == quote) {
+                quote = QChar();
+            }
+            continue;
+        }
+
+        if (ch == QLatin1Char('\'') || ch == QLatin1Char('"')
+                || ch == QLatin1Char('`')) {
+            quote = ch;
+            result += ch;
+        } else if (ch == QLatin1Char('-') && i + 1 < length
+                   && SQL[i + 1] == QLatin1Char('-')) {
+            int end = SQL.indexOf(QLatin1Char('\n'), i);
+            end = (end == -1) ? length : end;
+            result += SQL.midRef(i, end - i);
+            i = end - 1;
+        } else if (ch == QLatin1Char('?')) {
+            result += replacement(placeholderIndex++);
+        } else {
+            result += ch;
+        }
+    }
+
+    return result;
+}
+
 QStringList Connection::getColumn(const QString & SQL, std::size_t index)
 {
     QueryPtr query = getResults(SQL);
@@ -175,6 +444,29 @@ QueryPtr Connection::getResults(const QString & SQL)
     return query;
 }
 
+QueryPtr Connection::getResults(const QString & SQL,
+                                const QStringList & params)
+{
+    QueryPtr query = createQuery();
+    query->setSQL(SQL);
+    query->setBindValues(params);
+
+    query->execute();
+
+    return query;
+}
+
+QStringList Connection::getRow(const QString & SQL, const QStringList & params)
+{
+    QueryPtr query = getResults(SQL, params);
+    query->seekFirst();
+    if (!query->isEof()) {
+        return query->curRow();
+    } else {
+        return {};
+    }
+}
+
 QStringList Connection::getRow(const QString & SQL)
 {
     // TODO: say query to skip columns parsing
@@ -348,6 +640,25 @@ void Connection::stopThread()
     _thread.reset();
 }
 
+void Connection::addToStatistics(QueryResults & results)
+{
+    QueryTimings & timings = results.timings();
+    timings.rows = results.rowsFound();
+    bool isStreaming = !results.isEmpty() && results.front()->canFetchMore();
+    if (timings.firstByte.count() == 0 && !isStreaming) {
+        // buffered: rows follow the response header at once, streamed
+        // results measure it on the first row
+        timings.firstByte = timings.exec;
+    }
+
+    uint64_t queryId = _queryStatistics.addQuery(timings);
+    results.setStatisticsId(queryId);
+
+    for (const QueryResultPt & result : results.list()) {
+        result->setStatisticsId(queryId);
+    }
+}
+
 void Connection::keepAliveTimeout()
 {
     if (_active) {
@@ -3,6 +3,8 @@
 
 #include <memory>
 #include <atomic>
+#include <functional>
+#include <vector>
 #include <QObject>
 #include <QString>
 #include <QStringList>
@@ -10,6 +12,7 @@
 #include <QTimer>
 #include "common.h"
 #include "query_results.h"
+#include "query_statistics.h"
 #include "connection_parameters.h"
 #include "exception.h"
 #include "table_structure_parser.h"
@@ -33,6 +36,7 @@ namespace db {
 
 class Query;
 class DataBaseEntitiesFetcher;
+class EntitiesDiskCache;
 class QueryDataFetcher;
 class TableEntity;
 class EntityInDatabase;
@@ -54,6 +58,29 @@ class ConnectionQueryKiller;
 using QueryPtr = std::shared_ptr<Query>;
 using ConnectionQueryKillerPtr = std::shared_ptr<ConnectionQueryKiller>;
 
+// Column of Connection::streamRawRows(), enough to write a value as SQL
+struct RawColumn
+{
+    QString name;
+    bool isNumeric = false; // written as is
+    bool isBinary = false; // no charset
+};
+
+using RawColumnsCallback = std::function<void(const std::vector<RawColumn> &)>;
+// values[i] is nullptr for NULL, both are valid till return only.
+// Return false to stop receiving
+using RawRowCallback = std::function<bool(const char * const * values,
+                                          const unsigned long * lengths)>;
+
+// Rows of Connection::bulkInsert() in text format which both COPY and
+// LOAD DATA take by default: UTF-8, row per line ending with \n, values are
+// separated by \t, \N is NULL, \\ \t \n \r are escaped by backslash
+struct BulkRows
+{
+    QByteArray data;
+    int count = 0;
+};
+
 class Connection : public QObject
 {
     Q_OBJECT
@@ -82,12 +109,29 @@ public:
     QStringList getRow(const QString & SQL);
     QList<QStringList> getRows(const QString & SQL);
     QueryPtr getResults(const QString & SQL); // H: GetResults(SQL: String):
+    QueryPtr getResults(const QString & SQL, const QStringList & params);
+    QStringList getRow(const QString & SQL, const QStringList & params);
     QStringList allDatabases(bool refresh = false);
     QStringList databases(bool refresh = false);
     void setDatabases(const QStringList & databases);
     void setUseAllDatabases(bool all);
     QList<EntityPtr> getDbEntities(const QString & dbName,
                                           bool refresh = false);
+    // Fetches without cache, batches are passed as they are ready. Used by
+    // EntitiesFetchTask in connection's thread
+    void fetchDbEntities(
+            const QString & dbName,
+            const std::function<void(const QList<EntityPtr> &)> & onBatch);
+    void cacheDbEntities(const QString & dbName,
+                         const QList<EntityPtr> & entities);
+    bool hasCachedDbEntities(const QString & dbName) const {
+        return _databaseEntitiesCache.contains(dbName);
+    }
+    // See DataBaseEntitiesFetcher::fetchSignature()
+    QString fetchDbEntitiesSignature(const QString & dbName);
+    EntitiesDiskCache * entitiesDiskCache() const {
+        return _entitiesDiskCache.get();
+    }
     bool deleteAllCachedEntitiesInDatabase(const QString & dbName);
 
     QString quoteIdentifier(const char * identifier,
@@ -118,6 +162,30 @@ public:
     virtual QueryResults query(
             const QString & SQL,
             bool storeResult = false) = 0; // H: add LogCategory
+    // Returns result which receives rows on demand (see
+    // NativeQueryResult::fetchMore()), buffers everything if not supported.
+    // SQL is one statement, servers reject several
+    virtual QueryResults queryStreaming(const QString & SQL);
+    // Passes rows of SQL to onRow as they come without copying them to a
+    // result, for dumps of any size. Values are text in connection charset
+    // (as server sends them). Throws db::Exception
+    virtual void streamRawRows(const QString & SQL,
+                               const RawColumnsCallback & onColumns,
+                               const RawRowCallback & onRow);
+    // Inserts rows into columns of table in the fastest way the server has
+    // (one batch is atomic on transactional tables). Names are quoted,
+    // returns count of inserted rows, warningCount is of server's warnings
+    // (e.g. truncated values). Throws db::Exception
+    virtual db::ulonglong bulkInsert(const QString & quotedTable,
+                                     const QStringList & quotedColumns,
+                                     const BulkRows & rows,
+                                     db::ulonglong * warningCount = nullptr);
+    // SQL has ? placeholders for params, a null string param is NULL.
+    // Statements are prepared once and cached per connection if supported,
+    // otherwise params are escaped into SQL
+    virtual QueryResults queryPrepared(const QString & SQL,
+                                       const QStringList & params,
+                                       bool storeResult = false);
     virtual void setDatabase(const QString & database) = 0;
     virtual db::ulonglong getRowCount(const TableEntity * table) = 0;
     virtual QString escapeString(const QString & str,
@@ -135,6 +203,12 @@ public:
     virtual QString applyLikeFilter(
             const QList<db::TableColumn *> & columns,
             const QString & value) = 0;
+    // Condition for the quick filter pushed to server: finds at least the
+    // rows where text of any column contains value ignoring case, as
+    // QueryDataFilter does. Caller passes non-binary columns only
+    virtual QString applyQuickFilter(
+            const QList<db::TableColumn *> & columns,
+            const QString & value) = 0;
 
     virtual QueryDataFetcher * createQueryDataFetcher() = 0; // TODO return as unique_ptr
     virtual QString getCreateCode(const Entity * entity) = 0;
@@ -185,10 +259,20 @@ public:
 
     QLatin1Char getIdentQuote() const { return _identifierQuote; }
 
+    // Thread-safe
+    QueryStatistics * queryStatistics() { return &_queryStatistics; }
+
     threads::Mutex * mutex() { return &_mutex; }
     threads::DbThread * thread();
     std::unique_ptr<DbThreadInitializer> createThreadInitializer() const;
 
+    // Worker connection is opened and used in a worker thread (see
+    // BatchExecutor) instead of main, it has no keep-alive timer
+    void setIsWorkerConnection(bool isWorker) {
+        _isWorkerConnection = isWorker;
+    }
+    bool isWorkerConnection() const { return _isWorkerConnection; }
+
 protected:
     threads::Mutex _mutex;
     std::atomic<bool> _active;
@@ -201,10 +285,20 @@ protected:
     QLatin1Char _identifierQuote;
     int64_t _connectionIdOnServer;
     QTimer _keepAliveTimer;
+    bool _isWorkerConnection;
 
     void emitDatabaseChanged(const QString& newName);
     void stopThread();
 
+    // Counts query in statistics, call once the results are complete
+    void addToStatistics(QueryResults & results);
+
+    // Replaces ? placeholders outside of quotes and -- comments, replacement
+    // gets placeholder's index
+    static QString replacePlaceholders(
+            const QString & SQL,
+            const std::function<QString(int index)> & replacement);
+
     virtual DataBaseEntitiesFetcher * createDbEntitiesFetcher() = 0;
     // TODO: move editors and edit methods to separate class
     virtual TableEditor * createTableEditor() = 0;
@@ -246,7 +340,9 @@ private:
     std::unique_ptr<SessionVariables> _variables;
     std::unique_ptr<IUserManager> _userManager;
     std::unique_ptr<IUserEditor> _userEditor;
+    std::unique_ptr<EntitiesDiskCache> _entitiesDiskCache;
     std::unique_ptr<threads::DbThread> _thread;
+    QueryStatistics _queryStatistics;
 };
 
 } // namespace db
@@ -102,6 +102,16 @@ public:
     virtual bool supportsCancellingQuery() const {
         return true;
     }
+
+    virtual bool supportsStreamingResults() const {
+        return false;
+    }
+
+    // prepared statements receive typed values (see
+    // QueryCriteria::typedResult)
+    virtual bool supportsTypedResults() const {
+        return false;
+    }
 protected:
     Connection * _connection;
 };
@@ -211,6 +221,14 @@ public:
     virtual bool supportsUserManagement() const override {
         return true;
     }
+
+    virtual bool supportsStreamingResults() const override {
+        return true; // mysql_use_result()
+    }
+
+    virtual bool supportsTypedResults() const override {
+        return true; // binary protocol
+    }
 };
 
 // -----------------------------------------------------------------------------
@@ -260,6 +278,10 @@ public:
     virtual bool supportsViewingViews() const override {
         return true;
     }
+
+    virtual bool supportsStreamingResults() const override {
+        return true; // PQsetSingleRowMode()
+    }
 };
 
 // -----------------------------------------------------------------------------
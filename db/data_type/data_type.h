@@ -95,6 +95,12 @@ inline bool dataTypeIsNumeric(DataTypeIndex type) { // TODO: rm
         || category == DataTypeCategoryIndex::Integer;
 }
 
+// binary data is displayed (and quick filtered) as hex
+inline bool dataTypeCategoryIsShownAsHex(DataTypeCategoryIndex category) {
+    return category == DataTypeCategoryIndex::Binary
+        || category == DataTypeCategoryIndex::Spatial;
+}
+
 using DataTypeNamesMap = QMap<DataTypeIndex, QString>; // TODO: rm
 const DataTypeNamesMap & dataTypeNames(); // TODO: rm
 
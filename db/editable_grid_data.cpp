@@ -10,12 +10,28 @@ EditableGridData::EditableGridData()
 
 void EditableGridData::reserve(int alloc)
 {
-    _rows.reserve(alloc);
+    _rows.reserve(static_cast<std::size_t>(alloc));
 }
 
 void EditableGridData::reserveForAppend(int append)
 {
-    _rows.reserve(_rows.size() + append);
+    _rows.reserve(_rows.size() + static_cast<std::size_t>(append));
+}
+
+GridDataRow EditableGridData::rowAt(int rowNumber) const
+{
+    const RowRef & ref = _rows[static_cast<std::size_t>(rowNumber)];
+    if (ref.data == nullptr) {
+        return _ownRows[ref.index];
+    }
+
+    std::size_t columnCount = ref.data->columnCount();
+    GridDataRow row;
+    row.reserve(static_cast<int>(columnCount));
+    for (std::size_t col = 0; col < columnCount; ++col) {
+        row.append(ref.data->cell(ref.index, col));
+    }
+    return row;
 }
 
 } // namespace db
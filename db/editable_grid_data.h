@@ -4,7 +4,9 @@
 #include <QStringList>
 #include <QVariant>
 #include <memory>
+#include <vector>
 #include <QDebug>
+#include "db/columnar_result_data.h"
 
 namespace meow {
 namespace db {
@@ -27,34 +29,80 @@ public:
 };
 
 // Intent: data container for editing in grid/table form
+// Rows are references to result's columnar data until they are changed or
+// inserted, only such rows are copied (copy-on-write)
 class EditableGridData
 {
 public:
     EditableGridData();
 
-    void clear() { _rows.clear(); }
+    void clear() { _rows.clear(); _ownRows.clear(); _freeOwnRows.clear(); }
     void reserve(int alloc);
     void reserveForAppend(int append);
 
     inline void appendRow(const GridDataRow & row) {
-        _rows.append(row);
+        _rows.push_back(ownRow(row));
+    }
+
+    // data must outlive this
+    inline void appendRow(const ColumnarResultData * data,
+                          db::ulonglong row) {
+        _rows.push_back({data, row});
     }
 
     inline int rowsCount() const {
-        return _rows.size();
+        return static_cast<int>(_rows.size());
+    }
+
+    inline QString dataAt(int row, int col) const {
+
+        if (_editableRow && _editableRow->rowNumber == row) {
+            return _editableRow->data.at(col);
+        }
+
+        return notModifiedDataAt(row, col);
     }
 
-    inline const QString & dataAt(int row, int col) const {
+    // Zero-copy for not changed rows, see ColumnarResultData::cellView()
+    inline QString dataViewAt(int row, int col) const {
 
         if (_editableRow && _editableRow->rowNumber == row) {
             return _editableRow->data.at(col);
         }
 
-        return _rows.at(row).at(col);
+        const RowRef & ref = _rows[static_cast<std::size_t>(row)];
+        if (ref.data) {
+            return ref.data->cellView(ref.index, static_cast<std::size_t>(col));
+        }
+        return _ownRows[ref.index].at(col);
+    }
+
+    // Raw UTF-16 of cell as shown, nullptr for NULL. Zero-copy, valid till
+    // the data changes, see ColumnarResultData::cellData()
+    inline const QChar * cellDataAt(int row, int col, int * length) const {
+
+        const QString * value = nullptr;
+        if (_editableRow && _editableRow->rowNumber == row) {
+            value = &_editableRow->data.at(col);
+        } else {
+            const RowRef & ref = _rows[static_cast<std::size_t>(row)];
+            if (ref.data) {
+                std::size_t column = static_cast<std::size_t>(col);
+                *length = ref.data->length(ref.index, column);
+                return ref.data->cellData(ref.index, column);
+            }
+            value = &_ownRows[ref.index].at(col);
+        }
+        *length = value->length();
+        return value->isNull() ? nullptr : value->constData();
     }
 
-    const QString & notModifiedDataAt(int row, int col) const {
-        return _rows.at(row).at(col);
+    QString notModifiedDataAt(int row, int col) const {
+        const RowRef & ref = _rows[static_cast<std::size_t>(row)];
+        if (ref.data) {
+            return ref.data->cell(ref.index, static_cast<std::size_t>(col));
+        }
+        return _ownRows[ref.index].at(col);
     }
 
     bool setData(int row, int col, const QVariant &value) {
@@ -89,7 +137,12 @@ public:
         if (!isModified()) return -1;
 
         int editableRowNumber = _editableRow->rowNumber;
-        _rows[_editableRow->rowNumber] = _editableRow->data;
+        RowRef & ref = _rows[static_cast<std::size_t>(editableRowNumber)];
+        if (ref.data) {
+            ref = ownRow(_editableRow->data); // copy on write
+        } else {
+            _ownRows[ref.index] = _editableRow->data;
+        }
         _editableRow.reset();
 
         return editableRowNumber;
@@ -101,15 +154,20 @@ public:
 
     bool deleteRow(int row) {
         _editableRow.reset();
-        _rows.removeAt(row);
+        auto it = _rows.begin() + row;
+        if (it->data == nullptr) {
+            GridDataRow().swap(_ownRows[it->index]); // frees the copy
+            _freeOwnRows.push_back(it->index);
+        }
+        _rows.erase(it);
         return true;
     }
 
     int insertRow(int newRowNumber, const GridDataRow & data) {
-        _rows.insert(newRowNumber, data);
-        if (newRowNumber > (rowsCount() - 1)) {
-            newRowNumber = rowsCount() - 1;
+        if (newRowNumber > rowsCount()) {
+            newRowNumber = rowsCount();
         }
+        _rows.insert(_rows.begin() + newRowNumber, ownRow(data));
         createUpdateRow(newRowNumber);
         _editableRow->isInserted = true;
 
@@ -124,6 +182,25 @@ public:
 
 private:
 
+    struct RowRef
+    {
+        const ColumnarResultData * data; // nullptr if row is in _ownRows
+        db::ulonglong index; // row in data or in _ownRows
+    };
+
+    RowRef ownRow(const GridDataRow & row) {
+        if (!_freeOwnRows.empty()) { // reuse slot of deleted row
+            db::ulonglong index = _freeOwnRows.back();
+            _freeOwnRows.pop_back();
+            _ownRows[index] = row;
+            return {nullptr, index};
+        }
+        _ownRows.push_back(row);
+        return {nullptr, static_cast<db::ulonglong>(_ownRows.size() - 1)};
+    }
+
+    GridDataRow rowAt(int rowNumber) const;
+
     bool isSameData(const QString & str1, const QString & str2) {
         if (str1 == str2) {
             if (str1.isNull() != str2.isNull()) {
@@ -138,13 +215,15 @@ private:
     void createUpdateRow(int rowNumber) {
         if (!_editableRow || _editableRow->rowNumber != rowNumber) {
             _editableRow = std::make_shared<EditableGridDataRow>(
-                _rows[rowNumber],
+                rowAt(rowNumber),
                 rowNumber
             );
         }
     }
 
-    QList<GridDataRow> _rows;
+    std::vector<RowRef> _rows;
+    std::vector<GridDataRow> _ownRows; // changed and inserted rows
+    std::vector<db::ulonglong> _freeOwnRows; // slots of deleted rows
     std::shared_ptr<EditableGridDataRow> _editableRow;
 };
 
@@ -2,6 +2,9 @@
 #include "session_entity.h"
 #include "table_entity.h"
 #include "db/connection.h"
+#include "db/entity/entities_disk_cache.h"
+#include "threads/db_thread.h"
+#include "threads/entities_fetch_task.h"
 #include <QIcon>
 #include <QDebug>
 
@@ -11,13 +14,15 @@ namespace db {
 DataBaseEntity::DataBaseEntity(const QString & dbName, SessionEntity * parent)
     :Entity(parent),
      _dbName(dbName),
-     _entitiesWereInit(false)
+     _entitiesWereInit(false),
+     _showsCachedEntities(false)
 {
 
 }
 
 DataBaseEntity::~DataBaseEntity()
 {
+    abandonFetching();
     clearChildren();
 }
 
@@ -75,6 +80,10 @@ db::ulonglong DataBaseEntity::dataSize() const
 
 void DataBaseEntity::initEntitiesIfNeed()
 {
+    if (_entitiesWereInit == false && _fetchTask) {
+        return; // don't block, the rest comes with entitiesFetched()
+    }
+
     if (_entitiesWereInit == false) {
 
         _entities = connection()->getDbEntities(_dbName);
@@ -94,10 +103,121 @@ bool DataBaseEntity::childrenFetched() const
 
 void DataBaseEntity::clearChildren()
 {
+    abandonFetching();
+    _showsCachedEntities = false;
     connection()->deleteAllCachedEntitiesInDatabase(_dbName);
     _entitiesWereInit = false;
 }
 
+void DataBaseEntity::fetchEntitiesAsync()
+{
+    if (_entitiesWereInit || _fetchTask) {
+        return;
+    }
+
+    if (connection()->hasCachedDbEntities(_dbName)) {
+        initEntitiesIfNeed(); // nothing to wait for
+        emit entitiesFetched();
+        return;
+    }
+
+    QString cachedSignature;
+    _entities = connection()->entitiesDiskCache()->entities(
+                _dbName, &cachedSignature);
+    for (const auto & entity : _entities) {
+        entity->setParent(this);
+    }
+    _showsCachedEntities = !_entities.isEmpty();
+    if (_showsCachedEntities) {
+        emit entitiesFetched();
+    }
+
+    threads::DbThread * thread = connection()->thread();
+
+    // local ref: task may finish (and be released) right in postTask()
+    std::shared_ptr<threads::EntitiesFetchTask> task
+            = thread->createEntitiesFetchTask(_dbName, cachedSignature);
+    _fetchTask = task;
+
+    connect(task.get(), &threads::EntitiesFetchTask::entitiesReceived,
+            this, &DataBaseEntity::takeFetchedEntities);
+    connect(task.get(), &threads::ThreadTask::finished,
+            this, &DataBaseEntity::onFetchTaskFinished);
+
+    thread->postTask(task);
+}
+
+void DataBaseEntity::takeFetchedEntities()
+{
+    if (!_fetchTask || isStaleFetchSignal()) {
+        return; // abandoned or taken by initEntitiesIfNeed()
+    }
+
+    QList<EntityPtr> batch = _fetchTask->takeEntities();
+    if (batch.isEmpty()) {
+        return;
+    }
+
+    for (const auto & entity : batch) {
+        entity->setParent(this);
+    }
+
+    if (_showsCachedEntities) { // outdated
+        _showsCachedEntities = false;
+        _entities = batch;
+        emit entitiesReset();
+        return;
+    }
+
+    _entities += batch;
+
+    emit entitiesFetched();
+}
+
+void DataBaseEntity::onFetchTaskFinished()
+{
+    if (!_fetchTask || isStaleFetchSignal()) {
+        return;
+    }
+
+    takeFetchedEntities();
+
+    std::shared_ptr<threads::EntitiesFetchTask> task = _fetchTask;
+    abandonFetching();
+
+    bool showedCachedEntities = _showsCachedEntities;
+    _showsCachedEntities = false;
+
+    if (task->isFailed()) {
+        _entities.clear(); // try again next time
+        emit entitiesFetchFailed(task->errorMessage());
+        return;
+    }
+
+    if (showedCachedEntities && !task->isUpToDate()) {
+        _entities.clear(); // nothing was fetched instead
+        emit entitiesReset();
+    }
+
+    connection()->cacheDbEntities(_dbName, _entities);
+    _entitiesWereInit = true;
+}
+
+bool DataBaseEntity::isStaleFetchSignal() const
+{
+    // queued signal of abandoned task can be delivered after disconnect
+    QObject * task = sender();
+    return task != nullptr && task != _fetchTask.get();
+}
+
+void DataBaseEntity::abandonFetching()
+{
+    if (_fetchTask) {
+        disconnect(_fetchTask.get(), nullptr, this, nullptr);
+        _fetchTask.reset();
+    }
+}
+
 int DataBaseEntity::indexOf(Entity * entity)
 {
     initEntitiesIfNeed();
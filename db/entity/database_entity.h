@@ -4,6 +4,11 @@
 #include "entity.h"
 
 namespace meow {
+
+namespace threads {
+class EntitiesFetchTask;
+}
+
 namespace db {
 
 class SessionEntity;
@@ -14,6 +19,8 @@ using DataBaseEntityPtr = std::shared_ptr<DataBaseEntity>;
 
 class DataBaseEntity : public Entity
 {
+    Q_OBJECT
+
 private:
     DataBaseEntity(const QString & dbName, SessionEntity * parent);
 public:
@@ -34,6 +41,18 @@ public:
     bool childrenFetched() const;
     void clearChildren();
 
+    // Loads children in connection's thread, entitiesFetched() is emitted
+    // for every batch appended to entities(). Meanwhile sync access (e.g.
+    // childCount()) sees the received ones only. Children cached on disk are
+    // shown at once, if they turn out to be outdated entitiesReset() is
+    // emitted with the first fetched batch
+    void fetchEntitiesAsync();
+    bool isFetchingEntities() const { return _fetchTask != nullptr; }
+
+    Q_SIGNAL void entitiesFetched();
+    Q_SIGNAL void entitiesReset();
+    Q_SIGNAL void entitiesFetchFailed(const QString & error);
+
     int indexOf(Entity * entity);
 
     bool hasChild(const QString & name, const Entity::Type type);
@@ -66,9 +85,16 @@ private:
 
     void initEntitiesIfNeed();
 
+    void takeFetchedEntities();
+    void onFetchTaskFinished();
+    void abandonFetching();
+    bool isStaleFetchSignal() const;
+
     QString _dbName;
     QList<EntityPtr> _entities;
     bool _entitiesWereInit;
+    bool _showsCachedEntities; // from disk, are being revalidated
+    std::shared_ptr<threads::EntitiesFetchTask> _fetchTask;
 };
 
 } // namespace db
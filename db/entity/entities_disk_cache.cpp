@@ -0,0 +1,273 @@
+#include "entities_disk_cache.h"
+#include "db/connection_parameters.h"
+#include "db/entity/entity_factory.h"
+#include "db/entity/table_entity.h"
+#include "helpers/logger.h"
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+namespace meow {
+namespace db {
+
+namespace {
+
+const quint32 FILE_MAGIC = 0x4D454F57; // "MEOW"
+const quint32 FILE_FORMAT_VERSION = 1;
+
+} // namespace
+
+EntitiesDiskCache::EntitiesDiskCache(const ConnectionParameters & params)
+    : _loaded(false)
+    , _modified(false)
+{
+    // one file per server and user, password and session name don't matter
+    QString key = QString("%1|%2|%3|%4|%5|%6")
+            .arg(static_cast<int>(params.serverType()))
+            .arg(static_cast<int>(params.networkType()))
+            .arg(params.hostName())
+            .arg(params.port())
+            .arg(params.userName())
+            .arg(params.fileName());
+
+    QByteArray hash = QCryptographicHash::hash(key.toUtf8(),
+                                               QCryptographicHash::Sha1);
+
+    _fileName = cacheDirPath() + QDir::separator()
+            + QString::fromLatin1(hash.toHex()) + ".bin";
+}
+
+EntitiesDiskCache::Record EntitiesDiskCache::recordOf(const Entity * entity)
+{
+    Record record;
+    record.type = entity->type();
+    record.name = entity->name();
+    record.created = entity->created();
+    record.updated = entity->updated();
+
+    if (record.type == Entity::Type::Table) {
+        auto table = static_cast<const TableEntity *>(entity);
+        record.engine = table->engineStr();
+        record.collation = table->collation();
+        record.dataSize = table->dataSize();
+        record.rowsCount = const_cast<TableEntity *>(table)->rowsCount();
+        record.version = table->version();
+    }
+
+    return record;
+}
+
+QList<EntityPtr> EntitiesDiskCache::entities(const QString & dbName,
+                                             QString * signature) const
+{
+    QMutexLocker locker(&_mutex);
+    loadIfNeed();
+
+    QList<EntityPtr> list;
+
+    auto it = _databases.constFind(dbName);
+    if (it == _databases.constEnd()) {
+        return list;
+    }
+
+    if (signature) {
+        *signature = it->signature;
+    }
+
+    list.reserve(it->records.size());
+
+    for (const Record & record : it->records) {
+        EntityPtr entity;
+        if (record.type == Entity::Type::Table) {
+            TableEntityPtr table = EntityFactory::createTable(record.name);
+            table->setEngine(record.engine);
+            table->setCollation(record.collation);
+            table->setDataSize(record.dataSize);
+            table->setRowsCount(record.rowsCount);
+            table->setVersion(record.version);
+            entity = table;
+        } else {
+            entity = EntityFactory::createEntityInDatabase(record.name,
+                                                           record.type);
+        }
+        if (!entity) {
+            continue;
+        }
+        entity->setCreated(record.created);
+        entity->setUpdated(record.updated);
+        list.append(entity);
+    }
+
+    return list;
+}
+
+void EntitiesDiskCache::setEntities(const QString & dbName,
+                                    const QString & signature,
+                                    const QVector<Record> & records)
+{
+    QMutexLocker locker(&_mutex);
+    loadIfNeed();
+
+    CachedDatabase & database = _databases[dbName];
+    database.signature = signature;
+    database.records = records;
+    _modified = true;
+}
+
+void EntitiesDiskCache::removeDatabase(const QString & dbName)
+{
+    QMutexLocker locker(&_mutex);
+    loadIfNeed();
+
+    if (_databases.remove(dbName) > 0) {
+        _modified = true;
+    }
+}
+
+bool EntitiesDiskCache::save()
+{
+    QByteArray bytes;
+
+    {
+        QMutexLocker locker(&_mutex);
+
+        if (!_modified) {
+            return true;
+        }
+
+        QDataStream stream(&bytes, QIODevice::WriteOnly);
+        stream.setVersion(QDataStream::Qt_5_0);
+
+        stream << FILE_MAGIC << FILE_FORMAT_VERSION;
+        stream << static_cast<quint32>(_databases.size());
+
+        for (auto it = _databases.constBegin();
+             it != _databases.constEnd(); ++it) {
+            stream << it.key() << it->signature;
+            stream << static_cast<quint32>(it->records.size());
+            for (const Record & record : it->records) {
+                stream << static_cast<qint32>(record.type)
+                       << record.name << record.created << record.updated;
+                if (record.type == Entity::Type::Table) {
+                    stream << record.engine << record.collation
+                           << static_cast<quint64>(record.dataSize)
+                           << static_cast<quint64>(record.rowsCount)
+                           << static_cast<quint64>(record.version);
+                }
+            }
+        }
+
+        _modified = false;
+    }
+
+    QDir dir;
+    if (!dir.exists(cacheDirPath())) {
+        dir.mkpath(cacheDirPath());
+    }
+
+    QSaveFile file(_fileName); // don't leave a half written file
+    if (!file.open(QIODevice::WriteOnly)
+            || file.write(bytes) != bytes.size()
+            || !file.commit()) {
+        meowLogC(Log::Category::Error) << "Unable to write metadata cache: "
+                                       << _fileName;
+        return false;
+    }
+
+    return true;
+}
+
+void EntitiesDiskCache::loadIfNeed() const
+{
+    if (!_loaded) {
+        if (!load()) {
+            _databases.clear(); // outdated or broken, will be rewritten
+        }
+        _loaded = true;
+    }
+}
+
+bool EntitiesDiskCache::load() const
+{
+    QFile file(_fileName);
+    if (!file.exists()) {
+        return true;
+    }
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    quint32 magic = 0;
+    quint32 formatVersion = 0;
+    stream >> magic >> formatVersion;
+    if (magic != FILE_MAGIC || formatVersion != FILE_FORMAT_VERSION) {
+        return false;
+    }
+
+    quint32 databaseCount = 0;
+    stream >> databaseCount;
+
+    for (quint32 i = 0; i < databaseCount; ++i) {
+        QString dbName;
+        CachedDatabase database;
+        quint32 recordCount = 0;
+        stream >> dbName >> database.signature >> recordCount;
+        if (stream.status() != QDataStream::Ok) {
+            return false;
+        }
+
+        database.records.reserve(static_cast<int>(recordCount));
+
+        for (quint32 r = 0; r < recordCount; ++r) {
+            Record record;
+            qint32 type = 0;
+            stream >> type >> record.name >> record.created >> record.updated;
+            record.type = static_cast<Entity::Type>(type);
+            if (record.type == Entity::Type::Table) {
+                quint64 dataSize = 0;
+                quint64 rowsCount = 0;
+                quint64 version = 0;
+                stream >> record.engine >> record.collation
+                       >> dataSize >> rowsCount >> version;
+                record.dataSize = dataSize;
+                record.rowsCount = rowsCount;
+                record.version = version;
+            }
+            if (stream.status() != QDataStream::Ok) {
+                return false;
+            }
+            database.records.append(record);
+        }
+
+        _databases.insert(dbName, database);
+    }
+
+    return true;
+}
+
+QString EntitiesDiskCache::cacheDirPath()
+{
+    // cache, not config: the file can be deleted any time and is rebuilt
+#ifdef Q_OS_UNIX
+    QString rootLocation = QStandardPaths::writableLocation(
+                QStandardPaths::GenericCacheLocation)
+            + QDir::separator()
+            + QCoreApplication::organizationName();
+#else
+    QString rootLocation = QStandardPaths::writableLocation(
+                QStandardPaths::CacheLocation);
+#endif
+    return rootLocation + QDir::separator()
+            + QCoreApplication::applicationName() + "MetadataCache";
+}
+
+} // namespace db
+} // namespace meow
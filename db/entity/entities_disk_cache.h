@@ -0,0 +1,82 @@
+#ifndef DB_ENTITIES_DISK_CACHE_H
+#define DB_ENTITIES_DISK_CACHE_H
+
+#include <QDateTime>
+#include <QMap>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+#include "db/entity/entity.h"
+
+namespace meow {
+namespace db {
+
+class ConnectionParameters;
+
+// Intent: keeps entities of databases between sessions in a binary file per
+// server, so the tree is filled instantly on connect. Every database is
+// stored with a signature of its metadata (see
+// DataBaseEntitiesFetcher::fetchSignature()), cached entities are reused
+// while the server returns the same signature. Signature covers all cached
+// values, including sizes and row counts of tables.
+// Thread-safe: is updated in connection's thread, read in main
+class EntitiesDiskCache
+{
+public:
+
+    // Plain data of entity, can be created in any thread
+    struct Record
+    {
+        Entity::Type type = Entity::Type::None;
+        QString name;
+        QDateTime created;
+        QDateTime updated;
+        // tables only
+        QString engine;
+        QString collation;
+        db::ulonglong dataSize = 0;
+        db::ulonglong rowsCount = 0;
+        db::ulonglong version = 0;
+    };
+
+    explicit EntitiesDiskCache(const ConnectionParameters & params);
+
+    static Record recordOf(const Entity * entity);
+
+    // Returns new entities (without parent) and signature they were cached
+    // with, nothing if database is not cached
+    QList<EntityPtr> entities(const QString & dbName,
+                              QString * signature) const;
+
+    void setEntities(const QString & dbName,
+                     const QString & signature,
+                     const QVector<Record> & records);
+    void removeDatabase(const QString & dbName);
+
+    // Writes the file if anything was changed
+    bool save();
+
+private:
+
+    struct CachedDatabase
+    {
+        QString signature;
+        QVector<Record> records;
+    };
+
+    void loadIfNeed() const;
+    bool load() const;
+
+    static QString cacheDirPath();
+
+    QString _fileName;
+    mutable QMutex _mutex;
+    mutable bool _loaded;
+    bool _modified;
+    mutable QMap<QString, CachedDatabase> _databases;
+};
+
+} // namespace db
+} // namespace meow
+
+#endif // DB_ENTITIES_DISK_CACHE_H
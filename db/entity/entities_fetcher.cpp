@@ -9,5 +9,11 @@ DataBaseEntitiesFetcher::DataBaseEntitiesFetcher(Connection * connection)
 
 }
 
+void DataBaseEntitiesFetcher::run(const QString & dbName,
+                                  const BatchCallback & onBatch)
+{
+    onBatch(run(dbName));
+}
+
 } // namespace db
 } // namespace meow
@@ -1,6 +1,7 @@
 #ifndef DATABASE_ENTITIES_FETCHER_H
 #define DATABASE_ENTITIES_FETCHER_H
 
+#include <functional>
 #include <QString>
 #include "db/entity/entity.h"
 
@@ -15,6 +16,19 @@ public:
     explicit DataBaseEntitiesFetcher(Connection * connection);
     virtual ~DataBaseEntitiesFetcher() {}
     virtual QList<EntityPtr> run(const QString & dbName) = 0;
+
+    using BatchCallback = std::function<void(const QList<EntityPtr> & batch)>;
+    // Passes entities in batches as rows arrive, all at once by default
+    virtual void run(const QString & dbName, const BatchCallback & onBatch);
+
+    // Cheap digest of database's metadata which changes when entities are
+    // created, dropped, renamed or altered, or their sizes change. Empty if
+    // not supported, then entities are not cached on disk (see
+    // EntitiesDiskCache)
+    virtual QString fetchSignature(const QString & dbName) {
+        Q_UNUSED(dbName);
+        return QString();
+    }
 protected:  
     Connection * _connection;
 };
@@ -10,6 +10,7 @@
 #include "mysql_table_engines_fetcher.h"
 #include "db/entity/mysql_entity_filter.h"
 #include "mysql_query_result.h"
+#include "mysql_prepared_statement.h"
 #include "helpers/logger.h"
 #include "mysql_database_editor.h"
 #include "db/data_type/mysql_connection_data_types.h"
@@ -20,6 +21,9 @@
 #include "db/entity/view_entity.h"
 #include "threads/helpers.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
 #include <QDebug>
 #include <QElapsedTimer>
 #include <QObject> // tr()
@@ -47,11 +51,65 @@
 namespace meow {
 namespace db {
 
+namespace {
+
+// helper connection of killRunningQuery() must not hang when server is gone
+const unsigned int KILLER_CONNECT_TIMEOUT_SECONDS = 5;
+
+// LOAD DATA LOCAL INFILE handler, serves MySQLLocalInfile
+
+int localInfileInit(void ** ptr, const char * fileName, void * userdata)
+{
+    Q_UNUSED(fileName); // any name, data is ours
+    *ptr = userdata;
+    auto source = static_cast<MySQLLocalInfile *>(userdata);
+    return source->data == nullptr ? 1 : 0; // refuse requests of server
+}
+
+int localInfileRead(void * ptr, char * buffer, unsigned int bufferLength)
+{
+    auto source = static_cast<MySQLLocalInfile *>(ptr);
+    int length = std::min(static_cast<int>(bufferLength),
+                          source->data->size() - source->position);
+    memcpy(buffer, source->data->constData() + source->position,
+           static_cast<std::size_t>(length));
+    source->position += length;
+    return length;
+}
+
+void localInfileEnd(void * ptr)
+{
+    Q_UNUSED(ptr);
+}
+
+int localInfileError(void * ptr, char * errorMessage, unsigned int length)
+{
+    Q_UNUSED(ptr);
+    snprintf(errorMessage, length, "%s",
+             "LOAD DATA LOCAL INFILE is not expected");
+    return 2000; // CR_UNKNOWN_ERROR
+}
+
+// server or client don't allow LOCAL INFILE
+bool isLocalInfileDisabledError(unsigned int code)
+{
+    return code == 1148 // ER_NOT_ALLOWED_COMMAND
+        || code == 3948 // ER_CLIENT_LOCAL_FILES_DISABLED
+        || code == 2068; // CR_LOAD_DATA_LOCAL_INFILE_REJECTED
+}
+
+} // namespace
+
 MySQLConnection::MySQLConnection(const ConnectionParameters & params)
    : Connection(params)
    , _handle(nullptr)
    , _sshTunnel(nullptr)
    , _forkType(MySQLForkType::Original)
+   , _streamingResult(nullptr)
+   , _killerHandle(nullptr)
+   , _multiStatements(true)
+   , _preparedStatements(PREPARED_STATEMENTS_CACHE_SIZE)
+   , _localInfileAllowed(true)
 {
     _identifierQuote = QLatin1Char('`');
 }
@@ -68,7 +126,7 @@ MySQLConnection::~MySQLConnection()
 void MySQLConnection::setActive(bool active) // override
 {
 
-    MEOW_ASSERT_MAIN_THREAD
+    MEOW_ASSERT_CONNECTION_THREAD
 
     threads::MutexLocker locker(mutex()); // protects _handle
 
@@ -88,10 +146,15 @@ void MySQLConnection::setActive(bool active) // override
         }
 
         _handle = mysql_init(nullptr); // TODO: valgrind says it leaks?
+        _multiStatements = true; // see clientFlags
         // TODO _handle== NULL
 
         // TODO: H: SSL, named pipe
 
+        // for bulkInsert(), see localInfileInit()
+        unsigned int localInfile = 1;
+        mysql_options(_handle, MYSQL_OPT_LOCAL_INFILE, &localInfile);
+
         unsigned long clientFlags =
                   CLIENT_LOCAL_FILES
                 | CLIENT_INTERACTIVE
@@ -153,6 +216,15 @@ void MySQLConnection::setActive(bool active) // override
 
         meowLogDebugC(this) << "Connected";
 
+        // CLIENT_LOCAL_FILES lets server ask for any file, answer with
+        // data of bulkInsert() only
+        mysql_set_local_infile_handler(_handle,
+                                       localInfileInit,
+                                       localInfileRead,
+                                       localInfileEnd,
+                                       localInfileError,
+                                       &_localInfile);
+
         try {
             setCharacterSet("utf8mb4");
         } catch(meow::db::Exception & ex) {
@@ -179,6 +251,9 @@ void MySQLConnection::setActive(bool active) // override
 
         doAfterConnect();
     } else if (!active && _handle != nullptr) {
+        abandonStreamingResult();
+        closeKiller();
+        _preparedStatements.clear();
         mysql_close(_handle);
         _active = false;
         // H: ClearCache(False);
@@ -199,7 +274,7 @@ QString MySQLConnection::getLastError() // override
 
 QString MySQLConnection::fetchCharacterSet() // override
 {
-    MEOW_ASSERT_MAIN_THREAD
+    MEOW_ASSERT_CONNECTION_THREAD
 
     const char * charSet = mysql_character_set_name(_handle);
 
@@ -215,7 +290,7 @@ QString MySQLConnection::fetchCharacterSet() // override
 
 void MySQLConnection::setCharacterSet(const QString & characterSet) // override
 {
-    MEOW_ASSERT_MAIN_THREAD
+    MEOW_ASSERT_CONNECTION_THREAD
 
     // H:   FStatementNum := 0
 
@@ -235,7 +310,7 @@ void MySQLConnection::setCharacterSet(const QString & characterSet) // override
 
 bool MySQLConnection::ping(bool reconnect) // override
 {
-    MEOW_ASSERT_MAIN_THREAD
+    MEOW_ASSERT_CONNECTION_THREAD
 
     if (mutex()->tryLock() == false) {
         // Don't ping if we are busy in another thread
@@ -246,6 +321,12 @@ bool MySQLConnection::ping(bool reconnect) // override
 
     threads::MutexUnlocker unlocker(mutex()); // protects _handle
 
+    if (_streamingResult != nullptr) {
+        // we are receiving rows right now, so the connection is alive and
+        // mysql_ping() would fail with "Commands out of sync"
+        return _active;
+    }
+
     if (_handle == nullptr || mysql_ping(_handle) != 0) {
         setActive(false); // TODO: why?
                         // H: Be sure to release some stuff before reconnecting
@@ -264,39 +345,14 @@ QueryResults MySQLConnection::query(const QString & SQL,
     // protects _handle
     threads::MutexLocker locker(mutex());
 
-    meowLogCC(Log::Category::SQL, this) << SQL; // TODO: userSQL
-    
     QueryResults results;
 
-    if (threads::isCurrentThreadMain()) {
-        // ping may change _handle and call UI actions (in future),
-        // allow this action in main thread only (temp solution)
-        ping(true);
-    }
-    // TODO: H: FLastQuerySQL
+    realQuery(SQL, results);
 
-    QByteArray nativeSQL;
-
-    if (isUnicode()) {
-        nativeSQL = SQL.toUtf8();
-    } else {
-        nativeSQL = SQL.toLatin1();
-    }
+    int queryStatus = 0; // realQuery() throws otherwise
 
     QElapsedTimer elapsedTimer;
 
-    elapsedTimer.start();
-    int queryStatus = mysql_real_query(_handle,
-                                       nativeSQL.constData(),
-                                       nativeSQL.size());
-    results.incExecDuration(std::chrono::milliseconds(elapsedTimer.elapsed()));
-
-    if (queryStatus != 0) {
-        QString error = getLastError();
-        meowLogCC(Log::Category::Error, this) << "Query failed: " << error;
-        throw db::Exception(error);
-    }
-
     results.setWarningsCount(mysql_warning_count(_handle));
 
     MYSQL_RES * queryResult = nullptr;
@@ -305,7 +361,7 @@ QueryResults MySQLConnection::query(const QString & SQL,
         elapsedTimer.start();
         queryResult = mysql_store_result(_handle);
         results.incNetworkDuration(
-                std::chrono::milliseconds(elapsedTimer.elapsed()));
+                elapsedMicroseconds(elapsedTimer));
     }
 
     if (queryResult == nullptr
@@ -326,6 +382,7 @@ QueryResults MySQLConnection::query(const QString & SQL,
             if (storeResult) {
                 auto result = std::make_shared<MySQLQueryResult>(this);
                 result->init(queryResult);
+                results.timings().decode += result->timings().decode;
                 results << result;
             } else {
                 mysql_free_result(queryResult);
@@ -340,11 +397,11 @@ QueryResults MySQLConnection::query(const QString & SQL,
         queryStatus = mysql_next_result(_handle);
         if (queryStatus == 0) {
             results.incExecDuration(
-                        std::chrono::milliseconds(elapsedTimer.elapsed()));
+                        elapsedMicroseconds(elapsedTimer));
             elapsedTimer.start();
             queryResult = mysql_store_result(_handle);
             results.incNetworkDuration(
-                    std::chrono::milliseconds(elapsedTimer.elapsed()));
+                    elapsedMicroseconds(elapsedTimer));
         } else if (queryStatus > 0) { // err
             // MySQL stops executing a multi-query when an error occurs.
             // So do we here by raising an exception.
@@ -360,9 +417,424 @@ QueryResults MySQLConnection::query(const QString & SQL,
     meowLogDebugC(this) << "Query rows found/affected: " << results.rowsFound()
                         << "/" << results.rowsAffected();
 
+    addToStatistics(results);
+
+    return results;
+}
+
+QueryResults MySQLConnection::queryStreaming(const QString & SQL)
+{
+    // mysql_use_result() keeps the handle busy until all rows are fetched,
+    // see abandonStreamingResult()
+    threads::MutexLocker locker(mutex());
+
+    QueryResults results;
+
+    QElapsedTimer queryTimer; // till the first row, see fetchMore()
+    queryTimer.start();
+
+    // one result set can be streamed, the server rejects "a; b" now
+    realQuery(SQL, results, false);
+
+    results.setWarningsCount(mysql_warning_count(_handle));
+
+    QElapsedTimer elapsedTimer;
+    elapsedTimer.start();
+    // reads nothing but the result metadata
+    MYSQL_RES * queryResult = mysql_use_result(_handle);
+    results.incNetworkDuration(
+            elapsedMicroseconds(elapsedTimer));
+
+    if (queryResult == nullptr) {
+
+        if (mysql_field_count(_handle) != 0) {
+            QString error = getLastError();
+            meowLogCC(Log::Category::Error, this) << "Query (use) failed: "
+                                                  << error;
+            throw db::Exception(error);
+        }
+
+        // Statement returned no result set, nothing to stream
+        results.incRowsAffected(mysql_affected_rows(_handle));
+
+        // status result of CALL
+        while (mysql_more_results(_handle) && mysql_next_result(_handle) == 0) {
+            MYSQL_RES * nextResult = mysql_store_result(_handle);
+            if (nextResult) {
+                mysql_free_result(nextResult);
+            }
+        }
+
+        addToStatistics(results);
+
+        return results;
+    }
+
+    auto result = std::make_shared<MySQLQueryResult>(this);
+    result->initStreaming(queryResult, _handle, queryTimer);
+    _streamingResult = result.get();
+    results << result;
+
+    meowLogDebugC(this) << "Query result is streaming";
+
+    addToStatistics(results);
+
+    return results;
+}
+
+void MySQLConnection::streamRawRows(const QString & SQL,
+                                    const RawColumnsCallback & onColumns,
+                                    const RawRowCallback & onRow)
+{
+    // rows go from the network buffer to callback, nothing is stored
+    threads::MutexLocker locker(mutex());
+
+    QueryResults results;
+
+    realQuery(SQL, results, false); // see queryStreaming()
+
+    MYSQL_RES * queryResult = mysql_use_result(_handle);
+
+    if (queryResult == nullptr) {
+        if (mysql_field_count(_handle) != 0) {
+            QString error = getLastError();
+            meowLogCC(Log::Category::Error, this) << "Query (use) failed: "
+                                                  << error;
+            throw db::Exception(error);
+        }
+        return;
+    }
+
+    const unsigned int fieldCount = mysql_num_fields(queryResult);
+    const MYSQL_FIELD * fields = mysql_fetch_fields(queryResult);
+
+    std::vector<RawColumn> columns(fieldCount);
+    for (unsigned int i = 0; i < fieldCount; ++i) {
+        const MYSQL_FIELD & field = fields[i];
+        columns[i].name = QString::fromUtf8(field.name,
+                                            static_cast<int>(field.name_length));
+        columns[i].isNumeric = IS_NUM(field.type);
+        // charset 63 is binary: BINARY, VARBINARY, BLOBs, BIT, GEOMETRY
+        columns[i].isBinary = field.type == MYSQL_TYPE_BIT
+                || field.type == MYSQL_TYPE_GEOMETRY
+                || (field.charsetnr == 63 && !IS_NUM(field.type)
+                    && (field.type == MYSQL_TYPE_STRING
+                        || field.type == MYSQL_TYPE_VAR_STRING
+                        || field.type == MYSQL_TYPE_VARCHAR
+                        || field.type == MYSQL_TYPE_TINY_BLOB
+                        || field.type == MYSQL_TYPE_MEDIUM_BLOB
+                        || field.type == MYSQL_TYPE_LONG_BLOB
+                        || field.type == MYSQL_TYPE_BLOB));
+    }
+
+    QString error;
+
+    try {
+        onColumns(columns);
+
+        MYSQL_ROW row;
+        while ((row = mysql_fetch_row(queryResult)) != nullptr) {
+            if (!onRow(row, mysql_fetch_lengths(queryResult))) {
+                break;
+            }
+        }
+        if (row == nullptr && mysql_errno(_handle) != 0) {
+            error = getLastError();
+        }
+    } catch (...) {
+        mysql_free_result(queryResult); // drains the rest of rows
+        throw;
+    }
+
+    mysql_free_result(queryResult);
+
+    if (!error.isEmpty()) {
+        meowLogCC(Log::Category::Error, this) << "Query (fetch) failed: "
+                                              << error;
+        throw db::Exception(error);
+    }
+}
+
+db::ulonglong MySQLConnection::bulkInsert(const QString & quotedTable,
+                                          const QStringList & quotedColumns,
+                                          const BulkRows & rows,
+                                          db::ulonglong * warningCount)
+{
+    if (warningCount) {
+        *warningCount = 0;
+    }
+
+    if (rows.count == 0) {
+        return 0;
+    }
+
+    if (!_localInfileAllowed) {
+        return Connection::bulkInsert(quotedTable, quotedColumns, rows,
+                                      warningCount);
+    }
+
+    QString SQL = "LOAD DATA LOCAL INFILE 'meowsql_bulk_insert' INTO TABLE "
+        + quotedTable
+        + (serverVersionInt() >= 50503 ? " CHARACTER SET utf8mb4"
+                                       : " CHARACTER SET utf8")
+        + " (" + quotedColumns.join(", ") + ")";
+
+    {
+        threads::MutexLocker locker(mutex()); // protects _handle
+
+        QueryResults results;
+
+        _localInfile.data = &rows.data;
+        _localInfile.position = 0;
+
+        try {
+            realQuery(SQL, results);
+            _localInfile.data = nullptr;
+            if (warningCount) {
+                // bad values are truncated or set to defaults, not refused
+                *warningCount = mysql_warning_count(_handle);
+            }
+            return mysql_affected_rows(_handle);
+        } catch (meow::db::Exception & ex) {
+            _localInfile.data = nullptr;
+            if (!isLocalInfileDisabledError(mysql_errno(_handle))) {
+                throw;
+            }
+            meowLogCC(Log::Category::Info, this)
+                << "LOAD DATA LOCAL is not allowed, using INSERTs: "
+                << ex.message();
+            _localInfileAllowed = false;
+        }
+    }
+
+    return Connection::bulkInsert(quotedTable, quotedColumns, rows,
+                                  warningCount);
+}
+
+QueryResults MySQLConnection::queryPrepared(const QString & SQL,
+                                            const QStringList & params,
+                                            bool storeResult)
+{
+    threads::MutexLocker locker(mutex()); // protects _handle
+
+    meowLogCC(Log::Category::SQL, this) << SQL;
+
+    abandonStreamingResult();
+
+    if (threads::isCurrentThreadMain()) {
+        ping(true); // see realQuery()
+    }
+
+    QueryResults results;
+
+    QList<QByteArray> nativeParams;
+    nativeParams.reserve(params.size());
+    for (const QString & param : params) {
+        if (param.isNull()) {
+            nativeParams << QByteArray();
+        } else {
+            nativeParams << (isUnicode() ? param.toUtf8() : param.toLatin1());
+        }
+    }
+
+    try {
+        QElapsedTimer elapsedTimer;
+        elapsedTimer.start();
+
+        MySQLPreparedStatement * statement = preparedStatement(SQL);
+        statement->execute(nativeParams);
+
+        results.incExecDuration(elapsedMicroseconds(elapsedTimer));
+        results.setWarningsCount(mysql_warning_count(_handle));
+
+        if (mysql_stmt_field_count(statement->handle()) == 0) {
+            results.incRowsAffected(
+                mysql_stmt_affected_rows(statement->handle()));
+        } else {
+            auto queryResult = std::make_shared<MySQLQueryResult>(this);
+            queryResult->initPrepared(statement->handle());
+            results.timings().fetch += queryResult->timings().fetch;
+            results.timings().decode += queryResult->timings().decode;
+            results.incRowsFound(queryResult->recordCount());
+            if (storeResult) {
+                results << queryResult;
+            }
+        }
+    } catch (meow::db::Exception & ex) {
+        _preparedStatements.remove(SQL); // prepare again next time
+        meowLogCC(Log::Category::Error, this) << "Query (prepared) failed: "
+                                              << ex.message();
+        throw;
+    }
+
+    addToStatistics(results);
+
     return results;
 }
 
+MySQLPreparedStatement * MySQLConnection::preparedStatement(
+        const QString & SQL)
+{
+    MySQLPreparedStatement * statement = _preparedStatements.object(SQL);
+    if (statement != nullptr) {
+        return statement;
+    }
+
+    std::unique_ptr<MySQLPreparedStatement> newStatement(
+                new MySQLPreparedStatement(_handle));
+    newStatement->prepare(isUnicode() ? SQL.toUtf8() : SQL.toLatin1());
+
+    statement = newStatement.release();
+    _preparedStatements.insert(SQL, statement); // takes ownership
+    return statement;
+}
+
+void MySQLConnection::onStreamingResultFinished(MySQLQueryResult * result)
+{
+    if (_streamingResult == result) {
+        _streamingResult = nullptr;
+    }
+}
+
+bool MySQLConnection::killRunningQuery()
+{
+    if (_handle == nullptr || serverVersionInt() < 50000) {
+        return false; // KILL without QUERY would close the connection
+    }
+
+    QByteArray killSQL = "KILL QUERY "
+            + QByteArray::number(
+                static_cast<qulonglong>(mysql_thread_id(_handle)));
+
+    // the helper is kept: connecting each time holds the lock for long.
+    // Once more with a fresh one if the kept one was dropped by server
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        if (_killerHandle == nullptr && !connectKiller()) {
+            return false;
+        }
+        if (mysql_real_query(_killerHandle,
+                             killSQL.constData(),
+                             static_cast<unsigned long>(killSQL.size()))
+                == 0) {
+            return true;
+        }
+        meowLogCC(Log::Category::Error, this) << "Kill query failed: "
+                                              << mysql_error(_killerHandle);
+        closeKiller();
+    }
+
+    return false;
+}
+
+bool MySQLConnection::connectKiller()
+{
+    _killerHandle = mysql_init(nullptr);
+    if (_killerHandle == nullptr) {
+        return false;
+    }
+
+    unsigned int timeout = KILLER_CONNECT_TIMEOUT_SECONDS;
+    mysql_options(_killerHandle, MYSQL_OPT_CONNECT_TIMEOUT, &timeout);
+
+    // host and port of SSH tunnel's end if any, see setActive()
+    QByteArray hostBytes = connectionParams()->hostName().toLatin1();
+    QByteArray userBytes = connectionParams()->userName().toLatin1();
+    QByteArray pswdBytes = connectionParams()->password().toLatin1();
+
+    if (mysql_real_connect(_killerHandle,
+                           hostBytes.constData(),
+                           userBytes.constData(),
+                           pswdBytes.constData(),
+                           nullptr, // db
+                           connectionParams()->port(),
+                           nullptr, // unix_socket
+                           0) == nullptr) {
+        meowLogCC(Log::Category::Error, this)
+                << "Kill query failed: " << mysql_error(_killerHandle);
+        closeKiller();
+        return false;
+    }
+
+    return true;
+}
+
+void MySQLConnection::closeKiller()
+{
+    if (_killerHandle) {
+        mysql_close(_killerHandle);
+        _killerHandle = nullptr;
+    }
+}
+
+void MySQLConnection::realQuery(const QString & SQL,
+                                QueryResults & results,
+                                bool multiStatements)
+{
+    meowLogCC(Log::Category::SQL, this) << SQL; // TODO: userSQL
+
+    abandonStreamingResult();
+
+    if (threads::isCurrentThreadMain()) {
+        // ping may change _handle and call UI actions (in future),
+        // allow this action in main thread only (temp solution)
+        ping(true);
+    }
+
+    setMultiStatements(multiStatements);
+    // TODO: H: FLastQuerySQL
+
+    QByteArray nativeSQL;
+
+    if (isUnicode()) {
+        nativeSQL = SQL.toUtf8();
+    } else {
+        nativeSQL = SQL.toLatin1();
+    }
+
+    QElapsedTimer elapsedTimer;
+
+    elapsedTimer.start();
+    int queryStatus = mysql_real_query(_handle,
+                                       nativeSQL.constData(),
+                                       nativeSQL.size());
+    results.incExecDuration(elapsedMicroseconds(elapsedTimer));
+
+    if (queryStatus != 0) {
+        QString error = getLastError();
+        meowLogCC(Log::Category::Error, this) << "Query failed: " << error;
+        throw db::Exception(error);
+    }
+}
+
+void MySQLConnection::setMultiStatements(bool enabled)
+{
+    if (_multiStatements == enabled) {
+        return; // a round trip otherwise
+    }
+
+    int status = mysql_set_server_option(
+                _handle,
+                enabled ? MYSQL_OPTION_MULTI_STATEMENTS_ON
+                        : MYSQL_OPTION_MULTI_STATEMENTS_OFF);
+
+    if (status != 0) {
+        QString error = getLastError();
+        meowLogCC(Log::Category::Error, this)
+            << "Failed to switch multi statements: " << error;
+        throw db::Exception(error);
+    }
+
+    _multiStatements = enabled;
+}
+
+void MySQLConnection::abandonStreamingResult()
+{
+    if (_streamingResult != nullptr) {
+        // calls onStreamingResultFinished()
+        _streamingResult->abandonFetch();
+    }
+}
+
 QStringList MySQLConnection::fetchDatabases()
 {
 
@@ -429,7 +901,7 @@ QString MySQLConnection::unescapeString(const QString & str) const
 
 void MySQLConnection::setDatabase(const QString & database) // override
 {
-    MEOW_ASSERT_MAIN_THREAD
+    MEOW_ASSERT_CONNECTION_THREAD
 
     if (database == _database) {
         return;
@@ -441,6 +913,7 @@ void MySQLConnection::setDatabase(const QString & database) // override
     if (!database.isEmpty()) {
         query(QString("USE ") + quoteIdentifier(database));
     }
+    _preparedStatements.clear(); // bound to the default db of prepare time
     _database = database;
     emitDatabaseChanged(database);
 
@@ -500,6 +973,25 @@ QString MySQLConnection::applyLikeFilter(
     return conditions.join(" OR "); // TODO: ESCAPE
 }
 
+QString MySQLConnection::applyQuickFilter(
+            const QList<db::TableColumn *> & columns,
+            const QString & value)
+{
+    // LOWER() on both sides ignores case for _bin/_cs collations too
+    QString likeWithValue = " LIKE '%"
+            + escapeString(value.toLower(), true, false)
+            + "%'";
+
+    QStringList conditions;
+
+    for (db::TableColumn * column : columns) {
+        conditions.push_back("LOWER(CAST(" + quoteIdentifier(column->name())
+                             + " AS CHAR))" + likeWithValue);
+    }
+
+    return conditions.join(" OR ");
+}
+
 QueryDataFetcher * MySQLConnection::createQueryDataFetcher() // override
 {
     return new MySQLQueryDataFetcher(this);
@@ -599,7 +1091,7 @@ QString MySQLConnection::limitOnePostfix(bool select) const
 
 int64_t MySQLConnection::connectionIdOnServer()
 {
-    MEOW_ASSERT_MAIN_THREAD // TODO: do atomic
+    MEOW_ASSERT_CONNECTION_THREAD // TODO: do atomic
     if (_connectionIdOnServer == -1) {
         _connectionIdOnServer = 0; // requesting status to avoid recursion
         _connectionIdOnServer
@@ -9,6 +9,7 @@
 #include <mysql/mysql.h>
 #endif
 
+#include <QCache>
 #include "db/connection.h"
 
 namespace meow {
@@ -17,6 +18,17 @@ namespace ssh { class ISSHTunnel; }
 
 namespace db {
 
+class MySQLQueryResult;
+class MySQLPreparedStatement;
+
+// What LOAD DATA LOCAL INFILE reads: rows of bulkInsert() only, requests
+// of files by server are refused
+struct MySQLLocalInfile
+{
+    const QByteArray * data = nullptr; // nullptr: nothing is expected
+    int position = 0;
+};
+
 enum class MySQLForkType
 {
     Original = 0,
@@ -47,6 +59,23 @@ public:
             const QString & SQL,
             bool storeResult = false) override;
 
+    virtual QueryResults queryStreaming(const QString & SQL) override;
+
+    virtual void streamRawRows(const QString & SQL,
+                               const RawColumnsCallback & onColumns,
+                               const RawRowCallback & onRow) override;
+
+    // LOAD DATA LOCAL INFILE, or INSERTs when server doesn't allow it
+    virtual db::ulonglong bulkInsert(
+            const QString & quotedTable,
+            const QStringList & quotedColumns,
+            const BulkRows & rows,
+            db::ulonglong * warningCount = nullptr) override;
+
+    virtual QueryResults queryPrepared(const QString & SQL,
+                                       const QStringList & params,
+                                       bool storeResult = false) override;
+
     virtual QString escapeString(const QString & str,
                                  bool processJokerChars = false,
                                  bool doQuote = true) const override;
@@ -66,6 +95,9 @@ public:
     virtual QString applyLikeFilter(
             const QList<db::TableColumn *> & columns,
             const QString & value) override;
+    virtual QString applyQuickFilter(
+            const QList<db::TableColumn *> & columns,
+            const QString & value) override;
 
     virtual QueryDataFetcher * createQueryDataFetcher() override;
 
@@ -88,6 +120,14 @@ public:
     MySQLForkType forkType() const { return _forkType; }
     bool isMariaDB() const { return _forkType == MySQLForkType::MariaDB; }
 
+    void onStreamingResultFinished(MySQLQueryResult * result);
+
+    // KILL QUERY of the running statement via helper handle (connected once
+    // and kept till this one is closed), the handle of this connection is
+    // not touched. For stopping of unbuffered result which is busy till the
+    // server sent all rows
+    bool killRunningQuery();
+
 
 protected:
     virtual DataBaseEntitiesFetcher * createDbEntitiesFetcher() override;
@@ -105,13 +145,37 @@ protected:
 
 private:
 
+    // sends SQL to server, throws on error. Without multiStatements the
+    // server rejects several statements separated by ";"
+    void realQuery(const QString & SQL,
+                   QueryResults & results,
+                   bool multiStatements = true);
+    // switches MYSQL_OPTION_MULTI_STATEMENTS if it differs
+    void setMultiStatements(bool enabled);
+
+    // unbuffered result blocks the handle, release it before any query
+    void abandonStreamingResult();
+
+    // cached or prepared now, throws db::Exception
+    MySQLPreparedStatement * preparedStatement(const QString & SQL);
+
     QString getViewCreateCode(const ViewEntity * view);
 
     MySQLForkType forkTypeFromVersion(const QString & versionString) const;
 
+    // helper handle of killRunningQuery()
+    bool connectKiller();
+    void closeKiller();
+
     MYSQL * _handle;
     std::unique_ptr<ssh::ISSHTunnel> _sshTunnel;
     MySQLForkType _forkType;
+    MySQLQueryResult * _streamingResult; // not owned
+    MYSQL * _killerHandle; // helper connection, see killRunningQuery()
+    bool _multiStatements;
+    QCache<QString, MySQLPreparedStatement> _preparedStatements; // SQL : stmt
+    MySQLLocalInfile _localInfile;
+    bool _localInfileAllowed; // by server
 };
 
 } // namespace db
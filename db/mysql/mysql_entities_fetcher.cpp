@@ -12,6 +12,12 @@
 namespace meow {
 namespace db {
 
+namespace {
+// entities are passed on in batches, so the tree can show first of them
+// while the rest are created
+const int ENTITIES_PER_BATCH = 500;
+}
+
 MySQLEntitiesFetcher::MySQLEntitiesFetcher(MySQLConnection * connection)
     :DataBaseEntitiesFetcher(connection)
 {
@@ -19,25 +25,196 @@ MySQLEntitiesFetcher::MySQLEntitiesFetcher(MySQLConnection * connection)
 }
 
 QList<EntityPtr> MySQLEntitiesFetcher::run(const QString & dbName)
+{
+    QList<EntityPtr> list;
+
+    run(dbName, [&list](const QList<EntityPtr> & batch) {
+        list += batch;
+    });
+
+    return list;
+}
+
+void MySQLEntitiesFetcher::run(const QString & dbName,
+                               const BatchCallback & onBatch)
 {
     // TODO SELECT DEFAULT_COLLATION_NAME
 
+    unsigned long serverVersion = _connection->serverVersionInt();
+
+    if (serverVersion >= 50010) { // information_schema.TRIGGERS
+        fetchAllInOneQuery(dbName, onBatch);
+        // TODO: Events
+        return;
+    }
+
     QList<EntityPtr> list;
 
     fetchTablesViews(dbName, &list);
 
-    unsigned long serverVersion = _connection->serverVersionInt();
-
     if (serverVersion >= 50000) {
         fetchStoredFunctions(dbName, &list);
         fetchStoredProcedures(dbName, &list);
     }
 
-    if (serverVersion >= 50010) {
-        fetchTriggers(dbName, &list);
-        // TODO: Events
+    onBatch(list);
+}
+
+QString MySQLEntitiesFetcher::fetchSignature(const QString & dbName)
+{
+    if (_connection->serverVersionInt() < 50010) {
+        return QString();
+    }
+
+    // CRC of names catches renames, times catch (re)creation and alters.
+    // Sizes and row counts are in tables' CRC as they are cached too: a
+    // changed (estimated) size refetches the database instead of showing
+    // stale one
+    static const QString SQL =
+        "SELECT CONCAT_WS('|',"
+        " (SELECT CONCAT_WS(',', COUNT(*),"
+        "   SUM(CRC32(CONCAT_WS(',', `TABLE_NAME`, `DATA_LENGTH`,"
+        "    `INDEX_LENGTH`, `TABLE_ROWS`))),"
+        "   MAX(`CREATE_TIME`), MAX(`UPDATE_TIME`))"
+        "   FROM `information_schema`.`TABLES` WHERE `TABLE_SCHEMA` = ?),"
+        " (SELECT CONCAT_WS(',', COUNT(*), SUM(CRC32(`ROUTINE_NAME`)),"
+        "   MAX(`LAST_ALTERED`))"
+        "   FROM `information_schema`.`ROUTINES` WHERE `ROUTINE_SCHEMA` = ?),"
+        " (SELECT CONCAT_WS(',', COUNT(*), SUM(CRC32(`TRIGGER_NAME`)),"
+        "   MAX(`CREATED`))"
+        "   FROM `information_schema`.`TRIGGERS` WHERE `TRIGGER_SCHEMA` = ?)"
+        ") AS `Signature`";
+
+    QueryPtr queryResults = _connection->getResults(SQL,
+                                                    {dbName, dbName, dbName});
+
+    if (queryResults == nullptr || queryResults->isEof()) {
+        return QString();
+    }
+
+    return queryResults->curRowColumn(0);
+}
+
+void MySQLEntitiesFetcher::fetchAllInOneQuery(const QString & dbName,
+                                              const BatchCallback & onBatch)
+{
+    // Tables/views have columns of SHOW TABLE STATUS, routines and triggers
+    // use a part of them. Order is the same as of separate queries
+    static const QString SQL =
+        "SELECT 0 AS `Kind`, `TABLE_NAME` AS `Name`, `TABLE_TYPE` AS `Type`,"
+        " `ENGINE` AS `Engine`, `DATA_LENGTH` AS `Data_length`,"
+        " `INDEX_LENGTH` AS `Index_length`, `TABLE_ROWS` AS `Rows`,"
+        " `TABLE_COLLATION` AS `Collation`, `CREATE_TIME` AS `Created`,"
+        " `UPDATE_TIME` AS `Modified`, `VERSION` AS `Version`, '' AS `Sort`"
+        " FROM `information_schema`.`TABLES`"
+        " WHERE `TABLE_SCHEMA` = ?"
+        " UNION ALL"
+        " SELECT IF(`ROUTINE_TYPE` = 'FUNCTION', 1, 2), `ROUTINE_NAME`,"
+        " `ROUTINE_TYPE`, NULL, NULL, NULL, NULL, NULL,"
+        " `CREATED`, `LAST_ALTERED`, NULL, ''"
+        " FROM `information_schema`.`ROUTINES`"
+        " WHERE `ROUTINE_SCHEMA` = ?"
+        " UNION ALL"
+        " SELECT 3, `TRIGGER_NAME`, 'TRIGGER', NULL, NULL, NULL, NULL, NULL,"
+        " `CREATED`, NULL, NULL, `EVENT_OBJECT_TABLE`"
+        " FROM `information_schema`.`TRIGGERS`"
+        " WHERE `TRIGGER_SCHEMA` = ?"
+        " ORDER BY `Kind`, `Sort`, `Name`";
+
+    QueryPtr queryResults;
+
+    try {
+        queryResults = _connection->getResults(SQL, {dbName, dbName, dbName});
+    } catch(meow::db::Exception & ex) {
+        meowLogCC(Log::Category::Error, _connection)
+                << "Failed to fetch entities: " << ex.message();
+        return;
+    }
+
+    Query * resPtr = queryResults.get();
+
+    if (!resPtr) {
+        return;
+    }
+
+    std::size_t indexOfKind      = resPtr->indexOfColumn("Kind");
+    std::size_t indexOfName      = resPtr->indexOfColumn("Name");
+    std::size_t indexOfType      = resPtr->indexOfColumn("Type");
+    std::size_t indexOfEngine    = resPtr->indexOfColumn("Engine");
+    std::size_t indexOfDataLen   = resPtr->indexOfColumn("Data_length");
+    std::size_t indexOfIndexLen  = resPtr->indexOfColumn("Index_length");
+    std::size_t indexOfRows      = resPtr->indexOfColumn("Rows");
+    std::size_t indexOfCollation = resPtr->indexOfColumn("Collation");
+    std::size_t indexOfCreated   = resPtr->indexOfColumn("Created");
+    std::size_t indexOfModified  = resPtr->indexOfColumn("Modified");
+    std::size_t indexOfVersion   = resPtr->indexOfColumn("Version");
+
+    QList<EntityPtr> batch;
+
+    while (resPtr->isEof() == false) {
+
+        int kind = resPtr->curRowColumn(indexOfKind).toInt();
+        QString name = resPtr->curRowColumn(indexOfName);
+
+        EntityPtr entity;
+
+        if (kind == 0 && resPtr->curRowColumn(indexOfType) == "VIEW") {
+            entity = EntityFactory::createView(name);
+        } else if (kind == 0) {
+            TableEntityPtr table = EntityFactory::createTable(name);
+            // data size
+            if (!resPtr->isNull(indexOfDataLen) && !resPtr->isNull(indexOfIndexLen)) {
+                auto dataLen = resPtr->curRowColumn(indexOfDataLen).toULongLong();
+                auto indexLen = resPtr->curRowColumn(indexOfIndexLen).toULongLong();
+                table->setDataSize(dataLen + indexLen);
+            }
+            table->setEngine(resPtr->curRowColumn(indexOfEngine));
+            if (!resPtr->isNull(indexOfRows)) {
+                table->setRowsCount(
+                    resPtr->curRowColumn(indexOfRows).toULongLong()
+                );
+            }
+            if (!resPtr->isNull(indexOfCollation)) {
+                table->setCollation(resPtr->curRowColumn(indexOfCollation));
+            }
+            if (!resPtr->isNull(indexOfVersion)) {
+                table->setVersion(
+                    resPtr->curRowColumn(indexOfVersion).toULongLong()
+                );
+            }
+            entity = table;
+        } else if (kind == 1) {
+            entity = EntityFactory::createFunction(name);
+        } else if (kind == 2) {
+            entity = EntityFactory::createProcedure(name);
+        } else {
+            entity = EntityFactory::createTrigger(name);
+        }
+
+        if (!resPtr->isNull(indexOfCreated)) {
+            entity->setCreated(
+                helpers::parseDateTime(resPtr->curRowColumn(indexOfCreated))
+            );
+        }
+        if (!resPtr->isNull(indexOfModified)) {
+            entity->setUpdated(
+                helpers::parseDateTime(resPtr->curRowColumn(indexOfModified))
+            );
+        }
+
+        batch.append(entity);
+
+        if (batch.size() >= ENTITIES_PER_BATCH) {
+            onBatch(batch);
+            batch.clear();
+        }
+
+        resPtr->seekNext();
+    }
+
+    if (!batch.isEmpty()) {
+        onBatch(batch);
     }
-    return list;
 }
 
 void MySQLEntitiesFetcher::fetchTablesViews(const QString & dbName,
@@ -141,15 +318,25 @@ void MySQLEntitiesFetcher::fetchTablesViews(const QString & dbName,
     }
 }
 
+QString MySQLEntitiesFetcher::routinesSQL() const
+{
+    // same columns as SHOW FUNCTION/PROCEDURE STATUS, one prepared statement
+    // for both
+    return "SELECT `ROUTINE_NAME` AS `Name`, `CREATED` AS `Created`,"
+           " `LAST_ALTERED` AS `Modified`"
+           " FROM `information_schema`.`ROUTINES`"
+           " WHERE `ROUTINE_SCHEMA` = ? AND `ROUTINE_TYPE` = ?"
+           " ORDER BY `ROUTINE_NAME`";
+}
+
 void MySQLEntitiesFetcher::fetchStoredFunctions(const QString & dbName,
                                                 QList<EntityPtr> * toList)
 {
     QueryPtr queryResults;
 
     try {
-        queryResults = _connection->getResults(
-            QString("SHOW FUNCTION STATUS WHERE `Db` = ")
-                    + _connection->escapeString(dbName));
+        queryResults = _connection->getResults(routinesSQL(),
+                                               {dbName, "FUNCTION"});
     } catch(meow::db::Exception & ex) {
         meowLogCC(Log::Category::Error, _connection)
                 << "Failed to fetch stored functions: " << ex.message();
@@ -199,9 +386,8 @@ void MySQLEntitiesFetcher::fetchStoredProcedures(const QString & dbName,
     QueryPtr queryResults;
 
     try {
-        queryResults = _connection->getResults(
-            QString("SHOW PROCEDURE STATUS WHERE `Db` = ")
-                    + _connection->escapeString(dbName));
+        queryResults = _connection->getResults(routinesSQL(),
+                                               {dbName, "PROCEDURE"});
     } catch(meow::db::Exception & ex) {
         meowLogCC(Log::Category::Error, _connection)
                 << "Failed to fetch stored procedures: " << ex.message();
@@ -245,51 +431,6 @@ void MySQLEntitiesFetcher::fetchStoredProcedures(const QString & dbName,
     }
 }
 
-void MySQLEntitiesFetcher::fetchTriggers(const QString & dbName,
-                                         QList<EntityPtr> *toList)
-{
-
-    QueryPtr queryResults;
-
-    try {
-        queryResults = _connection->getResults(
-            QString("SHOW TRIGGERS FROM ")
-            + _connection->quoteIdentifier(dbName));
-    } catch(meow::db::Exception & ex) {
-        meowLogCC(Log::Category::Error, _connection)
-                << "Failed to fetch triggers: " << ex.message();
-        return;
-    }
-
-    Query * resPtr = queryResults.get();
-
-    if (resPtr) {
-
-        std::size_t indexOfTrigger = resPtr->indexOfColumn("Trigger");
-        std::size_t indexOfCreated = resPtr->indexOfColumn("Created");
-
-        while (resPtr->isEof() == false) {
-
-            QString name = resPtr->curRowColumn(indexOfTrigger);
-
-            TriggerEntityPtr trigger = EntityFactory::createTrigger(name);
-
-            if (!resPtr->isNull(indexOfCreated)) {
-                trigger->setCreated(
-                    helpers::parseDateTime(
-                        resPtr->curRowColumn(indexOfCreated)
-                    )
-                );
-            }
-
-            toList->append(trigger);
-
-            resPtr->seekNext();
-        }
-    }
-
-}
-
 } // namespace db
 } // namespace meow
 
@@ -13,15 +13,20 @@ class MySQLEntitiesFetcher : public DataBaseEntitiesFetcher
 public:
     MySQLEntitiesFetcher(MySQLConnection * connection);
     virtual QList<EntityPtr> run(const QString & dbName) override;
+    virtual QString fetchSignature(const QString & dbName) override;
+    virtual void run(const QString & dbName,
+                     const BatchCallback & onBatch) override;
 private:
+    // all kinds of entities by one query to information_schema
+    void fetchAllInOneQuery(const QString & dbName,
+                            const BatchCallback & onBatch);
     void fetchTablesViews(const QString & dbName,
                           QList<EntityPtr> * toList);
     void fetchStoredFunctions(const QString & dbName,
                           QList<EntityPtr> * toList);
     void fetchStoredProcedures(const QString & dbName,
                           QList<EntityPtr> * toList);
-    void fetchTriggers(const QString & dbName,
-                       QList<EntityPtr> * toList);
+    QString routinesSQL() const;
 };
 
 } // namespace db
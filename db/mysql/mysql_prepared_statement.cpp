@@ -0,0 +1,79 @@
+#include "mysql_prepared_statement.h"
+#include "db/exception.h"
+
+#include <cstring>
+#include <vector>
+
+namespace meow {
+namespace db {
+
+MySQLPreparedStatement::MySQLPreparedStatement(MYSQL * handle)
+    : _stmt(mysql_stmt_init(handle))
+{
+    if (_stmt == nullptr) {
+        throw db::Exception(QString(mysql_error(handle)));
+    }
+}
+
+MySQLPreparedStatement::~MySQLPreparedStatement()
+{
+    mysql_stmt_close(_stmt); // safe after mysql_close() as well
+}
+
+void MySQLPreparedStatement::prepare(const QByteArray & SQL)
+{
+    if (mysql_stmt_prepare(_stmt,
+                           SQL.constData(),
+                           static_cast<unsigned long>(SQL.size())) != 0) {
+        throw db::Exception(lastError(), mysql_stmt_errno(_stmt));
+    }
+}
+
+void MySQLPreparedStatement::execute(const QList<QByteArray> & params)
+{
+    unsigned long paramCount = mysql_stmt_param_count(_stmt);
+
+    if (paramCount != static_cast<unsigned long>(params.size())) {
+        throw db::Exception(
+            QString("Wrong number of parameters: %1 instead of %2")
+                .arg(params.size()).arg(paramCount));
+    }
+
+    std::vector<MYSQL_BIND> binds(paramCount);
+    std::vector<unsigned long> lengths(paramCount);
+
+    if (paramCount > 0) {
+        std::memset(binds.data(), 0, sizeof(MYSQL_BIND) * paramCount);
+    }
+
+    for (unsigned long i = 0; i < paramCount; ++i) {
+        const QByteArray & param = params[static_cast<int>(i)];
+        MYSQL_BIND & bind = binds[i];
+        if (param.isNull()) {
+            bind.buffer_type = MYSQL_TYPE_NULL;
+        } else {
+            // the server casts to column type as for a quoted literal
+            lengths[i] = static_cast<unsigned long>(param.size());
+            bind.buffer_type = MYSQL_TYPE_STRING;
+            bind.buffer = const_cast<char *>(param.constData());
+            bind.buffer_length = lengths[i];
+            bind.length = &lengths[i];
+        }
+    }
+
+    if (paramCount > 0 && mysql_stmt_bind_param(_stmt, binds.data()) != 0) {
+        throw db::Exception(lastError(), mysql_stmt_errno(_stmt));
+    }
+
+    if (mysql_stmt_execute(_stmt) != 0) {
+        throw db::Exception(lastError(), mysql_stmt_errno(_stmt));
+    }
+}
+
+QString MySQLPreparedStatement::lastError() const
+{
+    return QString(mysql_stmt_error(_stmt));
+}
+
+} // namespace db
+} // namespace meow
@@ -0,0 +1,44 @@
+#ifndef DB_MYSQL_PREPARED_STATEMENT_H
+#define DB_MYSQL_PREPARED_STATEMENT_H
+
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+#include <mysql.h>
+#else
+#include <mysql/mysql.h>
+#endif
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+
+namespace meow {
+namespace db {
+
+// Intent: owns server-side prepared statement
+class MySQLPreparedStatement
+{
+public:
+    explicit MySQLPreparedStatement(MYSQL * handle);
+    ~MySQLPreparedStatement();
+
+    MySQLPreparedStatement(const MySQLPreparedStatement &) = delete;
+    MySQLPreparedStatement & operator=(const MySQLPreparedStatement &) = delete;
+
+    // throws db::Exception
+    void prepare(const QByteArray & SQL);
+
+    // params are sent as strings, null array is NULL; throws db::Exception
+    void execute(const QList<QByteArray> & params);
+
+    MYSQL_STMT * handle() const { return _stmt; }
+
+    QString lastError() const;
+
+private:
+    MYSQL_STMT * _stmt;
+};
+
+} // namespace db
+} // namespace meow
+
+#endif // DB_MYSQL_PREPARED_STATEMENT_H
@@ -3,15 +3,79 @@
 #include "db/connection.h"
 #include "db/data_type/mysql_data_type.h"
 #include "db/data_type/mysql_connection_data_types.h"
+#include "mysql_connection.h"
+#include "helpers/logger.h"
+
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <vector>
 
 namespace meow {
 namespace db {
 
+namespace {
+
+// abandoned stream: rows read (not decoded) before KILL QUERY, a small rest
+// is cheaper to receive than a helper connection
+const db::ulonglong ABANDON_DRAIN_ROWS = 10 * 1000;
+
+// YYYY-MM-DD[ hh:mm:ss[.ffffff]] as the server sends it in text protocol
+qint64 packDateTimeText(const QString & text)
+{
+    auto number = [&text](int position, int length) {
+        return text.midRef(position, length).toInt();
+    };
+
+    int hour = 0, minute = 0, second = 0, microsecond = 0;
+    if (text.length() >= 19) {
+        hour = number(11, 2);
+        minute = number(14, 2);
+        second = number(17, 2);
+    }
+    if (text.length() > 20) {
+        QStringRef fraction = text.midRef(20, 6);
+        microsecond = fraction.toInt();
+        for (int i = fraction.length(); i < 6; ++i) {
+            microsecond *= 10;
+        }
+    }
+
+    return packDateTime(number(0, 4), number(5, 2), number(8, 2),
+                        hour, minute, second, microsecond);
+}
+
+NativeValue nativeValueOfText(const QString & text, NativeValueType type)
+{
+    NativeValue value;
+    value.asInt = 0;
+    switch (type) {
+    case NativeValueType::Int:
+        value.asInt = text.toLongLong();
+        break;
+    case NativeValueType::UInt:
+        value.asUInt = text.toULongLong();
+        break;
+    case NativeValueType::Double:
+        value.asDouble = text.toDouble();
+        break;
+    case NativeValueType::DateTime:
+        value.asInt = packDateTimeText(text);
+        break;
+    default:
+        break;
+    }
+    return value;
+}
+
+} // namespace
+
 MySQLQueryResult::MySQLQueryResult(Connection * connection)
     : NativeQueryResult(connection)
     , _res(nullptr)
-    , _curRow(nullptr)
+    , _connectionHandle(nullptr)
     , _columnsParsed(false)
+    , _isStreaming(false)
 {
 
 }
@@ -21,147 +85,490 @@ void MySQLQueryResult::init(MYSQL_RES * res)
     Q_ASSERT( res != nullptr);
     Q_ASSERT(_res == nullptr);
 
+    LapTimer timer;
+
+    clearColumnData();
+
+    addColumnData(res);
+
+    // copy everything once, MYSQL_RES is not needed anymore
+    _columnarData.reset(columnCount());
+    _columnarData.reserveRows(static_cast<std::size_t>(res->row_count));
+
+    mysql_data_seek(res, 0);
+
+    MYSQL_ROW row;
+    while ((row = mysql_fetch_row(res))) {
+        storeRow(_columnarData, row, mysql_fetch_lengths(res));
+    }
+
+    mysql_free_result(res);
+
+    _recordCount = _columnarData.rowCount();
+
+    _timings.decode += timer.lap(); // rows are in memory already
+
+    seekFirst();
+}
+
+void MySQLQueryResult::initStreaming(MYSQL_RES * res,
+                                     MYSQL * connectionHandle,
+                                     const QElapsedTimer & queryTimer)
+{
+    Q_ASSERT( res != nullptr);
+    Q_ASSERT(_res == nullptr);
+
     _res = res;
+    _connectionHandle = connectionHandle;
+    _queryTimer = queryTimer;
+    _isStreaming = true;
 
-    _recordCount = nativeRowsCount();
+    _recordCount = 0; // grows in fetchMore()
 
     clearColumnData();
 
     addColumnData(_res);
 
-    if (isEditing()) {
-        prepareResultForEditing(this);
+    _columnarData.reset(columnCount());
+
+    // typed as pages of prepared statements are (see initPrepared()), but
+    // values are parsed from text once on receiving
+    const MYSQL_FIELD * fields = mysql_fetch_fields(_res);
+    for (std::size_t col = 0; col < columnCount(); ++col) {
+        _columnarData.setNativeType(col, nativeValueTypeOfField(&fields[col]));
     }
 
     seekFirst();
 }
 
-void MySQLQueryResult::clearColumnData()
+void MySQLQueryResult::initPrepared(MYSQL_STMT * stmt)
 {
-    _columns.clear();
-    _columnLengths.clear();
-    _columnIndexes.clear();
-    _columnsParsed = false;
-}
+    Q_ASSERT(_res == nullptr);
 
-void MySQLQueryResult::addColumnData(MYSQL_RES * result)
-{
-    if (_columnsParsed) return;
+    LapTimer timer;
 
-    auto types = static_cast<MySQLConnectionDataTypes *>(
-                connection()->dataTypes());
+    MYSQL_RES * metadata = mysql_stmt_result_metadata(stmt);
+    if (metadata == nullptr) {
+        throw db::Exception(QString(mysql_stmt_error(stmt)),
+                            mysql_stmt_errno(stmt));
+    }
 
-    unsigned int numFields = mysql_num_fields(result);
+    clearColumnData();
 
-    _columnLengths.resize(numFields);
-    // TODO: skip columns parsing when we don't need them (e.g. sample queries)
+    addColumnData(metadata);
+
+    std::size_t numCols = columnCount();
+
+    _columnarData.reset(numCols);
+
+    // how every column is received, binary protocol sends numbers and
+    // dates natively, so they are kept typed without parsing
+    std::vector<NativeValueType> nativeTypes(numCols);
+    std::vector<enum_field_types> bufferTypes(numCols);
+    std::vector<unsigned int> decimals(numCols);
+    std::vector<bool> isUnsigned(numCols);
+
+    for (std::size_t col = 0; col < numCols; ++col) {
+        MYSQL_FIELD * field = mysql_fetch_field_direct(
+                    metadata, static_cast<unsigned int>(col));
+        nativeTypes[col] = nativeValueTypeOfField(field);
+        isUnsigned[col] = (field->flags & UNSIGNED_FLAG) != 0;
+        decimals[col] = field->decimals;
+        switch (nativeTypes[col]) {
+        case NativeValueType::Int:
+        case NativeValueType::UInt:
+            bufferTypes[col] = MYSQL_TYPE_LONGLONG;
+            break;
+        case NativeValueType::DateTime:
+            bufferTypes[col] = MYSQL_TYPE_DATETIME;
+            break;
+        default: // doubles too: text is formatted by the library as usual
+            bufferTypes[col] = MYSQL_TYPE_STRING;
+            break;
+        }
+        _columnarData.setNativeType(col, nativeTypes[col]);
+    }
 
-    _columns.resize(numFields);
+    mysql_free_result(metadata);
 
-    for (unsigned int i=0; i < numFields; ++i) {
-        MYSQL_FIELD * field = mysql_fetch_field_direct(result, i);
-        QueryColumn & column = _columns[i];
-        QString fieldName = QString(field->name);
-        column.name = fieldName;
-        _columnIndexes.insert(fieldName, i);
-        if (connection()->serverVersionInt() >= 40100) {
-            column.orgName = QString(field->org_name);
-        } else {
-            column.orgName = fieldName;
+    _timings.decode += timer.lap();
+
+    if (mysql_stmt_store_result(stmt) != 0) {
+        throw db::Exception(QString(mysql_stmt_error(stmt)),
+                            mysql_stmt_errno(stmt));
+    }
+
+    _timings.fetch += timer.lap();
+
+    _columnarData.reserveRows(
+        static_cast<std::size_t>(mysql_stmt_num_rows(stmt)));
+
+    // longer text cells are fetched again with a bigger buffer
+    const unsigned long initialBufferSize = 256;
+
+    std::vector<MYSQL_BIND> binds(numCols);
+    std::vector<std::vector<char>> buffers(numCols);
+    std::vector<qint64> integers(numCols);
+    std::vector<MYSQL_TIME> times(numCols);
+    std::vector<unsigned long> lengths(numCols);
+    // my_bool in old clients, bool in 8.0 (so not a vector<bool>)
+    using NullFlag = std::remove_pointer<decltype(MYSQL_BIND::is_null)>::type;
+    std::unique_ptr<NullFlag[]> nulls(new NullFlag[numCols]());
+    std::vector<char *> row(numCols); // text cells, see rowDataToString()
+
+    for (std::size_t col = 0; col < numCols; ++col) {
+        if (bufferTypes[col] == MYSQL_TYPE_STRING) {
+            buffers[col].resize(initialBufferSize);
         }
-        column.flags = field->flags;
-        column.dataType = types->dataTypeOfField(field);
     }
 
-    _columnsParsed = true;
+    auto bindResult = [&]() {
+        if (numCols > 0) {
+            std::memset(binds.data(), 0, sizeof(MYSQL_BIND) * numCols);
+        }
+        for (std::size_t col = 0; col < numCols; ++col) {
+            MYSQL_BIND & bind = binds[col];
+            bind.buffer_type = bufferTypes[col];
+            switch (bufferTypes[col]) {
+            case MYSQL_TYPE_LONGLONG:
+                bind.buffer = &integers[col];
+                bind.is_unsigned = isUnsigned[col];
+                break;
+            case MYSQL_TYPE_DATETIME:
+                bind.buffer = &times[col];
+                break;
+            default:
+                bind.buffer = buffers[col].data();
+                bind.buffer_length = buffers[col].size();
+                break;
+            }
+            bind.length = &lengths[col];
+            bind.is_null = &nulls[col];
+        }
+        return mysql_stmt_bind_result(stmt, binds.data()) == 0;
+    };
+
+    bool bound = bindResult();
+
+    int status = bound ? mysql_stmt_fetch(stmt) : 1;
+
+    while (status == 0 || status == MYSQL_DATA_TRUNCATED) {
+        bool rebind = false;
+        for (std::size_t col = 0; col < numCols; ++col) {
+            if (nulls[col]) {
+                _columnarData.appendNull(col);
+                continue;
+            }
+
+            NativeValue nativeValue;
+
+            switch (bufferTypes[col]) {
+
+            case MYSQL_TYPE_LONGLONG:
+                if (nativeTypes[col] == NativeValueType::UInt) {
+                    nativeValue.asUInt = static_cast<quint64>(integers[col]);
+                    _columnarData.appendCell(col,
+                        QString::number(nativeValue.asUInt), nativeValue);
+                } else {
+                    nativeValue.asInt = integers[col];
+                    _columnarData.appendCell(col,
+                        QString::number(nativeValue.asInt), nativeValue);
+                }
+                break;
+
+            case MYSQL_TYPE_DATETIME: {
+                const MYSQL_TIME & time = times[col];
+                nativeValue.asInt = packDateTime(
+                    static_cast<int>(time.year),
+                    static_cast<int>(time.month),
+                    static_cast<int>(time.day),
+                    static_cast<int>(time.hour),
+                    static_cast<int>(time.minute),
+                    static_cast<int>(time.second),
+                    static_cast<int>(time.second_part));
+                _columnarData.appendCell(col,
+                    formatDateTime(time, decimals[col]), nativeValue);
+                break;
+            }
+
+            default: {
+                if (lengths[col] > binds[col].buffer_length) {
+                    buffers[col].resize(lengths[col]);
+                    binds[col].buffer = buffers[col].data();
+                    binds[col].buffer_length = lengths[col];
+                    mysql_stmt_fetch_column(stmt, &binds[col],
+                                            static_cast<unsigned int>(col), 0);
+                    rebind = true;
+                }
+                row[col] = buffers[col].data();
+                QString text = rowDataToString(row.data(), col, lengths[col]);
+                if (nativeTypes[col] == NativeValueType::Double) {
+                    nativeValue.asDouble = text.toDouble(); // once, on load
+                    _columnarData.appendCell(col, text, nativeValue);
+                } else {
+                    _columnarData.appendCell(col, text);
+                }
+                break;
+            }
+            }
+        }
+        _columnarData.commitRow();
+
+        if (rebind) {
+            bound = bindResult();
+        }
+        status = bound ? mysql_stmt_fetch(stmt) : 1;
+    }
+
+    QString error;
+    if (status == 1) {
+        error = QString(mysql_stmt_error(stmt));
+    }
+
+    mysql_stmt_free_result(stmt);
+
+    // fetching of stored rows is conversion only
+    _timings.decode += timer.lap();
+
+    if (!error.isEmpty()) {
+        throw db::Exception(error);
+    }
+
+    _recordCount = _columnarData.rowCount();
+
+    seekFirst();
 }
 
-bool MySQLQueryResult::hasData() const
+NativeValueType MySQLQueryResult::nativeValueTypeOfField(
+        const MYSQL_FIELD * field) const
 {
-    return _res != nullptr || NativeQueryResult::hasData();
+    if (field->flags & ZEROFILL_FLAG) {
+        return NativeValueType::None; // keep server's padding
+    }
+
+    switch (field->type) {
+    case MYSQL_TYPE_TINY:
+    case MYSQL_TYPE_SHORT:
+    case MYSQL_TYPE_INT24:
+    case MYSQL_TYPE_LONG:
+    case MYSQL_TYPE_YEAR:
+        return NativeValueType::Int; // unsigned fit too
+    case MYSQL_TYPE_LONGLONG:
+        return (field->flags & UNSIGNED_FLAG) ? NativeValueType::UInt
+                                              : NativeValueType::Int;
+    case MYSQL_TYPE_FLOAT:
+    case MYSQL_TYPE_DOUBLE:
+        return NativeValueType::Double;
+    // DECIMAL stays exact text, a double would round long values, see
+    // QueryDataSorter for its order
+    case MYSQL_TYPE_DATE:
+    case MYSQL_TYPE_DATETIME:
+    case MYSQL_TYPE_TIMESTAMP:
+        return NativeValueType::DateTime;
+    default:
+        return NativeValueType::None;
+    }
 }
 
-void MySQLQueryResult::seekRecNo(db::ulonglong value)
+QString MySQLQueryResult::formatDateTime(const MYSQL_TIME & time,
+                                         unsigned int decimals) const
 {
-    if (value == _curRecNo) {
-        return;
+    // as the server sends it in text protocol
+    QString result = QString("%1-%2-%3")
+            .arg(time.year, 4, 10, QLatin1Char('0'))
+            .arg(time.month, 2, 10, QLatin1Char('0'))
+            .arg(time.day, 2, 10, QLatin1Char('0'));
+
+    if (time.time_type == MYSQL_TIMESTAMP_DATE) {
+        return result;
+    }
+
+    result += QString(" %1:%2:%3")
+            .arg(time.hour, 2, 10, QLatin1Char('0'))
+            .arg(time.minute, 2, 10, QLatin1Char('0'))
+            .arg(time.second, 2, 10, QLatin1Char('0'));
+
+    if (decimals > 0 && decimals <= 6) {
+        QString fraction = QString("%1").arg(time.second_part, 6, 10,
+                                             QLatin1Char('0'));
+        result += '.' + fraction.left(static_cast<int>(decimals));
     }
 
-    if (value >= recordCount()) {
-        _curRecNo = recordCount();
-        _eof = true;
+    return result;
+}
+
+void MySQLQueryResult::freeNative()
+{
+    if (_isStreaming) {
+        finishStreaming(true);
+    }
+}
+
+void MySQLQueryResult::storeRow(ColumnarResultData & data,
+                                MYSQL_ROW row,
+                                unsigned long * lengths)
+{
+    unsigned int numCols = static_cast<unsigned int>(columnCount());
+
+    for (unsigned int col = 0; col < numCols; ++col) {
+        if (row[col] == nullptr) {
+            data.appendNull(col);
+            continue;
+        }
+        QString text = rowDataToString(row, col, lengths[col]);
+        NativeValueType nativeType = data.nativeType(col);
+        if (nativeType == NativeValueType::None) {
+            data.appendCell(col, text);
+        } else {
+            data.appendCell(col, text, nativeValueOfText(text, nativeType));
+        }
+    }
+    data.commitRow();
+}
+
+void MySQLQueryResult::finishStreaming(bool cancel)
+{
+    if (!_isStreaming) {
         return;
     }
 
-    if (isEditing() == false) {
-
-        std::vector<MYSQL_RES *> resultList = this->resultList();
-
-        db::ulonglong numRows = 0;
-        for (auto curResPtr : resultList) {
-            numRows += curResPtr->row_count;
-            if (value < numRows) {
-                // TODO: using unsigned with "-" is risky
-                db::ulonglong wantedLocalRecNo
-                        = curResPtr->row_count - (numRows - value);
-                // H: Do not seek if FCurrentRow points to the previous row
-                // of the wanted row
-                if (wantedLocalRecNo == 0
-                        || (_curRecNo+1 != value)
-                        || _curRow == nullptr) {
-                    // TODO: it does not seems we need 3rd condition?
-                    mysql_data_seek(curResPtr, wantedLocalRecNo);
-                }
+    threads::MutexLocker locker(connection()->mutex()); // protects handle
 
-                _curRow = mysql_fetch_row(curResPtr);
+    if (_res == nullptr) { // finished in another thread
+        return;
+    }
 
-                // H: Remember length of column contents.
-                // Important for Col() so contents
-                // of cells with #0 chars are not cut off
-                unsigned long * lengths = mysql_fetch_lengths(curResPtr);
+    if (cancel) {
+        db::ulonglong drainedCount = 0;
+        while (drainedCount < ABANDON_DRAIN_ROWS
+               && mysql_fetch_row(_res) != nullptr) {
+            ++drainedCount;
+        }
+        if (drainedCount == ABANDON_DRAIN_ROWS) {
+            // otherwise the rest of rows is read and discarded below, the
+            // connection stays busy until the server sent them all. The kill
+            // hits this query only: the lock holds next ones
+            static_cast<MySQLConnection *>(connection())->killRunningQuery();
+        }
+    }
 
-                for (size_t i=0; i<_columnLengths.size(); ++i) {
-                    _columnLengths[i] = lengths[i];
-                }
+    mysql_free_result(_res);
+    _res = nullptr;
 
-                break;
-            }
+    // H: Consume all results to avoid "Commands out of sync"
+    while (mysql_more_results(_connectionHandle)
+           && mysql_next_result(_connectionHandle) == 0) {
+        MYSQL_RES * nextResult = mysql_store_result(_connectionHandle);
+        if (nextResult) {
+            mysql_free_result(nextResult);
         }
     }
 
-    _curRecNo = value;
-    _eof = false;
+    _isStreaming = false;
+
+    static_cast<MySQLConnection *>(connection())
+            ->onStreamingResultFinished(this);
 }
 
-QString MySQLQueryResult::curRowColumn(std::size_t index, bool ignoreErrors)
+void MySQLQueryResult::fetchRows(ColumnarResultData & data,
+                                 db::ulonglong maxRows,
+                                 QueryTimings & timings)
 {
-    if (index < columnCount()) {
+    threads::MutexLocker locker(connection()->mutex()); // protects handle
+
+    if (!canFetchMore()) { // finished in another thread while we waited
+        return;
+    }
+
+    db::ulonglong fetchedCount = 0;
+    QString error;
+
+    // two clock reads per row, much less than decoding of it
+    LapTimer timer;
+    qint64 fetchNs = 0;
+    qint64 decodeNs = 0;
+
+    while (fetchedCount < maxRows) {
 
-        if (isEditing()) {
-            return _editableData->dataAt(_curRecNo, index);
+        MYSQL_ROW row = mysql_fetch_row(_res);
+
+        timer.lap(&fetchNs);
+        // own rows are not changed once pages are fetched aside
+        if (_columnarData.rowCount() == 0 && timings.firstByte.count() == 0) {
+            timings.firstByte = elapsedMicroseconds(_queryTimer);
+        }
+
+        if (row == nullptr) { // no more rows or error
+            if (mysql_errno(_connectionHandle) != 0) {
+                error = QString(mysql_error(_connectionHandle));
+            }
+            finishStreaming(false);
+            break;
         }
 
-        return rowDataToString(_curRow, index, _columnLengths[index]);
+        storeRow(data, row, mysql_fetch_lengths(_res));
 
-    } else if (!ignoreErrors) {
-        throw db::Exception(QString(
-            "Column #%1 not available. Query returned %2 columns and %3 rows.")
-            .arg(index).arg(columnCount()).arg(recordCount()
-        ));
+        timer.lap(&decodeNs);
+
+        ++fetchedCount;
     }
 
-    return QString();
+    timings.fetch += Microseconds(fetchNs / 1000);
+    timings.decode += Microseconds(decodeNs / 1000);
+    timings.rows += fetchedCount;
+
+    if (!error.isEmpty()) {
+        meowLogCC(Log::Category::Error, connection())
+                << "Query (fetch) failed: " << error;
+        throw db::Exception(error);
+    }
 }
 
-bool MySQLQueryResult::isNull(std::size_t index)
+void MySQLQueryResult::abandonFetch()
 {
-    throwOnInvalidColumnIndex(index);
+    if (canFetchMore()) {
+        meowLogDebugC(connection()) << "Abandon streaming result after "
+                                    << _recordCount << " rows";
+        finishStreaming(true);
+    }
+}
 
-    if (isEditing()) {
-        return _editableData->dataAt(_curRecNo, index).isNull();
+void MySQLQueryResult::clearColumnData()
+{
+    _columns.clear();
+    _columnIndexes.clear();
+    _columnsParsed = false;
+}
+
+void MySQLQueryResult::addColumnData(MYSQL_RES * result)
+{
+    if (_columnsParsed) return;
+
+    auto types = static_cast<MySQLConnectionDataTypes *>(
+                connection()->dataTypes());
+
+    unsigned int numFields = mysql_num_fields(result);
+
+    // TODO: skip columns parsing when we don't need them (e.g. sample queries)
+
+    _columns.resize(numFields);
+
+    for (unsigned int i=0; i < numFields; ++i) {
+        MYSQL_FIELD * field = mysql_fetch_field_direct(result, i);
+        QueryColumn & column = _columns[i];
+        QString fieldName = QString(field->name);
+        column.name = fieldName;
+        _columnIndexes.insert(fieldName, i);
+        if (connection()->serverVersionInt() >= 40100) {
+            column.orgName = QString(field->org_name);
+        } else {
+            column.orgName = fieldName;
+        }
+        column.flags = field->flags;
+        column.dataType = types->dataTypeOfField(field);
     }
 
-    return _curRow[index] == nullptr;
+    _columnsParsed = true;
 }
 
 bool MySQLQueryResult::columnIsPrimaryKeyPart(std::size_t index) const
@@ -182,24 +589,6 @@ bool MySQLQueryResult::columnIsIndexKeyPart(std::size_t index) const
     return (column(index).flags & MULTIPLE_KEY_FLAG) > 0;
 }
 
-std::vector<MYSQL_RES *> MySQLQueryResult::resultList() const
-{
-    // TODO: optimize/cache resultList?
-    std::vector<MYSQL_RES *> resultList;
-    resultList.reserve(_appendedResults.size() + 1);
-    if (_res) {
-        resultList.push_back(_res);
-    }
-
-    for (const QueryResultPt & appendedResult : _appendedResults) {
-        resultList.push_back(
-            static_cast<MySQLQueryResult *>(appendedResult.get())
-                    ->nativePtr()
-        );
-    }
-    return resultList;
-}
-
 QString MySQLQueryResult::rowDataToString(MYSQL_ROW row,
                         std::size_t col,
                         unsigned long dataLen)
@@ -218,46 +607,6 @@ QString MySQLQueryResult::rowDataToString(MYSQL_ROW row,
     return result;
 }
 
-void MySQLQueryResult::prepareResultForEditing(MYSQL_RES * result)
-{
-    // it seems that copying all data is simplest way as we need to
-    // insert/delete rows at top/in the middle of data as well
-    // TODO: heidi works other way, maybe it's faster and/or takes less memory
-
-    db::ulonglong numRows = result->row_count;
-    unsigned int numCols = mysql_num_fields(result);
-
-    _editableData->reserveForAppend(numRows);
-
-    mysql_data_seek(result, 0);
-
-    MYSQL_ROW rowDataRaw;
-    while ((rowDataRaw = mysql_fetch_row(result))) {
-        GridDataRow rowData;
-        rowData.reserve(numCols);
-
-        unsigned long * lengths = mysql_fetch_lengths(result);
-
-        for (unsigned col = 0; col < numCols; ++col) {
-            rowData.append(
-                rowDataToString(rowDataRaw, col, lengths[col])
-            );
-        }
-
-        _editableData->appendRow(rowData);
-    }
-}
-
-
-void MySQLQueryResult::prepareResultForEditing(NativeQueryResult * result)
-{
-    MySQLQueryResult * mysqlResult = static_cast<MySQLQueryResult *>(result);
-    if (mysqlResult->nativePtr()) {
-        prepareResultForEditing(mysqlResult->nativePtr());
-        mysqlResult->freeNative(); // we just copied all data
-    }
-}
-
 } // namespace db
 } // namespace meow
 
@@ -1,6 +1,8 @@
 #ifndef DB_MYSQL_QUERY_RESULT_H
 #define DB_MYSQL_QUERY_RESULT_H
 
+#include <atomic>
+
 #if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
 #include <mysql.h>
 #else
@@ -12,65 +14,72 @@
 namespace meow {
 namespace db {
 
-// Wraps and owns MYSQL_RES ptr
+// Copies MYSQL_RES into columnar data, owns MYSQL_RES of streaming result
 class MySQLQueryResult : public NativeQueryResult
 {
 public:
     MySQLQueryResult(Connection * connection = nullptr);
 
     void init(MYSQL_RES * res);
+    // res is from mysql_use_result(), rows are received by fetchMore().
+    // queryTimer is started when the query is sent, for time to first row
+    void initStreaming(MYSQL_RES * res,
+                       MYSQL * connectionHandle,
+                       const QElapsedTimer & queryTimer);
+    // copies rows of executed prepared statement, numbers and dates are kept
+    // typed as well (see ColumnarResultData::nativeValue()),
+    // throws db::Exception
+    void initPrepared(MYSQL_STMT * stmt);
 
     virtual ~MySQLQueryResult() override {
         freeNative();
     }
 
-    virtual db::ulonglong nativeRowsCount() const override {
-        return static_cast<db::ulonglong>(_res->row_count);
+    virtual bool canFetchMore() const override {
+        return _isStreaming;
     }
-
-    virtual bool hasData() const override;
-
-    virtual void seekRecNo(db::ulonglong value) override;
-
-    virtual QString curRowColumn(std::size_t index,
-                                 bool ignoreErrors = false) override;
-
-    virtual bool isNull(std::size_t index) override;
+    virtual void abandonFetch() override;
 
     virtual bool columnIsPrimaryKeyPart(std::size_t index) const override;
     virtual bool columnIsUniqueKeyPart(std::size_t index) const override;
     virtual bool columnIsIndexKeyPart(std::size_t index) const override;
 
+protected:
 
-    MYSQL_RES * nativePtr() const { return _res; }
+    virtual void fetchRows(ColumnarResultData & data,
+                           db::ulonglong maxRows,
+                           QueryTimings & timings) override;
 
-protected:
-    virtual void prepareResultForEditing(NativeQueryResult * result) override;
 private:
 
-    void freeNative() {
-        if (_res) {
-            mysql_free_result(_res);
-            _res = nullptr;
-        }
-    }
+    void freeNative();
+
+    // copies row to columnar data
+    void storeRow(ColumnarResultData & data,
+                  MYSQL_ROW row,
+                  unsigned long * lengths);
+
+    // drains the rest of unbuffered result and releases the connection,
+    // kills the query before if cancel
+    void finishStreaming(bool cancel);
 
     QString rowDataToString(MYSQL_ROW row,
                             std::size_t col,
                             unsigned long dataLen);
 
-    void prepareResultForEditing(MYSQL_RES * result);
-
     void clearColumnData();
     void addColumnData(MYSQL_RES * result);
 
+    NativeValueType nativeValueTypeOfField(const MYSQL_FIELD * field) const;
+    QString formatDateTime(const MYSQL_TIME & time,
+                           unsigned int decimals) const;
 
-    std::vector<MYSQL_RES *> resultList() const;
-
-    MYSQL_RES * _res;
-    MYSQL_ROW _curRow;
-    std::vector<unsigned int> _columnLengths; // FColumnLengths
+    MYSQL_RES * _res; // stays alive while streaming only
+    MYSQL * _connectionHandle; // for streaming only
+    QElapsedTimer _queryTimer; // for streaming only
     bool _columnsParsed;
+    // until the last row is received, changed under connection mutex
+    std::atomic<bool> _isStreaming;
 };
 
 using MySQLQueryResultPtr = std::shared_ptr<MySQLQueryResult>;
@@ -1,9 +1,12 @@
 #include "native_query_result.h"
+#include "connection.h"
 #include "exception.h"
 #include "editable_grid_data.h"
 #include "entity/table_entity.h"
 #include "helpers/logger.h"
 
+#include <algorithm>
+
 namespace meow {
 namespace db {
 
@@ -13,7 +16,10 @@ NativeQueryResult::NativeQueryResult(Connection * connection)
      _eof(false),
      _editableData(nullptr),
      _connection(connection),
-     _entity(nullptr)
+     _entity(nullptr),
+     _curRowData(nullptr),
+     _curRowDataRecNo(0),
+     _statisticsId(0)
 {
 
 }
@@ -34,6 +40,137 @@ void NativeQueryResult::seekNext()
     seekRecNo(_curRecNo + 1);
 }
 
+void NativeQueryResult::seekRecNo(db::ulonglong value)
+{
+    if (value == _curRecNo) {
+        return;
+    }
+
+    if (value >= recordCount()) {
+        _curRecNo = recordCount();
+        _eof = true;
+        return;
+    }
+
+    if (isEditing() == false) {
+
+        _curRowData = nullptr;
+
+        db::ulonglong ownRows = _columnarData.rowCount(); // grows if streamed
+
+        if (value < ownRows) {
+            _curRowData = &_columnarData;
+            _curRowDataRecNo = value;
+        } else {
+            db::ulonglong appendedRecNo = value - ownRows;
+            auto it = std::upper_bound(_appendedRowsEnd.begin(),
+                                       _appendedRowsEnd.end(),
+                                       appendedRecNo);
+            if (it != _appendedRowsEnd.end()) {
+                std::size_t index = static_cast<std::size_t>(
+                            it - _appendedRowsEnd.begin());
+                db::ulonglong chunkStart
+                        = (index == 0) ? 0 : _appendedRowsEnd[index - 1];
+                _curRowData = &_appendedResults[index]->_columnarData;
+                _curRowDataRecNo = appendedRecNo - chunkStart;
+            }
+        }
+
+        Q_ASSERT(_curRowData != nullptr);
+    }
+
+    _curRecNo = value;
+    _eof = false;
+}
+
+QString NativeQueryResult::curRowColumn(std::size_t index, bool ignoreErrors)
+{
+    if (index < columnCount()) {
+
+        if (isEditing()) {
+            return _editableData->dataAt(_curRecNo, index);
+        }
+
+        return _curRowData->cell(_curRowDataRecNo, index);
+
+    } else if (!ignoreErrors) {
+        throw db::Exception(QString(
+            "Column #%1 not available. Query returned %2 columns and %3 rows.")
+            .arg(index).arg(columnCount()).arg(recordCount()
+        ));
+    }
+
+    return QString();
+}
+
+QString NativeQueryResult::curRowColumnView(std::size_t index)
+{
+    if (index >= columnCount()) {
+        return QString();
+    }
+
+    if (isEditing()) {
+        return _editableData->dataViewAt(_curRecNo, index);
+    }
+
+    return _curRowData->cellView(_curRowDataRecNo, index);
+}
+
+std::vector<NativeQueryResult::DataChunk>
+NativeQueryResult::dataChunks() const
+{
+    std::vector<DataChunk> chunks;
+    if (isEditing()) {
+        return chunks;
+    }
+
+    chunks.push_back({&_columnarData, 0});
+    db::ulonglong ownRows = _columnarData.rowCount();
+    for (std::size_t i = 0; i < _appendedResults.size(); ++i) {
+        db::ulonglong chunkStart = (i == 0) ? 0 : _appendedRowsEnd[i - 1];
+        chunks.push_back({&_appendedResults[i]->_columnarData,
+                          ownRows + chunkStart});
+    }
+    return chunks;
+}
+
+std::size_t NativeQueryResult::memoryUsage() const
+{
+    std::size_t bytes = _columnarData.memoryUsage();
+    for (const QueryResultPt & appendedResult : _appendedResults) {
+        bytes += appendedResult->memoryUsage();
+    }
+    return bytes;
+}
+
+bool NativeQueryResult::isNull(std::size_t index)
+{
+    throwOnInvalidColumnIndex(index);
+
+    if (isEditing()) {
+        return _editableData->dataAt(_curRecNo, index).isNull();
+    }
+
+    return _curRowData->isNull(_curRowDataRecNo, index);
+}
+
+NativeValueType NativeQueryResult::columnNativeType(std::size_t index) const
+{
+    if (isEditing() || index >= _columnarData.columnCount()) {
+        return NativeValueType::None;
+    }
+
+    NativeValueType type = _columnarData.nativeType(index);
+
+    for (const QueryResultPt & appendedResult : _appendedResults) {
+        if (appendedResult->columnNativeType(index) != type) {
+            return NativeValueType::None;
+        }
+    }
+
+    return type;
+}
+
 db::ulonglong NativeQueryResult::recordCount() const
 {
     return isEditing() ? _editableData->rowsCount() : _recordCount;
@@ -114,6 +251,8 @@ bool NativeQueryResult::prepareEditing()
     if (_editableData) {
         return true;
     }
+    LapTimer timer;
+
     _editableData = new EditableGridData();
 
     prepareResultForEditing(this);
@@ -122,6 +261,10 @@ bool NativeQueryResult::prepareEditing()
         prepareResultForEditing(appendedResult.get());
     }
 
+    QueryTimings timings;
+    timings.editablePrepare = timer.lap();
+    addTimings(timings);
+
     return false;
 }
 
@@ -237,6 +380,22 @@ QStringList NativeQueryResult::columnValuesList(std::size_t index) const
     return {};
 }
 
+void NativeQueryResult::prepareResultForEditing(NativeQueryResult * result)
+{
+    // we need to insert/delete rows at top/in the middle of data as well,
+    // so editable data refers all rows and copies only changed ones
+
+    const ColumnarResultData & data = result->_columnarData;
+
+    db::ulonglong numRows = data.rowCount();
+
+    _editableData->reserveForAppend(static_cast<int>(numRows));
+
+    for (db::ulonglong row = 0; row < numRows; ++row) {
+        _editableData->appendRow(&data, row);
+    }
+}
+
 void NativeQueryResult::throwOnInvalidColumnIndex(std::size_t index)
 {
     if (index >= columnCount()) {
@@ -247,17 +406,89 @@ void NativeQueryResult::throwOnInvalidColumnIndex(std::size_t index)
     }
 }
 
+void NativeQueryResult::addTimings(const QueryTimings & timings)
+{
+    _timings += timings;
+    if (_connection) {
+        _connection->queryStatistics()->addTimings(_statisticsId, timings);
+    }
+}
+
 void NativeQueryResult::appendResultData(const QueryResultPt &result)
 {
+    // kept when editing too: editable data refers its rows
+    _appendedResults.push_back(result);
+    _appendedRowsEnd.push_back((_appendedRowsEnd.empty()
+                                ? 0 : _appendedRowsEnd.back())
+                               + result->recordCount());
+    _recordCount += result->recordCount();
+    if (_entity) {
+        result->setEntity(_entity);
+    }
     if (isEditing()) {
         prepareResultForEditing(result.get());
-    } else {
-        _appendedResults.push_back(result);
-        _recordCount += result->recordCount();
-        if (_entity) {
-            result->setEntity(_entity);
+    }
+}
+
+db::ulonglong NativeQueryResult::fetchMore(db::ulonglong maxRows)
+{
+    if (!canFetchMore()) {
+        return 0;
+    }
+
+    db::ulonglong firstNewRow = _columnarData.rowCount();
+    QueryTimings timings;
+    QString error;
+
+    try {
+        fetchRows(_columnarData, maxRows, timings);
+    } catch (db::Exception & ex) {
+        error = ex.message(); // keep rows received before
+    }
+
+    db::ulonglong fetchedCount = _columnarData.rowCount() - firstNewRow;
+    _recordCount += fetchedCount;
+
+    if (isEditing()) { // streamed rows after prepareEditing()
+        _editableData->reserveForAppend(static_cast<int>(fetchedCount));
+        for (db::ulonglong row = firstNewRow;
+             row < _columnarData.rowCount(); ++row) {
+            _editableData->appendRow(&_columnarData, row);
         }
     }
+
+    addTimings(timings);
+
+    // force to seek again, the current row may be past the old end
+    _curRecNo = -1;
+    _eof = false;
+
+    if (!error.isEmpty()) {
+        throw db::Exception(error);
+    }
+
+    return fetchedCount;
+}
+
+QueryResultPt NativeQueryResult::fetchMoreAside(db::ulonglong maxRows)
+{
+    auto aside = std::make_shared<NativeQueryResult>(_connection);
+    aside->_columns = _columns;
+    aside->_columnIndexes = _columnIndexes;
+    aside->_columnarData.reset(columnCount());
+    for (std::size_t col = 0; col < _columnarData.columnCount(); ++col) {
+        aside->_columnarData.setNativeType(col, _columnarData.nativeType(col));
+    }
+    aside->setStatisticsId(_statisticsId);
+
+    QueryTimings timings;
+    fetchRows(aside->_columnarData, maxRows, timings); // rows lost on error
+
+    aside->_recordCount = aside->_columnarData.rowCount();
+    aside->addTimings(timings);
+    aside->seekFirst();
+
+    return aside;
 }
 
 bool NativeQueryResult::columnIsPrimaryKeyPart(std::size_t index) const
@@ -1,11 +1,14 @@
 #ifndef DB_NATIVE_QUERY_RESULT_INTERFACE_H
 #define DB_NATIVE_QUERY_RESULT_INTERFACE_H
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <QMap>
 #include <QStringList>
 #include "query_column.h"
+#include "columnar_result_data.h"
+#include "query_timings.h"
 #include "db/common.h"
 
 namespace meow {
@@ -20,6 +23,7 @@ class ForeignKey;
 using QueryResultPt = std::shared_ptr<NativeQueryResult>;
 
 // Intent: represents native result of query like MYSQL_RES
+// Backends copy native rows once to ColumnarResultData, all reading is here
 class NativeQueryResult
 {
 public:
@@ -28,8 +32,6 @@ public:
 
     virtual ~NativeQueryResult();
 
-    virtual db::ulonglong nativeRowsCount() const = 0;
-
     void setConnection(Connection * connection) {
         _connection = connection;
     }
@@ -57,10 +59,13 @@ public:
         return _columns[index];
     }
 
-    virtual void seekRecNo(db::ulonglong value) = 0; // H: SetRecNo
+    virtual void seekRecNo(db::ulonglong value); // H: SetRecNo
 
     virtual QString curRowColumn(std::size_t index,
-                                 bool ignoreErrors = false) = 0;
+                                 bool ignoreErrors = false);
+
+    // Zero-copy, for display only: valid till this result is destroyed
+    QString curRowColumnView(std::size_t index);
 
     QString curRowColumn(const QString & colName,
                          bool ignoreErrors = false);
@@ -70,10 +75,41 @@ public:
     QMap<QString, QString> curRowAsObject();
 
     virtual bool hasData() const {
-        return !_appendedResults.empty();
+        return _columnarData.columnCount() > 0 || !_appendedResults.empty();
+    }
+
+    virtual bool isNull(std::size_t index); // TODO: add by name mthd
+
+    // Typed values are received by binary protocol only. None if a part of
+    // rows is text only or data is being edited (edits are text)
+    NativeValueType columnNativeType(std::size_t index) const;
+    // Current row, the column must be typed and not NULL
+    NativeValue curRowNativeValue(std::size_t index) const {
+        return _curRowData->nativeValue(_curRowDataRecNo, index);
     }
 
-    virtual bool isNull(std::size_t index) = 0; // TODO: add by name mthd
+    // Streaming (unbuffered) results deliver rows incrementally, recordCount()
+    // grows with every fetchMore() until the server has nothing left
+    virtual bool canFetchMore() const { return false; }
+    // returns count of newly fetched rows, throws db::Exception
+    db::ulonglong fetchMore(db::ulonglong maxRows);
+    // Receives next rows into a new result to be appended later (see
+    // appendResultData()), this one is not changed: safe to call in
+    // another thread while this is read. Throws db::Exception
+    QueryResultPt fetchMoreAside(db::ulonglong maxRows);
+    // stops receiving rows, keeps already fetched
+    virtual void abandonFetch() {}
+
+    struct DataChunk
+    {
+        const ColumnarResultData * data;
+        db::ulonglong firstRecNo;
+    };
+    // Storage of all rows in order, can be read from several threads while
+    // no rows are fetched. Empty if editing (see editableData())
+    std::vector<DataChunk> dataChunks() const;
+    // Approximate heap size of rows incl. appended, bytes
+    std::size_t memoryUsage() const;
 
     // true if was already prepared
     bool prepareEditing();
@@ -109,9 +145,28 @@ public:
     virtual bool columnIsUniqueKeyPart(std::size_t index) const;
     virtual bool columnIsIndexKeyPart(std::size_t index) const;
 
+    // Phases measured by this result: decoding, streamed rows, editing
+    const QueryTimings & timings() const { return _timings; }
+    // See Connection::addToStatistics()
+    void setStatisticsId(uint64_t id) { _statisticsId = id; }
+    // Adds to own timings and to connection's statistics
+    void addTimings(const QueryTimings & timings);
+
 protected:
 
-    virtual void prepareResultForEditing(NativeQueryResult * result) = 0;
+    // Receives up to maxRows streamed rows into data (own or aside), locks
+    // the connection. Throws db::Exception after storing the rows received
+    // before the error
+    virtual void fetchRows(ColumnarResultData & data,
+                           db::ulonglong maxRows,
+                           QueryTimings & timings) {
+        Q_UNUSED(data);
+        Q_UNUSED(maxRows);
+        Q_UNUSED(timings);
+    }
+
+    // refers rows of result's columnar data in editable data
+    virtual void prepareResultForEditing(NativeQueryResult * result);
 
     void throwOnInvalidColumnIndex(std::size_t index);
 
@@ -124,6 +179,14 @@ protected:
     Connection * _connection;
     Entity * _entity;
     std::vector<QueryResultPt> _appendedResults;
+    // row count of _appendedResults[0..i] (prefix sums) for binary search
+    std::vector<db::ulonglong> _appendedRowsEnd;
+    ColumnarResultData _columnarData;
+    // position of current row in own or appended data
+    const ColumnarResultData * _curRowData;
+    db::ulonglong _curRowDataRecNo;
+    QueryTimings _timings;
+    uint64_t _statisticsId;
 };
 
 
@@ -2,6 +2,7 @@
 #include "pg_connection_query_killer.h"
 #include "helpers/logger.h"
 #include "pg_query_result.h"
+#include "pg_prepared_statement.h"
 #include "db/query.h"
 #include "pg_query_data_editor.h"
 #include "db/data_type/pg_connection_data_types.h"
@@ -12,6 +13,7 @@
 #include "pg_entity_create_code_generator.h"
 #include "ssh/ssh_tunnel_factory.h"
 
+#include <algorithm>
 #include <QElapsedTimer>
 #include <QDebug>
 
@@ -19,11 +21,15 @@ namespace meow {
 namespace db {
 
 static const int PG_SEND_QUERY_STATUS_SUCCESS = 1;
+static const int PG_COPY_PART_SIZE = 1024 * 1024;
 
 PGConnection::PGConnection(const ConnectionParameters & params)
     : Connection(params)
     , _handle(nullptr)
     , _sshTunnel(nullptr)
+    , _streamingResult(nullptr)
+    , _preparedStatements(PREPARED_STATEMENTS_CACHE_SIZE)
+    , _lastPreparedStatementId(0)
 {
 
     _identifierQuote = QLatin1Char('"');
@@ -95,6 +101,11 @@ void PGConnection::setActive(bool active)
         }
     // !active
     } else if (_handle != nullptr) {
+        abandonStreamingResult();
+        for (const QString & SQL : _preparedStatements.keys()) {
+            _preparedStatements.object(SQL)->detach();
+        }
+        _preparedStatements.clear();
         PQfinish(_handle);
         _active = false;
         _handle = nullptr;
@@ -180,6 +191,8 @@ QueryResults PGConnection::query(
 {
     meowLogCC(Log::Category::SQL, this) << SQL;
 
+    abandonStreamingResult();
+
     ping(true);
 
     QueryResults results;
@@ -192,8 +205,6 @@ QueryResults PGConnection::query(
         nativeSQL = SQL.toLatin1();
     }
 
-    QElapsedTimer elapsedTimer;
-
     // PQsendQuery is async, so we don't know exec time on server, add all inc
     // waiting PQgetResult to exec time. TODO: get network time somehow?
 
@@ -205,11 +216,12 @@ QueryResults PGConnection::query(
         throw db::Exception(error);
     }
 
-    elapsedTimer.start();
+    LapTimer timer;
     auto queryResult = std::make_shared<PGQueryResult>(this);
-    queryResult->init(PQgetResult(_handle), _handle);
-    results.incExecDuration(
-            std::chrono::milliseconds(elapsedTimer.elapsed()));
+    PGresult * nativeResult = PQgetResult(_handle);
+    results.incExecDuration(timer.lap());
+    queryResult->init(nativeResult, _handle);
+    results.timings().decode += timer.lap();
 
     while (queryResult->nativePtr() != nullptr) {
 
@@ -244,20 +256,333 @@ QueryResults PGConnection::query(
             throw db::Exception(error);
         }
 
+        queryResult->freeNative(); // rows are in columnar data already
+
         // next query
-        elapsedTimer.start();
         queryResult = std::make_shared<PGQueryResult>(this);
-        queryResult->init(PQgetResult(_handle), _handle);
-        results.incExecDuration(
-                std::chrono::milliseconds(elapsedTimer.elapsed()));
+        timer.lap();
+        nativeResult = PQgetResult(_handle);
+        results.incExecDuration(timer.lap());
+        queryResult->init(nativeResult, _handle);
+        results.timings().decode += timer.lap();
     }
 
     meowLogDebugC(this) << "Query rows found/affected: " << results.rowsFound()
                         << "/" << results.rowsAffected();
 
+    addToStatistics(results);
+
+    return results;
+}
+
+QueryResults PGConnection::queryStreaming(const QString & SQL)
+{
+    meowLogCC(Log::Category::SQL, this) << SQL;
+
+    abandonStreamingResult();
+
+    ping(true);
+
+    // single-row mode keeps the handle busy until all rows are received,
+    // see abandonStreamingResult()
+    threads::MutexLocker locker(mutex());
+
+    QueryResults results;
+
+    QByteArray nativeSQL;
+
+    if (isUnicode()) {
+        nativeSQL = SQL.toUtf8();
+    } else {
+        nativeSQL = SQL.toLatin1();
+    }
+
+    QElapsedTimer elapsedTimer;
+    elapsedTimer.start();
+
+    // extended protocol: one result set can be streamed, the server
+    // rejects "a; b" with "cannot insert multiple commands..."
+    int sendQueryStatus = PQsendQueryParams(_handle,
+                                            nativeSQL.constData(),
+                                            0, // no params
+                                            nullptr,
+                                            nullptr,
+                                            nullptr,
+                                            nullptr,
+                                            0); // text results
+
+    if (sendQueryStatus != PG_SEND_QUERY_STATUS_SUCCESS) {
+        QString error = getLastError();
+        meowLogCC(Log::Category::Error, this) << "Query failed: " << error;
+        throw db::Exception(error);
+    }
+
+    if (PQsetSingleRowMode(_handle) != 1) {
+        meowLogDebugC(this) << "Failed to set single-row mode";
+    }
+
+    // waits for the first row only
+    PGresult * firstResult = PQgetResult(_handle);
+    results.incExecDuration(elapsedMicroseconds(elapsedTimer));
+    results.timings().firstByte = results.timings().exec;
+
+    if (firstResult == nullptr) {
+        addToStatistics(results);
+        return results;
+    }
+
+    ExecStatusType resultStatus = PQresultStatus(firstResult);
+
+    if (resultStatus == PGRES_SINGLE_TUPLE) {
+        auto result = std::make_shared<PGQueryResult>(this);
+        result->initStreaming(firstResult, _handle);
+        _streamingResult = result.get();
+        results << result;
+
+        meowLogDebugC(this) << "Query result is streaming";
+
+        addToStatistics(results);
+
+        return results;
+    }
+
+    QString error;
+
+    if (resultStatus == PGRES_TUPLES_OK) { // empty result set
+        auto result = std::make_shared<PGQueryResult>(this);
+        result->init(firstResult, _handle);
+        result->freeNative();
+        results << result;
+    } else if (resultStatus == PGRES_COMMAND_OK) { // no data but ok
+        auto affected = QString::fromUtf8(PQcmdTuples(firstResult));
+        results.incRowsAffected(static_cast<db::ulonglong>(affected.toInt()));
+        PQclear(firstResult);
+    } else {
+        error = QString::fromUtf8(PQresultErrorMessage(firstResult)).trimmed();
+        PQclear(firstResult);
+    }
+
+    // the connection is busy until PQgetResult() returns null
+    PGresult * nextResult;
+    while ((nextResult = PQgetResult(_handle)) != nullptr) {
+        PQclear(nextResult);
+    }
+
+    if (!error.isEmpty()) {
+        meowLogCC(Log::Category::Error, this) << "Query failed: " << error;
+        throw db::Exception(error);
+    }
+
+    addToStatistics(results);
+
     return results;
 }
 
+db::ulonglong PGConnection::bulkInsert(const QString & quotedTable,
+                                       const QStringList & quotedColumns,
+                                       const BulkRows & rows,
+                                       db::ulonglong * warningCount)
+{
+    if (warningCount) {
+        *warningCount = 0; // COPY fails on bad values instead
+    }
+
+    if (rows.count == 0) {
+        return 0;
+    }
+
+    // rows are in text format of COPY already
+    const QString SQL = "COPY " + quotedTable
+            + " (" + quotedColumns.join(", ") + ") FROM STDIN";
+
+    meowLogCC(Log::Category::SQL, this) << SQL;
+
+    abandonStreamingResult();
+
+    ping(true);
+
+    threads::MutexLocker locker(mutex());
+
+    PGresult * result = PQexec(_handle,
+        (isUnicode() ? SQL.toUtf8() : SQL.toLatin1()).constData());
+
+    if (PQresultStatus(result) != PGRES_COPY_IN) {
+        PQclear(result);
+        QString error = getLastError();
+        meowLogCC(Log::Category::Error, this) << "Copy failed: " << error;
+        throw db::Exception(error);
+    }
+    PQclear(result);
+
+    // rows are UTF-8, server expects client encoding as for queries
+    const QByteArray data = isUnicode()
+            ? rows.data : QString::fromUtf8(rows.data).toLatin1();
+
+    QString error;
+
+    for (int position = 0; position < data.size();
+         position += PG_COPY_PART_SIZE) {
+        int length = std::min(PG_COPY_PART_SIZE, data.size() - position);
+        if (PQputCopyData(_handle,
+                          data.constData() + position,
+                          length) != 1) {
+            error = getLastError();
+            break;
+        }
+    }
+
+    if (PQputCopyEnd(_handle, error.isEmpty() ? nullptr : "aborted") != 1
+            && error.isEmpty()) {
+        error = getLastError();
+    }
+
+    db::ulonglong inserted = 0;
+
+    // the result of COPY and nothing after it
+    while ((result = PQgetResult(_handle)) != nullptr) {
+        if (PQresultStatus(result) == PGRES_COMMAND_OK) {
+            inserted = QString::fromUtf8(PQcmdTuples(result)).toULongLong();
+        } else if (error.isEmpty()) {
+            error = QString::fromUtf8(PQresultErrorMessage(result)).trimmed();
+        }
+        PQclear(result);
+    }
+
+    if (!error.isEmpty()) {
+        meowLogCC(Log::Category::Error, this) << "Copy failed: " << error;
+        throw db::Exception(error);
+    }
+
+    return inserted;
+}
+
+QueryResults PGConnection::queryPrepared(const QString & SQL,
+                                         const QStringList & params,
+                                         bool storeResult)
+{
+    meowLogCC(Log::Category::SQL, this) << SQL;
+
+    abandonStreamingResult();
+
+    ping(true);
+
+    threads::MutexLocker locker(mutex());
+
+    QueryResults results;
+
+    QList<QByteArray> nativeParams;
+    nativeParams.reserve(params.size());
+    for (const QString & param : params) {
+        if (param.isNull()) {
+            nativeParams << QByteArray();
+        } else {
+            nativeParams << (isUnicode() ? param.toUtf8() : param.toLatin1());
+        }
+    }
+
+    try {
+        QElapsedTimer elapsedTimer;
+        elapsedTimer.start();
+
+        PGPreparedStatement * statement = preparedStatement(SQL);
+        PGresult * res = statement->execute(nativeParams);
+
+        // "cached plan must not change result type": columns of * were
+        // changed (e.g. ALTER TABLE), the failed statement did nothing.
+        // In transaction it's aborted already, so retry outside only
+        if (res != nullptr && PQresultStatus(res) == PGRES_FATAL_ERROR
+                && qstrcmp(PQresultErrorField(res, PG_DIAG_SQLSTATE),
+                           "0A000") == 0
+                && PQtransactionStatus(_handle) == PQTRANS_IDLE) {
+            PQclear(res);
+            _preparedStatements.remove(SQL); // DEALLOCATE
+            statement = preparedStatement(SQL);
+            res = statement->execute(nativeParams);
+        }
+
+        results.incExecDuration(elapsedMicroseconds(elapsedTimer));
+
+        if (res == nullptr) {
+            throw db::Exception(getLastError());
+        }
+
+        elapsedTimer.start();
+        auto queryResult = std::make_shared<PGQueryResult>(this);
+        queryResult->init(res, _handle);
+        results.timings().decode += elapsedMicroseconds(elapsedTimer);
+
+        ExecStatusType resultStatus = PQresultStatus(res);
+
+        if (resultStatus == PGRES_TUPLES_OK) {
+            results.incRowsFound(queryResult->recordCount());
+            if (storeResult) {
+                results << queryResult;
+            }
+        } else if (resultStatus == PGRES_COMMAND_OK) {
+            auto affected = QString::fromUtf8(PQcmdTuples(res));
+            results.incRowsAffected(
+                static_cast<db::ulonglong>(affected.toInt()));
+        } else {
+            throw db::Exception(
+                QString::fromUtf8(PQresultErrorMessage(res)).trimmed());
+        }
+
+        queryResult->freeNative(); // rows are in columnar data already
+
+    } catch (meow::db::Exception & ex) {
+        _preparedStatements.remove(SQL); // prepare again next time
+        meowLogCC(Log::Category::Error, this) << "Query (prepared) failed: "
+                                              << ex.message();
+        throw;
+    }
+
+    addToStatistics(results);
+
+    return results;
+}
+
+PGPreparedStatement * PGConnection::preparedStatement(const QString & SQL)
+{
+    PGPreparedStatement * statement = _preparedStatements.object(SQL);
+    if (statement != nullptr) {
+        return statement;
+    }
+
+    int paramCount = 0;
+    QString nativeSQL = replacePlaceholders(SQL, [&](int index) {
+        paramCount = index + 1;
+        return QString("$%1").arg(index + 1);
+    });
+
+    QByteArray name = "meow_stmt_"
+            + QByteArray::number(++_lastPreparedStatementId);
+
+    std::unique_ptr<PGPreparedStatement> newStatement(
+                new PGPreparedStatement(_handle, name));
+    newStatement->prepare(
+        isUnicode() ? nativeSQL.toUtf8() : nativeSQL.toLatin1(),
+        paramCount);
+
+    statement = newStatement.release();
+    _preparedStatements.insert(SQL, statement); // takes ownership
+    return statement;
+}
+
+void PGConnection::onStreamingResultFinished(PGQueryResult * result)
+{
+    if (_streamingResult == result) {
+        _streamingResult = nullptr;
+    }
+}
+
+void PGConnection::abandonStreamingResult()
+{
+    if (_streamingResult != nullptr) {
+        // calls onStreamingResultFinished()
+        _streamingResult->abandonFetch();
+    }
+}
+
 QString PGConnection::escapeString(const QString & str,
                              bool processJokerChars,
                              bool doQuote) const
@@ -426,6 +751,26 @@ QString PGConnection::applyLikeFilter(
     return conditions.join(" OR ");
 }
 
+QString PGConnection::applyQuickFilter(
+            const QList<db::TableColumn *> & columns,
+            const QString & value)
+{
+    // E'' as escapeString() escapes with backslashes; ::text to search
+    // numbers, dates etc. as displayed
+    QString likeWithValue = " LIKE E'%"
+            + escapeString(value.toLower(), true, false)
+            + "%'";
+
+    QStringList conditions;
+
+    for (db::TableColumn * column : columns) {
+        conditions.push_back("lower(" + quoteIdentifier(column->name())
+                             + "::text)" + likeWithValue);
+    }
+
+    return conditions.join(" OR ");
+}
+
 QueryDataFetcher * PGConnection::createQueryDataFetcher()
 {
     return new PGQueryDataFetcher(this);
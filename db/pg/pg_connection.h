@@ -1,6 +1,7 @@
 #ifndef DB_PG_CONNECTION_H
 #define DB_PG_CONNECTION_H
 
+#include <QCache>
 #include "db/connection.h"
 #include <libpq-fe.h>
 #include "db/entity/entity_filter.h" // TODO: PGEntityFilter
@@ -11,6 +12,9 @@ namespace ssh { class ISSHTunnel; }
 
 namespace db {
 
+class PGQueryResult;
+class PGPreparedStatement;
+
 class PGConnection : public Connection
 {
 public:
@@ -34,6 +38,19 @@ public:
             const QString & SQL,
             bool storeResult = false) override;
 
+    virtual QueryResults queryStreaming(const QString & SQL) override;
+
+    // COPY FROM STDIN
+    virtual db::ulonglong bulkInsert(
+            const QString & quotedTable,
+            const QStringList & quotedColumns,
+            const BulkRows & rows,
+            db::ulonglong * warningCount = nullptr) override;
+
+    virtual QueryResults queryPrepared(const QString & SQL,
+                                       const QStringList & params,
+                                       bool storeResult = false) override;
+
     virtual QString escapeString(const QString & str,
                                  bool processJokerChars = false,
                                  bool doQuote = true) const override;
@@ -53,6 +70,9 @@ public:
     virtual QString applyLikeFilter(
             const QList<db::TableColumn *> & columns,
             const QString & value) override;
+    virtual QString applyQuickFilter(
+            const QList<db::TableColumn *> & columns,
+            const QString & value) override;
 
     virtual QueryDataFetcher * createQueryDataFetcher() override;
 
@@ -72,6 +92,8 @@ public:
 
     virtual ConnectionQueryKillerPtr createQueryKiller() const override;
 
+    void onStreamingResultFinished(PGQueryResult * result);
+
 protected:
     virtual DataBaseEntitiesFetcher * createDbEntitiesFetcher() override;
 
@@ -92,8 +114,17 @@ private:
 
     inline QString qu(const char * identifier) const;
 
+    // single-row mode blocks the handle, release it before any query
+    void abandonStreamingResult();
+
+    // cached or prepared now, throws db::Exception
+    PGPreparedStatement * preparedStatement(const QString & SQL);
+
     PGconn * _handle;
     std::unique_ptr<ssh::ISSHTunnel> _sshTunnel;
+    PGQueryResult * _streamingResult; // not owned
+    QCache<QString, PGPreparedStatement> _preparedStatements; // SQL : stmt
+    int _lastPreparedStatementId;
 };
 
 } // namespace db
@@ -59,13 +59,13 @@ void PGEntitiesFetcher::fetchTablesViews(const QString & dbName,
     + "LEFT JOIN " + qu("pg_namespace") + " n ON t.table_schema = n.nspname "
     + "LEFT JOIN " + qu("pg_class") + " c ON n.oid = c.relnamespace AND "
     + "c.relname=t.table_name "
-    + "WHERE t." + qu("table_schema") + "=" + _connection->escapeString(dbName)
+    + "WHERE t." + qu("table_schema") + "=?"
     + " ORDER BY t.table_name";
 
     QueryPtr queryResults;
 
     try {
-        queryResults = _connection->getResults(SQL);
+        queryResults = _connection->getResults(SQL, {dbName});
     } catch(meow::db::Exception & ex) {
         meowLogCC(Log::Category::Error, _connection)
                 << "Failed to fetch tables/views: " << ex.message();
@@ -124,12 +124,11 @@ void PGEntitiesFetcher::fetchStoredFunctions(const QString & dbName,
     + " FROM " + cDot + qu("pg_namespace") + " AS " + qu("n")
     + " JOIN " + cDot + qu("pg_proc")      + " AS " + qu("p")
     + " ON " + pDot + qu("pronamespace") + " = " + nDot + qu("oid")
-    + " WHERE " + nDot + qu("nspname")
-    + " = " + _connection->escapeString(dbName)
+    + " WHERE " + nDot + qu("nspname") + " = ?"
     + " ORDER BY " + pDot + qu("proname");
 
     try {
-        queryResults = _connection->getResults(SQL);
+        queryResults = _connection->getResults(SQL, {dbName});
     } catch (meow::db::Exception & ex) {
         meowLogCC(Log::Category::Error, _connection)
                 << "Failed to fetch stored functions: " << ex.message();
@@ -13,6 +13,7 @@ class PGEntitiesFetcher : public DataBaseEntitiesFetcher
 public:
     PGEntitiesFetcher(PGConnection * connection);
 
+    using DataBaseEntitiesFetcher::run;
     virtual QList<EntityPtr> run(const QString & dbName) override;
 private:
     void fetchTablesViews(const QString & dbName,
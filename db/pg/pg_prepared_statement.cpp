@@ -0,0 +1,73 @@
+#include "pg_prepared_statement.h"
+#include "db/exception.h"
+
+#include <QString>
+#include <vector>
+
+namespace meow {
+namespace db {
+
+PGPreparedStatement::PGPreparedStatement(PGconn * handle,
+                                         const QByteArray & name)
+    : _handle(handle)
+    , _name(name)
+{
+
+}
+
+PGPreparedStatement::~PGPreparedStatement()
+{
+    if (_handle != nullptr) {
+        QByteArray SQL = "DEALLOCATE " + _name;
+        PQclear(PQexec(_handle, SQL.constData()));
+    }
+}
+
+void PGPreparedStatement::prepare(const QByteArray & SQL, int paramCount)
+{
+    // types are inferred by server
+    PGresult * res = PQprepare(_handle,
+                               _name.constData(),
+                               SQL.constData(),
+                               paramCount,
+                               nullptr);
+
+    QString error;
+    if (res == nullptr) {
+        error = QString::fromUtf8(PQerrorMessage(_handle)).trimmed();
+    } else if (PQresultStatus(res) != PGRES_COMMAND_OK) {
+        error = QString::fromUtf8(PQresultErrorMessage(res)).trimmed();
+    }
+    PQclear(res);
+
+    if (!error.isEmpty()) {
+        _handle = nullptr; // nothing to deallocate
+        throw db::Exception(error);
+    }
+}
+
+PGresult * PGPreparedStatement::execute(const QList<QByteArray> & params)
+{
+    int paramCount = params.size();
+
+    std::vector<const char *> values(static_cast<std::size_t>(paramCount));
+    std::vector<int> lengths(static_cast<std::size_t>(paramCount));
+
+    for (int i = 0; i < paramCount; ++i) {
+        const QByteArray & param = params[i];
+        std::size_t index = static_cast<std::size_t>(i);
+        values[index] = param.isNull() ? nullptr : param.constData();
+        lengths[index] = param.size();
+    }
+
+    return PQexecPrepared(_handle,
+                          _name.constData(),
+                          paramCount,
+                          values.data(),
+                          lengths.data(),
+                          nullptr, // all in text format
+                          0);
+}
+
+} // namespace db
+} // namespace meow
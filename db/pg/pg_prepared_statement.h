@@ -0,0 +1,39 @@
+#ifndef DB_PG_PREPARED_STATEMENT_H
+#define DB_PG_PREPARED_STATEMENT_H
+
+#include <libpq-fe.h>
+#include <QByteArray>
+#include <QList>
+
+namespace meow {
+namespace db {
+
+// Intent: named statement on server, deallocated on destruction
+class PGPreparedStatement
+{
+public:
+    PGPreparedStatement(PGconn * handle, const QByteArray & name);
+    ~PGPreparedStatement();
+
+    PGPreparedStatement(const PGPreparedStatement &) = delete;
+    PGPreparedStatement & operator=(const PGPreparedStatement &) = delete;
+
+    // SQL has $1..$N placeholders, throws db::Exception
+    void prepare(const QByteArray & SQL, int paramCount);
+
+    // params are sent as text, null array is NULL; returns null on
+    // connection failure, the caller owns the result
+    PGresult * execute(const QList<QByteArray> & params);
+
+    // the connection is closing, server drops statements itself
+    void detach() { _handle = nullptr; }
+
+private:
+    PGconn * _handle;
+    QByteArray _name;
+};
+
+} // namespace db
+} // namespace meow
+
+#endif // DB_PG_PREPARED_STATEMENT_H
@@ -17,13 +17,18 @@ void PGQueryDataEditor::insert(
 
     EditableGridData * editableData = data->query()->editableData();
 
+    QStringList placeholders;
+    for (int i = 0; i < values.size(); ++i) {
+        placeholders << "?";
+    }
+
     QString insertSQL = QString("INSERT INTO %1 (%2) VALUES (%3) RETURNING *")
         .arg(db::quotedFullName(data->query()->entity()))
         .arg(columns.join(", "))
-        .arg(values.join(", "));
+        .arg(placeholders.join(", "));
 
     // insert and get the whole new row, PG is cool
-    QStringList newRowData = connection->getRow(insertSQL);
+    QStringList newRowData = connection->getRow(insertSQL, values);
 
     editableData->editableRow()->isInserted = false;
 
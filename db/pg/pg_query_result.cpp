@@ -2,10 +2,19 @@
 #include "db/editable_grid_data.h"
 #include "db/data_type/pg_connection_data_types.h"
 #include "db/pg/pg_connection.h"
+#include "helpers/logger.h"
 
 namespace meow {
 namespace db {
 
+namespace {
+
+// abandoned stream: rows received (not decoded) before cancel request, a
+// small rest is cheaper to receive than a connection for the request
+const db::ulonglong ABANDON_DRAIN_ROWS = 10 * 1000;
+
+} // namespace
+
 void PGQueryResult::init(PGresult * result, PGconn * connectionHandle)
 {
     Q_ASSERT(_res == nullptr);
@@ -13,12 +22,22 @@ void PGQueryResult::init(PGresult * result, PGconn * connectionHandle)
     _res = result;
     _connectionHandle = connectionHandle;
 
-    _recordCount = nativeRowsCount();
-
     clearColumnData();
 
     addColumnData(_res);
 
+    int numRows = PQntuples(_res);
+    int numCols = PQnfields(_res);
+
+    _columnarData.reset(static_cast<std::size_t>(numCols));
+    _columnarData.reserveRows(static_cast<std::size_t>(numRows));
+
+    for (int row = 0; row < numRows; ++row) {
+        storeRow(_columnarData, _res, row);
+    }
+
+    _recordCount = _columnarData.rowCount();
+
     if (isEditing()) {
         prepareResultForEditing(this);
     }
@@ -26,127 +45,151 @@ void PGQueryResult::init(PGresult * result, PGconn * connectionHandle)
     seekFirst();
 }
 
-bool PGQueryResult::hasData() const
+void PGQueryResult::initStreaming(PGresult * firstRow,
+                                  PGconn * connectionHandle)
 {
-    return _res != nullptr || NativeQueryResult::hasData();
-}
+    Q_ASSERT(firstRow != nullptr);
+    Q_ASSERT(_res == nullptr);
 
-void PGQueryResult::seekRecNo(db::ulonglong value)
-{
-    if (value == _curRecNo) {
-        return;
-    }
+    _connectionHandle = connectionHandle;
+    _isStreaming = true;
 
-    if (value >= recordCount()) {
-        _curRecNo = recordCount();
-        _eof = true;
-        return;
-    }
+    clearColumnData();
 
-    if (isEditing() == false) {
+    addColumnData(firstRow);
 
-        std::vector<PGresult *> resultList = this->resultList();
+    _columnarData.reset(static_cast<std::size_t>(PQnfields(firstRow)));
 
-        db::ulonglong numRows = 0;
-        for (PGresult * result : resultList) {
+    storeRow(_columnarData, firstRow, 0);
+    PQclear(firstRow);
 
-            db::ulonglong resultNumRows = PQntuples(result);
-            numRows += resultNumRows;
+    _recordCount = _columnarData.rowCount(); // grows in fetchMore()
 
-            if (numRows > value) {
-                _currentResult = result;
-                // TODO: using unsigned with "-" is risky
-                _curRecNoLocal = resultNumRows - (numRows - value);
+    seekFirst();
+}
 
-                for (size_t i=0; i<_columnLengths.size(); ++i) {
-                    _columnLengths[i] = static_cast<unsigned int>(
-                        PQgetlength(
-                            _currentResult,
-                            static_cast<int>(_curRecNoLocal),
-                            static_cast<int>(i)
-                        )
-                    );
-                }
+void PGQueryResult::storeRow(ColumnarResultData & data,
+                             PGresult * res,
+                             int row)
+{
+    int numCols = PQnfields(res);
 
-                break;
-            }
-        }
+    for (int col = 0; col < numCols; ++col) {
+        data.appendCell( // null string for NULL
+            static_cast<std::size_t>(col),
+            rowDataToString(res, row, col, PQgetlength(res, row, col))
+        );
     }
-
-    _curRecNo = value;
-    _eof = false;
+    data.commitRow();
 }
 
-QString PGQueryResult::curRowColumn(std::size_t index,
-                                    bool ignoreErrors)
+void PGQueryResult::finishStreaming(bool cancel)
 {
-    // TODO: hide this check for release builds?
-    if (index < columnCount()) {
+    threads::MutexLocker locker(connection()->mutex()); // protects handle
 
-        if (isEditing()) {
-            return _editableData->dataAt(_curRecNo, index);
-        }
+    if (!_isStreaming) { // finished in another thread while we waited
+        return;
+    }
 
+    _isStreaming = false;
 
-        return rowDataToString(_currentResult,
-                               static_cast<int>(_curRecNoLocal),
-                               static_cast<int>(index),
-                               static_cast<int>(_columnLengths[index]));
+    PGresult * res;
 
-    } else if (!ignoreErrors) {
-        throw db::Exception(QString(
-            "Column #%1 not available. Query returned %2 columns and %3 rows.")
-            .arg(index).arg(columnCount()).arg(recordCount()
-        ));
+    if (cancel) {
+        db::ulonglong drainedCount = 0;
+        while (drainedCount < ABANDON_DRAIN_ROWS
+               && (res = PQgetResult(_connectionHandle)) != nullptr) {
+            PQclear(res);
+            ++drainedCount;
+        }
+        if (drainedCount == ABANDON_DRAIN_ROWS) {
+            // otherwise draining waits until the server sent all the rows
+            PGcancel * cancelHandle = PQgetCancel(_connectionHandle);
+            if (cancelHandle) {
+                char errorBuf[256];
+                PQcancel(cancelHandle, errorBuf, sizeof(errorBuf));
+                PQfreeCancel(cancelHandle);
+            }
+        }
     }
 
-    return QString();
+    // the connection is busy until PQgetResult() returns null
+    while ((res = PQgetResult(_connectionHandle)) != nullptr) {
+        PQclear(res);
+    }
+
+    static_cast<PGConnection *>(connection())
+            ->onStreamingResultFinished(this);
 }
 
-bool PGQueryResult::isNull(std::size_t index)
+void PGQueryResult::fetchRows(ColumnarResultData & data,
+                              db::ulonglong maxRows,
+                              QueryTimings & timings)
 {
-    throwOnInvalidColumnIndex(index);
+    threads::MutexLocker locker(connection()->mutex()); // protects handle
 
-    if (isEditing()) {
-        return _editableData->dataAt(_curRecNo, index).isNull();
+    if (!canFetchMore()) { // finished in another thread while we waited
+        return;
     }
 
-    return PQgetisnull(
-        _currentResult,
-        static_cast<int>(_curRecNoLocal),
-        static_cast<int>(index)
-    ) == 1;
-}
+    db::ulonglong fetchedCount = 0;
+    QString error;
 
-void PGQueryResult::prepareResultForEditing(NativeQueryResult * result)
-{
-    PGresult * nativeRes = static_cast<PGQueryResult *>(result)->nativePtr();
+    // two clock reads per row, much less than decoding of it
+    LapTimer timer;
+    qint64 fetchNs = 0;
+    qint64 decodeNs = 0;
 
-    int numRows = PQntuples(nativeRes);
-    int numCols = PQnfields(nativeRes);
+    while (fetchedCount < maxRows) {
 
-    _editableData->reserveForAppend(numRows);
+        PGresult * res = PQgetResult(_connectionHandle);
 
-    for (int row = 0; row < numRows; ++row) {
-        GridDataRow rowData;
-        rowData.reserve(numCols);
+        timer.lap(&fetchNs);
 
-        for (int col = 0; col < numCols; ++col) {
+        ExecStatusType status = res ? PQresultStatus(res) : PGRES_TUPLES_OK;
 
-            int cellLength = PQgetlength(nativeRes, row, col);
-            rowData.append(
-                rowDataToString(nativeRes, row, col, cellLength)
-            );
+        if (status == PGRES_SINGLE_TUPLE) {
+            storeRow(data, res, 0);
+            PQclear(res);
+            timer.lap(&decodeNs);
+            ++fetchedCount;
+            continue;
         }
 
-        _editableData->appendRow(rowData);
+        // zero-row PGRES_TUPLES_OK ends the set, anything else is an error
+        if (status != PGRES_TUPLES_OK) {
+            error = QString::fromUtf8(PQresultErrorMessage(res)).trimmed();
+        }
+        if (res) {
+            PQclear(res);
+        }
+        finishStreaming(false);
+        break;
+    }
+
+    timings.fetch += Microseconds(fetchNs / 1000);
+    timings.decode += Microseconds(decodeNs / 1000);
+    timings.rows += fetchedCount;
+
+    if (!error.isEmpty()) {
+        meowLogCC(Log::Category::Error, connection())
+                << "Query (fetch) failed: " << error;
+        throw db::Exception(error);
+    }
+}
+
+void PGQueryResult::abandonFetch()
+{
+    if (canFetchMore()) {
+        meowLogDebugC(connection()) << "Abandon streaming result after "
+                                    << _recordCount << " rows";
+        finishStreaming(true);
     }
 }
 
 void PGQueryResult::clearColumnData()
 {
     _columns.clear();
-    _columnLengths.clear();
     _columnIndexes.clear();
     _columnsParsed = false;
 }
@@ -160,7 +203,6 @@ void PGQueryResult::addColumnData(PGresult * result)
 
     unsigned int numFields = static_cast<unsigned int>(PQnfields(result));
 
-    _columnLengths.resize(numFields);
     // TODO: skip columns parsing when we don't need them (e.g. sample queries)
 
     _columns.resize(numFields);
@@ -182,24 +224,6 @@ void PGQueryResult::addColumnData(PGresult * result)
     _columnsParsed = true;
 }
 
-std::vector<PGresult *> PGQueryResult::resultList() const
-{
-    // TODO: optimize/cache resultList?
-    std::vector<PGresult *> resultList;
-    resultList.reserve(_appendedResults.size() + 1);
-    if (_res) {
-        resultList.push_back(_res);
-    }
-
-    for (const QueryResultPt & appendedResult : _appendedResults) {
-        resultList.push_back(
-            static_cast<PGQueryResult *>(appendedResult.get())
-                    ->nativePtr()
-        );
-    }
-    return resultList;
-}
-
 void PGQueryResult::clearAll() {
     while (_res != nullptr) {
         PQclear(_res);
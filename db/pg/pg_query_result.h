@@ -1,6 +1,7 @@
 #ifndef DB_PG_QUERY_RESULT_H
 #define DB_PG_QUERY_RESULT_H
 
+#include <atomic>
 #include <libpq-fe.h>
 #include "db/native_query_result.h"
 #include "db/common.h"
@@ -8,46 +9,40 @@
 namespace meow {
 namespace db {
 
-// Wraps and owns PGresult ptr
+// Wraps and owns PGresult ptr, copies its rows into columnar data
 class PGQueryResult : public NativeQueryResult
 {
 public:
     PGQueryResult(Connection * connection) :
         NativeQueryResult(connection),
         _res(nullptr),
-        _currentResult(nullptr),
         _connectionHandle(nullptr),
-        _columnsParsed(false)
+        _columnsParsed(false),
+        _isStreaming(false)
     {
 
     }
 
     void init(PGresult * res, PGconn * connectionHandle);
+    // firstRow is the first PGRES_SINGLE_TUPLE result of single-row mode,
+    // the rest are received by fetchMore()
+    void initStreaming(PGresult * firstRow, PGconn * connectionHandle);
 
     virtual ~PGQueryResult() override {
+        abandonFetch();
         freeNative();
     }
 
-    virtual db::ulonglong nativeRowsCount() const override {
-        return static_cast<db::ulonglong>(PQntuples(_res));
+    virtual bool canFetchMore() const override {
+        return _isStreaming;
     }
-
-    virtual bool hasData() const override;
-
-    virtual void seekRecNo(db::ulonglong value) override;
-
-    virtual QString curRowColumn(std::size_t index,
-                                 bool ignoreErrors = false) override;
-
-    virtual bool isNull(std::size_t index) override;
+    virtual void abandonFetch() override;
 
     void clearAll();
 
     PGresult * nativePtr() const { return _res; }
-protected:
-    virtual void prepareResultForEditing(NativeQueryResult * result) override;
-private:
 
+    // rows are already copied, only status/counts are lost
     void freeNative() {
         if (_res) {
             PQclear(_res);
@@ -55,20 +50,33 @@ private:
         }
     }
 
+protected:
+
+    virtual void fetchRows(ColumnarResultData & data,
+                           db::ulonglong maxRows,
+                           QueryTimings & timings) override;
+
+private:
+
+    // copies row to columnar data
+    void storeRow(ColumnarResultData & data, PGresult * res, int row);
+
+    // drains the rest of results and releases the connection, cancels
+    // the query on server first if rows are not needed anymore
+    void finishStreaming(bool cancel);
+
     void clearColumnData();
     void addColumnData(PGresult * res);
-    std::vector<PGresult *> resultList() const;
     QString rowDataToString(PGresult * result,
                             int row,
                             int col,
                             int dataLen);
 
     PGresult * _res;
-    PGresult * _currentResult;
     PGconn * _connectionHandle;
-    std::vector<unsigned int> _columnLengths;
     bool _columnsParsed;
-    db::ulonglong _curRecNoLocal;
+    // until the last row is received, changed under connection mutex
+    std::atomic<bool> _isStreaming;
 };
 
 using PGQueryResultPtr = std::shared_ptr<PGQueryResult>;
@@ -17,128 +17,54 @@ void QtSQLQueryResult::init(QSqlQuery * query, QSqlDatabase * database)
     _query = query;
     _database = database;
 
-    _recordCount = nativeRowsCount();
-
     clearColumnData();
 
     addColumnData(_query);
 
-    if (isEditing()) {
-        prepareResultForEditing(this);
-    }
-
-    seekFirst();
-}
+    // read all rows once
+    std::size_t numCols = columnCount();
+    _columnarData.reset(numCols);
 
-db::ulonglong QtSQLQueryResult::nativeRowsCount() const
-{
-
-    if (_database->driver()->hasFeature(QSqlDriver::QuerySize)) { // fast
-
-        return static_cast<db::ulonglong>(_query->size());
-
-    } else { // slow
-        if (_rowsCountCache == static_cast<db::ulonglong>(-1)) {
-            _query->last();
-            int currentRow = _query->at();
-            if (currentRow < 0) { // on error this value is -2 in sqlite
-                _rowsCountCache = 0;
-            } else {
-                _rowsCountCache = static_cast<db::ulonglong>(currentRow + 1);
-            }
-
-            // TODO: seek first?
-            //_query->first();
-        }
-        return _rowsCountCache;
-    }
-}
-
-bool QtSQLQueryResult::hasData() const
-{
-    return _query != nullptr || NativeQueryResult::hasData();
-}
-
-void QtSQLQueryResult::seekRecNo(db::ulonglong value)
-{
-    if (value == _curRecNo) {
-        return;
+    if (_database->driver()->hasFeature(QSqlDriver::QuerySize)
+            && _query->size() > 0) {
+        _columnarData.reserveRows(static_cast<std::size_t>(_query->size()));
     }
 
-    if (value >= recordCount()) {
-        _curRecNo = recordCount();
-        _eof = true;
-        return;
-    }
-
-    if (isEditing() == false) {
-        db::ulonglong numRows = 0;
-        std::vector<const QtSQLQueryResult *> resultList = this->resultList();
-        for (const QtSQLQueryResult * result : resultList) {
-
-            db::ulonglong resultNumRows = result->nativeRowsCount();
-            numRows += resultNumRows;
-
-            if (value < numRows) {
-                // TODO: using unsigned with "-" is risky
-                db::ulonglong curRecNoLocal = resultNumRows - (numRows - value);
-                _currentQuery = result->query();
-                _currentQuery->seek(curRecNoLocal);
-
-                break;
+    while (_query->isSelect() && _query->next()) {
+        for (std::size_t col = 0; col < numCols; ++col) {
+            int colIndex = static_cast<int>(col);
+            if (_query->isNull(colIndex)) {
+                _columnarData.appendNull(col);
+            } else {
+                _columnarData.appendCell(col, valueToString(
+                    _query->value(colIndex), col));
             }
         }
+        _columnarData.commitRow();
     }
 
-    _curRecNo = value;
-    _eof = false;
-}
+    _recordCount = _columnarData.rowCount();
 
-QString QtSQLQueryResult::curRowColumn(std::size_t index, bool ignoreErrors)
-{
-    if (index < columnCount()) {
-
-        if (isEditing()) {
-            return _editableData->dataAt(_curRecNo, index);
-        }
-
-        DataTypeCategoryIndex typeCategory
-            = column(index).dataType->categoryIndex;
-        if (typeCategory == DataTypeCategoryIndex::Binary) {
-            // TODO: more effective way?
-            QByteArray bytes
-                    = _currentQuery->value(index).toByteArray();
-
-            return QString::fromLatin1(bytes.constData(), bytes.length());
-        }
-
-        return _currentQuery->value(index).toString();
-
-    } else if (!ignoreErrors) {
-        throw db::Exception(QString(
-            "Column #%1 not available. Query returned %2 columns and %3 rows.")
-            .arg(index).arg(columnCount()).arg(recordCount()
-        ));
+    if (isEditing()) {
+        prepareResultForEditing(this);
     }
 
-    return QString();
+    seekFirst();
 }
 
-bool QtSQLQueryResult::isNull(std::size_t index)
+QString QtSQLQueryResult::valueToString(const QVariant & value,
+                                        std::size_t index) const
 {
-    throwOnInvalidColumnIndex(index);
+    DataTypeCategoryIndex typeCategory
+        = column(index).dataType->categoryIndex;
+    if (typeCategory == DataTypeCategoryIndex::Binary) {
+        // TODO: more effective way?
+        QByteArray bytes = value.toByteArray();
 
-    if (isEditing()) {
-        return _editableData->dataAt(_curRecNo, index).isNull();
+        return QString::fromLatin1(bytes.constData(), bytes.length());
     }
 
-    return _currentQuery->isNull(index);
-}
-
-void QtSQLQueryResult::prepareResultForEditing(NativeQueryResult * result)
-{
-    Q_UNUSED(result);
-    // TODO: not implemented
+    return value.toString();
 }
 
 void QtSQLQueryResult::clearColumnData()
@@ -171,21 +97,5 @@ void QtSQLQueryResult::addColumnData(QSqlQuery * query)
     _columnsParsed = true;
 }
 
-std::vector<const QtSQLQueryResult *> QtSQLQueryResult::resultList() const
-{
-    std::vector<const QtSQLQueryResult *> resultList;
-    resultList.reserve(_appendedResults.size() + 1);
-    if (_query) {
-        resultList.push_back(static_cast<const QtSQLQueryResult *>(this));
-    }
-
-    for (const QueryResultPt & appendedResult : _appendedResults) {
-        resultList.push_back(
-            static_cast<const QtSQLQueryResult *>(appendedResult.get())
-        );
-    }
-    return resultList;
-}
-
 } // namespace db
 } // namespace meow
@@ -1,4 +1,5 @@
 #include "query.h"
+#include "connection.h"
 #include "exception.h"
 #include "editable_grid_data.h"
 #include "entity/table_entity.h"
@@ -11,8 +12,8 @@ Query::Query(Connection * connection)
     :_rowsFound(0),
      _rowsAffected(0),
      _warningsCount(0),
-     _execDuration(std::chrono::milliseconds(0)),
-     _networkDuration(std::chrono::milliseconds(0)),
+     _statisticsId(0),
+     _isPrepared(false),
      _connection(connection),
      _entity(nullptr)
 {
@@ -27,31 +28,68 @@ Query::~Query()
 void Query::setSQL(const QString & SQL)
 {
     _SQL = SQL;
+    _bindValues.clear();
+    _isPrepared = false;
 }
 
-void Query::execute(bool appendData)
+void Query::execute(bool appendData, bool streamResult)
 {
     // TODO appendData for isEditing() is broken
 
-    QueryResults results = connection()->query(this->SQL(), true);
+    if (!_currentResult) {
+        appendData = false;
+    }
 
-    if (_entity) {
-        for (QueryResultPt & result : results.list()) {
-            result->setEntity(_entity);
-        }
+    // streaming results can't be appended, their row count is not known yet
+    Q_ASSERT(!(appendData && streamResult));
+
+    QueryResults results;
+    if (_isPrepared) {
+        results = connection()->queryPrepared(this->SQL(), _bindValues, true);
+    } else if (streamResult) {
+        results = connection()->queryStreaming(this->SQL());
+    } else {
+        results = connection()->query(this->SQL(), true);
     }
 
+    applyResults(results, appendData);
+}
+
+void Query::takeResults(Query * other, bool appendData)
+{
     if (!_currentResult) {
         appendData = false;
     }
 
+    QueryResults results;
+    results.list() = std::move(other->_resultList);
+    results.setRowsFound(other->_rowsFound);
+    results.setRowsffected(other->_rowsAffected);
+    results.setWarningsCount(other->_warningsCount);
+    results.setTimings(other->_timings);
+    results.setStatisticsId(other->_statisticsId);
+
+    other->_resultList.clear();
+    other->_currentResult = nullptr;
+
+    applyResults(results, appendData);
+}
+
+void Query::applyResults(QueryResults & results, bool appendData)
+{
+    if (_entity) {
+        for (QueryResultPt & result : results.list()) {
+            result->setEntity(_entity);
+        }
+    }
+
     if (appendData) {
 
         _rowsFound += results.rowsFound();
         _rowsAffected += results.rowsAffected();
         _warningsCount += results.warningsCount();
-        _execDuration = +results.execDuration();
-        _networkDuration = +results.networkDuration();
+        _timings += results.timings();
+        _statisticsId = results.statisticsId();
 
         Q_ASSERT(results.list().size() <= 1); // only 1 result can be added
 
@@ -64,8 +102,8 @@ void Query::execute(bool appendData)
         _rowsFound = results.rowsFound();
         _rowsAffected = results.rowsAffected();
         _warningsCount = results.warningsCount();
-        _execDuration = results.execDuration();
-        _networkDuration = results.networkDuration();
+        _timings = results.timings();
+        _statisticsId = results.statisticsId();
 
         _resultList = results.list();
         _currentResult = nullptr;
@@ -75,6 +113,13 @@ void Query::execute(bool appendData)
     }
 }
 
+void Query::addTimings(const QueryTimings & timings)
+{
+    _timings += timings;
+    if (_connection) {
+        _connection->queryStatistics()->addTimings(_statisticsId, timings);
+    }
+}
 
 } // namespace db
 } // namespace meow
@@ -9,6 +9,7 @@
 #include "common.h"
 #include "query_column.h"
 #include "native_query_result.h"
+#include "query_results.h"
 
 namespace meow {
 namespace db {
@@ -27,6 +28,12 @@ public:
     virtual ~Query();
 
     void setSQL(const QString & SQL);
+    // executes SQL with ? placeholders as prepared statement, call after
+    // setSQL()
+    void setBindValues(const QStringList & values) {
+        _bindValues = values;
+        _isPrepared = true;
+    }
     void setConnection(Connection * connection) { _connection = connection; }
 
     const QString & SQL() const { return _SQL; }
@@ -62,7 +69,12 @@ public:
     }
 
     // H: procedure Execute(AddResult: Boolean=False; UseRawResult: Integer=-1); virtual; abstract;
-    void execute(bool appendData = false);
+    // streamResult: rows are received later on demand, see canFetchMore()
+    void execute(bool appendData = false, bool streamResult = false);
+
+    // Moves results of other (executed in another thread for e.g.) as if
+    // they were received by execute()
+    void takeResults(Query * other, bool appendData = false);
 
     inline bool hasResult() {
         return _resultList.empty() == false;
@@ -104,6 +116,15 @@ public:
         return _currentResult->isNull(index);
     }
 
+    inline bool canFetchMore() const {
+        if (!_currentResult) return false;
+        return _currentResult->canFetchMore();
+    }
+    inline db::ulonglong fetchMore(db::ulonglong maxRows) {
+        Q_ASSERT(_currentResult != nullptr);
+        return _currentResult->fetchMore(maxRows);
+    }
+
     // true if was already prepared
     inline bool prepareEditing() {
         Q_ASSERT(_currentResult != nullptr);
@@ -164,24 +185,38 @@ public:
         return _warningsCount;
     }
 
-    inline std::chrono::milliseconds execDuration() const {
-        return _execDuration;
+    inline Microseconds execDuration() const {
+        return _timings.exec;
+    }
+
+    inline Microseconds networkDuration() const {
+        return _timings.fetch;
     }
 
-    inline std::chrono::milliseconds networkDuration() const {
-        return _networkDuration;
+    // of the last execute(), summed up if appended
+    inline const QueryTimings & timings() const {
+        return _timings;
     }
 
+    // Phases after execute() like model population, adds to connection's
+    // statistics of the last executed query
+    void addTimings(const QueryTimings & timings);
+
 protected:
 
     db::ulonglong _rowsFound;
     db::ulonglong _rowsAffected;
     db::ulonglong _warningsCount;
-    std::chrono::milliseconds _execDuration;
-    std::chrono::milliseconds _networkDuration;
+    QueryTimings _timings;
+    uint64_t _statisticsId;
 
 private:
+
+    void applyResults(QueryResults & results, bool appendData);
+
     QString _SQL;
+    QStringList _bindValues;
+    bool _isPrepared;
     Connection * _connection;
     Entity * _entity;
 
@@ -6,7 +6,9 @@ namespace db {
 QueryCriteria::QueryCriteria()
     :quotedDbAndTableName(""),
      limit(0),
-     offset(0)
+     offset(0),
+     streamResult(false),
+     typedResult(false)
 {
     select << "*";
 }
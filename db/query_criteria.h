@@ -19,12 +19,27 @@ public:
         bool isAsc = true;
     };
 
+    struct KeyColumn
+    {
+        QString columnName;
+        bool isNumeric = false; // value is put to SQL as is, not as string
+    };
+
     QStringList select;
     QString quotedDbAndTableName;
     QString where;
     db::ulonglong limit;
     db::ulonglong offset;
     QVector<SortColumn> sortColumns;
+    bool streamResult; // receive rows on demand, ignored for offset > 0
+    // execute as prepared statement to receive typed values (binary
+    // protocol), ignored if streaming
+    bool typedResult;
+    // Keyset (seek) paging: rows are ordered by keyColumns (if no sort
+    // columns) and if afterKeyValues is set only rows after them are
+    // selected instead of skipping offset rows
+    QVector<KeyColumn> keyColumns;
+    QStringList afterKeyValues;
 };
 
 } // namespace db
@@ -1,6 +1,7 @@
 #include "query_data.h"
 #include "helpers/formatting.h"
 #include "query_data_editor.h"
+#include "row_window_cache.h"
 #include "entity/table_entity.h"
 #include "helpers/logger.h"
 #include "app/app.h"
@@ -8,13 +9,17 @@
 namespace meow {
 namespace db {
 
-QueryData::QueryData() : QObject(), _curRowNumber(-1), _resultIndex(0)
+QueryData::QueryData() : QObject(), _curRowNumber(-1), _resultIndex(0),
+    _rowWindows(nullptr)
 {
 
 }
 
 int QueryData::rowCount() const
 {
+    if (_rowWindows) {
+        return _rowWindows->rowCount();
+    }
     if (_queryPtr && _queryPtr->resultCount() > 0) {
         return static_cast<int>(currentResult()->recordCount());
     }
@@ -29,6 +34,33 @@ int QueryData::columnCount() const
     return 0;
 }
 
+bool QueryData::canFetchMore() const
+{
+    if (_rowWindows) {
+        return false;
+    }
+    if (_queryPtr && _queryPtr->resultCount() > 0) {
+        return currentResult()->canFetchMore();
+    }
+    return false;
+}
+
+int QueryData::fetchMore(int maxRows)
+{
+    if (!canFetchMore() || maxRows <= 0) {
+        return 0;
+    }
+    return static_cast<int>(currentResult()->fetchMore(
+                                static_cast<db::ulonglong>(maxRows)));
+}
+
+void QueryData::abandonFetch()
+{
+    if (canFetchMore()) {
+        currentResult()->abandonFetch();
+    }
+}
+
 QString QueryData::columnName(int index) const
 {
     if (_queryPtr) {
@@ -87,12 +119,18 @@ bool QueryData::columnIsIndexKeyPart(std::size_t index) const
 
 QString QueryData::displayDataAt(int row, int column) const
 {
-    currentResult()->seekRecNo(row);
-    if (currentResult()->isNull(column)) {
+    db::ulonglong recNo = 0;
+    NativeQueryResult * result = resultForRow(row, &recNo);
+    if (!result) {
+        return QString(); // window is loading
+    }
+    result->seekRecNo(recNo);
+    if (result->isNull(column)) {
         return "(NULL)"; // TODO: const
     } else {
 
-        QString data = currentResult()->curRowColumn(column, true);
+        // no copy: lives as long as the model paints it
+        QString data = result->curRowColumnView(column);
 
         // TODO: more formatting, see AnyGridGetText
 
@@ -116,7 +154,12 @@ QString QueryData::displayDataAt(int row, int column) const
 
 QVariant QueryData::editDataAt(int row, int column) const
 {
-    currentResult()->seekRecNo(row);
+    db::ulonglong recNo = 0;
+    NativeQueryResult * result = resultForRow(row, &recNo);
+    if (!result) {
+        return QString();
+    }
+    result->seekRecNo(recNo);
 
     if (currentResult()->entity()) {
 
@@ -157,19 +200,63 @@ QVariant QueryData::editDataAt(int row, int column) const
         }
     }
 
-    if (currentResult()->isNull(column)) {
+    if (result->isNull(column)) {
         return QString();
     } else {
         // TODO: format binary?
 
-        return currentResult()->curRowColumn(column, true);
+        return result->curRowColumn(column, true);
     }
 }
 
 bool QueryData::isNullAt(int row, int column) const
 {
-    currentResult()->seekRecNo(static_cast<std::size_t>(row));
-    return currentResult()->isNull(static_cast<std::size_t>(column));
+    db::ulonglong recNo = 0;
+    NativeQueryResult * result = resultForRow(row, &recNo);
+    if (!result) {
+        return false;
+    }
+    result->seekRecNo(recNo);
+    return result->isNull(static_cast<std::size_t>(column));
+}
+
+db::NativeValueType QueryData::nativeTypeForColumn(int column) const
+{
+    if (!_queryPtr || _queryPtr->resultCount() == 0) {
+        return db::NativeValueType::None;
+    }
+    return currentResult()->columnNativeType(
+                static_cast<std::size_t>(column));
+}
+
+db::NativeValue QueryData::nativeDataAt(int row, int column) const
+{
+    db::ulonglong recNo = 0;
+    NativeQueryResult * result = resultForRow(row, &recNo);
+    if (!result) {
+        return db::NativeValue();
+    }
+    result->seekRecNo(recNo);
+    return result->curRowNativeValue(static_cast<std::size_t>(column));
+}
+
+NativeQueryResult * QueryData::resultForRow(int row,
+                                            db::ulonglong * recNo) const
+{
+    if (!_rowWindows) {
+        *recNo = static_cast<db::ulonglong>(row);
+        return currentResult().get();
+    }
+
+    int window = _rowWindows->windowOfRow(row);
+    *recNo = static_cast<db::ulonglong>(
+        row - _rowWindows->firstRowOfWindow(window));
+
+    NativeQueryResult * result = _rowWindows->window(window);
+    if (result && *recNo >= result->recordCount()) {
+        return nullptr;
+    }
+    return result;
 }
 
 bool QueryData::setData(int row, int col, const QVariant &value)
@@ -184,6 +271,9 @@ bool QueryData::setData(int row, int col, const QVariant &value)
 
 void QueryData::prepareEditing()
 {
+    if (_rowWindows) { // read-only
+        return;
+    }
     if (_queryPtr && _queryPtr->resultCount()) {
         currentResult()->prepareEditing();
         emit editingPrepared();
@@ -358,7 +448,8 @@ int QueryData::duplicateCurrentRowWithKeys()
     return newRowIndex;
 }
 
-QString QueryData::whereForCurRow(bool beforeModifications) const
+QString QueryData::whereForCurRow(bool beforeModifications,
+                                  QStringList * bindValues) const
 {
     QStringList whereList;
 
@@ -415,10 +506,16 @@ QString QueryData::whereForCurRow(bool beforeModifications) const
                 break;
             // TODO: other types
             default:
-                whereVal = currentResult()->connection()->escapeString(value);
+                whereVal = bindValues ? value
+                    : currentResult()->connection()->escapeString(value);
                 break;
             }
 
+            if (bindValues) {
+                bindValues->append(whereVal);
+                whereVal = "?";
+            }
+
             whereVal = '=' + whereVal;
         }
 
@@ -448,13 +545,15 @@ void QueryData::ensureFullRow(bool refresh)
     Q_ASSERT(currentResult()->entity());
 
     QString entityName = db::quotedFullName(currentResult()->entity());
+    QStringList whereValues;
     QString selectSQL = QString("SELECT %1 FROM %2 WHERE %3 %4")
             .arg(columnNames.join(", "))
             .arg(entityName)
-            .arg(whereForCurRow())
+            .arg(whereForCurRow(false, &whereValues))
             .arg(currentResult()->connection()->limitOnePostfix(true));
 
-    QStringList newRowData = currentResult()->connection()->getRow(selectSQL);
+    QStringList newRowData = currentResult()->connection()->getRow(
+                selectSQL, whereValues);
     if (newRowData.size() != row->data.size()) {
         meowLogC(Log::Category::Error) << "Failed to load full row";
         //Q_ASSERT(false);
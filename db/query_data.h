@@ -12,6 +12,8 @@
 namespace meow {
 namespace db {
 
+class RowWindowCache;
+
 // id => value
 using IdValueList = QList<QPair<QString, QString>>;
 
@@ -28,6 +30,13 @@ public:
                                               _curRowNumber = -1; }
     void clearData() { setQueryPtr(nullptr); }
 
+    // Rows are read from windows (read-only), query gives columns only.
+    // nullptr to read rows of query
+    void setRowWindows(const RowWindowCache * rowWindows) {
+        _rowWindows = rowWindows;
+    }
+    bool hasRowWindows() const { return _rowWindows != nullptr; }
+
     size_t resultCount() const {
         if (_queryPtr) {
             return _queryPtr->resultCount();
@@ -42,9 +51,16 @@ public:
 
     int rowCount() const;
     int columnCount() const;
+
+    bool canFetchMore() const;
+    int fetchMore(int maxRows); // returns count of fetched rows
+    void abandonFetch();
     QString displayDataAt(int row, int column) const;
     QVariant editDataAt(int row, int column) const;
     bool isNullAt(int row, int column) const;
+    // see NativeQueryResult::columnNativeType()
+    db::NativeValueType nativeTypeForColumn(int column) const;
+    db::NativeValue nativeDataAt(int row, int column) const;
     QString columnName(int index) const;
     db::DataTypeCategoryIndex columnDataTypeCategory(int index) const;
     db::DataTypePtr dataTypeForColumn(int column) const;
@@ -75,7 +91,9 @@ public:
         return query->editableData()->isRowInserted(rowNumber);
     }
 
-    QString whereForCurRow(bool beforeModifications = false) const;
+    // with bindValues: key values are ? placeholders appended to the list
+    QString whereForCurRow(bool beforeModifications = false,
+                           QStringList * bindValues = nullptr) const;
     void ensureFullRow(bool refresh = false);
 
     void setCurrentRowNumber(int row);
@@ -87,12 +105,17 @@ private:
 
     bool hasFullData() const;
 
+    // result with row and its record number there, nullptr if the row's
+    // window is not loaded yet
+    NativeQueryResult * resultForRow(int row, db::ulonglong * recNo) const;
+
     QVariant editDataForForeignKey(ForeignKey * fKey,
                                    const QString & columnName) const;
 
     db::QueryPtr _queryPtr;
     int _curRowNumber;
     size_t _resultIndex;
+    const RowWindowCache * _rowWindows;
 };
 
 using QueryDataPtr = std::shared_ptr<QueryData>;
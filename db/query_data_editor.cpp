@@ -19,6 +19,7 @@ bool QueryDataEditor::applyModificationsInDB(QueryData * data)
     if (!data->isModified()) return false;
 
     QStringList updateDataList;
+    QStringList updateValuesList;
     QStringList insertColumnsList;
     QStringList insertValuesList;
     Connection * connection = data->query()->connection();
@@ -43,35 +44,33 @@ bool QueryDataEditor::applyModificationsInDB(QueryData * data)
             continue; // not modified
         }
 
-        QString valInDB;
-        if (newValue.isNull()) {
-            valInDB = "NULL";
-        } else {
-            // TODO: bit/spatial/temporal preprocessing
-            valInDB = connection->escapeString(newValue);
-        }
+        // TODO: bit/spatial/temporal preprocessing
+        // values are bound to prepared statements, null string is NULL
 
         QString columnName = connection->quoteIdentifier(
                     data->query()->column(c).orgName);
 
         if (isInsert) {
             insertColumnsList << columnName;
-            insertValuesList << valInDB;
+            insertValuesList << newValue;
         } else {
-            updateDataList << columnName + "=" + valInDB;
+            updateDataList << columnName + "=?";
+            updateValuesList << newValue;
         }
     }
 
     if (!updateDataList.isEmpty()) {
+        QStringList whereValues;
         QString updateSQL = QString("UPDATE %1 SET %2 WHERE %3 %4")
                 .arg(db::quotedFullName(data->query()->entity()))
                 .arg(updateDataList.join(", "))
-                .arg(data->whereForCurRow(true))
+                .arg(data->whereForCurRow(true, &whereValues))
                 .arg(connection->limitOnePostfix(false));
 
         // TODO: use "RETURNING *" for PG and avoid selecting result?
 
-        connection->query(updateSQL.trimmed());
+        connection->queryPrepared(updateSQL.trimmed(),
+                                  updateValuesList + whereValues);
         // TODO check rows affected
         return true;
     } else if (!insertColumnsList.isEmpty()) {
@@ -94,12 +93,17 @@ void QueryDataEditor::insert(
 
     EditableGridData * editableData = data->query()->editableData();
 
+    QStringList placeholders;
+    for (int i = 0; i < values.size(); ++i) {
+        placeholders << "?";
+    }
+
     QString insertSQL = QString("INSERT INTO %1 (%2) VALUES (%3)")
         .arg(db::quotedFullName(data->query()->entity()))
         .arg(columns.join(", "))
-        .arg(values.join(", "));
+        .arg(placeholders.join(", "));
 
-    connection->query(insertSQL);
+    connection->queryPrepared(insertSQL, values);
 
     editableData->editableRow()->isInserted = false;
 }
@@ -111,12 +115,13 @@ void QueryDataEditor::deleteCurrentRow(QueryData * data)
 
     Connection * connection = data->query()->connection();
 
+    QStringList whereValues;
     QString deleteSQL = QString("DELETE FROM %1 WHERE %2 %3")
             .arg(db::quotedFullName(data->query()->entity()))
-            .arg(data->whereForCurRow(true))
+            .arg(data->whereForCurRow(true, &whereValues))
             .arg(connection->limitOnePostfix(false));
 
-    connection->query(deleteSQL.trimmed());
+    connection->queryPrepared(deleteSQL.trimmed(), whereValues);
 
     // TODO check rows affected
 }
@@ -21,6 +21,7 @@ public:
     void deleteCurrentRow(QueryData * data);
 
 protected:
+    // columns are quoted, values are raw (null string is NULL)
     virtual void insert(QueryData * data,
                 const QStringList & columns,
                 const QStringList & values);
@@ -37,11 +37,80 @@ QueryDataFetcher::partLoadColumns(TableEntity * table)
     return partLoadColumns;
 }
 
-void QueryDataFetcher::run(
-        QueryCriteria * queryCriteria,
-        QueryData * toData)
+QList<meow::db::TableColumn *>
+QueryDataFetcher::keysetColumns(TableEntity * table)
 {
+    QList<meow::db::TableColumn *> keyColumns;
+    for (const TableIndex * index : table->structure()->indicies()) {
+        if (!index->isPrimaryKey()) {
+            continue;
+        }
+        for (const QString & columnName : index->columnNames()) {
+            TableColumn * column
+                    = table->structure()->columnByName(columnName);
+            if (column == nullptr) {
+                return {};
+            }
+            // values are compared as received in text, keep exact ones only
+            switch (column->dataType()->categoryIndex) {
+            case DataTypeCategoryIndex::Integer:
+            case DataTypeCategoryIndex::Text:
+            case DataTypeCategoryIndex::Temporal:
+                keyColumns << column;
+                break;
+            default:
+                return {};
+            }
+        }
+        break;
+    }
+    return keyColumns;
+}
 
+QString QueryDataFetcher::keysetCondition(QueryCriteria * queryCriteria,
+                                          QStringList * bindValues) const
+{
+    // (k1 > v1) OR (k1 = v1 AND k2 > v2) OR ...
+    // row constructors (k1, k2) > (v1, v2) don't use index in old MySQL
+    QStringList alternatives;
+    QStringList equalParts;
+
+    for (int i = 0; i < queryCriteria->keyColumns.size(); ++i) {
+        const auto & keyColumn = queryCriteria->keyColumns[i];
+        QString column = _connection->quoteIdentifier(keyColumn.columnName);
+        QString value;
+        if (bindValues) {
+            value = "?";
+        } else {
+            value = keyColumn.isNumeric
+                ? queryCriteria->afterKeyValues[i]
+                : _connection->escapeString(queryCriteria->afterKeyValues[i]);
+        }
+
+        QStringList parts = equalParts;
+        parts << column + " > " + value;
+        alternatives << parts.join(" AND ");
+
+        equalParts << column + " = " + value;
+    }
+
+    if (bindValues) { // in order of placeholders
+        for (int i = 0; i < queryCriteria->keyColumns.size(); ++i) {
+            for (int k = 0; k <= i; ++k) {
+                bindValues->append(queryCriteria->afterKeyValues[k]);
+            }
+        }
+    }
+
+    if (alternatives.size() == 1) {
+        return alternatives.front();
+    }
+    return "((" + alternatives.join(") OR (") + "))";
+}
+
+QString QueryDataFetcher::selectSQL(QueryCriteria * queryCriteria,
+                                    QStringList * bindValues)
+{
     QString selectList = queryCriteria->select.join(", ");
     if (selectList.isEmpty()) {
         selectList = "*";
@@ -49,7 +118,16 @@ void QueryDataFetcher::run(
     QString select = selectList
             + " FROM " + queryCriteria->quotedDbAndTableName;
 
-    if (!queryCriteria->where.isEmpty()) {
+    bool seekKeys = !queryCriteria->keyColumns.isEmpty()
+            && queryCriteria->keyColumns.size()
+                == queryCriteria->afterKeyValues.size();
+
+    if (seekKeys) {
+        select += " WHERE " + keysetCondition(queryCriteria, bindValues);
+        if (!queryCriteria->where.isEmpty()) {
+            select += " AND (" + queryCriteria->where + ")";
+        }
+    } else if (!queryCriteria->where.isEmpty()) {
         select += " WHERE " + queryCriteria->where;
     }
 
@@ -69,12 +147,31 @@ void QueryDataFetcher::run(
 
 
         select += " ORDER BY " + sortStatements.join(", ");
+
+    } else if (!queryCriteria->keyColumns.isEmpty()) {
+
+        QStringList keyNames;
+        for (const auto & keyColumn : queryCriteria->keyColumns) {
+            keyNames << _connection->quoteIdentifier(keyColumn.columnName);
+        }
+
+        select += " ORDER BY " + keyNames.join(", ");
     }
 
-    select = _connection->applyQueryLimit("SELECT", select,
-                                          queryCriteria->limit,
-                                          queryCriteria->offset);
+    if (queryCriteria->limit == 0 && queryCriteria->offset == 0) {
+        return "SELECT " + select; // all rows, e.g. to export
+    }
+
+    // the seek replaces offset: it costs the same for any page
+    return _connection->applyQueryLimit("SELECT", select,
+                                        queryCriteria->limit,
+                                        seekKeys ? 0 : queryCriteria->offset);
+}
 
+void QueryDataFetcher::run(
+        QueryCriteria * queryCriteria,
+        QueryData * toData)
+{
     Query * query = toData->query();
     if (query == nullptr) {
         QueryPtr newQuery = _connection->createQuery();
@@ -82,9 +179,18 @@ void QueryDataFetcher::run(
         query = toData->query();
     }
 
-    query->setSQL(select);
+    bool appendData = queryCriteria->offset > 0;
+    bool streamResult = queryCriteria->streamResult && !appendData;
+
+    if (queryCriteria->typedResult && !streamResult) {
+        QStringList bindValues;
+        query->setSQL(selectSQL(queryCriteria, &bindValues));
+        query->setBindValues(bindValues);
+    } else {
+        query->setSQL(selectSQL(queryCriteria));
+    }
 
-    query->execute(queryCriteria->offset > 0);
+    query->execute(appendData, streamResult);
 }
 
 } // namespace db
@@ -22,6 +22,12 @@ public:
     virtual void run(QueryCriteria * queryCriteria,
                      QueryData * toData);
 
+    // SELECT statement run() executes, to execute it elsewhere (e.g. thread).
+    // With bindValues: key values are ? placeholders appended to the list,
+    // so the same statement is prepared for every page
+    virtual QString selectSQL(QueryCriteria * queryCriteria,
+                              QStringList * bindValues = nullptr);
+
     virtual QStringList selectList(TableEntity * table) {
         Q_UNUSED(table);
         QStringList select;
@@ -29,10 +35,16 @@ public:
         return select;
     }
 
+    // Primary key columns usable for keyset paging, empty if none
+    virtual QList<TableColumn *> keysetColumns(TableEntity * table);
+
 protected:
 
     QList<meow::db::TableColumn *> partLoadColumns(TableEntity * table);
 
+    QString keysetCondition(QueryCriteria * queryCriteria,
+                            QStringList * bindValues = nullptr) const;
+
     Connection * _connection;
 };
 
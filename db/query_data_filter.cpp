@@ -0,0 +1,296 @@
+#include "query_data_filter.h"
+#include "db/query_data.h"
+#include "helpers/formatting.h"
+#include "helpers/parallel.h"
+
+#include <algorithm>
+#include <QtAlgorithms>
+
+#if defined(__SSE2__) || defined(_M_X64) \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MEOW_FILTER_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace meow {
+namespace db {
+
+namespace {
+
+// rows per thread, less is scanned in the calling thread
+const std::size_t PARALLEL_FILTER_MIN_ROWS = 16 * 1024;
+
+const QString NULL_TEXT = QStringLiteral("(NULL)"); // see displayDataAt()
+
+inline ushort asciiToLower(ushort c)
+{
+    return (c >= 'A' && c <= 'Z') ? static_cast<ushort>(c + ('a' - 'A')) : c;
+}
+
+// needle is ASCII lower case
+inline bool equalsAsciiCaseInsensitive(const ushort * str,
+                                       const ushort * needle,
+                                       int length)
+{
+    for (int i = 0; i < length; ++i) {
+        if (asciiToLower(str[i]) != needle[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Looks for candidates by the first char of needle (8 chars at once with
+// SSE2), then compares the rest. needle is ASCII lower case, not empty
+bool containsAsciiCaseInsensitive(const ushort * haystack,
+                                  int length,
+                                  const ushort * needle,
+                                  int needleLength)
+{
+    const int last = length - needleLength; // last possible start
+    const ushort first = needle[0];
+    const ushort firstUpper = (first >= 'a' && first <= 'z')
+            ? static_cast<ushort>(first - ('a' - 'A')) : first;
+    int i = 0;
+
+#ifdef MEOW_FILTER_SSE2
+    const __m128i lower = _mm_set1_epi16(static_cast<short>(first));
+    const __m128i upper = _mm_set1_epi16(static_cast<short>(firstUpper));
+    for (; i + 8 <= last + 1; i += 8) {
+        __m128i chars = _mm_loadu_si128(
+            reinterpret_cast<const __m128i *>(haystack + i));
+        __m128i equal = _mm_or_si128(_mm_cmpeq_epi16(chars, lower),
+                                     _mm_cmpeq_epi16(chars, upper));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(equal));
+        while (mask != 0) { // 2 bits per char
+            unsigned bit = qCountTrailingZeroBits(mask);
+            int pos = i + static_cast<int>(bit / 2);
+            if (equalsAsciiCaseInsensitive(haystack + pos + 1,
+                                           needle + 1,
+                                           needleLength - 1)) {
+                return true;
+            }
+            mask &= ~(3u << bit);
+        }
+    }
+#endif
+
+    for (; i <= last; ++i) {
+        ushort c = haystack[i];
+        if ((c == first || c == firstUpper)
+                && equalsAsciiCaseInsensitive(haystack + i + 1,
+                                              needle + 1,
+                                              needleLength - 1)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+QueryDataFilter::QueryDataFilter(QueryData * data)
+    : _data(data)
+    , _regexp(false)
+    , _isPlain(true)
+    , _isAscii(true)
+    , _nullMatches(true)
+{
+
+}
+
+void QueryDataFilter::setPattern(const QString & pattern, bool regexp)
+{
+    _pattern = pattern;
+    _regexp = regexp;
+    _isPlain = isPlainPattern(pattern, regexp);
+
+    if (_isPlain) {
+        _needle = pattern.toLower();
+        _isAscii = std::all_of(_needle.cbegin(), _needle.cend(),
+                               [](QChar c) { return c.unicode() < 0x80; });
+        _regExp = QRegExp();
+        _nullMatches = NULL_TEXT.contains(pattern, Qt::CaseInsensitive);
+    } else {
+        _needle.clear();
+        _isAscii = false;
+        _regExp = QRegExp(pattern,
+                          Qt::CaseInsensitive,
+                          regexp ? QRegExp::RegExp : QRegExp::Wildcard);
+        _nullMatches = _regExp.indexIn(NULL_TEXT) != -1;
+    }
+}
+
+bool QueryDataFilter::canMatch() const
+{
+    if (_data->query() == nullptr || _data->resultCount() == 0) {
+        return false;
+    }
+    if (!_isPlain && !_regExp.isValid()) {
+        return false;
+    }
+    return !_data->currentResult()->dataChunks().empty();
+}
+
+std::vector<char> QueryDataFilter::matchRows() const
+{
+    return match(nullptr, 0);
+}
+
+std::vector<char> QueryDataFilter::matchRows(
+        const std::vector<char> & candidates) const
+{
+    return match(&candidates, 0);
+}
+
+std::vector<char> QueryDataFilter::matchRowsFrom(std::size_t firstRow) const
+{
+    return match(nullptr, firstRow);
+}
+
+bool QueryDataFilter::narrows(const QString & previousPattern,
+                              bool previousRegexp) const
+{
+    if (previousPattern.isEmpty()) {
+        return true;
+    }
+    return _isPlain
+        && isPlainPattern(previousPattern, previousRegexp)
+        && _pattern.contains(previousPattern, Qt::CaseInsensitive);
+}
+
+std::vector<char> QueryDataFilter::match(
+        const std::vector<char> * candidates,
+        std::size_t firstRow) const
+{
+    QueryResultPt result = _data->currentResult();
+    std::vector<NativeQueryResult::DataChunk> chunks = result->dataChunks();
+    Q_ASSERT(!chunks.empty());
+
+    std::size_t rowCount = static_cast<std::size_t>(
+        chunks.back().firstRecNo + chunks.back().data->rowCount());
+    std::size_t columnCount = result->columnCount();
+
+    std::vector<char> matches(rowCount, 0);
+
+    if (_pattern.isEmpty()) {
+        std::fill(matches.begin() + static_cast<std::ptrdiff_t>(
+                      std::min(firstRow, rowCount)),
+                  matches.end(), 1);
+        return matches;
+    }
+
+    std::vector<char> hexColumns(columnCount, 0);
+    for (std::size_t c = 0; c < columnCount; ++c) {
+        hexColumns[c] = dataTypeCategoryIsShownAsHex(
+            _data->columnDataTypeCategory(static_cast<int>(c)));
+    }
+
+    const bool asciiSearch = _isPlain && _isAscii;
+    const ushort * needle = _needle.utf16();
+    const int needleLength = _needle.length();
+
+    helpers::parallelFor(rowCount, PARALLEL_FILTER_MIN_ROWS,
+                         [&](std::size_t begin, std::size_t end) {
+
+        QRegExp regExp = _regExp; // not reentrant, copy per thread
+
+        auto cellMatches = [&](const QString & text) -> bool {
+            if (asciiSearch) {
+                return containsAsciiCaseInsensitive(text.utf16(),
+                                                    text.length(),
+                                                    needle,
+                                                    needleLength);
+            } else if (_isPlain) {
+                return text.contains(_needle, Qt::CaseInsensitive);
+            }
+            return regExp.indexIn(text) != -1;
+        };
+
+        // first chunk of range
+        auto chunkIt = std::upper_bound(chunks.begin(), chunks.end(), begin,
+            [](std::size_t recNo, const NativeQueryResult::DataChunk & chunk) {
+                return recNo < chunk.firstRecNo;
+            }) - 1;
+
+        for (std::size_t recNo = begin; recNo < end; ++recNo) {
+
+            while (recNo >= chunkIt->firstRecNo + chunkIt->data->rowCount()) {
+                ++chunkIt;
+            }
+
+            if (recNo < firstRow
+                    || (candidates && recNo < candidates->size()
+                        && !(*candidates)[recNo])) {
+                continue;
+            }
+
+            const ColumnarResultData * data = chunkIt->data;
+            db::ulonglong row = recNo - chunkIt->firstRecNo;
+
+            for (std::size_t c = 0; c < columnCount; ++c) {
+                const QChar * cell = data->cellData(row, c);
+                bool matched;
+                if (cell == nullptr) {
+                    matched = _nullMatches;
+                } else {
+                    int length = data->length(row, c);
+                    if (asciiSearch && !hexColumns[c]) {
+                        matched = length >= needleLength
+                            && containsAsciiCaseInsensitive(
+                                reinterpret_cast<const ushort *>(cell),
+                                length,
+                                needle,
+                                needleLength);
+                    } else {
+                        QString text = QString::fromRawData(cell, length);
+                        matched = cellMatches(hexColumns[c]
+                                              ? helpers::formatAsHex(text)
+                                              : text);
+                    }
+                }
+                if (matched) {
+                    matches[recNo] = 1;
+                    break;
+                }
+            }
+        }
+    });
+
+    return matches;
+}
+
+bool QueryDataFilter::matchesLikeFilter(const QString & pattern,
+                                        bool regexp,
+                                        bool hasHexColumns)
+{
+    if (pattern.isEmpty()
+            || !isPlainPattern(pattern, regexp)
+            || NULL_TEXT.contains(pattern, Qt::CaseInsensitive)) {
+        return false;
+    }
+    if (hasHexColumns) { // may be found in hex text of binary cells only
+        return !std::all_of(pattern.cbegin(), pattern.cend(), [](QChar c) {
+            ushort u = c.unicode();
+            return (u >= '0' && u <= '9')
+                || (u >= 'a' && u <= 'f') || (u >= 'A' && u <= 'F');
+        });
+    }
+    return true;
+}
+
+bool QueryDataFilter::isPlainPattern(const QString & pattern, bool regexp)
+{
+    if (regexp) {
+        return false;
+    }
+    for (const QChar c : pattern) {
+        if (c == '*' || c == '?' || c == '[') { // wildcards
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace db
+} // namespace meow
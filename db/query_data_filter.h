@@ -0,0 +1,69 @@
+#ifndef DB_QUERY_DATA_FILTER_H
+#define DB_QUERY_DATA_FILTER_H
+
+#include <vector>
+#include <QRegExp>
+#include <QString>
+
+namespace meow {
+namespace db {
+
+class QueryData;
+
+// Intent: quick filter of loaded query data, finds rows where any displayed
+// cell contains the pattern. Scans raw cells of columnar data in parallel
+// ranges of rows, plain ASCII patterns are searched with SIMD
+class QueryDataFilter
+{
+public:
+    explicit QueryDataFilter(QueryData * data);
+
+    // Same syntax as QSortFilterProxyModel: wildcard or regexp, case
+    // insensitive, matches any part of cell
+    void setPattern(const QString & pattern, bool regexp);
+    QString pattern() const { return _pattern; }
+    bool patternIsRegexp() const { return _regexp; }
+
+    // False if data can't be scanned directly (e.g. is being edited)
+    bool canMatch() const;
+
+    // Returns row number -> matched
+    std::vector<char> matchRows() const;
+    // Checks only candidates (row number -> to check), see narrows(). Rows
+    // out of candidates are checked
+    std::vector<char> matchRows(const std::vector<char> & candidates) const;
+    // Checks rows starting from firstRow, e.g. just loaded
+    std::vector<char> matchRowsFrom(std::size_t firstRow) const;
+
+    // True if rows matched by this pattern are always matched by previous,
+    // e.g. when user types more chars
+    bool narrows(const QString & previousPattern, bool previousRegexp) const;
+
+    // True if case insensitive LIKE '%pattern%' on server over non-hex
+    // columns (see Connection::applyQuickFilter()) finds at least the rows
+    // matched here. (NULL) cells are matched here but not by LIKE
+    static bool matchesLikeFilter(const QString & pattern,
+                                  bool regexp,
+                                  bool hasHexColumns);
+
+private:
+
+    std::vector<char> match(const std::vector<char> * candidates,
+                            std::size_t firstRow) const;
+
+    static bool isPlainPattern(const QString & pattern, bool regexp);
+
+    QueryData * _data;
+    QString _pattern;
+    bool _regexp;
+    bool _isPlain; // substring search, no wildcards
+    bool _isAscii;
+    QString _needle; // lower case if plain
+    QRegExp _regExp; // if not plain
+    bool _nullMatches; // NULL is displayed as (NULL)
+};
+
+} // namespace db
+} // namespace meow
+
+#endif // DB_QUERY_DATA_FILTER_H
@@ -0,0 +1,309 @@
+#include "query_data_sorter.h"
+#include "db/query_data.h"
+#include "db/data_type/data_type.h"
+#include "helpers/parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace meow {
+namespace db {
+
+namespace {
+
+// rows per thread, smaller data is sorted in the calling thread
+const std::size_t PARALLEL_SORT_MIN_ROWS = 64 * 1024;
+
+template <typename T>
+inline int compareValues(const T & left, const T & right)
+{
+    return (left < right) ? -1 : ((right < left) ? 1 : 0);
+}
+
+// NaN is greater than any number and equal to NaN as in PostgreSQL, plain
+// < would break strict weak ordering of the sort
+inline int compareDoubles(double left, double right)
+{
+    bool leftIsNaN = std::isnan(left);
+    bool rightIsNaN = std::isnan(right);
+    if (leftIsNaN || rightIsNaN) {
+        return compareValues<int>(leftIsNaN, rightIsNaN);
+    }
+    return compareValues(left, right);
+}
+
+// Unsigned decimal texts like "0012.5" vs "12.50", digit by digit
+int compareDecimalMagnitudes(QStringRef left, QStringRef right)
+{
+    auto stripLeadingZeros = [](QStringRef & value) {
+        int i = 0;
+        while (i < value.length() && value.at(i) == QLatin1Char('0')) {
+            ++i;
+        }
+        value = value.mid(i);
+    };
+    stripLeadingZeros(left);
+    stripLeadingZeros(right);
+
+    int leftPoint = left.indexOf(QLatin1Char('.'));
+    int rightPoint = right.indexOf(QLatin1Char('.'));
+    if (leftPoint == -1) leftPoint = left.length();
+    if (rightPoint == -1) rightPoint = right.length();
+
+    if (leftPoint != rightPoint) { // more integer digits
+        return compareValues(leftPoint, rightPoint);
+    }
+
+    int result = left.left(leftPoint).compare(right.left(rightPoint));
+    if (result != 0) {
+        return result < 0 ? -1 : 1;
+    }
+
+    QStringRef leftFraction = left.mid(leftPoint + 1);
+    QStringRef rightFraction = right.mid(rightPoint + 1);
+    int length = std::max(leftFraction.length(), rightFraction.length());
+    for (int i = 0; i < length; ++i) { // missing digits are zeros
+        QChar l = i < leftFraction.length() ? leftFraction.at(i)
+                                            : QLatin1Char('0');
+        QChar r = i < rightFraction.length() ? rightFraction.at(i)
+                                             : QLatin1Char('0');
+        if (l != r) {
+            return compareValues(l, r);
+        }
+    }
+    return 0;
+}
+
+// Exact order of DECIMAL/NUMERIC texts, double would round long ones
+int compareDecimals(const QString & left, const QString & right)
+{
+    bool leftIsNaN = left == QLatin1String("NaN"); // PostgreSQL: the biggest
+    bool rightIsNaN = right == QLatin1String("NaN");
+    if (leftIsNaN || rightIsNaN) {
+        return compareValues(leftIsNaN, rightIsNaN);
+    }
+
+    bool leftIsNegative = left.startsWith(QLatin1Char('-'));
+    bool rightIsNegative = right.startsWith(QLatin1Char('-'));
+    if (leftIsNegative != rightIsNegative) {
+        return leftIsNegative ? -1 : 1;
+    }
+
+    int result = compareDecimalMagnitudes(left.midRef(leftIsNegative ? 1 : 0),
+                                          right.midRef(rightIsNegative ? 1 : 0));
+    return leftIsNegative ? -result : result;
+}
+
+} // namespace
+
+QueryDataSorter::QueryDataSorter(QueryData * data,
+                                 Qt::CaseSensitivity textCaseSensitivity)
+    : _data(data)
+    , _textCaseSensitivity(textCaseSensitivity)
+{
+
+}
+
+std::vector<int> QueryDataSorter::sortedRows(
+        const std::vector<SortColumn> & columns) const
+{
+    int rowCount = _data->rowCount();
+
+    std::vector<Keys> keys;
+    keys.reserve(columns.size());
+    for (const SortColumn & column : columns) {
+        keys.push_back(extractKeys(column, rowCount));
+    }
+
+    std::vector<int> rows(static_cast<std::size_t>(rowCount));
+    std::iota(rows.begin(), rows.end(), 0);
+
+    // row number breaks ties: chunks are sorted with std::sort (not stable)
+    helpers::parallelSort(rows.begin(), rows.end(),
+        [this, &keys](int left, int right) {
+            for (const Keys & columnKeys : keys) {
+                int result = compareKeys(columnKeys, left, right);
+                if (result != 0) {
+                    return columnKeys.isAsc ? result < 0 : result > 0;
+                }
+            }
+            return left < right;
+        },
+        PARALLEL_SORT_MIN_ROWS);
+
+    return rows;
+}
+
+QueryDataSorter::Keys QueryDataSorter::extractKeys(
+        const SortColumn & column, int rowCount) const
+{
+    Keys keys;
+    keys.isAsc = column.isAsc;
+    keys.nulls.resize(static_cast<std::size_t>(rowCount));
+
+    QueryResultPt result = _data->currentResult();
+    std::size_t index = static_cast<std::size_t>(column.index);
+
+    NativeValueType nativeType = _data->nativeTypeForColumn(column.index);
+
+    if (nativeType != NativeValueType::None) {
+        switch (nativeType) {
+        case NativeValueType::UInt:
+            keys.type = KeyType::UInt;
+            keys.uints.resize(static_cast<std::size_t>(rowCount));
+            break;
+        case NativeValueType::Double:
+            keys.type = KeyType::Double;
+            keys.doubles.resize(static_cast<std::size_t>(rowCount));
+            break;
+        default: // Int, DateTime
+            keys.type = KeyType::Int;
+            keys.ints.resize(static_cast<std::size_t>(rowCount));
+            break;
+        }
+        for (int row = 0; row < rowCount; ++row) {
+            std::size_t i = static_cast<std::size_t>(row);
+            result->seekRecNo(i);
+            if (result->isNull(index)) {
+                keys.nulls[i] = true;
+                continue;
+            }
+            NativeValue value = result->curRowNativeValue(index);
+            switch (keys.type) {
+            case KeyType::UInt:
+                keys.uints[i] = value.asUInt;
+                break;
+            case KeyType::Double:
+                keys.doubles[i] = value.asDouble;
+                break;
+            default:
+                keys.ints[i] = value.asInt;
+                break;
+            }
+        }
+        return keys;
+    }
+
+    DataTypePtr dataType = _data->dataTypeForColumn(column.index);
+    if (dataType && (dataType->index == DataTypeIndex::Decimal
+                     || dataType->index == DataTypeIndex::Numeric)) {
+        extractTextKeys(keys, column.index, rowCount);
+        keys.type = KeyType::Decimal;
+        return keys;
+    }
+
+    switch (_data->columnDataTypeCategory(column.index)) {
+    case DataTypeCategoryIndex::Integer:
+        if (!extractIntKeys(keys, column.index, rowCount)) {
+            // e.g. BIGINT UNSIGNED above signed max
+            extractDoubleKeys(keys, column.index, rowCount);
+        }
+        break;
+    case DataTypeCategoryIndex::Float:
+        extractDoubleKeys(keys, column.index, rowCount);
+        break;
+    default: // temporal text is ISO formatted and sorts as is
+        extractTextKeys(keys, column.index, rowCount);
+        break;
+    }
+
+    return keys;
+}
+
+bool QueryDataSorter::extractIntKeys(Keys & keys,
+                                     int column,
+                                     int rowCount) const
+{
+    keys.type = KeyType::Int;
+    keys.ints.resize(static_cast<std::size_t>(rowCount));
+
+    QueryResultPt result = _data->currentResult();
+    std::size_t index = static_cast<std::size_t>(column);
+
+    for (int row = 0; row < rowCount; ++row) {
+        std::size_t i = static_cast<std::size_t>(row);
+        result->seekRecNo(i);
+        if (result->isNull(index)) {
+            keys.nulls[i] = true;
+            continue;
+        }
+        bool ok = false;
+        keys.ints[i] = result->curRowColumnView(index).toLongLong(&ok);
+        if (!ok) {
+            keys.ints.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+void QueryDataSorter::extractDoubleKeys(Keys & keys,
+                                        int column,
+                                        int rowCount) const
+{
+    keys.type = KeyType::Double;
+    keys.doubles.resize(static_cast<std::size_t>(rowCount));
+
+    QueryResultPt result = _data->currentResult();
+    std::size_t index = static_cast<std::size_t>(column);
+
+    for (int row = 0; row < rowCount; ++row) {
+        std::size_t i = static_cast<std::size_t>(row);
+        result->seekRecNo(i);
+        if (result->isNull(index)) {
+            keys.nulls[i] = true;
+            continue;
+        }
+        keys.doubles[i] = result->curRowColumnView(index).toDouble();
+    }
+}
+
+void QueryDataSorter::extractTextKeys(Keys & keys,
+                                      int column,
+                                      int rowCount) const
+{
+    keys.type = KeyType::Text;
+    keys.texts.resize(static_cast<std::size_t>(rowCount));
+
+    QueryResultPt result = _data->currentResult();
+    std::size_t index = static_cast<std::size_t>(column);
+
+    for (int row = 0; row < rowCount; ++row) {
+        std::size_t i = static_cast<std::size_t>(row);
+        result->seekRecNo(i);
+        if (result->isNull(index)) {
+            keys.nulls[i] = true;
+            continue;
+        }
+        // no copy of cell, the view lives while data is not changed
+        keys.texts[i] = result->curRowColumnView(index);
+    }
+}
+
+int QueryDataSorter::compareKeys(const Keys & keys, int left, int right) const
+{
+    std::size_t l = static_cast<std::size_t>(left);
+    std::size_t r = static_cast<std::size_t>(right);
+
+    if (keys.nulls[l] || keys.nulls[r]) {
+        return compareValues<int>(keys.nulls[r], keys.nulls[l]); // NULLs first
+    }
+
+    switch (keys.type) {
+    case KeyType::Int:
+        return compareValues(keys.ints[l], keys.ints[r]);
+    case KeyType::UInt:
+        return compareValues(keys.uints[l], keys.uints[r]);
+    case KeyType::Double:
+        return compareDoubles(keys.doubles[l], keys.doubles[r]);
+    case KeyType::Decimal:
+        return compareDecimals(keys.texts[l], keys.texts[r]);
+    case KeyType::Text:
+        return keys.texts[l].compare(keys.texts[r], _textCaseSensitivity);
+    }
+    return 0;
+}
+
+} // namespace db
+} // namespace meow
@@ -0,0 +1,72 @@
+#ifndef DB_QUERY_DATA_SORTER_H
+#define DB_QUERY_DATA_SORTER_H
+
+#include <vector>
+#include <QString>
+#include <QtGlobal>
+
+namespace meow {
+namespace db {
+
+class QueryData;
+
+// Intent: sorts rows of query data on client. Keys of sort columns are
+// extracted once into contiguous arrays according to column's data type
+// category (or native values if any), then a permutation of row numbers is
+// sorted, in parallel for big data
+class QueryDataSorter
+{
+public:
+
+    struct SortColumn
+    {
+        int index = -1;
+        bool isAsc = true;
+    };
+
+    explicit QueryDataSorter(QueryData * data,
+                             Qt::CaseSensitivity textCaseSensitivity
+                                = Qt::CaseSensitive);
+
+    // Returns row numbers in sorted order, rows with equal keys keep their
+    // relative order. NULLs are less than any value, NaN is greater than
+    // any number
+    std::vector<int> sortedRows(const std::vector<SortColumn> & columns) const;
+
+private:
+
+    enum class KeyType
+    {
+        Int,
+        UInt,
+        Double,
+        Decimal, // exact, compared as text of digits
+        Text
+    };
+
+    struct Keys
+    {
+        KeyType type = KeyType::Text;
+        bool isAsc = true;
+        std::vector<char> nulls; // char: no bit packing, faster to read
+        std::vector<qint64> ints;
+        std::vector<quint64> uints;
+        std::vector<double> doubles;
+        std::vector<QString> texts;
+    };
+
+    Keys extractKeys(const SortColumn & column, int rowCount) const;
+    bool extractIntKeys(Keys & keys, int column, int rowCount) const;
+    void extractDoubleKeys(Keys & keys, int column, int rowCount) const;
+    void extractTextKeys(Keys & keys, int column, int rowCount) const;
+
+    inline int compareKeys(const Keys & keys, int left, int right) const;
+
+    QueryData * _data;
+    Qt::CaseSensitivity _textCaseSensitivity;
+};
+
+} // namespace db
+} // namespace meow
+
+#endif // DB_QUERY_DATA_SORTER_H
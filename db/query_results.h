@@ -1,9 +1,9 @@
 #ifndef DB_QUERY_RESULTS_H
 #define DB_QUERY_RESULTS_H
 
-#include <chrono>
 #include <vector>
 #include "native_query_result.h"
+#include "query_timings.h"
 
 namespace meow {
 namespace db {
@@ -32,8 +32,7 @@ public:
         _rowsFound = 0;
         _rowsAffected = 0;
         _warningsCount = 0;
-        _execDuration = std::chrono::milliseconds(0);
-        _networkDuration = std::chrono::milliseconds(0);
+        _timings = QueryTimings();
     }
 
     inline db::ulonglong rowsFound() const {
@@ -68,28 +67,41 @@ public:
         _warningsCount = warningsCount;
     }
 
-    inline std::chrono::milliseconds execDuration() const {
-        return _execDuration;
+    inline const QueryTimings & timings() const {
+        return _timings;
     }
 
-    inline void setExecDuration(std::chrono::milliseconds duration) {
-        _execDuration = duration;
+    inline QueryTimings & timings() {
+        return _timings;
     }
 
-    inline void incExecDuration(std::chrono::milliseconds duration) {
-        _execDuration += duration;
+    inline void setTimings(const QueryTimings & timings) {
+        _timings = timings;
     }
 
-    inline std::chrono::milliseconds networkDuration() const {
-        return _networkDuration;
+    // See Connection::addToStatistics()
+    inline uint64_t statisticsId() const {
+        return _statisticsId;
     }
 
-    inline void setNetworkDuration(std::chrono::milliseconds duration) {
-        _networkDuration = duration;
+    inline void setStatisticsId(uint64_t id) {
+        _statisticsId = id;
     }
 
-    inline void incNetworkDuration(std::chrono::milliseconds duration) {
-        _networkDuration += duration;
+    inline Microseconds execDuration() const {
+        return _timings.exec;
+    }
+
+    inline void incExecDuration(Microseconds duration) {
+        _timings.exec += duration;
+    }
+
+    inline Microseconds networkDuration() const {
+        return _timings.fetch;
+    }
+
+    inline void incNetworkDuration(Microseconds duration) {
+        _timings.fetch += duration;
     }
 
     inline QueryResults & operator<< (const QueryResultPt &result) {
@@ -118,8 +130,8 @@ private:
     db::ulonglong _rowsFound = 0;
     db::ulonglong _rowsAffected = 0;
     db::ulonglong _warningsCount = 0;
-    std::chrono::milliseconds _execDuration = std::chrono::milliseconds(0);
-    std::chrono::milliseconds _networkDuration = std::chrono::milliseconds(0);
+    QueryTimings _timings;
+    uint64_t _statisticsId = 0;
 };
 
 
@@ -0,0 +1,58 @@
+#include "query_statistics.h"
+
+namespace meow {
+namespace db {
+
+QueryStatistics::QueryStatistics()
+    : _lastQueryId(0)
+    , _version(0)
+{
+    _data.since = QDateTime::currentDateTime();
+}
+
+uint64_t QueryStatistics::addQuery(const QueryTimings & timings)
+{
+    QMutexLocker locker(&_mutex);
+
+    ++_lastQueryId;
+    ++_data.queryCount;
+    _data.total += timings;
+    _data.last = timings;
+
+    _version.fetch_add(1, std::memory_order_relaxed);
+
+    return _lastQueryId;
+}
+
+void QueryStatistics::addTimings(uint64_t queryId,
+                                 const QueryTimings & timings)
+{
+    QMutexLocker locker(&_mutex);
+
+    _data.total += timings;
+    if (queryId == _lastQueryId) {
+        _data.last += timings;
+    }
+
+    _version.fetch_add(1, std::memory_order_relaxed);
+}
+
+QueryStatistics::Snapshot QueryStatistics::snapshot() const
+{
+    QMutexLocker locker(&_mutex);
+    return _data;
+}
+
+void QueryStatistics::reset()
+{
+    QMutexLocker locker(&_mutex);
+
+    ++_lastQueryId; // phases of the old last don't get into the new one
+    _data = Snapshot();
+    _data.since = QDateTime::currentDateTime();
+
+    _version.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace db
+} // namespace meow
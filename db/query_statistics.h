@@ -0,0 +1,56 @@
+#ifndef DB_QUERY_STATISTICS_H
+#define DB_QUERY_STATISTICS_H
+
+#include <atomic>
+#include <cstdint>
+#include <QDateTime>
+#include <QMutex>
+#include "query_timings.h"
+
+namespace meow {
+namespace db {
+
+// Intent: per session sums of query timings for statistics view.
+// Thread-safe: written by connection's threads and read by UI. Results report
+// once per query or batch of rows, never per row, so it is always enabled
+class QueryStatistics
+{
+public:
+
+    struct Snapshot
+    {
+        QueryTimings total;
+        QueryTimings last; // the latest query with its later phases
+        db::ulonglong queryCount = 0;
+        QDateTime since;
+    };
+
+    QueryStatistics();
+
+    // Counts a new query, returns its id for addTimings()
+    uint64_t addQuery(const QueryTimings & timings);
+
+    // Phases measured after the query returned: streamed rows, editing,
+    // model. Included in Snapshot::last while queryId is the latest
+    void addTimings(uint64_t queryId, const QueryTimings & timings);
+
+    Snapshot snapshot() const;
+
+    // Grows with every change, to skip refresh of views
+    uint64_t version() const {
+        return _version.load(std::memory_order_relaxed);
+    }
+
+    void reset();
+
+private:
+    mutable QMutex _mutex;
+    uint64_t _lastQueryId;
+    Snapshot _data;
+    std::atomic<uint64_t> _version;
+};
+
+} // namespace db
+} // namespace meow
+
+#endif // DB_QUERY_STATISTICS_H
@@ -0,0 +1,79 @@
+#ifndef DB_QUERY_TIMINGS_H
+#define DB_QUERY_TIMINGS_H
+
+#include <chrono>
+#include <QElapsedTimer>
+#include "common.h"
+
+namespace meow {
+namespace db {
+
+using Microseconds = std::chrono::microseconds;
+
+// QElapsedTimer::elapsed() is whole milliseconds, we want more
+inline Microseconds elapsedMicroseconds(const QElapsedTimer & timer)
+{
+    return Microseconds(timer.nsecsElapsed() / 1000);
+}
+
+// Intent: where the time of a query is spent, on the way from sending it to
+// the rows shown in grid. Phases which didn't happen stay zero
+struct QueryTimings
+{
+    Microseconds exec{0};      // server executes, till response header
+    Microseconds firstByte{0}; // query is sent -> first row is received
+    Microseconds fetch{0};     // rows transfer (incl. libs' own parsing)
+    Microseconds decode{0};    // native rows -> columnar data
+    Microseconds editablePrepare{0}; // editable copy of data
+    Microseconds modelPopulate{0};   // grid model takes rows
+    db::ulonglong rows = 0;
+
+    // firstByte overlaps exec and fetch, it is not a part of total
+    Microseconds total() const {
+        return exec + fetch + decode + editablePrepare + modelPopulate;
+    }
+
+    QueryTimings & operator+=(const QueryTimings & other) {
+        exec += other.exec;
+        firstByte += other.firstByte;
+        fetch += other.fetch;
+        decode += other.decode;
+        editablePrepare += other.editablePrepare;
+        modelPopulate += other.modelPopulate;
+        rows += other.rows;
+        return *this;
+    }
+};
+
+// Intent: measures a phase of a hot loop in laps, one clock read per lap,
+// so it's cheap enough for per row timing in release builds
+class LapTimer
+{
+public:
+    LapTimer() : _lastNs(0) { _timer.start(); }
+
+    // time since the previous lap (or start)
+    Microseconds lap() {
+        qint64 nowNs = _timer.nsecsElapsed();
+        qint64 lapNs = nowNs - _lastNs;
+        _lastNs = nowNs;
+        return Microseconds(lapNs / 1000);
+    }
+
+    // same as lap() but accumulates nanoseconds, per row laps are often
+    // less than a microsecond
+    void lap(qint64 * sumNs) {
+        qint64 nowNs = _timer.nsecsElapsed();
+        *sumNs += nowNs - _lastNs;
+        _lastNs = nowNs;
+    }
+
+private:
+    QElapsedTimer _timer;
+    qint64 _lastNs;
+};
+
+} // namespace db
+} // namespace meow
+
+#endif // DB_QUERY_TIMINGS_H
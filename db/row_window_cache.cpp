@@ -0,0 +1,38 @@
+#include "row_window_cache.h"
+
+namespace meow {
+namespace db {
+
+RowWindowCache::RowWindowCache(int windowRows, int memoryBudgetMB)
+    : _windowRows(windowRows)
+    , _windows(memoryBudgetMB * 1024)
+    , _rowCount(0)
+{
+
+}
+
+NativeQueryResult * RowWindowCache::window(int window) const
+{
+    Window * cached = _windows.object(window);
+    return cached ? cached->result.get() : nullptr;
+}
+
+bool RowWindowCache::insert(int window, const QueryResultPt & result)
+{
+    int costKB = static_cast<int>(result->memoryUsage() / 1024) + 1;
+    return _windows.insert(window, new Window{result}, costKB);
+}
+
+void RowWindowCache::clear()
+{
+    _windows.clear();
+    _rowCount = 0;
+}
+
+std::size_t RowWindowCache::memoryUsage() const
+{
+    return static_cast<std::size_t>(_windows.totalCost()) * 1024;
+}
+
+} // namespace db
+} // namespace meow
@@ -0,0 +1,52 @@
+#ifndef DB_ROW_WINDOW_CACHE_H
+#define DB_ROW_WINDOW_CACHE_H
+
+#include <QCache>
+#include "native_query_result.h"
+#include "common.h"
+
+namespace meow {
+namespace db {
+
+// Intent: rows of a result too big to load, kept by windows of fixed row
+// count. Least recently read windows are dropped over memory budget
+class RowWindowCache
+{
+public:
+    explicit RowWindowCache(int windowRows = DATA_WINDOW_ROWS,
+                            int memoryBudgetMB = DATA_WINDOWS_MEMORY_BUDGET_MB);
+
+    int windowRows() const { return _windowRows; }
+    int windowOfRow(int row) const { return row / _windowRows; }
+    int firstRowOfWindow(int window) const { return window * _windowRows; }
+
+    bool contains(int window) const { return _windows.contains(window); }
+    // marks window as recently used, nullptr if not loaded or dropped
+    NativeQueryResult * window(int window) const;
+    // false if the window alone is over budget
+    bool insert(int window, const QueryResultPt & result);
+    void clear();
+
+    int count() const { return _windows.count(); }
+    std::size_t memoryUsage() const; // bytes
+
+    // estimated till the last window is loaded
+    int rowCount() const { return _rowCount; }
+    void setRowCount(int rowCount) { _rowCount = rowCount; }
+
+private:
+
+    struct Window
+    {
+        QueryResultPt result;
+    };
+
+    int _windowRows;
+    QCache<int, Window> _windows; // window number : rows, cost in KB
+    int _rowCount;
+};
+
+} // namespace db
+} // namespace meow
+
+#endif // DB_ROW_WINDOW_CACHE_H
@@ -6,6 +6,7 @@
 #include "db/query_data_fetcher.h"
 #include "db/entity/table_entity.h"
 #include "sqlite_table_structure_parser.h"
+#include <algorithm>
 
 // https://doc.qt.io/qt-5/sql-programming.html
 // https://code.qt.io/cgit/qt/qtbase.git/tree/examples/sql/sqlbrowser/browser.cpp?h=5.14
@@ -16,6 +17,7 @@ namespace db {
 
 SQLiteConnection::SQLiteConnection(const ConnectionParameters & params)
     : Connection(params)
+    , _preparedStatements(PREPARED_STATEMENTS_CACHE_SIZE)
 {
     // Listening: Stormlord - Leviathan
 
@@ -69,6 +71,7 @@ void SQLiteConnection::setActive(bool active)
             throw db::Exception(error);
         }
     } else {     // !active
+        _preparedStatements.clear();
         _handle.close();
         _active = false;
         meowLogDebugC(this) << "Closed";
@@ -127,11 +130,13 @@ QueryResults SQLiteConnection::query(
             throw db::Exception(error);
         }
 
-        results.incExecDuration(
-                std::chrono::milliseconds(elapsedTimer.elapsed()));
+        results.incExecDuration(elapsedMicroseconds(elapsedTimer));
 
+        // steps the statement through all rows, decoding and fetching is one
+        elapsedTimer.start();
         auto queryResult = std::make_shared<QtSQLQueryResult>(this);
         queryResult->init(query, &_handle);
+        results.timings().decode += elapsedMicroseconds(elapsedTimer);
 
         results.incRowsAffected(query->numRowsAffected());
         results.incRowsFound(queryResult->recordCount());
@@ -144,6 +149,66 @@ QueryResults SQLiteConnection::query(
     meowLogDebugC(this) << "Query rows found/affected: " << results.rowsFound()
                         << "/" << results.rowsAffected();
 
+    addToStatistics(results);
+
+    return results;
+}
+
+QueryResults SQLiteConnection::queryPrepared(const QString & SQL,
+                                             const QStringList & params,
+                                             bool storeResult)
+{
+    meowLogCC(Log::Category::SQL, this) << SQL;
+
+    QSqlQuery * preparedQuery = _preparedStatements.object(SQL);
+    if (preparedQuery == nullptr) {
+        preparedQuery = new QSqlQuery(_handle);
+        if (preparedQuery->prepare(SQL) == false) { // sqlite3_prepare_v2()
+            QString error = preparedQuery->lastError().text();
+            meowLogCC(Log::Category::Error, this) << "Query failed: " << error;
+            delete preparedQuery;
+            throw db::Exception(error);
+        }
+        _preparedStatements.insert(SQL, preparedQuery); // takes ownership
+    }
+
+    for (int i = 0; i < params.size(); ++i) {
+        preparedQuery->bindValue(i, params[i].isNull()
+                                 ? QVariant(QVariant::String) // NULL
+                                 : QVariant(params[i]));
+    }
+
+    QueryResults results;
+
+    QElapsedTimer elapsedTimer;
+    elapsedTimer.start();
+
+    if (preparedQuery->exec() == false) {
+        QString error = preparedQuery->lastError().text();
+        meowLogCC(Log::Category::Error, this) << "Query failed: " << error;
+        _preparedStatements.remove(SQL);
+        throw db::Exception(error);
+    }
+
+    results.incExecDuration(elapsedMicroseconds(elapsedTimer));
+
+    // the result owns the query, give it a handle sharing the statement
+    elapsedTimer.start();
+    auto queryResult = std::make_shared<QtSQLQueryResult>(this);
+    queryResult->init(new QSqlQuery(*preparedQuery), &_handle);
+    results.timings().decode += elapsedMicroseconds(elapsedTimer);
+
+    results.incRowsAffected(preparedQuery->numRowsAffected());
+    results.incRowsFound(queryResult->recordCount());
+
+    preparedQuery->finish(); // resets statement, rows are copied already
+
+    if (storeResult && queryResult->recordCount() > 0) {
+        results << queryResult;
+    }
+
+    addToStatistics(results);
+
     return results;
 }
 
@@ -287,6 +352,21 @@ QString SQLiteConnection::applyLikeFilter(
     return conditions.join(" OR "); // TODO + " ESCAPE '%'";
 }
 
+QString SQLiteConnection::applyQuickFilter(
+            const QList<db::TableColumn *> & columns,
+            const QString & value)
+{
+    // LIKE ignores case of ASCII letters only, so nothing is pushed for
+    // other values and all rows are filtered on client. Unescaped % and _
+    // find more rows, that's fine
+    bool isAscii = std::all_of(value.cbegin(), value.cend(),
+                               [](QChar c) { return c.unicode() < 0x80; });
+    if (!isAscii) {
+        return QString();
+    }
+    return applyLikeFilter(columns, value);
+}
+
 QueryDataFetcher * SQLiteConnection::createQueryDataFetcher()
 {
     return new QueryDataFetcher(this);
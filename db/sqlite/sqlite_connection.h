@@ -32,6 +32,10 @@ public:
             const QString & SQL,
             bool storeResult = false) override;
 
+    virtual QueryResults queryPrepared(const QString & SQL,
+                                       const QStringList & params,
+                                       bool storeResult = false) override;
+
     virtual QString escapeString(const QString & str,
                                  bool processJokerChars = false,
                                  bool doQuote = true) const override;
@@ -55,6 +59,9 @@ public:
     virtual QString applyLikeFilter(
             const QList<db::TableColumn *> & columns,
             const QString & value) override;
+    virtual QString applyQuickFilter(
+            const QList<db::TableColumn *> & columns,
+            const QString & value) override;
 
     virtual QueryDataFetcher * createQueryDataFetcher() override;
 
@@ -91,6 +98,7 @@ protected:
 private:
 
     QSqlDatabase _handle;
+    QCache<QString, QSqlQuery> _preparedStatements; // SQL : prepared query
 
 };
 
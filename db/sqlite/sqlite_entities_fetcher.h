@@ -13,6 +13,7 @@ class SQLiteEntitiesFetcher : public DataBaseEntitiesFetcher
 public:
     explicit SQLiteEntitiesFetcher(SQLiteConnection * connection);
 
+    using DataBaseEntitiesFetcher::run;
     virtual QList<EntityPtr> run(const QString & dbName) override;
 
 };
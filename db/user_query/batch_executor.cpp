@@ -1,6 +1,12 @@
 #include "batch_executor.h"
+#include "statement_splitter.h"
 #include "db/query.h"
+#include "db/db_thread_initializer.h"
 #include "helpers/logger.h"
+#include <thread>
+#include <utility>
+#include <vector>
+#include <QWaitCondition>
 
 namespace meow {
 namespace db {
@@ -11,82 +17,341 @@ BatchExecutor::BatchExecutor()
     , _currentQueryIndex(0)
     , _queryTotalCount(0)
     , _queryFailedCount(0)
+    , _droppedRowsFound(0)
+    , _droppedRowsAffected(0)
+    , _droppedWarningsCount(0)
+    , _droppedExecDuration(0)
+    , _droppedNetworkDuration(0)
+    , _statementPosition(0)
+    , _statementEnd(0)
     , _isAborted(false)
 {
 
 }
 
+void BatchExecutor::setParallelConnections(
+        const QList<ConnectionPtr> & connections,
+        const QString & database)
+{
+    _parallelConnections = connections;
+    _parallelDatabase = database;
+    for (const ConnectionPtr & sibling : _parallelConnections) {
+        sibling->setIsWorkerConnection(true);
+    }
+    QMutexLocker locker(&_mutex);
+    _openedParallelConnections.clear();
+}
+
 bool BatchExecutor::run(Connection * connection, const QStringList & queries)
 {
-    {
-        QMutexLocker locker(&_mutex);
-        _results.clear();
-        _error = db::Exception();
-        _failed = false;
-        _isAborted = false;
+    reset(queries.size());
 
-        _currentQueryIndex = 0;
-        _queryTotalCount = queries.size();
-        _queryFailedCount = 0;
-        _querySuccessCount = 0;
+    if (!_parallelConnections.isEmpty() && queries.size() > 1) {
+        return runParallel(connection, queries);
     }
 
-    bool doBreak = false;
+    for (int i = 0; i < queries.size(); ++i) {
+        if (!executeNext(connection, queries[i], i == queries.size() - 1)) {
+            break;
+        }
+    }
 
-    for (const QString & SQL : queries) {
+    return !_failed;
+}
 
-        db::QueryPtr query = connection->createQuery();
-        query->setSQL(SQL);
+bool BatchExecutor::run(Connection * connection, StatementSplitter * splitter)
+{
+    reset(0);
 
+    // one statement ahead to know which one is the last
+    SplitStatement current;
+    SplitStatement next;
+    bool hasCurrent = splitter->next(&current);
+
+    while (hasCurrent) {
+        bool hasNext = splitter->next(&next);
         {
             QMutexLocker locker(&_mutex);
-            _results.push_back(query);
+            _queryTotalCount = _currentQueryIndex + (hasNext ? 2 : 1);
+            _statementPosition = current.position;
+            _statementEnd = current.end;
+            _statementDelimiter = current.delimiter;
+        }
+        if (!executeNext(connection, current.text, !hasNext)) {
+            break;
         }
+        std::swap(current, next);
+        hasCurrent = hasNext;
+    }
+
+    return !_failed;
+}
+
+void BatchExecutor::reset(int queryTotalCount)
+{
+    QMutexLocker locker(&_mutex);
+    _results.clear();
+    _error = db::Exception();
+    _failed = false;
+    _isAborted = false;
+
+    _currentQueryIndex = 0;
+    _queryTotalCount = queryTotalCount;
+    _queryFailedCount = 0;
+    _querySuccessCount = 0;
+
+    _droppedRowsFound = 0;
+    _droppedRowsAffected = 0;
+    _droppedWarningsCount = 0;
+    _droppedExecDuration = std::chrono::microseconds(0);
+    _droppedNetworkDuration = std::chrono::microseconds(0);
+
+    _statementPosition = 0;
+    _statementEnd = 0;
+    _statementDelimiter.clear();
+}
+
+bool BatchExecutor::executeNext(Connection * connection,
+                                const QString & SQL,
+                                bool isLast)
+{
+    bool doBreak = false;
 
-        emit beforeQueryExecution(_currentQueryIndex, _queryTotalCount);
+    db::QueryPtr query = connection->createQuery();
+    query->setSQL(SQL);
 
-        try {
-            query->execute();
+    {
+        QMutexLocker locker(&_mutex);
+        _results.push_back(query);
+    }
+
+    emit beforeQueryExecution(_currentQueryIndex, _queryTotalCount);
+
+    try {
+        query->execute();
+        {
+            // no inc if above raises
+            QMutexLocker locker(&_mutex);
+            ++_querySuccessCount;
+        }
+    } catch(meow::db::Exception & ex) {
+        {
+            QMutexLocker locker(&_mutex);
+            ++_queryFailedCount;
+        }
+        if (_stopOnError || isLast) {
+            // TODO: not sure we should have || cond above
             {
-                // no inc if above raises
                 QMutexLocker locker(&_mutex);
-                ++_querySuccessCount;
+                _failed = true;
+                _error = ex;
             }
-        } catch(meow::db::Exception & ex) {
+            doBreak = true;
+        }
+    }
+
+    emit afterQueryExecution(_currentQueryIndex, _queryTotalCount);
+
+    if (_isAborted) {
+        doBreak = true;
+    }
+
+    if (doBreak) return false;
+
+    if (!_keepResults) {
+        dropResult(query);
+    }
+
+    {
+        QMutexLocker locker(&_mutex);
+        if (!isLast) {
+            ++_currentQueryIndex;
+        }
+    }
+
+    return true;
+}
+
+bool BatchExecutor::runParallel(Connection * connection,
+                                const QStringList & queries)
+{
+    // Every connection works in own thread and takes the next not started
+    // query. This thread waits for results in order of queries and reports
+    // them as run() does, so listeners see no difference.
+
+    struct Outcome
+    {
+        bool done = false;
+        bool failed = false;
+        db::Exception error;
+    };
+
+    const int totalCount = queries.size();
+
+    std::vector<db::QueryPtr> batch;
+    batch.reserve(static_cast<std::size_t>(totalCount));
+    for (const QString & SQL : queries) {
+        db::QueryPtr query = connection->createQuery();
+        query->setSQL(SQL);
+        batch.push_back(query);
+    }
+
+    std::vector<Outcome> outcomes(static_cast<std::size_t>(totalCount));
+    std::atomic<int> nextIndex(0);
+    std::atomic<bool> stopped(false); // on error
+    QMutex outcomesMutex;
+    QWaitCondition outcomeReady;
+
+    auto worker = [&](Connection * workerConnection,
+                      const ConnectionPtr & sibling) {
+
+        std::unique_ptr<DbThreadInitializer> initializer
+                = workerConnection->createThreadInitializer();
+        initializer->init();
+
+        // others take its share of queries if fails
+        bool isOpened = !sibling || openParallelConnection(sibling);
+
+        while (isOpened && !stopped && !_isAborted) {
+            int index = nextIndex++;
+            if (index >= totalCount) {
+                break;
+            }
+
+            const db::QueryPtr & query = batch[static_cast<std::size_t>(index)];
+            query->setConnection(workerConnection);
+
+            Outcome outcome;
+            try {
+                query->execute();
+            } catch(meow::db::Exception & ex) {
+                outcome.failed = true;
+                outcome.error = ex;
+                if (_stopOnError) {
+                    stopped = true;
+                }
+            }
+
+            // siblings live only while running, results stay with main one
+            query->setConnection(connection);
+            for (std::size_t r = 0; r < query->resultCount(); ++r) {
+                query->resultAt(r)->setConnection(connection);
+            }
+
+            outcome.done = true;
             {
-                QMutexLocker locker(&_mutex);
-                ++_queryFailedCount;
+                QMutexLocker locker(&outcomesMutex);
+                outcomes[static_cast<std::size_t>(index)] = outcome;
+            }
+            outcomeReady.wakeAll();
+        }
+
+        initializer->deinit();
+
+        {
+            // wake on abort too, after the waiter has checked the state
+            QMutexLocker locker(&outcomesMutex);
+        }
+        outcomeReady.wakeAll();
+    };
+
+    std::vector<std::thread> threads;
+    threads.emplace_back(worker, connection, ConnectionPtr());
+    for (const ConnectionPtr & sibling : _parallelConnections) {
+        threads.emplace_back(worker, sibling.get(), sibling);
+    }
+
+    for (int index = 0; index < totalCount; ++index) {
+
+        Outcome outcome;
+        {
+            QMutexLocker locker(&outcomesMutex);
+            const Outcome & ready = outcomes[static_cast<std::size_t>(index)];
+            // query which is not started yet won't be started when stopped
+            while (!ready.done
+                   && !(index >= nextIndex && (stopped || _isAborted))) {
+                outcomeReady.wait(&outcomesMutex);
             }
-            if (_stopOnError || (_currentQueryIndex == _queryTotalCount - 1)) {
-                // TODO: not sure we should have || cond above
-                {
-                    QMutexLocker locker(&_mutex);
+            outcome = ready;
+        }
+
+        if (!outcome.done) {
+            break; // stopped or aborted before this one
+        }
+
+        {
+            QMutexLocker locker(&_mutex);
+            _results.push_back(batch[static_cast<std::size_t>(index)]);
+            _currentQueryIndex = index;
+        }
+
+        emit beforeQueryExecution(index, totalCount);
+
+        bool doBreak = false;
+
+        {
+            QMutexLocker locker(&_mutex);
+            if (outcome.failed) {
+                ++_queryFailedCount;
+                if (_stopOnError || (index == totalCount - 1)) {
                     _failed = true;
-                    _error = ex;
+                    _error = outcome.error;
+                    doBreak = true;
                 }
-                doBreak = true;
+            } else {
+                ++_querySuccessCount;
             }
         }
 
-        emit afterQueryExecution(_currentQueryIndex, _queryTotalCount);
+        emit afterQueryExecution(index, totalCount);
 
         if (_isAborted) {
             doBreak = true;
         }
 
         if (doBreak) break;
+    }
 
-        {
-            QMutexLocker locker(&_mutex);
-            if (_currentQueryIndex < (_queryTotalCount - 1)) {
-                ++_currentQueryIndex;
-            }
-        }
+    stopped = true; // stop taking queries if we've broken above
+    for (std::thread & thread : threads) {
+        thread.join();
     }
 
     return !_failed;
 }
 
+bool BatchExecutor::openParallelConnection(const ConnectionPtr & sibling)
+{
+    try {
+        sibling->setActive(true);
+        if (!_parallelDatabase.isEmpty()) {
+            sibling->setDatabase(_parallelDatabase);
+        }
+        // get id before queries to allow KILL QUERY ID from main thread
+        sibling->connectionIdOnServer();
+    } catch(meow::db::Exception & ex) {
+        meowLogC(Log::Category::Error) << "Parallel connection failed: "
+                                       << ex.message();
+        return false;
+    }
+
+    QMutexLocker locker(&_mutex);
+    _openedParallelConnections << sibling;
+    return true;
+}
+
+void BatchExecutor::dropResult(const db::QueryPtr & query)
+{
+    // failed one is kept for error reporting
+    QMutexLocker locker(&_mutex);
+    _droppedRowsFound += query->rowsFound();
+    _droppedRowsAffected += query->rowsAffected();
+    _droppedWarningsCount += query->warningsCount();
+    _droppedExecDuration += query->execDuration();
+    _droppedNetworkDuration += query->networkDuration();
+    _results.removeOne(query);
+}
+
 void BatchExecutor::abort()
 {
     _isAborted = true;
@@ -95,13 +360,16 @@ void BatchExecutor::abort()
 db::QueryPtr BatchExecutor::resultAt(int queryIndex) const
 {
     QMutexLocker locker(&_mutex);
+    if (!_keepResults) { // only the running one
+        return _results.isEmpty() ? db::QueryPtr() : _results.last();
+    }
     return _results.at(queryIndex);
 }
 
 db::ulonglong BatchExecutor::rowsFound() const
 {
-    int sumRowsFound = 0;
     QMutexLocker locker(&_mutex);
+    db::ulonglong sumRowsFound = _droppedRowsFound;
     for (const db::QueryPtr & query : _results) {
         sumRowsFound += query->rowsFound();
     }
@@ -110,8 +378,8 @@ db::ulonglong BatchExecutor::rowsFound() const
 
 db::ulonglong BatchExecutor::rowsAffected() const
 {
-    int sumRowsAffected = 0;
     QMutexLocker locker(&_mutex);
+    db::ulonglong sumRowsAffected = _droppedRowsAffected;
     for (const db::QueryPtr & query : _results) {
         sumRowsAffected += query->rowsAffected();
     }
@@ -120,28 +388,28 @@ db::ulonglong BatchExecutor::rowsAffected() const
 
 db::ulonglong BatchExecutor::warningsCount() const
 {
-    int sumWarningsCount = 0;
     QMutexLocker locker(&_mutex);
+    db::ulonglong sumWarningsCount = _droppedWarningsCount;
     for (const db::QueryPtr & query : _results) {
         sumWarningsCount += query->warningsCount();
     }
     return sumWarningsCount;
 }
 
-std::chrono::milliseconds BatchExecutor::execDuration() const
+std::chrono::microseconds BatchExecutor::execDuration() const
 {
-    std::chrono::milliseconds sumDuration = std::chrono::milliseconds(0);
     QMutexLocker locker(&_mutex);
+    std::chrono::microseconds sumDuration = _droppedExecDuration;
     for (const db::QueryPtr & query : _results) {
         sumDuration += query->execDuration();
     }
     return sumDuration;
 }
 
-std::chrono::milliseconds BatchExecutor::networkDuration() const
+std::chrono::microseconds BatchExecutor::networkDuration() const
 {
-    std::chrono::milliseconds sumDuration = std::chrono::milliseconds(0);
     QMutexLocker locker(&_mutex);
+    std::chrono::microseconds sumDuration = _droppedNetworkDuration;
     for (const db::QueryPtr & query : _results) {
         sumDuration += query->networkDuration();
     }
@@ -12,6 +12,8 @@ namespace db {
 
 namespace user_query {
 
+class StatementSplitter;
+
 // Thread-safe executor of queries that reports result on the go
 class BatchExecutor : public QObject
 {
@@ -19,8 +21,24 @@ class BatchExecutor : public QObject
 public:
     BatchExecutor();
     bool run(Connection * connection, const QStringList & queries);
+    // Executes statements as soon as splitter finds them, total count grows
+    // while the script is read. Not parallel
+    bool run(Connection * connection, StatementSplitter * splitter);
     void abort();
 
+    // Opt-in: queries are spread over connection and these siblings (created
+    // with the same params, not connected), so they must not depend on each
+    // other or on session state. Every sibling is opened with the database
+    // in its worker thread, the one that fails to connect is skipped.
+    // Results are still reported in order of queries.
+    void setParallelConnections(const QList<ConnectionPtr> & connections,
+                                const QString & database = QString());
+    // Siblings opened by workers, e.g. to kill their queries
+    QList<ConnectionPtr> openedParallelConnections() const {
+        QMutexLocker locker(&_mutex);
+        return _openedParallelConnections;
+    }
+
     db::QueryPtr resultAt(int queryIndex) const;
     const db::Exception & error() const {
         QMutexLocker locker(&_mutex);
@@ -30,6 +48,11 @@ public:
         QMutexLocker locker(&_mutex);
         return _failed;
     }
+    // Off: finished queries are not kept (only their totals), so resultAt()
+    // returns the running query only. For scripts of unknown size
+    void setKeepResults(bool keep) {
+        _keepResults = keep;
+    }
     void setStopOnError(bool stop) {
         _stopOnError = stop;
     }
@@ -53,17 +76,46 @@ public:
         return _querySuccessCount;
     }
 
+    // streaming run(): running (or failed) statement, see ScriptPosition
+    qint64 statementPosition() const {
+        QMutexLocker locker(&_mutex);
+        return _statementPosition;
+    }
+    qint64 statementEnd() const {
+        QMutexLocker locker(&_mutex);
+        return _statementEnd;
+    }
+    QByteArray statementDelimiter() const {
+        QMutexLocker locker(&_mutex);
+        return _statementDelimiter;
+    }
+
     db::ulonglong rowsFound() const;
     db::ulonglong rowsAffected() const;
     db::ulonglong warningsCount() const;
 
-    std::chrono::milliseconds execDuration() const;
-    std::chrono::milliseconds networkDuration() const;
+    std::chrono::microseconds execDuration() const;
+    std::chrono::microseconds networkDuration() const;
 
     Q_SIGNAL void beforeQueryExecution(int queryIndex, int totalCount);
     Q_SIGNAL void afterQueryExecution(int queryIndex, int totalCount);
 
 private:
+
+    bool runParallel(Connection * connection, const QStringList & queries);
+    // in worker thread, returns false on error
+    bool openParallelConnection(const ConnectionPtr & sibling);
+
+    void reset(int queryTotalCount);
+    // Returns false if batch should be stopped
+    bool executeNext(Connection * connection,
+                     const QString & SQL,
+                     bool isLast);
+    void dropResult(const db::QueryPtr & query);
+
+    QList<ConnectionPtr> _parallelConnections;
+    QString _parallelDatabase;
+    QList<ConnectionPtr> _openedParallelConnections;
     QList<db::QueryPtr> _results;
     db::Exception _error;
     bool _failed;
@@ -72,6 +124,19 @@ private:
     int _queryFailedCount;
     int _querySuccessCount;
     bool _stopOnError = true;
+    bool _keepResults = true;
+
+    // totals of dropped results
+    db::ulonglong _droppedRowsFound;
+    db::ulonglong _droppedRowsAffected;
+    db::ulonglong _droppedWarningsCount;
+    std::chrono::microseconds _droppedExecDuration;
+    std::chrono::microseconds _droppedNetworkDuration;
+
+    qint64 _statementPosition;
+    qint64 _statementEnd;
+    QByteArray _statementDelimiter;
+
     std::atomic<bool> _isAborted;
 
     mutable QMutex _mutex;
@@ -1,121 +1,51 @@
 #include "sentences_parser.h"
+#include "statement_splitter.h"
 #include <QDebug>
 
 namespace meow {
 namespace db {
 namespace user_query {
 
-QList<Sentence> SentencesParser::parseByDelimiter(const QString &SQL,
-                                              const QString &delim) const
-{
-    // Let's make Chomsky cry
-
-    QList<Sentence> list;
-
-    // to unix line ends
-    QString str = SQL;
-    // Do new line replacement outside to keep positions unchanged
-    //str.replace("\r\n", "\n", Qt::CaseInsensitive); // win
-    //str.replace(QChar('\r'), QChar('\n'), Qt::CaseInsensitive); // mac
-    int allLen = str.length();
-    QChar curChar;
-    QChar nextChar;
-    QString curDelim = delim; // may be changed by SQL
-
-    bool inString = false;// in "enclosed string" or `identifier`
-    bool inLineComment = false; // in one-line comment (# or --)
-    bool inBigComment = false; // in /* multi-line */ or /*! conditional comment */
-    bool inEscape = false; // Previous char was backslash
-    QChar lastStringEncloser = QChar::Null;
-    int lastLeftOffset = 0;
-
-    for (int i=0; i<allLen; ++i) {
-        curChar = str.at(i);
-        nextChar = ((i+1) < allLen) ? str.at(i+1) : QChar::Null;
-
-        // 1. Check for comment syntax and for enclosed literals,
-        // so a query delimiter can be ignored
-
-        // inLineComment
-        if (!inLineComment && !inBigComment && !inString) {
-            inLineComment = (curChar == QChar('#'))
-                || (curChar == QChar('-') && nextChar == QChar('-'));
-            // TODO "--" requires space after?
-        }
-
-        // inBigComment
-        if (!inLineComment && !inBigComment && !inString) {
-            if (curChar == QChar('/') && nextChar == QChar('*')) {
-                inBigComment = true;
-            }
-        }
-        if (inBigComment && !inLineComment && !inString) {
-            if (curChar == QChar('*') && nextChar == QChar('/')) {
-                inBigComment = false;
-            }
-        }
+namespace {
 
-        // inString
-        if (!inEscape && !inLineComment && !inBigComment) {
-            if (curChar == QChar('"') ||
-                curChar == QChar('\'') ||
-                curChar == QChar('`')) { // str or id enclosers
-                if (!inString || (inString && curChar == lastStringEncloser)) {
-                    inString = !inString;
-                    lastStringEncloser = curChar;
-                }
-            }
+// Count of UTF-16 chars encoded by UTF-8 bytes
+int utf16Length(const char * utf8, qint64 size)
+{
+    int length = 0;
+    for (qint64 i = 0; i < size; ++i) {
+        uchar c = static_cast<uchar>(utf8[i]);
+        if ((c & 0xC0) != 0x80) { // not a continuation byte
+            length += (c >= 0xF0) ? 2 : 1; // surrogate pair
         }
+    }
+    return length;
+}
 
-        // new lines
-        if ((curChar == QChar::LineFeed && nextChar != QChar::LineFeed) || i==0) {
-            if (i > 0) {
-                inLineComment = false;
-            }
-            // TODO: detect DELIMITER query
-        }
+} // namespace
 
-        // inEscape
-        if (!inEscape) {
-            inEscape = (curChar == QChar('\\'));
-        } else {
-            inEscape = false;
-        }
+QList<Sentence> SentencesParser::parseByDelimiter(const QString &SQL,
+                                              const QString &delim) const
+{
+    QList<Sentence> list;
 
-        // Delim
-        bool onDelim = false;
-        if (!inLineComment && !inString && !inBigComment) {
-            int delimStart = std::max(0, i+1-curDelim.length()); // TODO: ?
-            QStringRef curDelimRef = str.midRef(delimStart, curDelim.length());
-            onDelim = curDelimRef == curDelim;
-        }
+    QByteArray utf8 = SQL.toUtf8();
+    StatementSplitter splitter(utf8, delim.toUtf8());
 
-        if (onDelim || (i+1 == allLen)) {
-            int rightOffset = i+1;
-            if (onDelim) {
-                rightOffset -= curDelim.length();
-            }
-            QStringRef queryTest
-                    = str.midRef(lastLeftOffset, rightOffset-lastLeftOffset);
+    // positions are in chars of SQL, splitter counts bytes
+    qint64 bytePosition = 0;
+    int charPosition = 0;
 
-            QStringRef queryTestTrimmed = queryTest.trimmed();
-            if (queryTestTrimmed.length() != 0) {
-                if (queryTestTrimmed != curDelim) {
-                    Sentence sentence;
-                    sentence.text = queryTestTrimmed.toString();
-                    // find start pos, ignoring leading spaces
-                    int spaceCount = 0;
-                    while (spaceCount < queryTest.length()
-                          && queryTest.at(spaceCount).isSpace()) {
-                        ++spaceCount;
-                    }
-                    sentence.position = lastLeftOffset + spaceCount;
-                    list.append(sentence);
-                }
-                lastLeftOffset = i+1;
-            }
+    SplitStatement statement;
+    while (splitter.next(&statement)) {
+        charPosition += utf16Length(utf8.constData() + bytePosition,
+                                    statement.position - bytePosition);
+        Sentence sentence;
+        sentence.text = statement.text;
+        sentence.position = charPosition;
+        list.append(sentence);
 
-        }
+        charPosition += statement.text.length();
+        bytePosition = statement.position + statement.size;
     }
 
     return list;
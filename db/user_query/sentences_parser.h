@@ -46,6 +46,7 @@ struct Sentence
 class SentencesParser
 {
 public:    
+    // See StatementSplitter, handles DELIMITER command too
     QList<Sentence> parseByDelimiter(
         const QString & SQL,
         const QString & delim = QString(";")) const;
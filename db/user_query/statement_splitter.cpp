@@ -0,0 +1,255 @@
+#include "statement_splitter.h"
+#include <QIODevice>
+#include <cstring>
+
+namespace meow {
+namespace db {
+namespace user_query {
+
+namespace {
+
+const int DEFAULT_CHUNK_SIZE = 1024 * 1024;
+
+inline bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r'
+        || c == '\v' || c == '\f';
+}
+
+inline char toLowerAscii(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c;
+}
+
+} // namespace
+
+StatementSplitter::StatementSplitter(QIODevice * device,
+                                     const QByteArray & delimiter)
+    : _device(device)
+    , _bufferOffset(device->pos())
+    , _pos(0)
+    , _chunkSize(DEFAULT_CHUNK_SIZE)
+    , _atEnd(false)
+    , _delimiter(delimiter)
+{
+
+}
+
+StatementSplitter::StatementSplitter(const QByteArray & data,
+                                     const QByteArray & delimiter)
+    : _device(nullptr)
+    , _buffer(data)
+    , _bufferOffset(0)
+    , _pos(0)
+    , _chunkSize(DEFAULT_CHUNK_SIZE)
+    , _atEnd(true)
+    , _delimiter(delimiter)
+{
+
+}
+
+bool StatementSplitter::next(SplitStatement * statement)
+{
+    compact();
+
+    bool inString = false; // in 'str', "str" or `identifier`
+    bool inLineComment = false; // # or --
+    bool inBigComment = false; // /* multi-line */
+    bool inEscape = false; // previous char was backslash in string
+    char stringEncloser = 0;
+    bool hasContent = false; // anything but spaces and comments
+
+    int start = _pos;
+    int i = _pos;
+
+    while (ensure(i, 1)) {
+
+        const char c = _buffer.at(i);
+
+        if (inLineComment) {
+            if (c == '\n') {
+                inLineComment = false;
+            }
+            ++i;
+            continue;
+        }
+
+        if (inBigComment) {
+            if (c == '*' && ensure(i, 2) && _buffer.at(i + 1) == '/') {
+                inBigComment = false;
+                i += 2;
+                continue;
+            }
+            ++i;
+            continue;
+        }
+
+        if (inString) {
+            if (inEscape) {
+                inEscape = false;
+            } else if (c == '\\' && stringEncloser != '`') {
+                inEscape = true;
+            } else if (c == stringEncloser) {
+                inString = false; // '' is two strings, that's ok
+            }
+            ++i;
+            continue;
+        }
+
+        // delimiter
+        const char * delim = _delimiter.constData();
+        if (c == delim[0] && ensure(i, _delimiter.size())
+                && memcmp(_buffer.constData() + i, delim,
+                          static_cast<std::size_t>(_delimiter.size())) == 0) {
+            int end = i + _delimiter.size();
+            _pos = end;
+            if (hasContent) {
+                break; // text is [start, i)
+            }
+            start = end; // e.g. ;; or comment;
+            i = end;
+            continue;
+        }
+
+        if (c == '#') {
+            inLineComment = true;
+            ++i;
+            continue;
+        }
+
+        if ((c == '-' || c == '/') && ensure(i, 2)) {
+            char nextChar = _buffer.at(i + 1);
+            if (c == '-' && nextChar == '-') {
+                inLineComment = true;
+                i += 2;
+                continue;
+            }
+            if (c == '/' && nextChar == '*') {
+                inBigComment = true;
+                // /*! and /*M! are executed by server
+                if (ensure(i, 3) && (_buffer.at(i + 2) == '!'
+                                     || _buffer.at(i + 2) == 'M')) {
+                    hasContent = true;
+                }
+                i += 2;
+                continue;
+            }
+        }
+
+        if (isSpace(c)) {
+            ++i;
+            continue;
+        }
+
+        if (!hasContent && (c == 'd' || c == 'D')) {
+            int lineEnd = parseDelimiterCommand(i);
+            if (lineEnd != -1) { // not a statement, start over
+                start = lineEnd;
+                i = lineEnd;
+                _pos = lineEnd;
+                continue;
+            }
+        }
+
+        hasContent = true;
+
+        if (c == '\'' || c == '"' || c == '`') {
+            inString = true;
+            stringEncloser = c;
+        }
+
+        ++i;
+    }
+
+    if (!ensure(i, 1)) { // end of data
+        _pos = i;
+        if (!hasContent) {
+            return false;
+        }
+    }
+
+    // trim
+    int textStart = start;
+    int textEnd = i;
+    while (textStart < textEnd && isSpace(_buffer.at(textStart))) {
+        ++textStart;
+    }
+    while (textEnd > textStart && isSpace(_buffer.at(textEnd - 1))) {
+        --textEnd;
+    }
+
+    statement->text = QString::fromUtf8(_buffer.constData() + textStart,
+                                        textEnd - textStart);
+    statement->position = _bufferOffset + textStart;
+    statement->size = textEnd - textStart;
+    statement->end = _bufferOffset + _pos;
+    statement->delimiter = _delimiter;
+
+    return true;
+}
+
+bool StatementSplitter::ensure(int index, int count)
+{
+    while (index + count > _buffer.size()) {
+        if (_atEnd) {
+            return false;
+        }
+        QByteArray chunk = _device->read(_chunkSize);
+        if (chunk.isEmpty()) {
+            _atEnd = true;
+            return false;
+        }
+        _buffer.append(chunk);
+    }
+    return true;
+}
+
+int StatementSplitter::parseDelimiterCommand(int index)
+{
+    static const QByteArray COMMAND = "delimiter";
+
+    if (!ensure(index, COMMAND.size() + 1)) {
+        return -1;
+    }
+    for (int k = 0; k < COMMAND.size(); ++k) {
+        if (toLowerAscii(_buffer.at(index + k)) != COMMAND.at(k)) {
+            return -1;
+        }
+    }
+    int i = index + COMMAND.size();
+    char afterCommand = _buffer.at(i);
+    if (afterCommand != ' ' && afterCommand != '\t') {
+        return -1; // e.g. delimiter_table
+    }
+
+    // new delimiter is the first word till end of line
+    while (ensure(i, 1) && (_buffer.at(i) == ' ' || _buffer.at(i) == '\t')) {
+        ++i;
+    }
+    int delimiterStart = i;
+    while (ensure(i, 1) && !isSpace(_buffer.at(i))) {
+        ++i;
+    }
+    if (i > delimiterStart) {
+        _delimiter = _buffer.mid(delimiterStart, i - delimiterStart);
+    }
+    while (ensure(i, 1) && _buffer.at(i) != '\n') {
+        ++i;
+    }
+    return ensure(i, 1) ? i + 1 : i;
+}
+
+void StatementSplitter::compact()
+{
+    // bounded memory: drop what was returned already
+    if (_device == nullptr || _pos < _chunkSize) {
+        return;
+    }
+    _buffer.remove(0, _pos);
+    _bufferOffset += _pos;
+    _pos = 0;
+}
+
+} // namespace user_query
+} // namespace db
+} // namespace meow
@@ -0,0 +1,78 @@
+#ifndef DB_USER_QUERY_STATEMENT_SPLITTER_H
+#define DB_USER_QUERY_STATEMENT_SPLITTER_H
+
+#include <QByteArray>
+#include <QString>
+
+class QIODevice;
+
+namespace meow {
+namespace db {
+namespace user_query {
+
+struct SplitStatement
+{
+    QString text; // trimmed, without delimiter
+    qint64 position = 0; // byte offset of text
+    qint64 size = 0; // bytes of text
+    qint64 end = 0; // byte offset after delimiter, next statement starts here
+    QByteArray delimiter; // which ends the statement
+};
+
+// Where to (re)start reading of a script: splitter state at statement start
+struct ScriptPosition
+{
+    qint64 offset = 0; // bytes
+    QByteArray delimiter = ";";
+    int statementIndex = 0; // count of statements before offset
+};
+
+// Intent: splits SQL script (UTF-8) into statements by delimiter, one by one
+// in a single pass. Reads device by chunks and keeps only the current
+// statement in memory, so scripts of any size can be executed while being
+// read. Supports DELIMITER command of mysql client, skips statements of
+// comments only (except /*! executable ones)
+class StatementSplitter
+{
+public:
+    // reads device from its current position
+    explicit StatementSplitter(QIODevice * device,
+                               const QByteArray & delimiter = ";");
+    // data in memory, e.g. QByteArray::fromRawData() of a mapped file
+    explicit StatementSplitter(const QByteArray & data,
+                               const QByteArray & delimiter = ";");
+
+    // Returns false when there are no more statements
+    bool next(SplitStatement * statement);
+
+    QByteArray delimiter() const { return _delimiter; }
+    // bytes consumed, end of last returned statement
+    qint64 position() const { return _bufferOffset + _pos; }
+
+    void setChunkSize(int size) { _chunkSize = size; }
+
+private:
+
+    // Makes sure buffer has count bytes from index if not at end of data
+    bool ensure(int index, int count);
+
+    // Checks DELIMITER command at index, changes delimiter and returns end
+    // of its line (or -1 if not a command)
+    int parseDelimiterCommand(int index);
+
+    void compact();
+
+    QIODevice * _device;
+    QByteArray _buffer;
+    qint64 _bufferOffset; // position of buffer start in data
+    int _pos; // in buffer, start of next statement
+    int _chunkSize;
+    bool _atEnd; // nothing more to read
+    QByteArray _delimiter;
+};
+
+} // namespace user_query
+} // namespace db
+} // namespace meow
+
+#endif // DB_USER_QUERY_STATEMENT_SPLITTER_H
@@ -3,9 +3,11 @@
 #include "db/query_data.h"
 #include "threads/db_thread.h"
 #include "threads/queries_task.h"
+#include "threads/file_queries_task.h"
 #include "helpers/logger.h"
 #include "helpers/formatting.h"
 #include <QUuid>
+#include <algorithm>
 
 namespace meow {
 namespace db {
@@ -16,6 +18,7 @@ UserQuery::UserQuery(ConnectionsManager * connectionsManager)
     , _lastRunningConnection(nullptr)
     , _modifiedButNotSaved(false)
     , _isRunning(false)
+    , _runInParallel(false)
 {
 
     connect(_connectionsManager, &ConnectionsManager::beforeConnectionClosed,
@@ -35,27 +38,28 @@ void UserQuery::runInCurrentConnection(const QStringList & queries)
 
     MEOW_ASSERT_MAIN_THREAD
 
-    _lastRunningConnection = _connectionsManager->activeConnection();
-
-    // do ping in main thread to handle possible reconnection
-    try {
-        _lastRunningConnection->ping(true);
-         // get id before async query execution to allow
-         // KILL QUERY ID from another thread
-        _lastRunningConnection->connectionIdOnServer();
-    } catch(meow::db::Exception & ex) {
-        Q_UNUSED(ex);
-        // TODO: process exception?
-    }
+    prepareRunningConnection();
 
     Q_ASSERT(isRunning() == false); // allow 1 query, block outside
 
+    _parallelConnections.clear();
+    // SSH tunnel of a sibling is a process of main thread, not parallel
+    if (_runInParallel && queries.size() > 1
+            && _lastRunningConnection->features()->supportsMultithreading()
+            && !_lastRunningConnection->connectionParams()->isSSHTunnel()) {
+        createParallelConnections(std::min(queries.size(),
+                                           PARALLEL_QUERIES_CONNECTIONS) - 1);
+    }
+
     setIsRunning(true);
 
     _resultsData.clear();
 
     threads::DbThread * thread = _lastRunningConnection->thread();
+    _fileQueriesTask.reset();
     _queriesTask = thread->createQueriesTask(queries);
+    _queriesTask->setParallelConnections(
+                _parallelConnections, _lastRunningConnection->database());
 
     connect(_queriesTask.get(), &threads::ThreadTask::finished,
             this, &UserQuery::onQueriesFinished); // before post!
@@ -66,6 +70,52 @@ void UserQuery::runInCurrentConnection(const QStringList & queries)
     thread->postTask(_queriesTask);
 }
 
+void UserQuery::runFileInCurrentConnection(
+        const QString & fileName,
+        const user_query::ScriptPosition & start)
+{
+    MEOW_ASSERT_MAIN_THREAD
+
+    prepareRunningConnection();
+
+    Q_ASSERT(isRunning() == false); // allow 1 query, block outside
+
+    _parallelConnections.clear(); // script statements depend on each other
+
+    setIsRunning(true);
+
+    _resultsData.clear();
+
+    threads::DbThread * thread = _lastRunningConnection->thread();
+    _fileQueriesTask = thread->createFileQueriesTask(fileName, start);
+    _queriesTask = _fileQueriesTask;
+
+    connect(_queriesTask.get(), &threads::ThreadTask::finished,
+            this, &UserQuery::onQueriesFinished); // before post!
+
+    // no queryFinished: not a signal per statement for huge scripts
+    connect(_fileQueriesTask.get(), &threads::FileQueriesTask::progress,
+            this, &UserQuery::fileProgress);
+
+    thread->postTask(_queriesTask);
+}
+
+void UserQuery::prepareRunningConnection()
+{
+    _lastRunningConnection = _connectionsManager->activeConnection();
+
+    // do ping in main thread to handle possible reconnection
+    try {
+        _lastRunningConnection->ping(true);
+         // get id before async query execution to allow
+         // KILL QUERY ID from another thread
+        _lastRunningConnection->connectionIdOnServer();
+    } catch(meow::db::Exception & ex) {
+        Q_UNUSED(ex);
+        // TODO: process exception?
+    }
+}
+
 QString UserQuery::lastError() const
 {
     MEOW_ASSERT_MAIN_THREAD
@@ -90,20 +140,20 @@ int UserQuery::querySuccessCount() const
     return _queriesTask ? _queriesTask->querySuccessCount() : 0;
 }
 
-std::chrono::milliseconds UserQuery::execDuration() const
+std::chrono::microseconds UserQuery::execDuration() const
 {
     MEOW_ASSERT_MAIN_THREAD
     return _queriesTask
             ? _queriesTask->execDuration()
-            : std::chrono::milliseconds(0);
+            : std::chrono::microseconds(0);
 }
 
-std::chrono::milliseconds UserQuery::networkDuration() const
+std::chrono::microseconds UserQuery::networkDuration() const
 {
     MEOW_ASSERT_MAIN_THREAD
     return _queriesTask
             ? _queriesTask->networkDuration()
-            : std::chrono::milliseconds(0);
+            : std::chrono::microseconds(0);
 }
 
 QString UserQuery::uniqueId() const
@@ -115,13 +165,34 @@ QString UserQuery::uniqueId() const
     return _uniqieId;
 }
 
+void UserQuery::createParallelConnections(int count)
+{
+    // not connected: every one is opened in its worker thread, see
+    // BatchExecutor::setParallelConnections()
+    for (int i = 0; i < count; ++i) {
+        _parallelConnections
+            << _lastRunningConnection->connectionParams()->createConnection();
+    }
+}
+
+QList<ConnectionPtr> UserQuery::parallelConnections() const
+{
+    MEOW_ASSERT_MAIN_THREAD
+    if (_queriesTask == nullptr || _parallelConnections.isEmpty()) {
+        return {};
+    }
+    return _queriesTask->openedParallelConnections();
+}
+
 void UserQuery::onQueriesFinished()
 {
     MEOW_ASSERT_MAIN_THREAD
 
-    setIsRunning(false);
+    // close siblings here: connections are closed in main thread only
+    _queriesTask->setParallelConnections({});
+    _parallelConnections.clear();
 
-    emit queriesFinished();
+    setIsRunning(false);
 
     QStringList logStrings;
 
@@ -155,7 +226,7 @@ void UserQuery::onQueriesFinished()
     durationAndCountStr += QString(" %1 sec.").arg(
                 helpers::formatAsSeconds(execDuration()));
 
-    std::chrono::milliseconds networkDuration = this->networkDuration();
+    std::chrono::microseconds networkDuration = this->networkDuration();
 
     if (networkDuration.count() > 0) {
         durationAndCountStr += QString(" (+%1 sec. network)").arg(
@@ -164,8 +235,28 @@ void UserQuery::onQueriesFinished()
 
     logStrings << durationAndCountStr;
 
+    if (_fileQueriesTask) {
+        logStrings << QObject::tr("File %1: %2 statements, %3 of %4"
+                                  " (%5 statements/s, %6/s)")
+            .arg(_fileQueriesTask->fileName())
+            .arg(_fileQueriesTask->statementsDone())
+            .arg(helpers::formatByteSize(
+                     static_cast<helpers::byteSize>(
+                         _fileQueriesTask->bytesDone())))
+            .arg(helpers::formatByteSize(
+                     static_cast<helpers::byteSize>(
+                         _fileQueriesTask->fileSize())))
+            .arg(static_cast<qint64>(_fileQueriesTask->statementsPerSecond()))
+            .arg(helpers::formatByteSize(
+                     static_cast<helpers::byteSize>(
+                         _fileQueriesTask->bytesPerSecond())));
+    }
+
     meowLogC(Log::Category::Info) << logStrings.join(" ");
 
+    // last: listeners may start next run, e.g. resume of file
+    emit queriesFinished();
+
     // Listening: Hatebreed - I will be heard
 }
 
@@ -5,11 +5,13 @@
 #include <QStringList>
 #include <QVector>
 #include "db/query_data.h"
+#include "db/user_query/statement_splitter.h"
 #include "threads/helpers.h"
 
 namespace meow {
 namespace threads {
 class QueriesTask;
+class FileQueriesTask;
 }
 namespace db {
 
@@ -25,6 +27,16 @@ public:
     ~UserQuery() override;
 
     void runInCurrentConnection(const QStringList & queries);
+    // Executes SQL script file in place, from start, no results data
+    void runFileInCurrentConnection(
+            const QString & fileName,
+            const user_query::ScriptPosition & start
+                = user_query::ScriptPosition());
+    // nullptr unless last run was a file
+    threads::FileQueriesTask * fileQueriesTask() const {
+        MEOW_ASSERT_MAIN_THREAD
+        return _fileQueriesTask.get();
+    }
     QString lastError() const;
 
     int resultsDataCount() const {
@@ -35,8 +47,8 @@ public:
     int queryFailedCount() const;
     int querySuccessCount() const;
 
-    std::chrono::milliseconds execDuration() const;
-    std::chrono::milliseconds networkDuration() const;
+    std::chrono::microseconds execDuration() const;
+    std::chrono::microseconds networkDuration() const;
 
     QueryDataPtr resultsDataAt(int index) const {
         MEOW_ASSERT_MAIN_THREAD
@@ -85,8 +97,21 @@ public:
         return _lastRunningConnection;
     }
 
+    // Opt-in: run independent queries over a few connections at once
+    void setRunInParallel(bool parallel) {
+        MEOW_ASSERT_MAIN_THREAD
+        _runInParallel = parallel;
+    }
+    bool isRunInParallel() const {
+        return _runInParallel;
+    }
+    // sibling connections of lastRunningConnection() opened so far while
+    // running, e.g. to kill their queries
+    QList<ConnectionPtr> parallelConnections() const;
+
     Q_SIGNAL void queryFinished(int queryIndex, int totalCount);
     Q_SIGNAL void queriesFinished();
+    Q_SIGNAL void fileProgress();
     Q_SIGNAL void newQueryDataResult(int index);
     Q_SIGNAL void isRunningChanged(bool isRunning);
     Q_SIGNAL void executionConnectionClosed();
@@ -98,6 +123,8 @@ private:
     Q_SLOT void onConnectionClose(SessionEntity * session);
 
     QString generateUniqueId() const;
+    void prepareRunningConnection();
+    void createParallelConnections(int count);
 
     ConnectionsManager * _connectionsManager;
     Connection * _lastRunningConnection;
@@ -106,7 +133,10 @@ private:
     mutable QString _uniqieId;
     bool _modifiedButNotSaved;
     std::shared_ptr<threads::QueriesTask> _queriesTask;
+    std::shared_ptr<threads::FileQueriesTask> _fileQueriesTask;
     std::atomic<bool> _isRunning;
+    bool _runInParallel;
+    QList<ConnectionPtr> _parallelConnections;
 };
 
 } // namespace db
@@ -97,18 +97,15 @@ void ViewStructureParser::getColumns(ViewEntity * view)
         return;
     }
 
-    QString schemaClause = tableSchemaColumnName() + '='
-            + connection->escapeString(meow::db::databaseName(view));
-
     QString columnsQuery = "SELECT * FROM "
         + connection->quoteIdentifier(
                 connection->informationSchemaDatabaseName())
         + '.' + connection->quoteIdentifier(columnsObjectName)
-        + " WHERE " + schemaClause + " AND TABLE_NAME="
-        + connection->escapeString(view->name())
+        + " WHERE " + tableSchemaColumnName() + "=? AND TABLE_NAME=?"
         + " ORDER BY ORDINAL_POSITION";
 
-    QueryPtr queryResults = connection->getResults(columnsQuery);
+    QueryPtr queryResults = connection->getResults(
+        columnsQuery, {meow::db::databaseName(view), view->name()});
 
     ITableStructureParser * tableParser = connection->tableStructureParser();
 
@@ -59,12 +59,21 @@ QString formatAsHex(const QString & str)
     return QString::fromLatin1( str.toLatin1().toHex() ).toUpper();
 }
 
-QString formatAsSeconds(std::chrono::milliseconds ms)
+QString formatAsSeconds(std::chrono::microseconds duration)
 {
     // if less than minute format with 3 digits e.g. "0.023" sec
     // otherwise format with 1 digit e.g "120.1" sec
-    int precision = (ms.count() < 1000 * 60) ? 3 : 1;
-    return QLocale().toString((double)ms.count()/(double)1000, 'f', precision);
+    int precision = (duration.count() < 1000 * 1000 * 60) ? 3 : 1;
+    return QLocale().toString((double)duration.count()/(double)(1000 * 1000),
+                              'f', precision);
+}
+
+QString formatAsMilliseconds(std::chrono::microseconds duration)
+{
+    // 3 digits till a second e.g. "0.023" ms, then 1 digit e.g. "1250.7" ms
+    int precision = (duration.count() < 1000 * 1000) ? 3 : 1;
+    return QLocale().toString((double)duration.count()/(double)1000,
+                              'f', precision);
 }
 
 } // namespace helpers
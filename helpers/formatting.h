@@ -17,7 +17,8 @@ QString formatDate(const QDateTime & dateTime);
 QString formatTime(const QDateTime & dateTime);
 QString formatYear(const QDateTime & dateTime);
 QString formatAsHex(const QString & str);
-QString formatAsSeconds(std::chrono::milliseconds ms);
+QString formatAsSeconds(std::chrono::microseconds duration);
+QString formatAsMilliseconds(std::chrono::microseconds duration);
 
 QString dateTimeFormatString();
 QString dateFormatString();
@@ -0,0 +1,80 @@
+#ifndef MEOW_HELPERS_MPSC_QUEUE_H
+#define MEOW_HELPERS_MPSC_QUEUE_H
+
+#include <atomic>
+#include <utility>
+#include <vector>
+
+namespace meow {
+namespace helpers {
+
+// Intent: lock-free queue of many producer threads and one consumer.
+// Producers push onto an atomic list (as Treiber stack), the consumer takes
+// the whole list with one exchange - single items are never popped, so there
+// is no ABA problem - and restores the order of pushing
+template <typename T>
+class MPSCQueue
+{
+public:
+    MPSCQueue() : _head(nullptr) {}
+
+    MPSCQueue(const MPSCQueue &) = delete;
+    MPSCQueue & operator=(const MPSCQueue &) = delete;
+
+    ~MPSCQueue() {
+        std::vector<T> rest;
+        takeAll(&rest);
+    }
+
+    // Thread-safe. Returns true if the queue was empty, so the caller can
+    // wake up the consumer once per batch
+    bool push(T && value) {
+        Node * node = new Node{std::move(value), nullptr};
+        Node * head = _head.load(std::memory_order_relaxed);
+        do {
+            node->next = head;
+        } while (!_head.compare_exchange_weak(head, node,
+                                              std::memory_order_release,
+                                              std::memory_order_relaxed));
+        return head == nullptr;
+    }
+
+    // Consumer only: appends all pushed values in order of pushing
+    void takeAll(std::vector<T> * values) {
+        Node * node = _head.exchange(nullptr, std::memory_order_acquire);
+
+        Node * reversed = nullptr; // newest first -> oldest first
+        while (node != nullptr) {
+            Node * next = node->next;
+            node->next = reversed;
+            reversed = node;
+            node = next;
+        }
+
+        while (reversed != nullptr) {
+            values->push_back(std::move(reversed->value));
+            Node * next = reversed->next;
+            delete reversed;
+            reversed = next;
+        }
+    }
+
+    bool isEmpty() const {
+        return _head.load(std::memory_order_relaxed) == nullptr;
+    }
+
+private:
+
+    struct Node
+    {
+        T value;
+        Node * next;
+    };
+
+    std::atomic<Node *> _head;
+};
+
+} // namespace helpers
+} // namespace meow
+
+#endif // MEOW_HELPERS_MPSC_QUEUE_H
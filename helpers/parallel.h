@@ -0,0 +1,107 @@
+#ifndef HELPERS_PARALLEL_H
+#define HELPERS_PARALLEL_H
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace meow {
+namespace helpers {
+
+// Count of threads to process count items, at least minPerThread each
+inline std::size_t parallelThreadCount(std::size_t count,
+                                       std::size_t minPerThread)
+{
+    std::size_t threadCount = std::max(1u, std::thread::hardware_concurrency());
+    return std::max<std::size_t>(1,
+        std::min(threadCount, count / std::max<std::size_t>(1, minPerThread)));
+}
+
+// Calls func(begin, end) for ranges of [0, count) in threads, small counts
+// are processed in the calling thread
+template <typename Func>
+void parallelFor(std::size_t count, std::size_t minPerThread, Func func)
+{
+    std::size_t threadCount = parallelThreadCount(count, minPerThread);
+
+    if (threadCount < 2) {
+        func(std::size_t(0), count);
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < threadCount; ++i) {
+        std::size_t begin = count * i / threadCount;
+        std::size_t end = count * (i + 1) / threadCount;
+        threads.emplace_back([=]() {
+            func(begin, end);
+        });
+    }
+    for (std::thread & thread : threads) {
+        thread.join();
+    }
+}
+
+// Sorts chunks in threads, then merges neighbour chunks pairwise (also in
+// threads) until one is left
+template <typename Iterator, typename Compare>
+void parallelSort(Iterator begin, Iterator end,
+                  Compare compare,
+                  std::size_t minPerThread)
+{
+    std::size_t count = static_cast<std::size_t>(end - begin);
+    std::size_t threadCount = parallelThreadCount(count, minPerThread);
+
+    if (threadCount < 2) {
+        std::sort(begin, end, compare);
+        return;
+    }
+
+    std::vector<Iterator> bounds; // chunk i is [bounds[i], bounds[i+1])
+    for (std::size_t i = 0; i < threadCount; ++i) {
+        bounds.push_back(
+            begin + static_cast<std::ptrdiff_t>(count * i / threadCount));
+    }
+    bounds.push_back(end);
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i + 1 < bounds.size(); ++i) {
+        Iterator first = bounds[i];
+        Iterator last = bounds[i + 1];
+        threads.emplace_back([=]() {
+            std::sort(first, last, compare);
+        });
+    }
+    for (std::thread & thread : threads) {
+        thread.join();
+    }
+
+    while (bounds.size() > 2) {
+        threads.clear();
+        for (std::size_t i = 0; i + 2 < bounds.size(); i += 2) {
+            Iterator first = bounds[i];
+            Iterator middle = bounds[i + 1];
+            Iterator last = bounds[i + 2];
+            threads.emplace_back([=]() {
+                std::inplace_merge(first, middle, last, compare);
+            });
+        }
+        for (std::thread & thread : threads) {
+            thread.join();
+        }
+
+        std::vector<Iterator> merged;
+        for (std::size_t i = 0; i < bounds.size(); i += 2) {
+            merged.push_back(bounds[i]);
+        }
+        if (bounds.size() % 2 == 0) { // odd chunk count, last one is as is
+            merged.push_back(bounds.back());
+        }
+        bounds.swap(merged);
+    }
+}
+
+} // namespace helpers
+} // namespace meow
+
+#endif // HELPERS_PARALLEL_H
@@ -79,6 +79,7 @@ SOURCES += main.cpp\
     app/actions.cpp \
     app/app.cpp \
     app/log.cpp \
+    db/columnar_result_data.cpp \
     db/connection.cpp \
     db/connection_parameters.cpp \
     db/connection_features.cpp \
@@ -89,6 +90,7 @@ SOURCES += main.cpp\
     db/data_type/data_type.cpp \
     db/entity/database_entity.cpp \
     db/entity/entities_fetcher.cpp \
+    db/entity/entities_disk_cache.cpp \
     db/entity/entity.cpp \
     db/entity/entity_filter.cpp \
     db/entity/entity_holder.cpp \
@@ -106,8 +108,12 @@ SOURCES += main.cpp\
     db/query_criteria.cpp \
     db/query_data.cpp \
     db/query_data_fetcher.cpp \
+    db/query_data_filter.cpp \
+    db/query_data_sorter.cpp \
+    db/query_statistics.cpp \
     db/routine_editor.cpp \
     db/routine_structure_parser.cpp \
+    db/row_window_cache.cpp \
     db/routine_structure.cpp \
     db/session_variables.cpp \
     db/table_column.cpp \
@@ -125,6 +131,7 @@ SOURCES += main.cpp\
     db/user_queries_manager.cpp \
     db/user_query/batch_executor.cpp \
     db/user_query/sentences_parser.cpp \
+    db/user_query/statement_splitter.cpp \
     db/user_query/user_query.cpp \
     helpers/formatting.cpp \
     helpers/logger.cpp \
@@ -142,7 +149,11 @@ SOURCES += main.cpp\
     ssh/ssh_tunnel_factory.cpp \
     ssh/ssh_tunnel_parameters.cpp \
     threads/db_thread.cpp \
+    threads/file_queries_task.cpp \
     threads/queries_task.cpp \
+    threads/query_data_task.cpp \
+    threads/fetch_rows_task.cpp \
+    threads/entities_fetch_task.cpp \
     threads/thread_init_task.cpp \
     threads/thread_task.cpp \
     ui/common/checkbox_list_popup.cpp \
@@ -150,6 +161,7 @@ SOURCES += main.cpp\
     ui/common/geometry_helpers.cpp \
     ui/common/sql_editor.cpp \
     ui/common/sql_log_editor.cpp \
+    ui/common/sql_keywords_lookup.cpp \
     ui/common/sql_syntax_highlighter.cpp \
     ui/common/table_column_default_editor.cpp \
     ui/common/table_cell_line_edit.cpp \
@@ -173,6 +185,8 @@ SOURCES += main.cpp\
     ui/edit_database/dialog.cpp \
     ui/export_database/bottom_widget.cpp \
     ui/export_database/top_widget.cpp \
+    ui/export_grid/export_dialog.cpp \
+    ui/import_csv/import_dialog.cpp \
     ui/main_window/central_left_db_tree.cpp \
     ui/main_window/central_left_widget.cpp \
     ui/main_window/central_right/database/central_right_database_tab.cpp \
@@ -181,6 +195,7 @@ SOURCES += main.cpp\
     ui/main_window/central_right/global_filter_widget.cpp \
     ui/main_window/central_right/host/central_right_host_tab.cpp \
     ui/main_window/central_right/host/cr_host_databases_tab.cpp \
+    ui/main_window/central_right/host/cr_host_statistics_tab.cpp \
     ui/main_window/central_right/host/cr_host_variables_tab.cpp \
     ui/main_window/central_right/query/central_right_query_tab.cpp \
     ui/main_window/central_right/query/cr_query_data_tab.cpp \
@@ -225,6 +240,7 @@ SOURCES += main.cpp\
     ui/models/routine_parameters_model.cpp \
     ui/models/users_table_model.cpp \
     ui/models/user_privileges_model.cpp \
+    ui/models/query_statistics_table_model.cpp \
     ui/models/variables_table_model.cpp \
     ui/models/session_objects_tree_model.cpp \
     ui/presenters/central_right_host_widget_model.cpp \
@@ -262,7 +278,12 @@ SOURCES += main.cpp\
     ui/common/editable_data_table_view.cpp \
     ui/main_window/central_bottom_widget.cpp \
     ui/main_window/central_log_widget.cpp \
-    utils/exporting/mysql_dump_console.cpp \
+    utils/exporting/dump_writer.cpp \
+    utils/exporting/grid_exporter.cpp \
+    utils/exporting/grid_formats.cpp \
+    utils/exporting/mysql_dumper.cpp \
+    utils/importing/csv_importer.cpp \
+    utils/importing/csv_parser.cpp \
     ui/export_database/export_dialog.cpp
 
 
@@ -270,6 +291,7 @@ HEADERS  +=  app/actions.h \
     app/app.h \
     app/log.h \
     db/collation_fetcher.h \
+    db/columnar_result_data.h \
     db/common.h \
     db/connection.h \
     db/connection_parameters.h \
@@ -283,6 +305,7 @@ HEADERS  +=  app/actions.h \
     db/data_type/data_type.h \
     db/entity/database_entity.h \
     db/entity/entities_fetcher.h \
+    db/entity/entities_disk_cache.h \
     db/entity/entity_filter.h \
     db/entity/entity.h \
     db/entity/entity_holder.h \
@@ -304,7 +327,12 @@ HEADERS  +=  app/actions.h \
     db/routine_structure.h \
     db/session_variables.h \
     db/query_data.h \
+    db/query_data_filter.h \
+    db/query_data_sorter.h \
     db/query_results.h \
+    db/query_statistics.h \
+    db/query_timings.h \
+    db/row_window_cache.h \
     db/query.h \
     db/table_column.h \
     db/table_editor.h \
@@ -323,10 +351,13 @@ HEADERS  +=  app/actions.h \
     db/user_editor_interface.h \
     db/user_query/batch_executor.h \
     db/user_query/sentences_parser.h \
+    db/user_query/statement_splitter.h \
     db/user_query/user_query.h \
     db/user_queries_manager.h \
     helpers/formatting.h \
     helpers/logger.h \
+    helpers/mpsc_queue.h \
+    helpers/parallel.h \
     helpers/parsing.h \
     helpers/random_password_generator.h \
     helpers/text.h \
@@ -343,7 +374,11 @@ HEADERS  +=  app/actions.h \
     threads/helpers.h \
     threads/mutex.h \
     threads/db_thread.h \
+    threads/file_queries_task.h \
     threads/queries_task.h \
+    threads/query_data_task.h \
+    threads/fetch_rows_task.h \
+    threads/entities_fetch_task.h \
     threads/thread_init_task.h \
     threads/thread_task.h \
     ui/common/checkbox_list_popup.h \
@@ -352,6 +387,7 @@ HEADERS  +=  app/actions.h \
     ui/common/mysql_syntax.h \
     ui/common/sql_editor.h \
     ui/common/sql_log_editor.h \
+    ui/common/sql_keywords_lookup.h \
     ui/common/sql_syntax_highlighter.h \
     ui/common/table_column_default_editor.h \
     ui/common/table_cell_line_edit.h \
@@ -375,6 +411,8 @@ HEADERS  +=  app/actions.h \
     ui/edit_database/dialog.h \
     ui/export_database/bottom_widget.h \
     ui/export_database/top_widget.h \
+    ui/export_grid/export_dialog.h \
+    ui/import_csv/import_dialog.h \
     ui/main_window/central_left_db_tree.h \
     ui/main_window/central_left_widget.h \
     ui/main_window/central_right/base_root_tab.h \
@@ -385,6 +423,7 @@ HEADERS  +=  app/actions.h \
     ui/main_window/central_right/global_data_filter_interface.h \
     ui/main_window/central_right/host/central_right_host_tab.h \
     ui/main_window/central_right/host/cr_host_databases_tab.h \
+    ui/main_window/central_right/host/cr_host_statistics_tab.h \
     ui/main_window/central_right/host/cr_host_variables_tab.h \
     ui/main_window/central_right/query/central_right_query_tab.h \
     ui/main_window/central_right/query/cr_query_data_tab.h \
@@ -429,6 +468,7 @@ HEADERS  +=  app/actions.h \
     ui/models/routine_parameters_model.h \
     ui/models/users_table_model.h \
     ui/models/user_privileges_model.h \
+    ui/models/query_statistics_table_model.h \
     ui/models/variables_table_model.h \
     ui/models/session_objects_tree_model.h \
     ui/presenters/central_right_host_widget_model.h \
@@ -466,7 +506,13 @@ HEADERS  +=  app/actions.h \
     ui/common/editable_data_table_view.h \
     ui/main_window/central_bottom_widget.h \
     ui/main_window/central_log_widget.h \
-    utils/exporting/mysql_dump_console.h \
+    utils/exporting/dump_writer.h \
+    utils/exporting/grid_exporter.h \
+    utils/exporting/grid_formats.h \
+    utils/exporting/mysql_dumper.h \
+    utils/exporting/sql_literals.h \
+    utils/importing/csv_importer.h \
+    utils/importing/csv_parser.h \
     ui/export_database/export_dialog.h
 
 win32:SOURCES += ssh/plink_ssh_tunnel.cpp
@@ -478,6 +524,7 @@ WITH_MYSQL {
     db/mysql/mysql_database_editor.cpp \
     db/mysql/mysql_entities_fetcher.cpp \
     db/mysql/mysql_query_result.cpp \
+    db/mysql/mysql_prepared_statement.cpp \
     db/mysql/mysql_query_data_editor.cpp \
     db/mysql/mysql_collation_fetcher.cpp \
     db/mysql/mysql_connection.cpp \
@@ -498,6 +545,7 @@ WITH_POSTGRESQL {
     db/pg/pg_entities_fetcher.cpp \
     db/pg/pg_entity_create_code_generator.cpp \
     db/pg/pg_query_result.cpp \
+    db/pg/pg_prepared_statement.cpp \
     db/pg/pg_query_data_editor.cpp \
     db/pg/pg_query_data_fetcher.cpp
 }
@@ -525,6 +573,7 @@ WITH_MYSQL {
     db/mysql/mysql_database_editor.h \
     db/mysql/mysql_entities_fetcher.h \
     db/mysql/mysql_query_result.h \
+    db/mysql/mysql_prepared_statement.h \
     db/mysql/mysql_query_data_editor.h \
     db/mysql/mysql_collation_fetcher.h \
     db/mysql/mysql_connection.h \
@@ -542,6 +591,7 @@ WITH_POSTGRESQL {
     HEADERS += db/data_type/pg_connection_data_types.h \
     db/data_type/pg_data_type.h \
     db/pg/pg_query_result.h \
+    db/pg/pg_prepared_statement.h \
     db/pg/pg_connection.h \
     db/pg/pg_connection_query_killer.h \
     db/pg/pg_entities_fetcher.h \
@@ -10,6 +10,11 @@ static const char SHOW_LOG_SETTINGS_KEY[]
 static const char SHOW_FILTER_SETTINGS_KEY[]
     = "ui/main_windows/status_bar/show_filter";
 
+static const char LOG_MAX_LINE_COUNT_SETTINGS_KEY[]
+    = "ui/main_windows/log/max_line_count";
+
+static const int LOG_MAX_LINE_COUNT_DEFAULT = 10000;
+
 Geometry::Geometry()
 {
     load();
@@ -51,11 +56,28 @@ void Geometry::setShowFilterPanel(bool show)
     }
 }
 
+int Geometry::logMaxLineCount() const
+{
+    return _logMaxLineCount;
+}
+
+void Geometry::setLogMaxLineCount(int count)
+{
+    if (_logMaxLineCount != count) {
+        _logMaxLineCount = count;
+        QSettings settings;
+        settings.setValue(LOG_MAX_LINE_COUNT_SETTINGS_KEY, count);
+        emit logMaxLineCountChanged(count);
+    }
+}
+
 void Geometry::load()
 {
     QSettings settings;
     _showSQLLog = settings.value(SHOW_LOG_SETTINGS_KEY, false).toBool();
     _showFilterPanel = settings.value(SHOW_FILTER_SETTINGS_KEY, false).toBool();
+    _logMaxLineCount = settings.value(LOG_MAX_LINE_COUNT_SETTINGS_KEY,
+                                      LOG_MAX_LINE_COUNT_DEFAULT).toInt();
 
 }
 
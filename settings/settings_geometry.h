@@ -23,11 +23,17 @@ public:
     void setShowFilterPanel(bool show);
     Q_SIGNAL void showFilterPanelChanged(bool show);
 
+    // older lines are dropped from log panel
+    int logMaxLineCount() const;
+    void setLogMaxLineCount(int count);
+    Q_SIGNAL void logMaxLineCountChanged(int count);
+
 private:
 
     void load();
     bool _showSQLLog;
     bool _showFilterPanel;
+    int _logMaxLineCount;
 };
 
 } // namespace meow
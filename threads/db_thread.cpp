@@ -1,5 +1,9 @@
 #include "db_thread.h"
 #include "queries_task.h"
+#include "file_queries_task.h"
+#include "query_data_task.h"
+#include "fetch_rows_task.h"
+#include "entities_fetch_task.h"
 #include "helpers.h"
 #include "thread_init_task.h"
 #include <QTimer>
@@ -55,6 +59,35 @@ std::shared_ptr<QueriesTask> DbThread::createQueriesTask(
     return std::make_shared<QueriesTask>(queries, _connection);
 }
 
+std::shared_ptr<FileQueriesTask> DbThread::createFileQueriesTask(
+        const QString & fileName,
+        const db::user_query::ScriptPosition & start)
+{
+    return std::make_shared<FileQueriesTask>(fileName, start, _connection);
+}
+
+std::shared_ptr<QueryDataTask> DbThread::createQueryDataTask(
+        const QString & SQL)
+{
+    return std::make_shared<QueryDataTask>(SQL, _connection);
+}
+
+std::shared_ptr<FetchRowsTask> DbThread::createFetchRowsTask(
+        const std::shared_ptr<db::NativeQueryResult> & result,
+        unsigned long long maxRows)
+{
+    return std::make_shared<FetchRowsTask>(result, maxRows);
+}
+
+std::shared_ptr<EntitiesFetchTask> DbThread::createEntitiesFetchTask(
+        const QString & dbName,
+        const QString & cachedSignature)
+{
+    return std::make_shared<EntitiesFetchTask>(dbName,
+                                               _connection,
+                                               cachedSignature);
+}
+
 void DbThread::postTask(const std::shared_ptr<ThreadTask> &task)
 {
     MEOW_ASSERT_MAIN_THREAD
@@ -12,12 +12,21 @@ namespace db {
 
 using SQLBatch = QStringList;
 class Connection;
+class NativeQueryResult;
+
+namespace user_query {
+struct ScriptPosition;
+}
 
 }
 
 namespace threads {
 
 class QueriesTask;
+class FileQueriesTask;
+class QueryDataTask;
+class FetchRowsTask;
+class EntitiesFetchTask;
 class ThreadTask;
 
 // Intent: executes db tasks for connection
@@ -28,6 +37,16 @@ public:
     DbThread(db::Connection * connection);
     virtual ~DbThread() override;
     std::shared_ptr<QueriesTask> createQueriesTask(const db::SQLBatch & queries);
+    std::shared_ptr<FileQueriesTask> createFileQueriesTask(
+            const QString & fileName,
+            const db::user_query::ScriptPosition & start);
+    std::shared_ptr<QueryDataTask> createQueryDataTask(const QString & SQL);
+    std::shared_ptr<FetchRowsTask> createFetchRowsTask(
+            const std::shared_ptr<db::NativeQueryResult> & result,
+            unsigned long long maxRows);
+    std::shared_ptr<EntitiesFetchTask> createEntitiesFetchTask(
+            const QString & dbName,
+            const QString & cachedSignature = QString());
     void postTask(const std::shared_ptr<ThreadTask> & task);
     void quit();
     void wait();
@@ -0,0 +1,109 @@
+#include "entities_fetch_task.h"
+#include "db/connection.h"
+#include "db/exception.h"
+#include "db/entity/entities_disk_cache.h"
+#include <QCoreApplication>
+#include <QThread>
+#include <QMutexLocker>
+
+namespace meow {
+namespace threads {
+
+EntitiesFetchTask::EntitiesFetchTask(const QString & dbName,
+                                     db::Connection * connection,
+                                     const QString & cachedSignature)
+    : ThreadTask(TaskType::FetchEntities)
+    , _dbName(dbName)
+    , _connection(connection)
+    , _cachedSignature(cachedSignature)
+    , _failed(false)
+    , _upToDate(false)
+{
+
+}
+
+EntitiesFetchTask::~EntitiesFetchTask()
+{
+
+}
+
+void EntitiesFetchTask::run()
+{
+    QString signature;
+    try {
+        // before fetching, so changes made meanwhile are caught next time
+        signature = _connection->fetchDbEntitiesSignature(_dbName);
+    } catch(meow::db::Exception & ex) {
+        Q_UNUSED(ex); // unknown, just fetch
+    }
+
+    _upToDate = !signature.isEmpty() && signature == _cachedSignature;
+
+    if (!_upToDate) {
+        fetchEntities(signature);
+    }
+
+    emit finished();
+    if (isFailed()) {
+        emit failed();
+    }
+}
+
+void EntitiesFetchTask::fetchEntities(const QString & signature)
+{
+    QThread * mainThread = QCoreApplication::instance()->thread();
+
+    QVector<db::EntitiesDiskCache::Record> records;
+
+    try {
+        _connection->fetchDbEntities(_dbName,
+            [&](const QList<db::EntityPtr> & batch) {
+                for (const db::EntityPtr & entity : batch) {
+                    if (!signature.isEmpty()) {
+                        records.append(
+                            db::EntitiesDiskCache::recordOf(entity.get()));
+                    }
+                    entity->moveToThread(mainThread); // created here
+                }
+                {
+                    QMutexLocker locker(&_mutex);
+                    _entities += batch;
+                }
+                emit entitiesReceived();
+            });
+    } catch(meow::db::Exception & ex) {
+        _failed = true;
+        _errorMessage = ex.message();
+        return;
+    }
+
+    if (signature.isEmpty()) {
+        return;
+    }
+
+    db::EntitiesDiskCache * diskCache = _connection->entitiesDiskCache();
+    // fetchers log and skip errors, so nothing can mean a failure; empty
+    // databases are fast to fetch anyway
+    if (records.isEmpty()) {
+        diskCache->removeDatabase(_dbName);
+    } else {
+        diskCache->setEntities(_dbName, signature, records);
+    }
+    diskCache->save();
+}
+
+bool EntitiesFetchTask::isFailed() const
+{
+    return _failed;
+}
+
+QList<db::EntityPtr> EntitiesFetchTask::takeEntities()
+{
+    QMutexLocker locker(&_mutex);
+    QList<db::EntityPtr> entities;
+    entities.swap(_entities);
+    return entities;
+}
+
+} // namespace threads
+} // namespace meow
@@ -0,0 +1,57 @@
+#ifndef MEOW_THREADS_ENTITIES_FETCH_TASK_H
+#define MEOW_THREADS_ENTITIES_FETCH_TASK_H
+
+#include <QMutex>
+#include <QString>
+#include "thread_task.h"
+#include "db/entity/entity.h"
+
+namespace meow {
+
+namespace db {
+class Connection;
+}
+
+namespace threads {
+
+// Intent: fetches entities of database (see DataBaseEntitiesFetcher), they
+// are taken by main thread in batches as they come. If entities were taken
+// from disk cache, revalidates them first and fetches only if changed
+class EntitiesFetchTask : public ThreadTask
+{
+    Q_OBJECT
+public:
+    EntitiesFetchTask(const QString & dbName,
+                      db::Connection * connection,
+                      const QString & cachedSignature = QString());
+    ~EntitiesFetchTask() override;
+    void run() override;
+    bool isFailed() const override;
+
+    QString errorMessage() const { return _errorMessage; }
+
+    // True if cached entities are still valid, nothing was fetched
+    bool isUpToDate() const { return _upToDate; }
+
+    // entities received since last call, they live in main thread
+    QList<db::EntityPtr> takeEntities();
+
+    Q_SIGNAL void entitiesReceived();
+
+private:
+    void fetchEntities(const QString & signature);
+
+    QString _dbName;
+    db::Connection * _connection;
+    QString _cachedSignature;
+    QMutex _mutex;
+    QList<db::EntityPtr> _entities;
+    bool _failed;
+    bool _upToDate;
+    QString _errorMessage;
+};
+
+} // namespace threads
+} // namespace meow
+
+#endif // MEOW_THREADS_ENTITIES_FETCH_TASK_H
@@ -0,0 +1,58 @@
+#include "fetch_rows_task.h"
+#include "db/exception.h"
+
+namespace meow {
+namespace threads {
+
+FetchRowsTask::FetchRowsTask(const db::QueryResultPt & result,
+                             db::ulonglong maxRows)
+    : ThreadTask(TaskType::FetchRows)
+    , _result(result)
+    , _maxRows(maxRows)
+    , _aborted(false)
+    , _failed(false)
+{
+
+}
+
+FetchRowsTask::~FetchRowsTask()
+{
+
+}
+
+void FetchRowsTask::run()
+{
+    if (!_aborted) {
+        try {
+            _rows = _result->fetchMoreAside(_maxRows);
+        } catch(meow::db::Exception & ex) {
+            _failed = true;
+            _errorMessage = ex.message();
+        }
+    }
+
+    if (_aborted) {
+        // nobody needs them, free (and drain) the result here if it was
+        // the last ref, not in UI thread
+        _rows.reset();
+    }
+    _result.reset();
+
+    emit finished();
+    if (isFailed()) {
+        emit failed();
+    }
+}
+
+bool FetchRowsTask::isFailed() const
+{
+    return _failed;
+}
+
+void FetchRowsTask::abort()
+{
+    _aborted = true;
+}
+
+} // namespace threads
+} // namespace meow
@@ -0,0 +1,45 @@
+#ifndef MEOW_THREADS_FETCH_ROWS_TASK_H
+#define MEOW_THREADS_FETCH_ROWS_TASK_H
+
+#include <atomic>
+#include <QString>
+#include "thread_task.h"
+#include "db/common.h"
+#include "db/native_query_result.h"
+
+namespace meow {
+namespace threads {
+
+// Intent: receives next page of streamed result aside (see
+// NativeQueryResult::fetchMoreAside()), rows are appended to the result by
+// model in main thread when finished
+class FetchRowsTask : public ThreadTask
+{
+    Q_OBJECT
+public:
+    FetchRowsTask(const db::QueryResultPt & result, db::ulonglong maxRows);
+    ~FetchRowsTask() override;
+    void run() override;
+    bool isFailed() const override;
+
+    void abort();
+    bool isAborted() const { return _aborted; }
+
+    QString errorMessage() const { return _errorMessage; }
+
+    // received rows, null if failed or aborted
+    db::QueryResultPt rows() const { return _rows; }
+
+private:
+    db::QueryResultPt _result;
+    db::ulonglong _maxRows;
+    db::QueryResultPt _rows;
+    std::atomic<bool> _aborted;
+    bool _failed;
+    QString _errorMessage;
+};
+
+} // namespace threads
+} // namespace meow
+
+#endif // MEOW_THREADS_FETCH_ROWS_TASK_H
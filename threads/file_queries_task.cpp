@@ -0,0 +1,133 @@
+#include "file_queries_task.h"
+#include <QFile>
+
+namespace meow {
+namespace threads {
+
+namespace {
+
+const qint64 PROGRESS_INTERVAL_MS = 250;
+
+} // namespace
+
+FileQueriesTask::FileQueriesTask(const QString & fileName,
+                                 const db::user_query::ScriptPosition & start,
+                                 db::Connection * connection)
+    : QueriesTask(db::SQLBatch(), connection)
+    , _fileName(fileName)
+    , _start(start)
+    , _fileSize(0)
+    , _bytesDone(start.offset)
+    , _elapsedMs(0)
+    , _lastProgressMs(0)
+{
+    // results of millions of statements would not fit in memory
+    _executor.setKeepResults(false);
+
+    connect(&_executor, &db::user_query::BatchExecutor::afterQueryExecution,
+            this, &FileQueriesTask::onStatementFinished,
+            Qt::DirectConnection);
+}
+
+void FileQueriesTask::run()
+{
+    _timer.start();
+
+    QFile file(_fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        _openError = tr("Unable to open file %1: %2")
+                .arg(_fileName).arg(file.errorString());
+    } else if (!file.seek(_start.offset)) {
+        _openError = tr("Unable to seek file %1 to %2: %3")
+                .arg(_fileName).arg(_start.offset).arg(file.errorString());
+    }
+
+    if (_openError.isEmpty()) {
+        _fileSize = file.size();
+
+        db::user_query::StatementSplitter splitter(&file, _start.delimiter);
+        _executor.run(_connection, &splitter);
+
+        if (!_executor.failed()) {
+            _bytesDone = splitter.position();
+        }
+    }
+
+    _elapsedMs = _timer.elapsed();
+    emit progress();
+
+    emit finished();
+    if (isFailed()) {
+        emit failed();
+    }
+}
+
+bool FileQueriesTask::isFailed() const
+{
+    return !_openError.isEmpty() || QueriesTask::isFailed();
+}
+
+QString FileQueriesTask::errorMessage() const
+{
+    return _openError.isEmpty() ? QueriesTask::errorMessage() : _openError;
+}
+
+int FileQueriesTask::statementsDone() const
+{
+    return _start.statementIndex + _executor.querySuccessCount()
+            + _executor.queryFailedCount();
+}
+
+double FileQueriesTask::statementsPerSecond() const
+{
+    qint64 ms = _elapsedMs;
+    if (ms <= 0) return 0.0;
+    return (statementsDone() - _start.statementIndex) * 1000.0 / ms;
+}
+
+double FileQueriesTask::bytesPerSecond() const
+{
+    qint64 ms = _elapsedMs;
+    if (ms <= 0) return 0.0;
+    return (_bytesDone - _start.offset) * 1000.0 / ms;
+}
+
+bool FileQueriesTask::canResume() const
+{
+    return _openError.isEmpty() && QueriesTask::isFailed();
+}
+
+db::user_query::ScriptPosition FileQueriesTask::failedPosition() const
+{
+    db::user_query::ScriptPosition position;
+    position.offset = _executor.statementPosition();
+    position.delimiter = _executor.statementDelimiter();
+    position.statementIndex = _start.statementIndex
+            + _executor.currentQueryIndex();
+    return position;
+}
+
+db::user_query::ScriptPosition FileQueriesTask::nextPosition() const
+{
+    db::user_query::ScriptPosition position = failedPosition();
+    position.offset = _executor.statementEnd();
+    ++position.statementIndex;
+    return position;
+}
+
+void FileQueriesTask::onStatementFinished()
+{
+    // connection thread
+    _bytesDone = _executor.statementEnd();
+
+    qint64 elapsedMs = _timer.elapsed();
+    _elapsedMs = elapsedMs;
+
+    if (elapsedMs - _lastProgressMs >= PROGRESS_INTERVAL_MS) {
+        _lastProgressMs = elapsedMs;
+        emit progress();
+    }
+}
+
+} // namespace threads
+} // namespace meow
@@ -0,0 +1,67 @@
+#ifndef MEOW_THREADS_FILE_QUERIES_TASK_H
+#define MEOW_THREADS_FILE_QUERIES_TASK_H
+
+#include <atomic>
+#include <QElapsedTimer>
+#include "queries_task.h"
+#include "db/user_query/statement_splitter.h"
+
+namespace meow {
+namespace threads {
+
+// Intent: executes SQL script file in place: statements are read, executed
+// and forgotten one by one, so memory doesn't depend on file size and nothing
+// is loaded into editor. Results of queries are not shown, only totals
+class FileQueriesTask : public QueriesTask
+{
+    Q_OBJECT
+public:
+    FileQueriesTask(const QString & fileName,
+                    const db::user_query::ScriptPosition & start,
+                    db::Connection * connection);
+    void run() override;
+    bool isFailed() const override;
+    QString errorMessage() const override;
+
+    QString fileName() const { return _fileName; }
+    qint64 fileSize() const { return _fileSize; }
+    // bytes from file start, including skipped ones on resume
+    qint64 bytesDone() const { return _bytesDone; }
+    // statements from file start, including skipped ones on resume
+    int statementsDone() const;
+    std::chrono::milliseconds elapsed() const {
+        return std::chrono::milliseconds(_elapsedMs.load());
+    }
+    // throughput of this run, skipped part is not counted
+    double statementsPerSecond() const;
+    double bytesPerSecond() const;
+
+    // true if stopped on a failed statement, see failedPosition()
+    bool canResume() const;
+
+    // where the failed statement starts: run it again
+    db::user_query::ScriptPosition failedPosition() const;
+    // after the failed statement: skip it
+    db::user_query::ScriptPosition nextPosition() const;
+
+    // emitted from connection thread a few times per second at most
+    Q_SIGNAL void progress();
+
+private:
+
+    void onStatementFinished();
+
+    QString _fileName;
+    db::user_query::ScriptPosition _start;
+    QString _openError;
+    std::atomic<qint64> _fileSize;
+    std::atomic<qint64> _bytesDone;
+    std::atomic<qint64> _elapsedMs;
+    QElapsedTimer _timer; // connection thread only
+    qint64 _lastProgressMs;
+};
+
+} // namespace threads
+} // namespace meow
+
+#endif // MEOW_THREADS_FILE_QUERIES_TASK_H
@@ -17,4 +17,8 @@ static bool isCurrentThreadMain()
 
 #define MEOW_ASSERT_MAIN_THREAD Q_ASSERT(meow::threads::isCurrentThreadMain());
 
+// In Connection methods: main thread unless it's a worker connection
+#define MEOW_ASSERT_CONNECTION_THREAD \
+    Q_ASSERT(isWorkerConnection() || meow::threads::isCurrentThreadMain());
+
 #endif // MEOW_THREADS_HELPERS_H
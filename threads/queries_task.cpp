@@ -37,6 +37,18 @@ void QueriesTask::abort()
     _executor.abort();
 }
 
+void QueriesTask::setParallelConnections(
+        const QList<db::ConnectionPtr> & connections,
+        const QString & database)
+{
+    _executor.setParallelConnections(connections, database);
+}
+
+QList<db::ConnectionPtr> QueriesTask::openedParallelConnections() const
+{
+    return _executor.openedParallelConnections();
+}
+
 QString QueriesTask::errorMessage() const
 {
     return _executor.error().message();
@@ -82,12 +94,12 @@ int QueriesTask::querySuccessCount() const
     return _executor.querySuccessCount();
 }
 
-std::chrono::milliseconds QueriesTask::execDuration() const
+std::chrono::microseconds QueriesTask::execDuration() const
 {
     return _executor.execDuration();
 }
 
-std::chrono::milliseconds QueriesTask::networkDuration() const
+std::chrono::microseconds QueriesTask::networkDuration() const
 {
     return _executor.networkDuration();
 }
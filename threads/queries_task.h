@@ -26,7 +26,12 @@ public:
     void run() override;
     bool isFailed() const override;
     void abort();
-    QString errorMessage() const;
+    virtual QString errorMessage() const;
+
+    // see BatchExecutor::setParallelConnections()
+    void setParallelConnections(const QList<db::ConnectionPtr> & connections,
+                                const QString & database = QString());
+    QList<db::ConnectionPtr> openedParallelConnections() const;
 
     int currentResultsCount() const;
     db::QueryPtr resultAt(int queryIndex) const;
@@ -39,12 +44,12 @@ public:
     int queryFailedCount() const;
     int querySuccessCount() const;
 
-    std::chrono::milliseconds execDuration() const;
-    std::chrono::milliseconds networkDuration() const;
+    std::chrono::microseconds execDuration() const;
+    std::chrono::microseconds networkDuration() const;
 
     Q_SIGNAL void queryFinished(int queryIndex, int totalCount);
 
-private:
+protected:
     db::SQLBatch _queries;
     db::Connection * _connection;
     db::user_query::BatchExecutor _executor;
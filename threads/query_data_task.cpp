@@ -0,0 +1,96 @@
+#include "query_data_task.h"
+#include "db/connection.h"
+#include "db/exception.h"
+#include <algorithm>
+
+namespace meow {
+namespace threads {
+
+QueryDataTask::QueryDataTask(const QString & SQL, db::Connection * connection)
+    : ThreadTask(TaskType::QueryData)
+    , _SQL(SQL)
+    , _connection(connection)
+    , _streamResult(false)
+    , _firstRowsCount(0)
+    , _isPrepared(false)
+    , _aborted(false)
+    , _started(false)
+    , _failed(false)
+{
+
+}
+
+QueryDataTask::~QueryDataTask()
+{
+
+}
+
+void QueryDataTask::run()
+{
+    if (_aborted) { // superseded while queued
+        emit finished();
+        return;
+    }
+    _started = true;
+
+    _query = _connection->createQuery();
+    _query->setSQL(_SQL);
+    if (_isPrepared) {
+        _query->setBindValues(_bindValues);
+    }
+
+    try {
+        _query->execute(false, _streamResult);
+
+        if (_streamResult) {
+            // receive by steps to report progress and be able to stop
+            while (!_aborted
+                   && _query->recordCount() < _firstRowsCount
+                   && _query->canFetchMore()) {
+                db::ulonglong rowsLeft = _firstRowsCount
+                        - _query->recordCount();
+                _query->fetchMore(
+                    std::min(rowsLeft, (db::ulonglong)db::DATA_ROWS_PER_STEP));
+                emit rowsReceived(static_cast<int>(_query->recordCount()));
+            }
+        }
+    } catch(meow::db::Exception & ex) {
+        _failed = true;
+        _errorMessage = ex.message();
+    }
+
+    if (_aborted) {
+        // nobody needs it, free (and drain) the result here, not in UI thread
+        _query.reset();
+    }
+
+    emit finished();
+    if (isFailed()) {
+        emit failed();
+    }
+}
+
+bool QueryDataTask::isFailed() const
+{
+    return _failed;
+}
+
+void QueryDataTask::setStreamResult(bool stream, db::ulonglong firstRowsCount)
+{
+    _streamResult = stream;
+    _firstRowsCount = firstRowsCount;
+}
+
+void QueryDataTask::setBindValues(const QStringList & values)
+{
+    _bindValues = values;
+    _isPrepared = true;
+}
+
+void QueryDataTask::abort()
+{
+    _aborted = true;
+}
+
+} // namespace threads
+} // namespace meow
@@ -0,0 +1,64 @@
+#ifndef MEOW_THREADS_QUERY_DATA_TASK_H
+#define MEOW_THREADS_QUERY_DATA_TASK_H
+
+#include <atomic>
+#include <QString>
+#include "thread_task.h"
+#include "db/common.h"
+#include "db/query.h"
+
+namespace meow {
+
+namespace db {
+class Connection;
+}
+
+namespace threads {
+
+// Intent: runs SELECT of table data (see QueryDataFetcher::selectSQL()),
+// result is taken by model in main thread when finished
+class QueryDataTask : public ThreadTask
+{
+    Q_OBJECT
+public:
+    QueryDataTask(const QString & SQL, db::Connection * connection);
+    ~QueryDataTask() override;
+    void run() override;
+    bool isFailed() const override;
+
+    // Streaming: receive only first rows, the rest stays on the way
+    void setStreamResult(bool stream, db::ulonglong firstRowsCount = 0);
+
+    // Executes SQL as prepared statement, see QueryCriteria::typedResult
+    void setBindValues(const QStringList & values);
+
+    // Stops receiving of streamed rows, use query killer to stop the query
+    void abort();
+    bool isAborted() const { return _aborted; }
+    // true once SQL is sent, a queued task has nothing to kill
+    bool isStarted() const { return _started; }
+
+    QString errorMessage() const { return _errorMessage; }
+
+    db::Query * query() const { return _query.get(); }
+
+    Q_SIGNAL void rowsReceived(int rowCount);
+
+private:
+    QString _SQL;
+    db::Connection * _connection;
+    db::QueryPtr _query;
+    bool _streamResult;
+    db::ulonglong _firstRowsCount;
+    bool _isPrepared;
+    QStringList _bindValues;
+    std::atomic<bool> _aborted;
+    std::atomic<bool> _started;
+    bool _failed;
+    QString _errorMessage;
+};
+
+} // namespace threads
+} // namespace meow
+
+#endif // MEOW_THREADS_QUERY_DATA_TASK_H
@@ -9,6 +9,9 @@ namespace threads {
 enum class TaskType
 {
     Query,
+    QueryData,
+    FetchRows,
+    FetchEntities,
     InitDBThread
 };
 
@@ -55,8 +55,41 @@ void EditableDataTableView::contextMenuEvent(QContextMenuEvent * event)
     menu.addAction(presenter.resetDataSortAction());
     menu.addAction(presenter.refreshDataAction());
 
+    menu.addSeparator();
+
+    menu.addAction(presenter.exportDataAction());
+
     menu.exec(event->globalPos());
 }
 
+void EditableDataTableView::scrollContentsBy(int dx, int dy)
+{
+    TableView::scrollContentsBy(dx, dy);
+    if (dy != 0) {
+        emitVisibleRowsChanged();
+    }
+}
+
+void EditableDataTableView::resizeEvent(QResizeEvent * event)
+{
+    TableView::resizeEvent(event);
+    emitVisibleRowsChanged();
+}
+
+void EditableDataTableView::emitVisibleRowsChanged()
+{
+    if (!model() || model()->rowCount() == 0) {
+        return;
+    }
+
+    int firstRow = rowAt(0);
+    int lastRow = rowAt(viewport()->height() - 1);
+    if (lastRow == -1) { // below the last row
+        lastRow = model()->rowCount() - 1;
+    }
+
+    emit visibleRowsChanged(firstRow, lastRow);
+}
+
 } // namespace ui
 } // namespace meow
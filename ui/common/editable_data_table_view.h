@@ -8,8 +8,18 @@ namespace ui {
 
 class EditableDataTableView : public TableView
 {
+    Q_OBJECT
+public:
+    // rows of model() currently painted, see DataTableModel::setViewport()
+    Q_SIGNAL void visibleRowsChanged(int firstRow, int lastRow);
+
 protected:
     virtual void contextMenuEvent(QContextMenuEvent * event) override;
+    virtual void scrollContentsBy(int dx, int dy) override;
+    virtual void resizeEvent(QResizeEvent * event) override;
+
+private:
+    void emitVisibleRowsChanged();
 };
 
 } // namespace ui
@@ -0,0 +1,156 @@
+#include "sql_keywords_lookup.h"
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+namespace meow {
+namespace ui {
+namespace common {
+
+namespace {
+
+const quint32 MAX_BUCKET_SEED = 16 * 1024;
+const int MAX_WORD_LENGTH = 64; // longer words are never keywords
+
+} // namespace
+
+SQLKeywordsLookup::SQLKeywordsLookup()
+    : _mask(0)
+    , _bucketMask(0)
+    , _maxLength(0)
+{
+
+}
+
+void SQLKeywordsLookup::insert(const QStringList & words, int kind)
+{
+    for (const QString & word : words) {
+        Slot slot;
+        slot.word = word.toLower().toLatin1().left(MAX_WORD_LENGTH);
+        slot.kind = kind;
+        bool isDuplicate = std::any_of(_words.begin(), _words.end(),
+            [&slot](const Slot & other) { return other.word == slot.word; });
+        if (isDuplicate) {
+            continue; // first kind wins
+        }
+        _maxLength = std::max(_maxLength, slot.word.length());
+        _words.push_back(slot);
+    }
+}
+
+void SQLKeywordsLookup::build()
+{
+    std::size_t size = 16;
+    while (size < _words.size()) {
+        size *= 2;
+    }
+
+    while (!place(size)) { // never happens for ~300 keywords
+        size *= 2;
+    }
+}
+
+int SQLKeywordsLookup::find(const QChar * word, int length) const
+{
+    if (length == 0 || length > _maxLength || _slots.empty()) {
+        return -1;
+    }
+
+    char lower[MAX_WORD_LENGTH];
+    for (int i = 0; i < length; ++i) {
+        ushort c = word[i].unicode();
+        if (c >= 0x80) {
+            return -1;
+        }
+        lower[i] = (c >= 'A' && c <= 'Z') ? static_cast<char>(c + 32)
+                                          : static_cast<char>(c);
+    }
+
+    quint32 seed = _seeds[hash(lower, length, 0) & _bucketMask];
+    const Slot & slot = _slots[hash(lower, length, seed) & _mask];
+
+    if (slot.word.length() == length
+            && memcmp(slot.word.constData(), lower,
+                      static_cast<std::size_t>(length)) == 0) {
+        return slot.kind;
+    }
+    return -1;
+}
+
+quint32 SQLKeywordsLookup::hash(const char * word, int length, quint32 seed)
+{
+    quint32 h = 2166136261u ^ (seed * 0x9E3779B9u); // FNV-1a
+    for (int i = 0; i < length; ++i) {
+        h ^= static_cast<unsigned char>(word[i]);
+        h *= 16777619u;
+    }
+    return h ^ (h >> 15);
+}
+
+bool SQLKeywordsLookup::place(std::size_t size)
+{
+    std::size_t bucketCount = std::max<std::size_t>(1, size / 4);
+
+    _slots.assign(size, Slot());
+    _seeds.assign(bucketCount, 0);
+    _mask = static_cast<quint32>(size - 1);
+    _bucketMask = static_cast<quint32>(bucketCount - 1);
+
+    std::vector<std::vector<const Slot *>> buckets(bucketCount);
+    for (const Slot & word : _words) {
+        quint32 bucket = hash(word.word.constData(), word.word.length(), 0)
+                & _bucketMask;
+        buckets[bucket].push_back(&word);
+    }
+
+    // biggest buckets first while there are many free slots
+    std::vector<std::size_t> order(bucketCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+        [&buckets](std::size_t left, std::size_t right) {
+            return buckets[left].size() > buckets[right].size();
+        });
+
+    std::vector<quint32> indices;
+
+    for (std::size_t bucket : order) {
+        if (buckets[bucket].empty()) {
+            break;
+        }
+
+        bool placed = false;
+
+        for (quint32 seed = 1; seed < MAX_BUCKET_SEED && !placed; ++seed) {
+            indices.clear();
+            placed = true;
+            for (const Slot * word : buckets[bucket]) {
+                quint32 index = hash(word->word.constData(),
+                                     word->word.length(),
+                                     seed) & _mask;
+                if (_slots[index].kind != -1
+                        || std::find(indices.begin(), indices.end(), index)
+                            != indices.end()) {
+                    placed = false;
+                    break;
+                }
+                indices.push_back(index);
+            }
+            if (placed) {
+                _seeds[bucket] = seed;
+                for (std::size_t i = 0; i < indices.size(); ++i) {
+                    _slots[indices[i]] = *buckets[bucket][i];
+                }
+            }
+        }
+
+        if (!placed) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace common
+} // namespace ui
+} // namespace meow
@@ -0,0 +1,52 @@
+#ifndef UI_COMMON_SQL_KEYWORDS_LOOKUP_H
+#define UI_COMMON_SQL_KEYWORDS_LOOKUP_H
+
+#include <vector>
+#include <QByteArray>
+#include <QChar>
+#include <QStringList>
+
+namespace meow {
+namespace ui {
+namespace common {
+
+// Intent: case insensitive lookup of SQL keywords in text without copying
+// words. Perfect hash (hash and displace): words are grouped into buckets by
+// one hash, every bucket gets a seed of second hash which puts its words to
+// free slots. A lookup is two hashes and one compare
+class SQLKeywordsLookup
+{
+public:
+    SQLKeywordsLookup();
+
+    // kind is returned by find(), words are ASCII
+    void insert(const QStringList & words, int kind);
+    void build();
+
+    // Returns kind of word or -1
+    int find(const QChar * word, int length) const;
+
+private:
+
+    struct Slot
+    {
+        QByteArray word; // lower case
+        int kind = -1;
+    };
+
+    static quint32 hash(const char * word, int length, quint32 seed);
+    bool place(std::size_t size);
+
+    std::vector<Slot> _words;
+    std::vector<Slot> _slots;
+    std::vector<quint32> _seeds; // per bucket
+    quint32 _mask;
+    quint32 _bucketMask;
+    int _maxLength;
+};
+
+} // namespace common
+} // namespace ui
+} // namespace meow
+
+#endif // UI_COMMON_SQL_KEYWORDS_LOOKUP_H
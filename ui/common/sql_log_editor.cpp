@@ -1,4 +1,6 @@
 #include "sql_log_editor.h"
+#include <algorithm>
+#include <QInputDialog>
 #include <QMenu>
 #include "app/app.h"
 
@@ -8,18 +10,50 @@ namespace common {
 
 SQLLogEditor::SQLLogEditor(QWidget * parent) : SQLEditor(parent)
 {
+    auto geometrySettings = meow::app()->settings()->geometrySettings();
 
+    // the document drops the first blocks itself: a ring buffer of lines
+    setMaximumBlockCount(geometrySettings->logMaxLineCount());
+
+    connect(geometrySettings,
+            &meow::settings::Geometry::logMaxLineCountChanged,
+            this,
+            &QPlainTextEdit::setMaximumBlockCount);
 }
 
-void SQLLogEditor::appendMessage(const QString & message)
+void SQLLogEditor::appendMessages(const QStringList & messages)
 {
-    bool isEmpty = this->document()->isEmpty();
+    if (messages.isEmpty()) {
+        return;
+    }
 
-    moveCursor(QTextCursor::End);
-    if (!isEmpty) {
-        insertPlainText(QString(QChar::LineFeed));
+    // don't insert (and highlight) what would be dropped right away
+    int maxLineCount = maximumBlockCount();
+    int first = messages.size();
+    int lineCount = 0;
+    while (first > 0) {
+        lineCount += messages[first - 1].count(QChar::LineFeed) + 1;
+        if (maxLineCount > 0 && lineCount > maxLineCount) {
+            break;
+        }
+        --first;
     }
-    insertPlainText(message);
+    first = std::min(first, messages.size() - 1);
+
+    QString text;
+    if (!this->document()->isEmpty()) {
+        text += QChar::LineFeed;
+    }
+    for (int i = first; i < messages.size(); ++i) {
+        if (i > first) {
+            text += QChar::LineFeed;
+        }
+        text += messages[i];
+    }
+
+    QTextCursor cursor(document());
+    cursor.movePosition(QTextCursor::End);
+    cursor.insertText(text);
     moveCursor(QTextCursor::End);
 }
 
@@ -28,10 +62,34 @@ void SQLLogEditor::contextMenuEvent(QContextMenuEvent *event)
     QMenu * menu = createStandardContextMenu();
     menu->addAction(meow::app()->actions()->logClear());
 
+    QAction * maxLineCountAction = menu->addAction(tr("Maximum lines..."));
+    connect(maxLineCountAction, &QAction::triggered,
+            [=]() { onMaxLineCountAction(); });
+
     menu->exec(event->globalPos());
     delete menu;
 }
 
+void SQLLogEditor::onMaxLineCountAction()
+{
+    auto geometrySettings = meow::app()->settings()->geometrySettings();
+
+    bool ok = false;
+    int count = QInputDialog::getInt(
+        this,
+        tr("SQL log"),
+        tr("Keep last lines (0 - all):"),
+        geometrySettings->logMaxLineCount(),
+        0,
+        10000000,
+        1000,
+        &ok);
+
+    if (ok) {
+        geometrySettings->setLogMaxLineCount(count);
+    }
+}
+
 } // namespace common
 } // namespace ui
 } // namespace meow
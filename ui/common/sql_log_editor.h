@@ -7,15 +7,18 @@ namespace meow {
 namespace ui {
 namespace common {
 
+// Intent: log panel, keeps only the last lines (see logMaxLineCount())
 class SQLLogEditor : public SQLEditor
 {
 public:
     explicit SQLLogEditor(QWidget * parent = nullptr);
 
-    void appendMessage(const QString & message);
+    // Line per message, all in one edit
+    void appendMessages(const QStringList & messages);
 
 private:
     void contextMenuEvent(QContextMenuEvent *event) override;
+    void onMaxLineCountAction();
 };
 
 } // namespace common
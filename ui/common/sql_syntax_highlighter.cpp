@@ -30,10 +30,29 @@ SQLSyntaxHighlighter::SQLSyntaxHighlighter(QTextDocument * parent)
         isLightTheme ? QColor(153, 0, 85) : QColor(201, 115, 115));
     _functionFormat.setForeground(QColor(221, 74, 104));
 
-    addKeywordsRules();
+    addKeywords();
 }
 
-void SQLSyntaxHighlighter::addKeywordsRules()
+namespace {
+
+inline bool isWordChar(QChar c)
+{
+    ushort u = c.unicode();
+    if (u < 0x80) {
+        return (u >= 'a' && u <= 'z') || (u >= 'A' && u <= 'Z')
+            || (u >= '0' && u <= '9') || u == '_' || u == '$';
+    }
+    return c.isLetterOrNumber();
+}
+
+inline bool isDigit(QChar c)
+{
+    return c.unicode() >= '0' && c.unicode() <= '9';
+}
+
+} // namespace
+
+void SQLSyntaxHighlighter::addKeywords()
 {
 
     QStringList reservedKeywords = meow::db::common::mySqlReservedKeywords();
@@ -43,31 +62,9 @@ void SQLSyntaxHighlighter::addKeywordsRules()
         reservedKeywords.removeOne(word);
     }
 
-    appendKeywords(reservedKeywords, _reservedKeywordFormat);
-    appendKeywords(boolLiterals,     _boolLiteralsFormat);
-
-    //TODO: this is stupid but better than nothing
-    QString floatPattern(R"([-+]?[0-9]*\.?[0-9]+([eE][-+]?[0-9]+)?)");
-    HighlightingRule rule;
-    rule.pattern = QRegularExpression(QString(R"(\b%1\b)").arg(floatPattern));
-    rule.format = _numericFormat;
-
-    _keywordsRules.append(rule);
-}
-
-void SQLSyntaxHighlighter::appendKeywords(
-    const QStringList & words,
-    const QTextCharFormat & format)
-{
-    HighlightingRule rule;
-
-    for (const QString &keyword : words) {
-        QString pattern = QString(R"(\b%1\b)").arg(keyword);
-        rule.pattern = QRegularExpression
-                (pattern, QRegularExpression::CaseInsensitiveOption);
-        rule.format = format;
-        _keywordsRules.append(rule);
-    }
+    _keywords.insert(reservedKeywords, ReservedKeyword);
+    _keywords.insert(boolLiterals,     BoolLiteral);
+    _keywords.build();
 }
 
 void SQLSyntaxHighlighter::highlightBlock(const QString &text)
@@ -91,30 +88,9 @@ void SQLSyntaxHighlighter::highlightBlock(const QString &text)
 
         switch (token->type) {
 
-        case uq::SentenceTokenType::Text: {
-
-            QString tokenText = text.mid(token->startIndex, token->len);
-
-            for (const HighlightingRule &rule : _keywordsRules) {
-                QRegularExpressionMatchIterator matchIterator =
-                        rule.pattern.globalMatch(tokenText);
-
-                while (matchIterator.hasNext()) {
-
-                    QRegularExpressionMatch match = matchIterator.next();
-
-                    //if (isQuotedId(tokenText, match)) {
-                    //    continue;
-                    //}
-
-                    setFormat(
-                                match.capturedStart() + token->startIndex,
-                                match.capturedLength(),
-                                rule.format);
-                }
-            }
+        case uq::SentenceTokenType::Text:
+            highlightText(text, token->startIndex, token->len);
             break;
-        }
 
         case uq::SentenceTokenType::SingleLineComment:
             setFormat(
@@ -153,24 +129,86 @@ void SQLSyntaxHighlighter::highlightBlock(const QString &text)
     }
 }
 
-bool SQLSyntaxHighlighter::isQuotedId( // rm
-        const QString & text,
-        const QRegularExpressionMatch & match) const
+void SQLSyntaxHighlighter::highlightText(const QString & text,
+                                         int start,
+                                         int length)
 {
-    int startIndex = match.capturedStart();
-    int endIndex = match.capturedEnd();
-
-    if (startIndex > 0) {
-        if (text.at(startIndex-1) == QChar('.')) {
-            return true;
-        } else if (text.at(startIndex-1) == QChar('`')) {
-            if (endIndex < text.length()) {
-                return text.at(endIndex) == QChar('`');
+    const QChar * data = text.constData();
+    const int end = start + length;
+
+    int i = start;
+    while (i < end) {
+        QChar c = data[i];
+
+        bool afterDot = (i > 0 && data[i - 1] == QChar('.'));
+
+        if (isDigit(c) || (c == QChar('.') && !afterDot
+                           && i + 1 < end && isDigit(data[i + 1])
+                           && (i == 0 || !isWordChar(data[i - 1])))) {
+            int numberEnd = scanNumber(data, i, end);
+            if (numberEnd != -1) {
+                setFormat(i, numberEnd - i, _numericFormat);
+                i = numberEnd;
+                continue;
             }
         }
+
+        if (!isWordChar(c)) {
+            ++i;
+            continue;
+        }
+
+        int wordStart = i;
+        while (i < end && isWordChar(data[i])) {
+            ++i;
+        }
+
+        if (afterDot) { // e.g. table.column, not a keyword
+            continue;
+        }
+
+        switch (_keywords.find(data + wordStart, i - wordStart)) {
+        case ReservedKeyword:
+            setFormat(wordStart, i - wordStart, _reservedKeywordFormat);
+            break;
+        case BoolLiteral:
+            setFormat(wordStart, i - wordStart, _boolLiteralsFormat);
+            break;
+        default:
+            break;
+        }
     }
+}
 
-    return false;
+int SQLSyntaxHighlighter::scanNumber(const QChar * text, int index, int end)
+{
+    // [0-9]*\.?[0-9]+([eE][-+]?[0-9]+)? not followed by word char
+    int i = index;
+    while (i < end && isDigit(text[i])) {
+        ++i;
+    }
+    if (i + 1 < end && text[i] == QChar('.') && isDigit(text[i + 1])) {
+        i += 2;
+        while (i < end && isDigit(text[i])) {
+            ++i;
+        }
+    }
+    if (i < end && (text[i] == QChar('e') || text[i] == QChar('E'))) {
+        int e = i + 1;
+        if (e < end && (text[e] == QChar('-') || text[e] == QChar('+'))) {
+            ++e;
+        }
+        if (e < end && isDigit(text[e])) {
+            i = e;
+            while (i < end && isDigit(text[i])) {
+                ++i;
+            }
+        }
+    }
+    if (i < end && isWordChar(text[i])) {
+        return -1; // e.g. 1abc
+    }
+    return i;
 }
 
 } // namespace common
@@ -5,7 +5,7 @@
 
 #include <QSyntaxHighlighter>
 #include <QTextCharFormat>
-#include <QRegularExpression>
+#include "sql_keywords_lookup.h"
 
 class QTextDocument;
 
@@ -13,6 +13,10 @@ namespace meow {
 namespace ui {
 namespace common {
 
+// Intent: highlights SQL in one pass over a block. Comments and strings are
+// found by SentencesParser, its open token type is the block state, so Qt
+// rehighlights next blocks only when it changes. Words of text tokens are
+// looked up in keywords table
 class SQLSyntaxHighlighter : public QSyntaxHighlighter
 {
 
@@ -24,21 +28,19 @@ protected:
 
 private:
 
-    void addKeywordsRules();
-    void createSingleLineCommentRules();
+    enum KeywordKind {
+        ReservedKeyword = 0,
+        BoolLiteral
+    };
 
-    bool isQuotedId(const QString &text,
-                    const QRegularExpressionMatch & match) const;
+    void addKeywords();
 
-    void appendKeywords(const QStringList & words,
-                        const QTextCharFormat & format);
+    void highlightText(const QString & text, int start, int length);
 
-    struct HighlightingRule
-    {
-        QRegularExpression pattern;
-        QTextCharFormat format;
-    };
-    QVector<HighlightingRule> _keywordsRules;
+    // Returns end of number starting at index or -1
+    static int scanNumber(const QChar * text, int index, int end);
+
+    SQLKeywordsLookup _keywords;
 
     QTextCharFormat _singleLineCommentFormat;
     QTextCharFormat _quotationFormat;
@@ -21,8 +21,7 @@ TopWidget::TopWidget(presenters::ExportDatabaseForm *form, QWidget *parent)
             { _triggersCreateCheckbox,          Option::Triggers },
             { _triggersDropCheckbox,            Option::AddDropTrigger },
             { _routinesCreateCheckbox,          Option::Routines },
-            { _eventsCreateCheckbox,            Option::Events },
-            { _disableColumnStatisticsCheckbox, Option::NoColumnStatistics}
+            { _eventsCreateCheckbox,            Option::Events }
     };
 
     connect(_form, &presenters::ExportDatabaseForm::optionsChanged,
@@ -174,13 +173,39 @@ void TopWidget::createWidgets()
 
     // -------------------------------------------------------------------------
 
-    _disableColumnStatisticsCheckbox = new QCheckBox(
-                tr("Disable column statistics (mysqldump v8+)"));
+    _optionsOutputLabel = new QLabel(tr("Output:"));
+    _mainGridLayout->addWidget(_optionsOutputLabel, row, 0);
 
-    connect(_disableColumnStatisticsCheckbox, &QCheckBox::stateChanged,
-            this, &TopWidget::onOptionsCheckboxChanged);
+    _compressCheckbox = new QCheckBox(tr("Compress (gzip)"));
+    connect(_compressCheckbox, &QCheckBox::stateChanged,
+            [=](int state) {
+                _form->setCompress(state == Qt::Checked);
+            });
 
-    _mainGridLayout->addWidget(_disableColumnStatisticsCheckbox, row, 0, 1, 2);
+    _rowsPerInsertSpinBox = new QSpinBox();
+    _rowsPerInsertSpinBox->setRange(1, 100000);
+    _rowsPerInsertSpinBox->setSuffix(tr(" rows per INSERT"));
+    connect(_rowsPerInsertSpinBox,
+            static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged),
+            [=](int value) {
+                _form->setRowsPerInsert(value);
+            });
+
+    _connectionsSpinBox = new QSpinBox();
+    _connectionsSpinBox->setRange(1, 16);
+    _connectionsSpinBox->setSuffix(tr(" connection(s)"));
+    connect(_connectionsSpinBox,
+            static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged),
+            [=](int value) {
+                _form->setParallelConnections(value);
+            });
+
+    QHBoxLayout * outputLayout = new QHBoxLayout();
+    outputLayout->addWidget(_compressCheckbox);
+    outputLayout->addWidget(_rowsPerInsertSpinBox);
+    outputLayout->addWidget(_connectionsSpinBox);
+    outputLayout->addStretch(1);
+    _mainGridLayout->addLayout(outputLayout, row, 1);
 
     row++;
 
@@ -204,7 +229,7 @@ void TopWidget::fillDataFromForm()
 {
 
     clearResults();
-    appendToResults(_form->currentCommand());
+    appendToResults(_form->description());
 
     if (_filenameEdit->text() != _form->filename()) {
         _filenameEdit->blockSignals(true);
@@ -224,6 +249,18 @@ void TopWidget::fillDataFromForm()
     }
     _databaseToExportComboBox->blockSignals(false);
 
+    _compressCheckbox->blockSignals(true);
+    _compressCheckbox->setChecked(_form->compress());
+    _compressCheckbox->blockSignals(false);
+
+    _rowsPerInsertSpinBox->blockSignals(true);
+    _rowsPerInsertSpinBox->setValue(_form->rowsPerInsert());
+    _rowsPerInsertSpinBox->blockSignals(false);
+
+    _connectionsSpinBox->blockSignals(true);
+    _connectionsSpinBox->setValue(_form->parallelConnections());
+    _connectionsSpinBox->blockSignals(false);
+
 
     auto it = _checkboxOptions.constBegin();
     while (it != _checkboxOptions.constEnd()) {
@@ -253,6 +290,10 @@ void TopWidget::setInputsEnabled(bool enabled)
     _databaseToExportComboBox->setEnabled(enabled);
     _filenameEdit->setEnabled(enabled);
     _filenameSelectionButton->setEnabled(enabled);
+    _compressCheckbox->setEnabled(enabled);
+    _rowsPerInsertSpinBox->setEnabled(enabled
+        && _form->isOptionEnabled(Option::ExtendedInsert));
+    _connectionsSpinBox->setEnabled(enabled);
 
     auto it = _checkboxOptions.constBegin();
     while (it != _checkboxOptions.constEnd()) {
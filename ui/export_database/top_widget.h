@@ -57,7 +57,10 @@ private:
     QCheckBox * _routinesCreateCheckbox;
     QCheckBox * _eventsCreateCheckbox;
 
-    QCheckBox * _disableColumnStatisticsCheckbox;
+    QLabel * _optionsOutputLabel;
+    QCheckBox * _compressCheckbox;
+    QSpinBox * _rowsPerInsertSpinBox;
+    QSpinBox * _connectionsSpinBox;
 
     QPlainTextEdit * _results;
 
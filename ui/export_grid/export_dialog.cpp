@@ -0,0 +1,371 @@
+#include "export_dialog.h"
+#include "helpers/formatting.h"
+#include "utils/exporting/grid_exporter.h"
+
+namespace meow {
+namespace ui {
+namespace export_grid {
+
+namespace {
+
+using utils::exporting::GridExportFormat;
+
+struct FormatItem
+{
+    const char * title;
+    GridExportFormat format;
+    char delimiter;
+    const char * extension;
+};
+
+const FormatItem FORMATS[] = {
+    { QT_TRANSLATE_NOOP("meow::ui::export_grid::Dialog",
+                        "CSV, comma separated"),
+      GridExportFormat::CSV, ',', "csv" },
+    { QT_TRANSLATE_NOOP("meow::ui::export_grid::Dialog",
+                        "CSV, semicolon separated"),
+      GridExportFormat::CSV, ';', "csv" },
+    { QT_TRANSLATE_NOOP("meow::ui::export_grid::Dialog",
+                        "TSV, tab separated"),
+      GridExportFormat::CSV, '\t', "tsv" },
+    { QT_TRANSLATE_NOOP("meow::ui::export_grid::Dialog",
+                        "JSON lines"),
+      GridExportFormat::JSONLines, ',', "jsonl" },
+    { QT_TRANSLATE_NOOP("meow::ui::export_grid::Dialog",
+                        "SQL INSERTs"),
+      GridExportFormat::SQLInserts, ',', "sql" },
+    { QT_TRANSLATE_NOOP("meow::ui::export_grid::Dialog",
+                        "Columnar binary"),
+      GridExportFormat::Columnar, ',', "meowcol" },
+};
+
+} // namespace
+
+Dialog::Dialog(const db::QueryDataPtr & data,
+               const QString & wholeQuerySQL,
+               const QString & tableName)
+    : QDialog(nullptr, Qt::WindowCloseButtonHint)
+    , _data(data)
+    , _wholeQuerySQL(wholeQuerySQL)
+{
+    setMinimumSize(320, 300);
+    setWindowTitle(tr("Export grid rows"));
+
+    createWidgets();
+
+    _tableNameEdit->setText(tableName);
+    validateControls();
+
+    resize(700, 450);
+}
+
+Dialog::~Dialog()
+{
+
+}
+
+void Dialog::createWidgets()
+{
+    _mainGridLayout = new QGridLayout();
+    int row = 0;
+
+    // -------------------------------------------------------------------------
+
+    QLabel * filenameLabel = new QLabel(tr("Filename:"));
+    _mainGridLayout->addWidget(filenameLabel, row, 0);
+
+    _filenameEdit = new QLineEdit();
+    filenameLabel->setBuddy(_filenameEdit);
+    _filenameSelectionButton = new QPushButton(tr("..."));
+    _filenameSelectionButton->setMaximumWidth(40);
+    connect(_filenameSelectionButton, &QAbstractButton::clicked,
+            this, &Dialog::onFilenameSelectionButtonClicked);
+
+    QHBoxLayout * filenameLayout = new QHBoxLayout();
+    filenameLayout->addWidget(_filenameEdit, 1);
+    filenameLayout->addWidget(_filenameSelectionButton);
+    _mainGridLayout->addLayout(filenameLayout, row, 1);
+
+    row++;
+
+    // -------------------------------------------------------------------------
+
+    QLabel * formatLabel = new QLabel(tr("Format:"));
+    _mainGridLayout->addWidget(formatLabel, row, 0);
+
+    _formatComboBox = new QComboBox();
+    for (const FormatItem & item : FORMATS) {
+        _formatComboBox->addItem(tr(item.title));
+    }
+    connect(_formatComboBox,
+            static_cast<void(QComboBox::*)(int)>(
+                &QComboBox::currentIndexChanged),
+            this, &Dialog::onFormatChanged);
+
+    _compressCheckbox = new QCheckBox(tr("Compress (gzip)"));
+
+    QHBoxLayout * formatLayout = new QHBoxLayout();
+    formatLayout->addWidget(_formatComboBox);
+    formatLayout->addWidget(_compressCheckbox);
+    formatLayout->addStretch(1);
+    _mainGridLayout->addLayout(formatLayout, row, 1);
+
+    row++;
+
+    // -------------------------------------------------------------------------
+
+    QLabel * rowsLabel = new QLabel(tr("Rows:"));
+    _mainGridLayout->addWidget(rowsLabel, row, 0);
+
+    _loadedRowsRadio = new QRadioButton(
+        tr("Loaded (%1)").arg(helpers::formatNumber(
+            static_cast<unsigned long long>(_data->rowCount()))));
+    _loadedRowsRadio->setChecked(true);
+    _allRowsRadio = new QRadioButton(tr("All, execute query again"));
+    _allRowsRadio->setToolTip(
+        tr("Rows are received and written one by one, any count fits"));
+    _allRowsRadio->setEnabled(!_wholeQuerySQL.isEmpty());
+    if (_data->hasRowWindows()) { // only windows around viewport are loaded
+        _loadedRowsRadio->setEnabled(false);
+        _allRowsRadio->setChecked(true);
+    }
+
+    QHBoxLayout * rowsLayout = new QHBoxLayout();
+    rowsLayout->addWidget(_loadedRowsRadio);
+    rowsLayout->addWidget(_allRowsRadio);
+    rowsLayout->addStretch(1);
+    _mainGridLayout->addLayout(rowsLayout, row, 1);
+
+    row++;
+
+    // -------------------------------------------------------------------------
+
+    QLabel * optionsLabel = new QLabel(tr("Options:"));
+    _mainGridLayout->addWidget(optionsLabel, row, 0);
+
+    _includeHeaderCheckbox = new QCheckBox(tr("Column names in first row"));
+    _includeHeaderCheckbox->setChecked(true);
+
+    _tableNameEdit = new QLineEdit();
+    _tableNameEdit->setPlaceholderText(tr("Table"));
+    _tableNameEdit->setToolTip(tr("Quoted name of table to INSERT into"));
+
+    _rowsPerInsertSpinBox = new QSpinBox();
+    _rowsPerInsertSpinBox->setRange(1, 100000);
+    _rowsPerInsertSpinBox->setValue(1000);
+    _rowsPerInsertSpinBox->setSuffix(tr(" rows per INSERT"));
+
+    QHBoxLayout * optionsLayout = new QHBoxLayout();
+    optionsLayout->addWidget(_includeHeaderCheckbox);
+    optionsLayout->addWidget(_tableNameEdit, 1);
+    optionsLayout->addWidget(_rowsPerInsertSpinBox);
+    optionsLayout->addStretch(1);
+    _mainGridLayout->addLayout(optionsLayout, row, 1);
+
+    row++;
+
+    // -------------------------------------------------------------------------
+
+    _progressBar = new QProgressBar();
+    _progressBar->setRange(0, 1000);
+    _progressBar->setValue(0);
+    _progressBar->setTextVisible(false);
+    _mainGridLayout->addWidget(_progressBar, row, 0, 1, 2);
+
+    row++;
+
+    _results = new QPlainTextEdit;
+    _results->setReadOnly(true);
+    _mainGridLayout->addWidget(_results, row, 0, 1, 2);
+    _mainGridLayout->setRowStretch(row, 1);
+
+    row++;
+
+    // -------------------------------------------------------------------------
+
+    QHBoxLayout * buttonsLayout = new QHBoxLayout();
+    buttonsLayout->addStretch(1);
+
+    _exportButton = new QPushButton(tr("Export"));
+    connect(_exportButton, &QAbstractButton::clicked,
+            this, &Dialog::onExport);
+    buttonsLayout->addWidget(_exportButton);
+
+    _cancelButton = new QPushButton(tr("Cancel"));
+    connect(_cancelButton, &QAbstractButton::clicked,
+            this, &Dialog::onCancel);
+    buttonsLayout->addWidget(_cancelButton);
+
+    _mainGridLayout->addLayout(buttonsLayout, row, 0, 1, 2);
+
+    _mainGridLayout->setColumnMinimumWidth(0, 100);
+    _mainGridLayout->setColumnStretch(1, 2);
+    this->setLayout(_mainGridLayout);
+}
+
+void Dialog::setInputsEnabled(bool enabled)
+{
+    _filenameEdit->setEnabled(enabled);
+    _filenameSelectionButton->setEnabled(enabled);
+    _formatComboBox->setEnabled(enabled);
+    _compressCheckbox->setEnabled(enabled);
+    _loadedRowsRadio->setEnabled(enabled && !_data->hasRowWindows());
+    _allRowsRadio->setEnabled(enabled && !_wholeQuerySQL.isEmpty());
+    _exportButton->setEnabled(enabled);
+    if (enabled) {
+        validateControls();
+    } else {
+        _includeHeaderCheckbox->setEnabled(false);
+        _tableNameEdit->setEnabled(false);
+        _rowsPerInsertSpinBox->setEnabled(false);
+    }
+}
+
+void Dialog::validateControls()
+{
+    const FormatItem & item = FORMATS[_formatComboBox->currentIndex()];
+    bool isCSV = item.format == GridExportFormat::CSV;
+    bool isSQL = item.format == GridExportFormat::SQLInserts;
+
+    _includeHeaderCheckbox->setEnabled(isCSV);
+    _tableNameEdit->setEnabled(isSQL);
+    _rowsPerInsertSpinBox->setEnabled(isSQL);
+}
+
+QString Dialog::fileExtension() const
+{
+    QString extension = FORMATS[_formatComboBox->currentIndex()].extension;
+    if (_compressCheckbox->isChecked()) {
+        extension += ".gz";
+    }
+    return extension;
+}
+
+void Dialog::onFilenameSelectionButtonClicked()
+{
+    QString extension = fileExtension();
+
+    QString fileName = QFileDialog::getSaveFileName(
+        this,
+        tr("Select file"),
+        _filenameEdit->text(),
+        tr("%1 files (*.%2);;All files (*)")
+            .arg(_formatComboBox->currentText()).arg(extension));
+
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    if (QFileInfo(fileName).suffix().isEmpty()) {
+        fileName += "." + extension;
+    }
+
+    _filenameEdit->setText(QDir::toNativeSeparators(fileName));
+}
+
+void Dialog::onFormatChanged()
+{
+    validateControls();
+
+    // keep the name, fix extension
+    QString fileName = _filenameEdit->text();
+    if (fileName.isEmpty()) {
+        return;
+    }
+    QFileInfo fileInfo(fileName);
+    QString baseName = fileInfo.fileName().section('.', 0, 0);
+    if (baseName.isEmpty()) {
+        return;
+    }
+    _filenameEdit->setText(QDir::toNativeSeparators(
+        fileInfo.dir().filePath(baseName + "." + fileExtension())));
+}
+
+void Dialog::onCancel()
+{
+    if (!_exporter || _exporter->cancel() == false) {
+        // close if was not running
+        reject();
+    }
+}
+
+void Dialog::onExport()
+{
+    if (_filenameEdit->text().isEmpty()) {
+        onFilenameSelectionButtonClicked();
+        if (_filenameEdit->text().isEmpty()) {
+            return;
+        }
+    }
+
+    const FormatItem & item = FORMATS[_formatComboBox->currentIndex()];
+
+    utils::exporting::GridExportSettings settings;
+    settings.fileName = _filenameEdit->text();
+    settings.format = item.format;
+    settings.delimiter = item.delimiter;
+    settings.wholeQuery = _allRowsRadio->isChecked();
+    settings.compress = _compressCheckbox->isChecked();
+    settings.includeHeader = _includeHeaderCheckbox->isChecked();
+    settings.rowsPerInsert = _rowsPerInsertSpinBox->value();
+    settings.quotedTable = _tableNameEdit->text();
+
+    _exporter.reset(new utils::exporting::GridExporter(
+                        _data, _wholeQuerySQL, settings));
+
+    connect(_exporter.get(),
+            &utils::exporting::GridExporter::finished,
+            this,
+            &Dialog::exportFinished);
+
+    connect(_exporter.get(),
+            &utils::exporting::GridExporter::progressMessage,
+            this,
+            &Dialog::appendToResults);
+
+    connect(_exporter.get(),
+            &utils::exporting::GridExporter::progress,
+            this,
+            &Dialog::onProgress);
+
+    setInputsEnabled(false);
+    _results->clear();
+    _progressBar->setRange(0, settings.wholeQuery ? 0 : 1000); // 0: busy
+    _progressBar->setValue(0);
+
+    _exporter->start();
+}
+
+void Dialog::onProgress(qint64 rowsDone, qint64 rowsTotal)
+{
+    if (rowsTotal > 0) {
+        _progressBar->setValue(static_cast<int>(
+            rowsDone * _progressBar->maximum() / rowsTotal));
+    }
+}
+
+void Dialog::exportFinished(bool success)
+{
+    _progressBar->setRange(0, 1000);
+    _progressBar->setValue(success ? 1000 : 0);
+
+    if (success == false) {
+        QMessageBox msgBox;
+        msgBox.setText(tr("Export failed.\nSee messages for details."));
+        msgBox.setStandardButtons(QMessageBox::Ok);
+        msgBox.setDefaultButton(QMessageBox::Ok);
+        msgBox.setIcon(QMessageBox::Critical);
+        msgBox.exec();
+    }
+    setInputsEnabled(true);
+}
+
+void Dialog::appendToResults(const QString & str)
+{
+    _results->insertPlainText(str);
+    _results->moveCursor(QTextCursor::End);
+}
+
+} // namespace export_grid
+} // namespace ui
+} // namespace meow
@@ -0,0 +1,74 @@
+#ifndef UI_EXPORT_GRID_EXPORT_DIALOG_H
+#define UI_EXPORT_GRID_EXPORT_DIALOG_H
+
+#include <memory>
+#include <QtWidgets>
+#include "db/query_data.h"
+
+namespace meow {
+
+namespace utils {
+namespace exporting {
+    class GridExporter;
+}
+}
+
+namespace ui {
+namespace export_grid {
+
+class Dialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    // wholeQuerySQL selects all rows of grid, empty if not available;
+    // tableName is a target of INSERTs
+    Dialog(const db::QueryDataPtr & data,
+           const QString & wholeQuerySQL,
+           const QString & tableName);
+    ~Dialog() override;
+
+private:
+
+    void createWidgets();
+    void setInputsEnabled(bool enabled);
+    void validateControls();
+    QString fileExtension() const;
+
+    Q_SLOT void onFilenameSelectionButtonClicked();
+    Q_SLOT void onFormatChanged();
+    Q_SLOT void onCancel();
+    Q_SLOT void onExport();
+    Q_SLOT void onProgress(qint64 rowsDone, qint64 rowsTotal);
+    Q_SLOT void exportFinished(bool success);
+
+    void appendToResults(const QString & str);
+
+    db::QueryDataPtr _data;
+    const QString _wholeQuerySQL;
+    std::unique_ptr<utils::exporting::GridExporter> _exporter;
+
+    QGridLayout * _mainGridLayout;
+
+    QLineEdit * _filenameEdit;
+    QPushButton * _filenameSelectionButton;
+    QComboBox * _formatComboBox;
+    QCheckBox * _compressCheckbox;
+    QRadioButton * _loadedRowsRadio;
+    QRadioButton * _allRowsRadio;
+    QCheckBox * _includeHeaderCheckbox;
+    QLineEdit * _tableNameEdit;
+    QSpinBox * _rowsPerInsertSpinBox;
+
+    QProgressBar * _progressBar;
+    QPlainTextEdit * _results;
+
+    QPushButton * _exportButton;
+    QPushButton * _cancelButton;
+};
+
+} // namespace export_grid
+} // namespace ui
+} // namespace meow
+
+#endif // UI_EXPORT_GRID_EXPORT_DIALOG_H
@@ -0,0 +1,268 @@
+#include "import_dialog.h"
+#include "db/entity/table_entity.h"
+#include "utils/importing/csv_importer.h"
+
+namespace meow {
+namespace ui {
+namespace import_csv {
+
+Dialog::Dialog(db::TableEntity * table)
+    : QDialog(nullptr, Qt::WindowCloseButtonHint)
+    , _table(table)
+{
+    setMinimumSize(320, 300);
+    setWindowTitle(tr("Import CSV file into %1").arg(table->name()));
+
+    createWidgets();
+
+    resize(700, 450);
+}
+
+Dialog::~Dialog()
+{
+
+}
+
+void Dialog::createWidgets()
+{
+    _mainGridLayout = new QGridLayout();
+    int row = 0;
+
+    // -------------------------------------------------------------------------
+
+    QLabel * filenameLabel = new QLabel(tr("Filename:"));
+    _mainGridLayout->addWidget(filenameLabel, row, 0);
+
+    _filenameEdit = new QLineEdit();
+    filenameLabel->setBuddy(_filenameEdit);
+    _filenameSelectionButton = new QPushButton(tr("..."));
+    _filenameSelectionButton->setMaximumWidth(40);
+    connect(_filenameSelectionButton, &QAbstractButton::clicked,
+            this, &Dialog::onFilenameSelectionButtonClicked);
+
+    QHBoxLayout * filenameLayout = new QHBoxLayout();
+    filenameLayout->addWidget(_filenameEdit, 1);
+    filenameLayout->addWidget(_filenameSelectionButton);
+    _mainGridLayout->addLayout(filenameLayout, row, 1);
+
+    row++;
+
+    // -------------------------------------------------------------------------
+
+    QLabel * formatLabel = new QLabel(tr("Format:"));
+    _mainGridLayout->addWidget(formatLabel, row, 0);
+
+    _delimiterComboBox = new QComboBox();
+    _delimiterComboBox->addItem(tr("Comma separated"), QChar(','));
+    _delimiterComboBox->addItem(tr("Semicolon separated"), QChar(';'));
+    _delimiterComboBox->addItem(tr("Tab separated"), QChar('\t'));
+    _delimiterComboBox->addItem(tr("Pipe separated"), QChar('|'));
+
+    _quoteComboBox = new QComboBox();
+    _quoteComboBox->addItem(tr("Quoted by \""), QChar('"'));
+    _quoteComboBox->addItem(tr("Quoted by '"), QChar('\''));
+    _quoteComboBox->addItem(tr("Not quoted"), QChar());
+
+    QHBoxLayout * formatLayout = new QHBoxLayout();
+    formatLayout->addWidget(_delimiterComboBox);
+    formatLayout->addWidget(_quoteComboBox);
+    formatLayout->addStretch(1);
+    _mainGridLayout->addLayout(formatLayout, row, 1);
+
+    row++;
+
+    // -------------------------------------------------------------------------
+
+    QLabel * valuesLabel = new QLabel(tr("Values:"));
+    _mainGridLayout->addWidget(valuesLabel, row, 0);
+
+    _hasHeaderCheckbox = new QCheckBox(tr("First row has column names"));
+    _hasHeaderCheckbox->setChecked(true);
+    _emptyIsNullCheckbox = new QCheckBox(tr("Empty unquoted value is NULL"));
+    _emptyIsNullCheckbox->setChecked(true);
+
+    QHBoxLayout * valuesLayout = new QHBoxLayout();
+    valuesLayout->addWidget(_hasHeaderCheckbox);
+    valuesLayout->addWidget(_emptyIsNullCheckbox);
+    valuesLayout->addStretch(1);
+    _mainGridLayout->addLayout(valuesLayout, row, 1);
+
+    row++;
+
+    // -------------------------------------------------------------------------
+
+    QLabel * loadingLabel = new QLabel(tr("Loading:"));
+    _mainGridLayout->addWidget(loadingLabel, row, 0);
+
+    _rowsPerBatchSpinBox = new QSpinBox();
+    _rowsPerBatchSpinBox->setRange(1, 1000000);
+    _rowsPerBatchSpinBox->setValue(10000);
+    _rowsPerBatchSpinBox->setSuffix(tr(" rows per batch"));
+    _stopOnErrorCheckbox = new QCheckBox(tr("Stop on error"));
+    _stopOnErrorCheckbox->setChecked(true);
+    _stopOnErrorCheckbox->setToolTip(
+        tr("Otherwise rows of failed batch are skipped"));
+
+    QHBoxLayout * loadingLayout = new QHBoxLayout();
+    loadingLayout->addWidget(_rowsPerBatchSpinBox);
+    loadingLayout->addWidget(_stopOnErrorCheckbox);
+    loadingLayout->addStretch(1);
+    _mainGridLayout->addLayout(loadingLayout, row, 1);
+
+    row++;
+
+    // -------------------------------------------------------------------------
+
+    _progressBar = new QProgressBar();
+    _progressBar->setRange(0, 1000);
+    _progressBar->setValue(0);
+    _progressBar->setTextVisible(false);
+    _mainGridLayout->addWidget(_progressBar, row, 0, 1, 2);
+
+    row++;
+
+    _results = new QPlainTextEdit;
+    _results->setReadOnly(true);
+    _mainGridLayout->addWidget(_results, row, 0, 1, 2);
+    _mainGridLayout->setRowStretch(row, 1);
+
+    row++;
+
+    // -------------------------------------------------------------------------
+
+    QHBoxLayout * buttonsLayout = new QHBoxLayout();
+    buttonsLayout->addStretch(1);
+
+    _importButton = new QPushButton(tr("Import"));
+    connect(_importButton, &QAbstractButton::clicked,
+            this, &Dialog::onImport);
+    buttonsLayout->addWidget(_importButton);
+
+    _cancelButton = new QPushButton(tr("Cancel"));
+    connect(_cancelButton, &QAbstractButton::clicked,
+            this, &Dialog::onCancel);
+    buttonsLayout->addWidget(_cancelButton);
+
+    _mainGridLayout->addLayout(buttonsLayout, row, 0, 1, 2);
+
+    _mainGridLayout->setColumnMinimumWidth(0, 100);
+    _mainGridLayout->setColumnStretch(1, 2);
+    this->setLayout(_mainGridLayout);
+}
+
+void Dialog::setInputsEnabled(bool enabled)
+{
+    _filenameEdit->setEnabled(enabled);
+    _filenameSelectionButton->setEnabled(enabled);
+    _delimiterComboBox->setEnabled(enabled);
+    _quoteComboBox->setEnabled(enabled);
+    _hasHeaderCheckbox->setEnabled(enabled);
+    _emptyIsNullCheckbox->setEnabled(enabled);
+    _rowsPerBatchSpinBox->setEnabled(enabled);
+    _stopOnErrorCheckbox->setEnabled(enabled);
+    _importButton->setEnabled(enabled);
+}
+
+void Dialog::onFilenameSelectionButtonClicked()
+{
+    QString fileName = QFileDialog::getOpenFileName(
+        this,
+        tr("Select CSV file"),
+        _filenameEdit->text(),
+        tr("CSV files (*.csv *.tsv *.txt);;All files (*)"));
+
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    _filenameEdit->setText(QDir::toNativeSeparators(fileName));
+
+    // guess by extension
+    if (fileName.endsWith(".tsv", Qt::CaseInsensitive)) {
+        _delimiterComboBox->setCurrentIndex(
+            _delimiterComboBox->findData(QChar('\t')));
+    }
+}
+
+void Dialog::onCancel()
+{
+    if (!_importer || _importer->cancel() == false) {
+        // close if was not running
+        reject();
+    }
+}
+
+void Dialog::onImport()
+{
+    if (_filenameEdit->text().isEmpty()) {
+        onFilenameSelectionButtonClicked();
+        if (_filenameEdit->text().isEmpty()) {
+            return;
+        }
+    }
+
+    utils::importing::CSVImportSettings settings;
+    settings.fileName = _filenameEdit->text();
+    settings.format.delimiter
+        = _delimiterComboBox->currentData().toChar().toLatin1();
+    settings.format.quote
+        = _quoteComboBox->currentData().toChar().toLatin1();
+    settings.hasHeader = _hasHeaderCheckbox->isChecked();
+    settings.emptyIsNull = _emptyIsNullCheckbox->isChecked();
+    settings.rowsPerBatch = _rowsPerBatchSpinBox->value();
+    settings.stopOnError = _stopOnErrorCheckbox->isChecked();
+
+    _importer.reset(new utils::importing::CSVImporter(_table, settings));
+
+    connect(_importer.get(),
+            &utils::importing::CSVImporter::finished,
+            this,
+            &Dialog::importFinished);
+
+    connect(_importer.get(),
+            &utils::importing::CSVImporter::progressMessage,
+            this,
+            &Dialog::appendToResults);
+
+    connect(_importer.get(),
+            &utils::importing::CSVImporter::progress,
+            this,
+            &Dialog::onProgress);
+
+    setInputsEnabled(false);
+    _results->clear();
+    _progressBar->setValue(0);
+
+    _importer->start();
+}
+
+void Dialog::onProgress(qint64 bytesDone, qint64 bytesTotal)
+{
+    if (bytesTotal > 0) {
+        _progressBar->setValue(static_cast<int>(
+            bytesDone * _progressBar->maximum() / bytesTotal));
+    }
+}
+
+void Dialog::importFinished(bool success)
+{
+    if (success == false) {
+        QMessageBox msgBox;
+        msgBox.setText(tr("Import failed.\nSee messages for details."));
+        msgBox.setStandardButtons(QMessageBox::Ok);
+        msgBox.setDefaultButton(QMessageBox::Ok);
+        msgBox.setIcon(QMessageBox::Critical);
+        msgBox.exec();
+    }
+    setInputsEnabled(true);
+}
+
+void Dialog::appendToResults(const QString & str)
+{
+    _results->insertPlainText(str);
+    _results->moveCursor(QTextCursor::End);
+}
+
+} // namespace import_csv
+} // namespace ui
+} // namespace meow
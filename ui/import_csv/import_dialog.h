@@ -0,0 +1,68 @@
+#ifndef UI_IMPORT_CSV_IMPORT_DIALOG_H
+#define UI_IMPORT_CSV_IMPORT_DIALOG_H
+
+#include <memory>
+#include <QtWidgets>
+
+namespace meow {
+
+namespace db {
+    class TableEntity;
+}
+
+namespace utils {
+namespace importing {
+    class CSVImporter;
+}
+}
+
+namespace ui {
+namespace import_csv {
+
+class Dialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit Dialog(db::TableEntity * table);
+    ~Dialog() override;
+
+private:
+
+    void createWidgets();
+    void setInputsEnabled(bool enabled);
+
+    Q_SLOT void onFilenameSelectionButtonClicked();
+    Q_SLOT void onCancel();
+    Q_SLOT void onImport();
+    Q_SLOT void onProgress(qint64 bytesDone, qint64 bytesTotal);
+    Q_SLOT void importFinished(bool success);
+
+    void appendToResults(const QString & str);
+
+    db::TableEntity * _table;
+    std::unique_ptr<utils::importing::CSVImporter> _importer;
+
+    QGridLayout * _mainGridLayout;
+
+    QLineEdit * _filenameEdit;
+    QPushButton * _filenameSelectionButton;
+    QComboBox * _delimiterComboBox;
+    QComboBox * _quoteComboBox;
+    QCheckBox * _hasHeaderCheckbox;
+    QCheckBox * _emptyIsNullCheckbox;
+    QSpinBox * _rowsPerBatchSpinBox;
+    QCheckBox * _stopOnErrorCheckbox;
+
+    QProgressBar * _progressBar;
+    QPlainTextEdit * _results;
+
+    QPushButton * _importButton;
+    QPushButton * _cancelButton;
+};
+
+} // namespace import_csv
+} // namespace ui
+} // namespace meow
+
+#endif // UI_IMPORT_CSV_IMPORT_DIALOG_H
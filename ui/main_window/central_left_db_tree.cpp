@@ -12,6 +12,8 @@
 
 #include "ui/export_database/export_dialog.h"
 #include "ui/presenters/export_database_form.h"
+#include "ui/import_csv/import_dialog.h"
+#include "db/entity/table_entity.h"
 
 namespace meow {
 namespace ui {
@@ -82,6 +84,10 @@ void DbTree::contextMenuEvent(QContextMenuEvent * event)
         menu.addAction(meow::app()->actions()->exportDatabase());
     }
 
+    if (currentItemSupportsImporting()) {
+        menu.addAction(meow::app()->actions()->importCSV());
+    }
+
 
     menu.addSeparator();
 
@@ -337,6 +343,24 @@ void DbTree::createActions()
         dialog.exec();
     });
 
+    // import ==================================================================
+
+    connect(meow::app()->actions()->importCSV(),
+            &QAction::triggered,
+            [=](bool checked)
+    {
+        Q_UNUSED(checked);
+        if (!currentItemSupportsImporting()) {
+            return;
+        }
+
+        auto table = static_cast<db::TableEntity *>(
+                    this->treeModel()->currentEntity());
+
+        meow::ui::import_csv::Dialog dialog(table);
+        dialog.exec();
+    });
+
     // refresh =================================================================
     _refreshAction = new QAction(QIcon(":/icons/arrow_refresh.png"),
                                  tr("Refresh"), this);
@@ -361,6 +385,19 @@ bool DbTree::currentItemSupportsDumping() const
     return false;
 }
 
+bool DbTree::currentItemSupportsImporting() const
+{
+    auto treeModel = this->treeModel();
+
+    db::Entity * currentEntity = treeModel->currentEntity();
+    if (currentEntity && currentEntity->type() == db::Entity::Type::Table) {
+        return currentEntity->connection()
+                ->features()->supportsEditingTablesData();
+    }
+
+    return false;
+}
+
 bool DbTree::currentItemSupportsEditing() const
 {
     auto treeModel = this->treeModel();
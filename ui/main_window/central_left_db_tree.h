@@ -27,6 +27,7 @@ private:
     void createActions();
 
     bool currentItemSupportsDumping() const;
+    bool currentItemSupportsImporting() const;
     bool currentItemSupportsEditing() const;
 
     models::EntitiesTreeModel * treeModel() const;
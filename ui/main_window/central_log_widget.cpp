@@ -27,9 +27,9 @@ void CentralLogWidget::createWidgets()
             &CentralLogWidget::onClearAction);
 }
 
-void CentralLogWidget::onLogMessage(const QString & msg)
+void CentralLogWidget::onLogMessages(const QStringList & messages)
 {
-    _logEditor->appendMessage(msg);
+    _logEditor->appendMessages(messages);
 }
 
 void CentralLogWidget::onClearAction(bool checked)
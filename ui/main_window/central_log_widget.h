@@ -19,7 +19,7 @@ class CentralLogWidget : public QWidget, public Log::ISink
 public:
     explicit CentralLogWidget(QWidget * parent = nullptr);
 
-    void onLogMessage(const QString & msg) override;
+    void onLogMessages(const QStringList & messages) override;
 
 private:
 
@@ -1,7 +1,10 @@
 #include "central_right_data_tab.h"
 #include "db/common.h"
 #include "app/app.h"
+#include "helpers/formatting.h"
 #include "ui/common/editable_data_table_view.h"
+#include "ui/export_grid/export_dialog.h"
+#include "db/entity/entity.h"
 
 namespace meow {
 namespace ui {
@@ -75,11 +78,28 @@ DataTab::DataTab(QWidget *parent) :
             this,
             &DataTab::onDataResetSortAction);
 
+    connect(meow::app()->actions()->dataExport(),
+            &QAction::triggered,
+            this,
+            &DataTab::onDataExportAction);
+
     connect(&_model, &models::DataTableModel::editingStarted,
             this, &DataTab::validateControls);
 
-    connect(&_model, &models::DataTableModel::dataRefreshed,
-            this, &DataTab::onDataRefreshed);
+    connect(&_model, &models::DataTableModel::loadingStarted,
+            this, &DataTab::onLoadingStarted);
+
+    connect(&_model, &models::DataTableModel::loadingProgress,
+            this, &DataTab::onLoadingProgress);
+
+    connect(&_model, &models::DataTableModel::loadingFinished,
+            this, &DataTab::onLoadingFinished);
+
+    connect(&_model, &models::DataTableModel::loadingFailed,
+            this, &DataTab::onLoadingFailed);
+
+    connect(&_model, &models::DataTableModel::loadingCancelled,
+            this, &DataTab::onLoadingCancelled);
 
     validateControls();
 }
@@ -153,6 +173,27 @@ void DataTab::createDataButtonsToolBar()
             this, &DataTab::onActionAllRows);
     _dataButtonsToolBar->addAction(_showAllRowsAction);
 
+    // Cancel loading
+    _cancelLoadingAction = new QAction(QIcon(":/icons/cancel.png"),
+                                       tr("Cancel"),
+                                       this);
+    _cancelLoadingAction->setToolTip(tr("Stop loading of data"));
+    connect(_cancelLoadingAction, &QAction::triggered,
+            this, &DataTab::onActionCancelLoading);
+    _dataButtonsToolBar->addAction(_cancelLoadingAction);
+
+    // Virtual scrolling
+    _virtualScrollingAction = new QAction(QIcon(":/icons/arrow_down.png"),
+                                          tr("Scroll all"),
+                                          this);
+    _virtualScrollingAction->setToolTip(
+        tr("Scroll through all rows, only visible ones are loaded "
+           "(read-only)"));
+    _virtualScrollingAction->setCheckable(true);
+    connect(_virtualScrollingAction, &QAction::triggered,
+            this, &DataTab::onActionVirtualScrolling);
+    _dataButtonsToolBar->addAction(_virtualScrollingAction);
+
     // Separator
     _dataButtonsToolBar->addSeparator();
 
@@ -185,10 +226,25 @@ void DataTab::createDataTable()
     _dataTable->setSelectionBehavior(
         QAbstractItemView::SelectionBehavior::SelectRows);
 
-    _dataTable->setModel(_model.createSortFilterModel());
+    setDataTableModel(_model.createSortFilterModel());
     _mainLayout->addWidget(_dataTable, 1);
     _dataTable->setSortingEnabled(false);
 
+    connect(_dataTable, &EditableDataTableView::visibleRowsChanged,
+            &_model, &models::DataTableModel::setViewport);
+
+    connect(this, &DataTab::changeRowSelection,
+            this, &DataTab::onChangeRowSelectionRequest,
+            Qt::QueuedConnection);
+}
+
+void DataTab::setDataTableModel(QAbstractItemModel * model)
+{
+    // view creates new selection model and leaves the old one to us
+    QItemSelectionModel * oldSelectionModel = _dataTable->selectionModel();
+    _dataTable->setModel(model);
+    delete oldSelectionModel;
+
     connectRowChanged();
 
     connect(_dataTable->selectionModel(),
@@ -207,10 +263,6 @@ void DataTab::createDataTable()
                 this->validateDataDeleteActionState();
             }
     );
-
-    connect(this, &DataTab::changeRowSelection,
-            this, &DataTab::onChangeRowSelectionRequest,
-            Qt::QueuedConnection);
 }
 
 void DataTab::onActionAllRows()
@@ -219,8 +271,6 @@ void DataTab::onActionAllRows()
     try {
         _model.setNoRowsCountLimit();
         _model.loadData(true);
-        refreshDataLabelText();
-        validateShowToolBarState();
     } catch(meow::db::Exception & ex) {
         errorDialog(ex.message());
     }
@@ -232,13 +282,39 @@ void DataTab::onActionNextRows()
         _model.incRowsCountForOneStep();
         _model.loadData(true);
         // TODO: select addition
-        refreshDataLabelText();
-        validateShowToolBarState();
     } catch(meow::db::Exception & ex) {
         errorDialog(ex.message());
     }
 }
 
+void DataTab::onActionCancelLoading()
+{
+    try {
+        _model.cancelLoading();
+    } catch(meow::db::Exception & ex) {
+        errorDialog(ex.message());
+    }
+}
+
+void DataTab::onActionVirtualScrolling(bool checked)
+{
+    applyModifications(); // close pending, rows are read-only there
+
+    try {
+        _model.setVirtualScrolling(checked);
+    } catch(meow::db::Exception & ex) {
+        errorDialog(ex.message());
+    }
+
+    if (checked) {
+        setDataTableModel(&_model);
+    } else {
+        setDataTableModel(_model.createSortFilterModel());
+    }
+
+    validateControls();
+}
+
 void DataTab::onActionShowFilter(bool checked)
 {
     // Listening: Moonspell - Alma Matter
@@ -277,17 +353,6 @@ void DataTab::onDataDuplicateRowWithKeys()
     duplicateCurrentRowWithKeys();
 }
 
-void DataTab::onDataRefreshed()
-{
-    // TODO: just call onLoadData() ?
-    if (meow::app()->settings()->textSettings()->autoResizeTableColumns()) {
-        _dataTable->resizeColumnsToContents();
-    }
-
-    refreshDataLabelText();
-    validateControls();
-}
-
 void DataTab::setDBEntity(db::Entity * tableOrViewEntity, bool loadData)
 {
     applyModifications(); // close pending to avoid crash
@@ -295,8 +360,8 @@ void DataTab::setDBEntity(db::Entity * tableOrViewEntity, bool loadData)
     _model.resetWhereFilter();
     _model.resetAllColumnsSort();
     _model.setEntity(tableOrViewEntity, loadData);
-    if (loadData) {
-        onLoadData();
+    if (!loadData) {
+        validateControls();
     }
     _dataFilter->setDBEntity(tableOrViewEntity);
 }
@@ -306,13 +371,15 @@ void DataTab::refresh()
     // TODO: catch db exception?
     applyModifications(); // close pending to avoid crash
     _model.refresh();
-    onLoadData();
 }
 
 void DataTab::loadData()
 {
-    _model.loadData();
-    onLoadData();
+    _model.loadData(); // onLoadingFinished() is called when (if) started
+    if (!_model.isLoading()) {
+        refreshDataLabelText();
+        validateControls();
+    }
 }
 
 void DataTab::invalidateData()
@@ -362,6 +429,41 @@ void DataTab::onLoadData()
     }
 }
 
+void DataTab::onLoadingStarted()
+{
+    _dataLabel->setText(tr("Loading data..."));
+    validateControls();
+}
+
+void DataTab::onLoadingProgress(int rowsReceived)
+{
+    _dataLabel->setText(tr("Loading data: %1 rows received...")
+                        .arg(meow::helpers::formatNumber(rowsReceived)));
+}
+
+void DataTab::onLoadingFinished(bool appended)
+{
+    if (appended) {
+        refreshDataLabelText();
+        validateShowToolBarState();
+    } else {
+        onLoadData();
+    }
+}
+
+void DataTab::onLoadingFailed(const QString & error)
+{
+    refreshDataLabelText();
+    validateControls();
+    errorDialog(error);
+}
+
+void DataTab::onLoadingCancelled()
+{
+    refreshDataLabelText();
+    validateControls();
+}
+
 void DataTab::refreshDataLabelText()
 {
     _dataLabel->setText(_model.rowCountStats());
@@ -388,8 +490,10 @@ void DataTab::disconnectRowChanged()
 
 void DataTab::validateShowToolBarState()
 {
-    _nextRowsAction->setDisabled(_model.allDataLoaded());
-    _showAllRowsAction->setDisabled(_model.allDataLoaded());
+    bool isLoading = _model.isLoading();
+    _nextRowsAction->setDisabled(isLoading || _model.allDataLoaded());
+    _showAllRowsAction->setDisabled(isLoading || _model.allDataLoaded());
+    _cancelLoadingAction->setVisible(isLoading);
 }
 
 void DataTab::validateDataToolBarState()
@@ -528,6 +632,19 @@ void DataTab::onDataResetSortAction()
     }
 }
 
+void DataTab::onDataExportAction()
+{
+    if (!_model.entity() || _model.isLoading()
+            || _model.queryData()->columnCount() == 0) {
+        return; // nothing to export or rows are changing
+    }
+
+    export_grid::Dialog dialog(_model.queryDataPtr(),
+                               _model.selectAllSQL(),
+                               db::quotedFullName(_model.entity()));
+    dialog.exec();
+}
+
 bool DataTab::applyModifications(int rowToApply)
 {
     if (_skipApplyModifications) return true;
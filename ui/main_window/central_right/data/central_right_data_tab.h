@@ -46,11 +46,21 @@ private:
 
     void onLoadData();
 
+    Q_SLOT void onLoadingStarted();
+    Q_SLOT void onLoadingProgress(int rowsReceived);
+    Q_SLOT void onLoadingFinished(bool appended);
+    Q_SLOT void onLoadingFailed(const QString & error);
+    Q_SLOT void onLoadingCancelled();
+
     Q_SLOT void onActionAllRows();
     Q_SLOT void onActionNextRows();
+    Q_SLOT void onActionCancelLoading();
+    Q_SLOT void onActionVirtualScrolling(bool checked);
     Q_SLOT void onActionShowFilter(bool checked);
 
     void createDataTable();
+    // view of proxy model or of data model when scrolling virtually
+    void setDataTableModel(QAbstractItemModel * model);
     void createTopPanel();
     void createDataButtonsToolBar();
     void createDataActionsToolBar();
@@ -69,6 +79,7 @@ private:
     Q_SLOT void onDataSetNULLAction(bool checked);
     Q_SLOT void onDataRefreshAction(bool checked);
     Q_SLOT void onDataResetSortAction();
+    Q_SLOT void onDataExportAction();
 
     Q_SLOT void onDataPostChanges(bool checked);
     Q_SLOT void onDataCancelChanges(bool checked);
@@ -76,7 +87,6 @@ private:
     Q_SLOT void onDataInsertRow();
     Q_SLOT void onDataDuplicateRowWithoutKeys();
     Q_SLOT void onDataDuplicateRowWithKeys();
-    Q_SLOT void onDataRefreshed();
 
     Q_SIGNAL void changeRowSelection(const QModelIndex &index);
     Q_SLOT void onChangeRowSelectionRequest(const QModelIndex &index);
@@ -113,6 +123,8 @@ private:
     QToolBar * _dataActionsToolBar;
     QAction * _nextRowsAction;
     QAction * _showAllRowsAction;
+    QAction * _cancelLoadingAction;
+    QAction * _virtualScrollingAction;
     QAction * _showFilterPanelAction;
     DataFilterWidget * _dataFilter;
     // bottom:
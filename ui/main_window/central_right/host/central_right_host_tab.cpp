@@ -40,6 +40,11 @@ void HostTab::createRootTabs()
     _rootTabs->addTab(_databasesTab,
                       QIcon(":/icons/database.png"),
                       _model.titleForDatabasesTab());
+
+    _statisticsTab = new HostStatisticsTab();
+    _rootTabs->addTab(_statisticsTab,
+                      QIcon(":/icons/time.png"),
+                      tr("Statistics"));
 }
 
 HostVariablesTab * HostTab::variablesTab()
@@ -92,6 +97,8 @@ void HostTab::onSessionChanged(meow::db::SessionEntity * session)
     _rootTabs->setTabText(static_cast<int>(Tabs::Databases),
                           _model.titleForDatabasesTab());
 
+    _statisticsTab->setSession(session);
+
     if (_model.showVariablesTab()) {
 
         variablesTab(); // create tab
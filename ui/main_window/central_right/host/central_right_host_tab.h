@@ -5,6 +5,7 @@
 #include "ui/main_window/central_right/base_root_tab.h"
 #include "cr_host_databases_tab.h"
 #include "cr_host_variables_tab.h"
+#include "cr_host_statistics_tab.h"
 #include "ui/presenters/central_right_host_widget_model.h"
 
 namespace meow {
@@ -42,6 +43,7 @@ private:
     QTabWidget  * _rootTabs;
     HostDatabasesTab * _databasesTab;
     HostVariablesTab * _variablesTab;
+    HostStatisticsTab * _statisticsTab; // always the last one
 
     presenters::CentralRightHostWidgetModel _model;
 
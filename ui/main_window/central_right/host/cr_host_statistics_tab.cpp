@@ -0,0 +1,104 @@
+#include "cr_host_statistics_tab.h"
+#include "app/app.h"
+#include "helpers/formatting.h"
+
+namespace meow {
+namespace ui {
+namespace main_window {
+namespace central_right {
+
+namespace {
+
+const int REFRESH_INTERVAL_MS = 1000;
+
+} // namespace
+
+HostStatisticsTab::HostStatisticsTab(QWidget *parent)
+    : QWidget(parent)
+{
+    _mainLayout = new QVBoxLayout();
+    _mainLayout->setContentsMargins(2, 2, 2, 2);
+    this->setLayout(_mainLayout);
+
+    createWidgets();
+
+    _refreshTimer.setInterval(REFRESH_INTERVAL_MS);
+    connect(&_refreshTimer, &QTimer::timeout,
+            this, &HostStatisticsTab::refresh);
+}
+
+void HostStatisticsTab::createWidgets()
+{
+    _summaryLabel = new QLabel();
+
+    _resetButton = new QPushButton(tr("Reset"));
+    connect(_resetButton, &QAbstractButton::clicked, [=]() {
+        _model.reset();
+        refreshSummary();
+    });
+
+    QHBoxLayout * summaryLayout = new QHBoxLayout();
+    summaryLayout->addWidget(_summaryLabel, 1);
+    summaryLayout->addWidget(_resetButton);
+    _mainLayout->addLayout(summaryLayout);
+
+    _statisticsTable = new QTableView();
+    _statisticsTable->verticalHeader()->hide();
+    _statisticsTable->horizontalHeader()->setHighlightSections(false);
+    auto geometrySettings = meow::app()->settings()->geometrySettings();
+    _statisticsTable->verticalHeader()->setDefaultSectionSize(
+       geometrySettings->tableViewDefaultRowHeight());
+
+    _statisticsTable->setModel(&_model);
+    _mainLayout->addWidget(_statisticsTable);
+    _statisticsTable->setSortingEnabled(false);
+    _statisticsTable->setSelectionBehavior(
+                QAbstractItemView::SelectionBehavior::SelectRows);
+    _statisticsTable->setSelectionMode(QAbstractItemView::SingleSelection);
+    for (int i=0; i<_model.columnCount(); ++i) {
+        _statisticsTable->setColumnWidth(i, _model.columnWidth(i));
+    }
+}
+
+void HostStatisticsTab::setSession(meow::db::SessionEntity * session)
+{
+    _model.setSession(session);
+    refreshSummary();
+}
+
+void HostStatisticsTab::refresh()
+{
+    _model.refresh();
+    refreshSummary();
+}
+
+void HostStatisticsTab::refreshSummary()
+{
+    const auto & snapshot = _model.snapshot();
+
+    _summaryLabel->setText(
+        tr("Queries: %1, rows: %2, since %3")
+            .arg(helpers::formatNumber(snapshot.queryCount))
+            .arg(helpers::formatNumber(snapshot.total.rows))
+            .arg(snapshot.since.isValid()
+                 ? helpers::formatDateTime(snapshot.since)
+                 : QString("-")));
+}
+
+void HostStatisticsTab::showEvent(QShowEvent * event)
+{
+    QWidget::showEvent(event);
+    refresh();
+    _refreshTimer.start();
+}
+
+void HostStatisticsTab::hideEvent(QHideEvent * event)
+{
+    QWidget::hideEvent(event);
+    _refreshTimer.stop();
+}
+
+} // namespace central_right
+} // namespace main_window
+} // namespace ui
+} // namespace meow
@@ -0,0 +1,43 @@
+#ifndef UI_CR_HOST_STATISTICS_TAB_H
+#define UI_CR_HOST_STATISTICS_TAB_H
+
+#include <QtWidgets>
+#include "ui/models/query_statistics_table_model.h"
+
+namespace meow {
+namespace ui {
+namespace main_window {
+namespace central_right {
+
+// Intent: shows where time of session's queries goes
+class HostStatisticsTab : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit HostStatisticsTab(QWidget *parent = nullptr);
+    void setSession(meow::db::SessionEntity * session);
+
+private:
+
+    void createWidgets();
+    void refresh();
+    void refreshSummary();
+
+    void showEvent(QShowEvent * event) override;
+    void hideEvent(QHideEvent * event) override;
+
+    models::QueryStatisticsTableModel _model;
+    QTimer _refreshTimer; // runs while visible only
+
+    QVBoxLayout * _mainLayout;
+    QLabel * _summaryLabel;
+    QPushButton * _resetButton;
+    QTableView * _statisticsTable;
+};
+
+} // namespace central_right
+} // namespace main_window
+} // namespace ui
+} // namespace meow
+
+#endif // UI_CR_HOST_STATISTICS_TAB_H
@@ -20,6 +20,9 @@ QueryTab::QueryTab(db::UserQuery * query, QWidget *parent) :
     connect(_presenter.query(), &db::UserQuery::queryFinished,
             this, &QueryTab::onExecQueryFinished);
 
+    connect(_presenter.query(), &db::UserQuery::fileProgress,
+            this, &QueryTab::onExecFileProgress);
+
     connect(_presenter.query(), &db::UserQuery::newQueryDataResult,
             this, &QueryTab::onExecQueryDataResult);
 
@@ -79,6 +82,17 @@ void QueryTab::createWidgets()
     connect(_queryPanel, &QueryPanel::cancelQueryRequested,
             this, &QueryTab::onActionCancelQuery);
 
+    connect(_queryPanel, &QueryPanel::execFileRequested,
+            this, &QueryTab::onActionExecFile);
+
+    _queryPanel->runInParallelAction()->setChecked(
+                _presenter.isRunInParallel());
+    connect(_queryPanel, &QueryPanel::runInParallelToggled,
+            [=](bool parallel) {
+                _presenter.setRunInParallel(parallel);
+            }
+    );
+
     _queryResult = new QueryResult(&_presenter);
     _queryResult->setMinimumHeight(80);
     _mainVerticalSplitter->addWidget(_queryResult);
@@ -98,6 +112,10 @@ void QueryTab::validateControls()
                 _presenter.isExecCurrentQueryActionEnabled());
     _queryPanel->cancelQueryAction()->setEnabled(
                 _presenter.isCancelQueryActionEnabled());
+    _queryPanel->execFileAction()->setEnabled(
+                _presenter.isExecFileActionEnabled());
+    _queryPanel->runInParallelAction()->setEnabled(
+                _presenter.isRunInParallelActionEnabled());
 }
 
 void QueryTab::onActionExecQuery()
@@ -126,8 +144,38 @@ void QueryTab::onActionCancelQuery()
     }
 }
 
+void QueryTab::onActionExecFile()
+{
+    QFileDialog dialog(this);
+    dialog.setWindowTitle(tr("Run SQL file"));
+    dialog.setFileMode(QFileDialog::ExistingFile);
+    dialog.setNameFilter(tr("SQL files (*.sql);;All files (*.*)"));
+
+    if (dialog.exec()) {
+        QStringList fileNames = dialog.selectedFiles();
+        if (fileNames.isEmpty() == false) {
+            beforeRunQueries();
+            _presenter.execFile(fileNames.first());
+            onExecFileProgress();
+        }
+    }
+}
+
+void QueryTab::onExecFileProgress()
+{
+    _queryResult->showStatus(_presenter.fileProgressText());
+}
+
 void QueryTab::onExecQueriesFinished()
 {
+    if (_presenter.isFileRun()) {
+        onExecFileProgress();
+        if (_presenter.canResumeFile()) {
+            askResumeFile();
+            return;
+        }
+    }
+
     if (_presenter.hasError()) {
         QMessageBox msgBox;
         msgBox.setText(_presenter.lastError());
@@ -138,6 +186,28 @@ void QueryTab::onExecQueriesFinished()
     }
 }
 
+void QueryTab::askResumeFile()
+{
+    QMessageBox msgBox;
+    msgBox.setText(tr("Statement #%1 failed:")
+                   .arg(_presenter.fileFailedStatementNumber()));
+    msgBox.setInformativeText(_presenter.lastError() + "\n\n"
+        + tr("Retry it, skip it and go on with the next one, or stop?"));
+    msgBox.setStandardButtons(QMessageBox::Retry
+                              | QMessageBox::Ignore
+                              | QMessageBox::Abort);
+    msgBox.setDefaultButton(QMessageBox::Abort);
+    msgBox.setIcon(QMessageBox::Critical);
+
+    int result = msgBox.exec();
+
+    if (result == QMessageBox::Retry) {
+        _presenter.resumeFile(false);
+    } else if (result == QMessageBox::Ignore) {
+        _presenter.resumeFile(true);
+    }
+}
+
 void QueryTab::onExecQueryFinished(int queryIndex, int totalCount)
 {
     Q_UNUSED(queryIndex);
@@ -169,6 +239,7 @@ void QueryTab::onExecutionConnectionClosed()
 
 void QueryTab::beforeRunQueries()
 {
+    _queryResult->hideStatus();
     _queryResult->hideAllQueriesData();
 }
 
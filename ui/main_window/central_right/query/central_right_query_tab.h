@@ -34,6 +34,8 @@ private:
     Q_SLOT void onActionExecQuery();
     Q_SLOT void onActionExecCurrentQuery(int charPosition);
     Q_SLOT void onActionCancelQuery();
+    Q_SLOT void onActionExecFile();
+    Q_SLOT void onExecFileProgress();
     Q_SLOT void onExecQueriesFinished();
     Q_SLOT void onExecQueryFinished(int queryIndex, int totalCount);
     Q_SLOT void onExecQueryDataResult(int queryIndex);
@@ -41,6 +43,7 @@ private:
     Q_SLOT void onExecutionConnectionClosed();
 
     void beforeRunQueries();
+    void askResumeFile();
 
     QHBoxLayout * _mainLayout;
     QSplitter * _mainVerticalSplitter;
@@ -1,5 +1,7 @@
 #include "cr_query_data_tab.h"
 #include "app/app.h"
+#include "db/entity/entity.h"
+#include "ui/export_grid/export_dialog.h"
 
 namespace meow {
 namespace ui {
@@ -27,6 +29,8 @@ QueryDataTab::QueryDataTab(db::QueryDataPtr queryData, QWidget *parent)
         meow::app()->settings()->textSettings()->tableAutoResizeRowsLookupCount()
     );
 
+    db::LapTimer timer;
+
     _dataTable->setModel(&_model);
     mainLayout->addWidget(_dataTable);
     _dataTable->setSortingEnabled(false); // TODO
@@ -34,6 +38,19 @@ QueryDataTab::QueryDataTab(db::QueryDataPtr queryData, QWidget *parent)
     if (meow::app()->settings()->textSettings()->autoResizeTableColumns()) {
         _dataTable->resizeColumnsToContents();
     }
+
+    if (queryData->query()) {
+        db::QueryTimings timings;
+        timings.modelPopulate = timer.lap();
+        queryData->query()->addTimings(timings);
+    }
+
+    QAction * exportAction = new QAction(
+                QIcon(":/icons/table_save.png"),
+                tr("Export grid rows..."), _dataTable);
+    connect(exportAction, &QAction::triggered, this, &QueryDataTab::onExport);
+    _dataTable->addAction(exportAction);
+    _dataTable->setContextMenuPolicy(Qt::ActionsContextMenu);
 }
 
 QueryDataTab::~QueryDataTab()
@@ -41,6 +58,29 @@ QueryDataTab::~QueryDataTab()
 
 }
 
+void QueryDataTab::onExport()
+{
+    db::QueryData * queryData = _model.queryData();
+    db::Query * query = queryData->query();
+    if (query == nullptr || queryData->columnCount() == 0) {
+        return;
+    }
+
+    // a statement of several results (e.g. CALL) can't give one of them
+    QString wholeQuerySQL = (query->resultCount() == 1) ? query->SQL()
+                                                        : QString();
+
+    db::Entity * entity = queryData->currentResult()->entity();
+    QString tableName = entity
+            ? db::quotedFullName(entity)
+            : query->connection()->quoteIdentifier("query_result");
+
+    export_grid::Dialog dialog(_model.queryDataPtr(),
+                               wholeQuerySQL,
+                               tableName);
+    dialog.exec();
+}
+
 } // namespace central_right
 } // namespace main_window
 } // namespace ui
@@ -17,6 +17,8 @@ public:
     explicit QueryDataTab(db::QueryDataPtr queryData, QWidget *parent = 0);
     virtual ~QueryDataTab();
 private:
+    void onExport();
+
     models::BaseDataTableModel _model;
     TableView  * _dataTable;
 };
@@ -1,6 +1,7 @@
 #include "cr_query_panel.h"
 #include "central_right_query_tab.h"
 #include "ui/common/sql_editor.h"
+#include "db/common.h"
 
 namespace meow {
 namespace ui {
@@ -75,8 +76,31 @@ void QueryPanel::createToolBar()
             this, &QueryPanel::cancelQueryRequested);
 
 
+    _execFileAction = new QAction(QIcon(":/icons/script_go.png"),
+                                  tr("Run SQL file..."), this);
+    _execFileAction->setToolTip(tr("Run SQL file without loading it"));
+    _execFileAction->setStatusTip(
+        tr("Execute SQL file of any size statement by statement"));
+    connect(_execFileAction, &QAction::triggered,
+            this, &QueryPanel::execFileRequested);
+
+
+    _runInParallelAction = new QAction(QIcon(":/icons/lightning.png"),
+                                       tr("Run queries in parallel"), this);
+    _runInParallelAction->setToolTip(
+        tr("Run independent queries over %1 connections at once")
+            .arg(meow::db::PARALLEL_QUERIES_CONNECTIONS));
+    _runInParallelAction->setStatusTip(
+        tr("Queries must not depend on each other or on session state"));
+    _runInParallelAction->setCheckable(true);
+    connect(_runInParallelAction, &QAction::toggled,
+            this, &QueryPanel::runInParallelToggled);
+
+
     _toolBar->addAction(_execQueryAction);
     _toolBar->addAction(_cancelQueryAction);
+    _toolBar->addAction(_execFileAction);
+    _toolBar->addAction(_runInParallelAction);
 
     // TODO: add _execCurrentQueryAction to toolbar
 
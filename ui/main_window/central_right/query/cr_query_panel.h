@@ -27,6 +27,8 @@ public:
     Q_SIGNAL void execQueryRequested();
     Q_SIGNAL void execCurrentQueryRequested(int charPosition);
     Q_SIGNAL void cancelQueryRequested();
+    Q_SIGNAL void execFileRequested();
+    Q_SIGNAL void runInParallelToggled(bool parallel);
     
     QAction * execQueryAction() const {
         return _execQueryAction;
@@ -37,6 +39,12 @@ public:
     QAction * cancelQueryAction() const {
         return _cancelQueryAction;
     }
+    QAction * execFileAction() const {
+        return _execFileAction;
+    }
+    QAction * runInParallelAction() const {
+        return _runInParallelAction;
+    }
 
 private:
 
@@ -55,6 +63,8 @@ private:
     QAction * _execQueryAction;
     QAction * _execCurrentQueryAction;
     QAction * _cancelQueryAction;
+    QAction * _execFileAction;
+    QAction * _runInParallelAction;
     QAction * _separatorAction;
 };
 
@@ -18,6 +18,12 @@ QueryResult::QueryResult(presenters::CentralRightQueryPresenter * presenter,
     layout->setContentsMargins(0,0,0,0);
     this->setLayout(layout);
 
+    _statusLabel = new QLabel();
+    _statusLabel->setContentsMargins(4, 4, 4, 4);
+    _statusLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+    _statusLabel->hide();
+    layout->addWidget(_statusLabel);
+
     _dataTabs = new QTabWidget();
     layout->addWidget(_dataTabs);
 
@@ -58,6 +64,17 @@ void QueryResult::showQueryData(int queryResultIndex)
     _dataTabs->addTab(dataTab, _presenter->resultTabCaption(queryResultIndex));
 }
 
+void QueryResult::showStatus(const QString & text)
+{
+    _statusLabel->setText(text);
+    _statusLabel->show();
+}
+
+void QueryResult::hideStatus()
+{
+    _statusLabel->hide();
+}
+
 void QueryResult::removeAllDataTabs()
 {
     for (int i=0; i < _dataTabs->count(); ++i) {
@@ -27,12 +27,16 @@ public:
 
     void showQueryData(int queryResultIndex);
 
+    void showStatus(const QString & text);
+    void hideStatus();
+
 private:
 
     void removeAllDataTabs();
 
     presenters::CentralRightQueryPresenter * _presenter;
 
+    QLabel * _statusLabel;
     QTabWidget  * _dataTabs;
 };
 
@@ -477,6 +477,10 @@ central_right::DataTab * CentralRightWidget::dataTab()
         connect(_dataTab->model(), &QAbstractItemModel::rowsRemoved,
                 this, &CentralRightWidget::onDataTabDataChanged);
 
+        // quick filter is applied with a delay
+        connect(_dataTab->model(), &models::DataTableModel::criteriaApplied,
+                this, &CentralRightWidget::onDataTabDataChanged);
+
         _rootTabs->insertTab(_model.indexForDataTab(),
                              _dataTab,
                              QIcon(":/icons/data.png"),
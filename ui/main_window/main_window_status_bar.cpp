@@ -1,11 +1,23 @@
 #include "main_window_status_bar.h"
 #include "app/app.h"
+#include "db/connection.h"
+#include "helpers/formatting.h"
 
 namespace meow {
 namespace ui {
 namespace main_window {
 
-StatusBar::StatusBar(QWidget *parent) : QStatusBar(parent)
+namespace {
+
+// how often the label checks for new statistics
+const int QUERY_TIMINGS_REFRESH_MS = 500;
+
+} // namespace
+
+StatusBar::StatusBar(QWidget *parent)
+    : QStatusBar(parent)
+    , _queryTimingsConnection(nullptr)
+    , _queryTimingsVersion(0)
 {
 
     auto settings = meow::app()->settings()->geometrySettings();
@@ -28,9 +40,18 @@ StatusBar::StatusBar(QWidget *parent) : QStatusBar(parent)
     //_toggleLogButton->setMinimumHeight(20); // cut on win
     // TODO: style it (no radius etc)
 
+    _queryTimingsLabel = new QLabel();
+
+    this->addPermanentWidget(_queryTimingsLabel);
     this->addPermanentWidget(_toggleShowFilterButton);
     this->addPermanentWidget(_toggleLogButton);
 
+    // statistics are written by connection threads without signals
+    _queryTimingsTimer.setInterval(QUERY_TIMINGS_REFRESH_MS);
+    connect(&_queryTimingsTimer, &QTimer::timeout,
+            this, &StatusBar::refreshQueryTimings);
+    _queryTimingsTimer.start();
+
     _toggleShowFilterButton->setChecked(settings->showFilterPanel());
     _toggleLogButton->setChecked(settings->showSQLLog());
 
@@ -56,6 +77,56 @@ StatusBar::StatusBar(QWidget *parent) : QStatusBar(parent)
     );
 }
 
+void StatusBar::refreshQueryTimings()
+{
+    db::Connection * connection
+        = meow::app()->dbConnectionsManager()->activeConnection();
+
+    if (connection == nullptr) {
+        _queryTimingsConnection = nullptr;
+        _queryTimingsLabel->clear();
+        _queryTimingsLabel->setToolTip(QString());
+        return;
+    }
+
+    db::QueryStatistics * statistics = connection->queryStatistics();
+    if (_queryTimingsConnection == connection
+            && _queryTimingsVersion == statistics->version()) {
+        return;
+    }
+    _queryTimingsConnection = connection;
+    _queryTimingsVersion = statistics->version();
+
+    db::QueryStatistics::Snapshot snapshot = statistics->snapshot();
+    if (snapshot.queryCount == 0) {
+        _queryTimingsLabel->clear();
+        _queryTimingsLabel->setToolTip(QString());
+        return;
+    }
+
+    const db::QueryTimings & last = snapshot.last;
+
+    _queryTimingsLabel->setText(
+        tr("Last query: %1 ms").arg(
+            helpers::formatAsMilliseconds(last.total())));
+
+    _queryTimingsLabel->setToolTip(
+        tr("Server execution: %1 ms\n"
+           "First row: %2 ms\n"
+           "Transfer: %3 ms\n"
+           "Decoding: %4 ms\n"
+           "Editable copy: %5 ms\n"
+           "Grid population: %6 ms\n"
+           "Rows: %7")
+        .arg(helpers::formatAsMilliseconds(last.exec))
+        .arg(helpers::formatAsMilliseconds(last.firstByte))
+        .arg(helpers::formatAsMilliseconds(last.fetch))
+        .arg(helpers::formatAsMilliseconds(last.decode))
+        .arg(helpers::formatAsMilliseconds(last.editablePrepare))
+        .arg(helpers::formatAsMilliseconds(last.modelPopulate))
+        .arg(helpers::formatNumber(last.rows)));
+}
+
 } // namespace main_window
 } // namespace ui
 } // namespace meow
@@ -1,8 +1,11 @@
 #ifndef UI_MAIN_WINDOW_STATUS_BAR_H
 #define UI_MAIN_WINDOW_STATUS_BAR_H
 
+#include <cstdint>
 #include <QStatusBar>
 #include <QPushButton>
+#include <QLabel>
+#include <QTimer>
 
 namespace meow {
 namespace ui {
@@ -15,6 +18,15 @@ public:
     explicit StatusBar(QWidget *parent = nullptr);
 
 private:
+
+    // timings of the last query of active session
+    void refreshQueryTimings();
+
+    QLabel * _queryTimingsLabel;
+    QTimer _queryTimingsTimer;
+    const void * _queryTimingsConnection; // shown in label, compared only
+    uint64_t _queryTimingsVersion;
+
     QPushButton * _toggleShowFilterButton;
     QPushButton * _toggleLogButton;
 };
@@ -26,6 +26,8 @@ public:
             const QModelIndex &parent = QModelIndex()) const override;
 
     meow::db::QueryData * queryData() { return _queryData.get(); }
+    meow::db::QueryDataPtr queryDataPtr() const { return _queryData; }
+    const meow::db::QueryData * queryData() const { return _queryData.get(); }
 
     meow::db::DataTypeCategoryIndex typeCategoryForColumn(int column) const {
         return _queryData->columnDataTypeCategory(column);
@@ -10,11 +10,39 @@
 #include "db/entity/view_entity.h"
 #include <QColor>
 #include "app/app.h"
+#include "threads/db_thread.h"
+#include "threads/query_data_task.h"
+#include "threads/fetch_rows_task.h"
+#include "threads/helpers.h"
+#include <algorithm>
+#include <limits>
 
 namespace meow {
 namespace ui {
 namespace models {
 
+namespace {
+
+// pause in typing/clicking after which quick filter and sort are applied
+const int CRITERIA_DEBOUNCE_MS = 300;
+
+// ascending sort by primary key is the order of keyset paging
+bool sortsByKeys(const QVector<meow::db::QueryCriteria::SortColumn> & sort,
+                 const QList<meow::db::TableColumn *> & keyColumns)
+{
+    if (sort.isEmpty() || sort.size() != keyColumns.size()) {
+        return false;
+    }
+    for (int i = 0; i < sort.size(); ++i) {
+        if (!sort[i].isAsc || sort[i].columnName != keyColumns[i]->name()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
 DataTableModel::DataTableModel(QObject *parent)
     : BaseDataTableModel(
           meow::db::QueryDataPtr(new meow::db::QueryData()),
@@ -23,15 +51,29 @@ DataTableModel::DataTableModel(QObject *parent)
       _filterPatternIsRegexp(false),
       _entityChangedProcessed(false),
       _dbEntity(nullptr),
-      _wantedRowsCount(meow::db::DATA_MAX_ROWS)
+      _wantedRowsCount(meow::db::DATA_MAX_ROWS),
+      _loadingAppends(false),
+      _sortChanged(false),
+      _virtualScrolling(false),
+      _loadingWindow(-1),
+      _viewportFirstRow(0),
+      _viewportLastRow(0),
+      _scrollsDown(true),
+      _rowCountIsExact(false),
+      _windowsLoadingStopped(false)
 {
     QObject::connect(queryData(), &meow::db::QueryData::editingPrepared,
             this, &DataTableModel::editingStarted);
+
+    _criteriaTimer.setSingleShot(true);
+    _criteriaTimer.setInterval(CRITERIA_DEBOUNCE_MS);
+    connect(&_criteriaTimer, &QTimer::timeout,
+            this, &DataTableModel::applyCriteria);
 }
 
 DataTableModel::~DataTableModel()
 {
-
+    abandonLoading();
 }
 
 Qt::ItemFlags DataTableModel::flags(const QModelIndex &index) const
@@ -49,7 +91,7 @@ Qt::ItemFlags DataTableModel::flags(const QModelIndex &index) const
             _dbEntity->connection()->features()->supportsEditingTablesData();
     }
 
-    if (isEditable) {
+    if (isEditable && !_virtualScrolling) {
         flags |= Qt::ItemIsEditable; // TODO: read-only tables?
     }
 
@@ -146,9 +188,30 @@ QVariant DataTableModel::headerData(int section,
     return BaseDataTableModel::headerData(section, orientation, role);
 }
 
+bool DataTableModel::canFetchMore(const QModelIndex &parent) const
+{
+    if (parent.isValid()) {
+        return false;
+    }
+    return _fetchingTask == nullptr // rows of it are not appended yet
+            && _wantedRowsCount < meow::db::DATA_MAX_ROWS
+            && queryData()->canFetchMore();
+}
+
+void DataTableModel::fetchMore(const QModelIndex &parent)
+{
+    if (!canFetchMore(parent)) {
+        return;
+    }
+    // called by views when scrolled to the end
+    incRowsCountForOneStep();
+    fetchStreamedRows(_wantedRowsCount);
+}
+
 void DataTableModel::setEntity(meow::db::Entity * tableOrViewEntity,
                                bool loadData)
 {
+    abandonLoading();
     removeData();
 
     // Listening: As I Lay Dying - Defender
@@ -178,6 +241,17 @@ void DataTableModel::removeData()
     }
 
     queryData()->clearData();
+    _lastKeyValues.clear();
+
+    _rowWindows.clear();
+    _viewportFirstRow = 0;
+    _viewportLastRow = 0;
+    _rowCountIsExact = false;
+    _windowsLoadingStopped = false;
+
+    if (_sortFilterModel) {
+        _sortFilterModel->sort(-1); // new data comes sorted by server
+    }
 }
 
 void DataTableModel::loadData(bool force)
@@ -190,26 +264,53 @@ void DataTableModel::loadData(bool force)
         return;
     }
 
+    if (_virtualScrolling) {
+        _entityChangedProcessed = true;
+        if (force) {
+            _windowsLoadingStopped = false;
+        }
+        loadNextWindow();
+        return;
+    }
+
+    if (_entityChangedProcessed
+            && (_fetchingTask || queryData()->canFetchMore())) {
+        // rest of rows is on the way
+        if (_fetchingTask == nullptr) {
+            fetchStreamedRows(_wantedRowsCount);
+        }
+        return;
+    }
+
+    abandonLoading();
+
+    meow::db::Connection * connection = _dbEntity->connection();
+
     meow::db::QueryDataFetcher * queryDataFetcher =
-        _dbEntity->connection()->createQueryDataFetcher();
+        connection->createQueryDataFetcher();
 
     std::shared_ptr<meow::db::QueryDataFetcher> fetcher(queryDataFetcher);
 
     meow::db::ulonglong offset = 0;
-    int prevColCount = 0;
-    int prevRowCount = 0;
 
     if (_entityChangedProcessed) { // load from the same table/view
         offset = rowCount();
-        prevColCount = columnCount();
-        prevRowCount = rowCount();
     }
 
+    // Stream fresh data: the server sends rows up to max limit, but we
+    // receive only wanted count and the rest when (if) user asks
+    bool streamData = (offset == 0) && canStreamData();
+
     meow::db::QueryCriteria queryCritera;
     queryCritera.quotedDbAndTableName = meow::db::quotedFullName(_dbEntity);
-    queryCritera.where = _whereFilter;
-    queryCritera.limit = _wantedRowsCount - offset;
+    queryCritera.where = whereWithQuickFilter();
+    queryCritera.limit = streamData ? meow::db::DATA_MAX_ROWS
+                                    : _wantedRowsCount - offset;
     queryCritera.offset = offset;
+    queryCritera.streamResult = streamData;
+    // streamed rows come as text, MySQL result types them on receiving
+    queryCritera.typedResult = !streamData
+            && connection->features()->supportsTypedResults();
 
     auto textSettings = meow::app()->settings()->textSettings();
     bool limitDataLoadLen = textSettings->autoLimitLoadDataLength();
@@ -221,43 +322,192 @@ void DataTableModel::loadData(bool force)
         }
     }
 
-    if (!_columnsSort.empty()) {
+    appendSortColumns(&queryCritera);
 
-        QStringList columnNames;
+    QList<meow::db::TableColumn *> keyColumns;
+    if (_dbEntity->type() == meow::db::Entity::Type::Table) {
+        auto table = static_cast<meow::db::TableEntity *>(_dbEntity);
+        keyColumns = queryDataFetcher->keysetColumns(table);
+    }
 
-        if (_dbEntity->type() == meow::db::Entity::Type::Table) {
-            auto table = static_cast<meow::db::TableEntity *>(_dbEntity);
-            columnNames = table->structure()->columnNames();
-        } else if (_dbEntity->type() == meow::db::Entity::Type::View) {
-            auto view = static_cast<meow::db::ViewEntity *>(_dbEntity);
-            columnNames = view->structure()->columnNames();
+    // Page by primary key: WHERE pk > last seen costs the same for any page.
+    // Streamed first page is ordered by it too (the order of InnoDB's
+    // clustered index), so pages after abandoned stream seek by key.
+    // Next pages keep the order of the first one
+    bool keyOrder = queryCritera.sortColumns.isEmpty()
+            || sortsByKeys(queryCritera.sortColumns, keyColumns);
+    bool keysetPaging = (offset == 0)
+            ? keyOrder
+            : !_keysetColumnNames.isEmpty();
+
+    if (keysetPaging) {
+        for (auto column : keyColumns) {
+            db::QueryCriteria::KeyColumn keyColumn;
+            keyColumn.columnName = column->name();
+            keyColumn.isNumeric = column->dataType()->categoryIndex
+                    == meow::db::DataTypeCategoryIndex::Integer;
+            queryCritera.keyColumns.push_back(keyColumn);
+        }
+    }
+
+    if (offset == 0) {
+        _keysetColumnNames.clear();
+        for (const auto & keyColumn : queryCritera.keyColumns) {
+            _keysetColumnNames << keyColumn.columnName;
+        }
+    } else {
+        if (_lastKeyValues.isEmpty()) { // last rows came from stream
+            rememberLastKeyValues(queryData()->query());
         }
+        if (!_lastKeyValues.isEmpty()
+                && _lastKeyValues.size() == queryCritera.keyColumns.size()) {
+            queryCritera.afterKeyValues = _lastKeyValues;
+        } // else offset is used
+    }
 
-        for (const SortColumn & sort : _columnsSort) {
+    // do ping in main thread to handle possible reconnection
+    connection->ping(true);
+    // get id before async query execution to allow
+    // KILL QUERY ID from another thread
+    connection->connectionIdOnServer();
+
+    threads::DbThread * thread = connection->thread();
+
+    // local ref: task may finish (and be released) right in postTask()
+    QStringList bindValues;
+    std::shared_ptr<threads::QueryDataTask> task
+        = thread->createQueryDataTask(
+            queryDataFetcher->selectSQL(
+                &queryCritera,
+                queryCritera.typedResult ? &bindValues : nullptr));
+    task->setStreamResult(streamData, _wantedRowsCount);
+    if (queryCritera.typedResult) {
+        task->setBindValues(bindValues);
+    }
 
-            int columnIndex = sort.columnIndex;
-            bool isAscending = (sort.sortOrder == Qt::AscendingOrder);
+    _loadingTask = task;
+    _loadingAppends = offset > 0;
+    _entityChangedProcessed = true;
 
-            if (columnIndex < columnNames.size()) {
+    connect(task.get(), &threads::ThreadTask::finished,
+            this, &DataTableModel::onLoadingTaskFinished); // before post!
 
-                db::QueryCriteria::SortColumn sort;
-                sort.columnName = columnNames[columnIndex];
-                sort.isAsc = isAscending;
+    connect(task.get(), &threads::QueryDataTask::rowsReceived,
+            this, &DataTableModel::loadingProgress);
 
-                queryCritera.sortColumns.push_back(sort);
-            }
+    emit loadingStarted();
+
+    thread->postTask(task);
+}
+
+void DataTableModel::appendSortColumns(
+        meow::db::QueryCriteria * criteria) const
+{
+    QStringList columnNames;
+
+    if (_dbEntity->type() == meow::db::Entity::Type::Table) {
+        auto table = static_cast<meow::db::TableEntity *>(_dbEntity);
+        columnNames = table->structure()->columnNames();
+    } else if (_dbEntity->type() == meow::db::Entity::Type::View) {
+        auto view = static_cast<meow::db::ViewEntity *>(_dbEntity);
+        columnNames = view->structure()->columnNames();
+    }
+
+    for (const SortColumn & sort : _columnsSort) {
+
+        int columnIndex = sort.columnIndex;
+        bool isAscending = (sort.sortOrder == Qt::AscendingOrder);
+
+        if (columnIndex < columnNames.size()) {
+
+            db::QueryCriteria::SortColumn sort;
+            sort.columnName = columnNames[columnIndex];
+            sort.isAsc = isAscending;
+
+            criteria->sortColumns.push_back(sort);
+        }
+    }
+
+    if (criteria->sortColumns.isEmpty()
+            || _dbEntity->type() != meow::db::Entity::Type::Table) {
+        return;
+    }
+
+    // Ties are ordered by primary key, else pages by offset may repeat or
+    // skip rows of equal values
+    auto table = static_cast<meow::db::TableEntity *>(_dbEntity);
+    std::unique_ptr<meow::db::QueryDataFetcher> fetcher(
+        _dbEntity->connection()->createQueryDataFetcher());
+
+    for (auto column : fetcher->keysetColumns(table)) {
+        bool isSorted = false;
+        for (const auto & sort : criteria->sortColumns) {
+            isSorted = isSorted || sort.columnName == column->name();
+        }
+        if (!isSorted) {
+            db::QueryCriteria::SortColumn sort;
+            sort.columnName = column->name();
+            criteria->sortColumns.push_back(sort);
+        }
+    }
+}
+
+QString DataTableModel::selectAllSQL() const
+{
+    if (!_dbEntity) {
+        return QString();
+    }
+
+    meow::db::Connection * connection = _dbEntity->connection();
+    std::unique_ptr<meow::db::QueryDataFetcher> fetcher(
+        connection->createQueryDataFetcher());
+
+    meow::db::QueryCriteria queryCritera; // no limit
+    queryCritera.quotedDbAndTableName = meow::db::quotedFullName(_dbEntity);
+    queryCritera.where = whereWithQuickFilter();
+    appendSortColumns(&queryCritera);
+
+    return fetcher->selectSQL(&queryCritera);
+}
+
+void DataTableModel::onLoadingTaskFinished()
+{
+    MEOW_ASSERT_MAIN_THREAD
+
+    if (!_loadingTask || sender() != _loadingTask.get()) {
+        return; // abandoned
+    }
+
+    std::shared_ptr<threads::QueryDataTask> task = _loadingTask;
+    _loadingTask.reset();
+    disconnect(task.get(), nullptr, this, nullptr);
+
+    if (task->isAborted() || task->isFailed()) {
+        if (!_loadingAppends) {
+            _entityChangedProcessed = false; // nothing is loaded, try again
         }
+        if (task->isAborted()) {
+            emit loadingCancelled();
+        } else {
+            emit loadingFailed(task->errorMessage());
+        }
+        return;
     }
 
+    int prevColCount = columnCount();
+    int prevRowCount = rowCount();
+
+    meow::db::LapTimer timer;
+
+    rememberLastKeyValues(task->query());
+
     if (queryData()->query() == nullptr) {
         queryData()->setQueryPtr( // TODO: what a shitty code?
             _dbEntity->connection()->createQuery()
         );
         queryData()->query()->setEntity(_dbEntity);
     }
-    queryDataFetcher->run(&queryCritera, queryData());
-
-    _entityChangedProcessed = true;
+    queryData()->query()->takeResults(task->query(), _loadingAppends);
 
     int newColumnCount = queryData()->columnCount();
 
@@ -278,11 +528,458 @@ void DataTableModel::loadData(bool force)
         setRowCount(newRowCount);
         endInsertRows();
     }
+
+    meow::db::QueryTimings timings;
+    timings.modelPopulate = timer.lap();
+    queryData()->query()->addTimings(timings);
+
+    emit loadingFinished(_loadingAppends);
+}
+
+void DataTableModel::rememberLastKeyValues(meow::db::Query * query)
+{
+    if (_keysetColumnNames.isEmpty() || query->recordCount() == 0) {
+        return;
+    }
+
+    query->seekRecNo(query->recordCount() - 1);
+
+    QStringList values;
+    for (const QString & columnName : _keysetColumnNames) {
+        if (!query->columnExists(columnName)) {
+            _lastKeyValues.clear(); // fallback to offset
+            return;
+        }
+        values << query->curRowColumn(query->indexOfColumn(columnName));
+    }
+    _lastKeyValues = values;
+}
+
+void DataTableModel::cancelLoading()
+{
+    // a fetching page is not cancelled: it is small and its rows are taken
+    // from the stream already
+    if (!_loadingTask) {
+        return;
+    }
+
+    _loadingTask->abort();
+
+    meow::db::Connection * connection = _dbEntity->connection();
+    if (connection->features()->supportsCancellingQuery()) {
+        // the task fails with "interrupted" error, we report it as cancel
+        connection->createQueryKiller()->run();
+    }
+}
+
+void DataTableModel::abandonLoading(bool killQuery)
+{
+    if (_fetchingTask) { // its rows go nowhere
+        disconnect(_fetchingTask.get(), nullptr, this, nullptr);
+        _fetchingTask->abort();
+        _fetchingTask.reset(); // DbThread keeps it until finished
+    }
+
+    if (!_loadingTask) {
+        return;
+    }
+
+    bool isRunning = _loadingTask->isStarted();
+
+    disconnect(_loadingTask.get(), nullptr, this, nullptr);
+    _loadingTask->abort();
+    _loadingTask.reset(); // DbThread keeps it until finished
+    _loadingWindow = -1;
+
+    meow::db::Connection * connection = _dbEntity->connection();
+    if (killQuery && isRunning
+            && connection->features()->supportsCancellingQuery()) {
+        // before next task is posted, so only the abandoned one is hit
+        connection->createQueryKiller()->run();
+    }
+}
+
+void DataTableModel::setVirtualScrolling(bool enabled)
+{
+    if (_virtualScrolling == enabled) {
+        return;
+    }
+
+    abandonLoading();
+    removeData();
+
+    _virtualScrolling = enabled;
+    queryData()->setRowWindows(enabled ? &_rowWindows : nullptr);
+
+    if (_sortFilterModel) {
+        // proxy maps every row, it's for loaded data only
+        _sortFilterModel->setSourceModel(enabled ? nullptr : this);
+    }
+
+    if (_dbEntity) {
+        loadData(true);
+    }
+}
+
+void DataTableModel::setViewport(int firstRow, int lastRow)
+{
+    if (!_virtualScrolling || firstRow < 0) {
+        return;
+    }
+
+    if (firstRow != _viewportFirstRow) {
+        _scrollsDown = firstRow > _viewportFirstRow;
+    }
+    _viewportFirstRow = firstRow;
+    _viewportLastRow = std::max(firstRow, lastRow);
+
+    cancelStaleWindowLoading();
+    loadNextWindow();
+}
+
+std::vector<int> DataTableModel::wantedWindows() const
+{
+    int firstWindow = _rowWindows.windowOfRow(_viewportFirstRow);
+    int lastWindow = _rowWindows.windowOfRow(_viewportLastRow);
+
+    std::vector<int> windows;
+    for (int window = firstWindow; window <= lastWindow; ++window) {
+        windows.push_back(window);
+    }
+    for (int i = 1; i <= meow::db::DATA_WINDOWS_PREFETCH; ++i) {
+        windows.push_back(_scrollsDown ? lastWindow + i : firstWindow - i);
+    }
+    windows.push_back(_scrollsDown ? firstWindow - 1 : lastWindow + 1);
+
+    int windowCount = (rowCount() > 0)
+            ? _rowWindows.windowOfRow(rowCount() - 1) + 1
+            : 0;
+    if (!_rowCountIsExact && windowCount == 0) {
+        windowCount = 1; // nothing is loaded yet
+    }
+
+    windows.erase(std::remove_if(windows.begin(), windows.end(),
+                                 [&](int window) {
+        return window < 0 || window >= windowCount
+                || _rowWindows.contains(window);
+    }), windows.end());
+
+    return windows;
+}
+
+void DataTableModel::loadNextWindow()
+{
+    if (!_virtualScrolling || _dbEntity == nullptr
+            || _loadingTask || _windowsLoadingStopped) {
+        return;
+    }
+
+    std::vector<int> windows = wantedWindows();
+    if (windows.empty()) {
+        return;
+    }
+    int window = windows.front();
+    bool isFirstWindow = queryData()->query() == nullptr;
+
+    meow::db::Connection * connection = _dbEntity->connection();
+    std::unique_ptr<meow::db::QueryDataFetcher> fetcher(
+        connection->createQueryDataFetcher());
+
+    meow::db::QueryCriteria queryCritera;
+    queryCritera.quotedDbAndTableName = meow::db::quotedFullName(_dbEntity);
+    queryCritera.where = whereWithQuickFilter();
+    queryCritera.limit = _rowWindows.windowRows();
+    queryCritera.offset = _rowWindows.firstRowOfWindow(window);
+    queryCritera.typedResult = connection->features()->supportsTypedResults();
+
+    meow::db::TableEntity * table = nullptr;
+    if (_dbEntity->type() == meow::db::Entity::Type::Table) {
+        table = static_cast<meow::db::TableEntity *>(_dbEntity);
+        auto textSettings = meow::app()->settings()->textSettings();
+        if (textSettings->autoLimitLoadDataLength()) {
+            queryCritera.select = fetcher->selectList(table);
+        }
+    }
+
+    // Windows must fit each other, so order is stable: by primary key,
+    // which also breaks ties of user's sort
+    appendSortColumns(&queryCritera);
+
+    if (table) {
+        QList<meow::db::TableColumn *> keyColumns
+                = fetcher->keysetColumns(table);
+        if (queryCritera.sortColumns.isEmpty()
+                || sortsByKeys(queryCritera.sortColumns, keyColumns)) {
+            for (auto column : keyColumns) {
+                db::QueryCriteria::KeyColumn keyColumn;
+                keyColumn.columnName = column->name();
+                keyColumn.isNumeric = column->dataType()->categoryIndex
+                        == meow::db::DataTypeCategoryIndex::Integer;
+                queryCritera.keyColumns.push_back(keyColumn);
+            }
+        }
+    }
+
+    // Scrolling on: seek from the last row of previous window instead of
+    // skipping offset rows. Jumps use offset
+    meow::db::NativeQueryResult * previous
+            = (window > 0 && !queryCritera.keyColumns.isEmpty())
+            ? _rowWindows.window(window - 1) : nullptr;
+    if (previous && previous->recordCount()
+            == static_cast<meow::db::ulonglong>(_rowWindows.windowRows())) {
+        previous->seekRecNo(previous->recordCount() - 1);
+        QStringList values;
+        for (const auto & keyColumn : queryCritera.keyColumns) {
+            if (!previous->columnExists(keyColumn.columnName)) {
+                values.clear();
+                break;
+            }
+            values << previous->curRowColumn(
+                          previous->indexOfColumn(keyColumn.columnName));
+        }
+        queryCritera.afterKeyValues = values;
+    }
+
+    if (isFirstWindow) {
+        // do ping in main thread to handle possible reconnection
+        connection->ping(true);
+        // get id before async query execution to allow
+        // KILL QUERY ID from another thread
+        connection->connectionIdOnServer();
+    }
+
+    threads::DbThread * thread = connection->thread();
+
+    QStringList bindValues;
+    std::shared_ptr<threads::QueryDataTask> task
+        = thread->createQueryDataTask(
+            fetcher->selectSQL(
+                &queryCritera,
+                queryCritera.typedResult ? &bindValues : nullptr));
+    if (queryCritera.typedResult) {
+        task->setBindValues(bindValues);
+    }
+
+    _loadingTask = task;
+    _loadingWindow = window;
+    _loadingAppends = !isFirstWindow;
+
+    connect(task.get(), &threads::ThreadTask::finished,
+            this, &DataTableModel::onWindowTaskFinished); // before post!
+
+    if (isFirstWindow) {
+        emit loadingStarted();
+    }
+
+    thread->postTask(task);
+}
+
+void DataTableModel::onWindowTaskFinished()
+{
+    MEOW_ASSERT_MAIN_THREAD
+
+    if (!_loadingTask || sender() != _loadingTask.get()) {
+        return; // abandoned
+    }
+
+    std::shared_ptr<threads::QueryDataTask> task = _loadingTask;
+    int window = _loadingWindow;
+    _loadingTask.reset();
+    _loadingWindow = -1;
+    disconnect(task.get(), nullptr, this, nullptr);
+
+    bool isFirstWindow = queryData()->query() == nullptr;
+
+    if (task->isAborted() || task->isFailed()) {
+        // not retried at once, next viewport change or loadData(true) does
+        if (isFirstWindow) {
+            _entityChangedProcessed = false;
+        }
+        if (task->isAborted()) {
+            emit loadingCancelled();
+        } else {
+            emit loadingFailed(task->errorMessage());
+        }
+        return;
+    }
+
+    meow::db::LapTimer timer;
+
+    meow::db::Query * query = task->query();
+    meow::db::QueryResultPt result = query->resultCount()
+            ? query->resultAt(0) : nullptr;
+    const int windowRows = _rowWindows.windowRows();
+    const int received = result ? static_cast<int>(result->recordCount()) : 0;
+
+    if (isFirstWindow) {
+        // columns are taken from the first window
+        queryData()->setQueryPtr(_dbEntity->connection()->createQuery());
+        queryData()->query()->setEntity(_dbEntity);
+        queryData()->query()->takeResults(query, false);
+    }
+
+    if (received > 0 && !_rowWindows.insert(window, result)) {
+        _windowsLoadingStopped = true; // window alone is over memory budget
+    }
+
+    int prevColCount = columnCount();
+    int newColumnCount = queryData()->columnCount();
+
+    if (newColumnCount > prevColCount) {
+        beginInsertColumns(QModelIndex(), prevColCount, newColumnCount-1);
+        setColumnCount(newColumnCount);
+        endInsertColumns();
+    }
+
+    // Row count is estimated first, grows while full windows come and is
+    // exact when a short one comes
+    qint64 firstRow = _rowWindows.firstRowOfWindow(window);
+    qint64 endRow = firstRow + received;
+    int prevRowCount = rowCount();
+    qint64 newRowCount = prevRowCount;
+
+    if (isFirstWindow
+            && _dbEntity->type() == meow::db::Entity::Type::Table) {
+        auto table = static_cast<meow::db::TableEntity *>(_dbEntity);
+        qint64 estimate = static_cast<qint64>(table->rowsCount(true));
+        if (!isFiltered()) {
+            newRowCount = estimate;
+        }
+    }
+
+    if (received < windowRows) {
+        newRowCount = endRow;
+        _rowCountIsExact = true;
+    } else if (!_rowCountIsExact && endRow >= newRowCount) {
+        newRowCount = endRow + windowRows; // may be more, next window tells
+    }
+
+    newRowCount = std::min(newRowCount,
+        static_cast<qint64>(std::numeric_limits<int>::max()));
+
+    if (newRowCount > prevRowCount) {
+        beginInsertRows(QModelIndex(), prevRowCount, newRowCount-1);
+        setRowCount(static_cast<int>(newRowCount));
+        _rowWindows.setRowCount(static_cast<int>(newRowCount));
+        endInsertRows();
+    } else if (newRowCount < prevRowCount) {
+        beginRemoveRows(QModelIndex(),
+                        static_cast<int>(newRowCount), prevRowCount-1);
+        setRowCount(static_cast<int>(newRowCount));
+        _rowWindows.setRowCount(static_cast<int>(newRowCount));
+        endRemoveRows();
+    }
+
+    if (!isFirstWindow && received > 0) {
+        emit dataChanged(
+            index(static_cast<int>(firstRow), 0),
+            index(static_cast<int>(std::min(endRow, newRowCount)) - 1,
+                  columnCount() - 1));
+    }
+
+    meow::db::QueryTimings timings;
+    timings.modelPopulate = timer.lap();
+    queryData()->query()->addTimings(timings);
+
+    emit loadingFinished(!isFirstWindow);
+
+    loadNextWindow();
+}
+
+void DataTableModel::cancelStaleWindowLoading()
+{
+    if (!_loadingTask || _loadingWindow == -1) {
+        return;
+    }
+
+    std::vector<int> windows = wantedWindows();
+    if (std::find(windows.begin(), windows.end(), _loadingWindow)
+            != windows.end()) {
+        return; // still needed
+    }
+
+    // result is dropped, not killed: a window is small and a kill needs a
+    // helper connection on every scroll. Queued task won't even start
+    abandonLoading();
+}
+
+bool DataTableModel::canStreamData() const
+{
+    return _dbEntity->connection()->features()->supportsStreamingResults();
+}
+
+void DataTableModel::fetchStreamedRows(meow::db::ulonglong upToRowCount)
+{
+    Q_ASSERT(_fetchingTask == nullptr);
+
+    int prevRowCount = rowCount();
+    if (upToRowCount <= (meow::db::ulonglong)prevRowCount) {
+        return;
+    }
+
+    // rows are received aside: views keep reading current ones meanwhile
+    threads::DbThread * thread = _dbEntity->connection()->thread();
+
+    std::shared_ptr<threads::FetchRowsTask> task
+        = thread->createFetchRowsTask(
+            queryData()->currentResult(),
+            upToRowCount - static_cast<meow::db::ulonglong>(prevRowCount));
+
+    _fetchingTask = task;
+
+    connect(task.get(), &threads::ThreadTask::finished,
+            this, &DataTableModel::onFetchingTaskFinished); // before post!
+
+    emit loadingStarted();
+
+    thread->postTask(task);
+}
+
+void DataTableModel::onFetchingTaskFinished()
+{
+    MEOW_ASSERT_MAIN_THREAD
+
+    if (!_fetchingTask || sender() != _fetchingTask.get()) {
+        return; // abandoned
+    }
+
+    std::shared_ptr<threads::FetchRowsTask> task = _fetchingTask;
+    _fetchingTask.reset();
+    disconnect(task.get(), nullptr, this, nullptr);
+
+    if (task->isFailed()) {
+        emit loadingFailed(task->errorMessage());
+        return;
+    }
+
+    int prevRowCount = rowCount();
+
+    meow::db::LapTimer timer;
+
+    if (task->rows() && task->rows()->recordCount() > 0) {
+        queryData()->currentResult()->appendResultData(task->rows());
+    }
+
+    int newRowCount = queryData()->rowCount();
+
+    if (newRowCount > prevRowCount) {
+        _lastKeyValues.clear(); // seen by stream, not by query
+
+        beginInsertRows(QModelIndex(), prevRowCount, newRowCount-1);
+        setRowCount(newRowCount);
+        endInsertRows();
+
+        meow::db::QueryTimings timings;
+        timings.modelPopulate = timer.lap();
+        queryData()->query()->addTimings(timings);
+    }
+
+    emit loadingFinished(true);
 }
 
 bool DataTableModel::isEditable() const
 {
-    if (_dbEntity == nullptr) {
+    if (_dbEntity == nullptr || _virtualScrolling) {
         return false;
     }
     if (_dbEntity->type() == meow::db::Entity::Type::Table) {
@@ -410,11 +1107,11 @@ QAbstractItemModel * DataTableModel::createSortFilterModel()
 {
     if (_sortFilterModel == nullptr) {
         _sortFilterModel = new QueryDataSortFilterProxyModel(queryData(), this);
-        _sortFilterModel->setSourceModel(this);
-        _sortFilterModel->setFilterCaseSensitivity(Qt::CaseInsensitive);
-        _sortFilterModel->setFilterKeyColumn(-1); // all columns
-
-        setFilterPattern(_filterPattern, _filterPatternIsRegexp);
+        if (!_virtualScrolling) {
+            _sortFilterModel->setSourceModel(this);
+        }
+        _sortFilterModel->setQuickFilter(_filterPattern,
+                                         _filterPatternIsRegexp);
     }
     return _sortFilterModel;
 }
@@ -425,15 +1122,7 @@ void DataTableModel::setFilterPattern(const QString & pattern, bool regexp)
 
     _filterPattern = pattern;
     _filterPatternIsRegexp = regexp;
-    if (_sortFilterModel) {
-        if (_filterPatternIsRegexp) {
-            _sortFilterModel->setFilterRegExp(QRegExp(pattern,
-                                                      Qt::CaseInsensitive,
-                                                      QRegExp::RegExp));
-        } else {
-            _sortFilterModel->setFilterWildcard(pattern);
-        }
-    }
+    _criteriaTimer.start(); // restarts on every char
 }
 
 QString DataTableModel::filterPattern() const
@@ -443,14 +1132,14 @@ QString DataTableModel::filterPattern() const
 
 int DataTableModel::filterMatchedRowCount() const
 {
-    if (_sortFilterModel) {
+    if (hasSortFilterModel()) {
         return _sortFilterModel->rowCount();
     } else {
         return rowCount(); // all matched if no filter
     }
 }
 
-QList<db::TableColumn *> DataTableModel::selectedTableColumns()
+QList<db::TableColumn *> DataTableModel::selectedTableColumns() const
 {
     if (_dbEntity == nullptr) {
         return {};
@@ -521,15 +1210,130 @@ void DataTableModel::resetAllColumnsSort()
 
 void DataTableModel::applyColumnSort()
 {
-    incRowsCountForOneStep(true); // reset limit/offset
-    refresh();
+    _sortChanged = true;
+    _criteriaTimer.start(); // coalesces clicks: asc -> desc -> none
+}
+
+void DataTableModel::applyCriteria()
+{
+    _criteriaTimer.stop();
+
+    // plain pattern is found by LIKE too, the server narrows loaded rows
+    // and the proxy filters them exactly
+    QString serverFilterPattern
+        = filterPatternMatchesLike() ? _filterPattern : QString();
+
+    bool onClient = canApplyCriteriaOnClient();
+
+    if (_sortFilterModel) {
+        _sortFilterModel->setQuickFilter(_filterPattern,
+                                         _filterPatternIsRegexp);
+    }
+
+    if (onClient) {
+        if (_sortChanged) {
+            std::vector<db::QueryDataSorter::SortColumn> sortColumns;
+            for (const SortColumn & sort : _columnsSort) {
+                db::QueryDataSorter::SortColumn sortColumn;
+                sortColumn.index = sort.columnIndex;
+                sortColumn.isAsc = (sort.sortOrder == Qt::AscendingOrder);
+                sortColumns.push_back(sortColumn);
+            }
+            _sortFilterModel->sortByColumns(sortColumns);
+            _sortChanged = false;
+        }
+        emit criteriaApplied();
+        return;
+    }
+
+    if (!_sortChanged && serverFilterPattern == _serverFilterPattern) {
+        emit criteriaApplied(); // e.g. regexp on a part of rows
+        return;
+    }
+
+    _sortChanged = false;
+    _serverFilterPattern = serverFilterPattern;
+
+    if (_dbEntity == nullptr || !_entityChangedProcessed) {
+        return; // used by next loading
+    }
+
+    try {
+        incRowsCountForOneStep(true); // reset limit/offset
+        refresh();
+    } catch(meow::db::Exception & ex) {
+        emit loadingFailed(ex.message());
+    }
+}
+
+bool DataTableModel::canApplyCriteriaOnClient() const
+{
+    if (!hasSortFilterModel()
+            || !_entityChangedProcessed
+            || _loadingTask != nullptr
+            || isLimited() // a part of rows
+            || queryData()->canFetchMore()
+            || queryData()->isModified()) {
+        return false;
+    }
+
+    if (_serverFilterPattern.isEmpty()) {
+        return true;
+    }
+
+    // loaded rows match the pushed pattern, ok if the new one narrows it
+    return filterPatternMatchesLike()
+        && _filterPattern.contains(_serverFilterPattern, Qt::CaseInsensitive);
+}
+
+bool DataTableModel::filterPatternMatchesLike() const
+{
+    bool hasHexColumns = false;
+    for (db::TableColumn * column : selectedTableColumns()) {
+        if (db::dataTypeCategoryIsShownAsHex(
+                column->dataType()->categoryIndex)) {
+            hasHexColumns = true;
+            break;
+        }
+    }
+    return meow::db::QueryDataFilter::matchesLikeFilter(
+                _filterPattern, _filterPatternIsRegexp, hasHexColumns);
+}
+
+QList<db::TableColumn *> DataTableModel::quickFilterColumns() const
+{
+    QList<db::TableColumn *> columns;
+    for (db::TableColumn * column : selectedTableColumns()) {
+        if (!db::dataTypeCategoryIsShownAsHex(
+                column->dataType()->categoryIndex)) {
+            columns.append(column);
+        }
+    }
+    return columns;
+}
+
+QString DataTableModel::whereWithQuickFilter() const
+{
+    if (_serverFilterPattern.isEmpty() || _dbEntity == nullptr) {
+        return _whereFilter;
+    }
+
+    QString likeFilter = _dbEntity->connection()->applyQuickFilter(
+                quickFilterColumns(), _serverFilterPattern);
+
+    if (likeFilter.isEmpty()) {
+        return _whereFilter;
+    } else if (_whereFilter.isEmpty()) {
+        return likeFilter;
+    }
+    return "(" + _whereFilter + ") AND (" + likeFilter + ")";
 }
 
 void DataTableModel::refresh()
 {
+    abandonLoading(true); // superseded
     removeData();
     loadData(true);
-    emit dataRefreshed();
 }
 
 void DataTableModel::invalidateData()
@@ -555,8 +1359,12 @@ QString DataTableModel::rowCountStats() const
             static_cast<meow::db::TableEntity *>(_dbEntity);
 
         meow::db::ulonglong rowsTotal = 0;
-        if (_entityChangedProcessed && !isLimited() && !isFiltered()) {
+        if (_entityChangedProcessed && !isLimited() && !isFiltered()
+                && (!_virtualScrolling || _rowCountIsExact)) {
             rowsTotal = rowCount();
+        } else if (_virtualScrolling) {
+            // estimated with first window, windows may be loading now
+            rowsTotal = table->rowsCount(false);
         } else {
             rowsTotal = table->rowsCount(true);// TODO: rm extra query
         }
@@ -607,16 +1415,22 @@ void DataTableModel::incRowsCountForOneStep(bool reset)
 
 bool DataTableModel::isLimited() const
 {
+    if (_virtualScrolling) {
+        return false; // rows come on scrolling
+    }
     return _wantedRowsCount <= (meow::db::ulonglong)rowCount();
 }
 
 bool DataTableModel::isFiltered() const
 {
-    return !_whereFilter.isEmpty();
+    return !_whereFilter.isEmpty() || !_serverFilterPattern.isEmpty();
 }
 
 bool DataTableModel::allDataLoaded() const
 {
+    if (_virtualScrolling) {
+        return true; // nothing to load by Next/Show all
+    }
     return !isLimited() || (_wantedRowsCount == meow::db::DATA_MAX_ROWS);
 }
 
@@ -1,10 +1,13 @@
 #ifndef DATA_TABLE_MODEL_H
 #define DATA_TABLE_MODEL_H
 
+#include <memory>
 #include <QObject>
+#include <QTimer>
 #include "query_data_sort_filter_proxy_model.h"
 #include "base_data_table_model.h"
 #include "db/common.h"
+#include "db/row_window_cache.h"
 #include "ui/delegates/edit_query_data_delegate.h"
 
 // Main Window
@@ -16,6 +19,13 @@ namespace meow {
 
 namespace db {
 class TableColumn;
+class Query;
+class QueryCriteria;
+}
+
+namespace threads {
+class QueryDataTask;
+class FetchRowsTask;
 }
 
 namespace ui {
@@ -37,13 +47,20 @@ public:
             const QModelIndex &index) const override;
     virtual QVariant headerData(int section, Qt::Orientation orientation,
                         int role = Qt::DisplayRole) const override;
+    virtual bool canFetchMore(const QModelIndex &parent) const override;
+    virtual void fetchMore(const QModelIndex &parent) override;
 
     void setEntity(meow::db::Entity * tableOrViewEntity, bool loadData = true);
     meow::db::Entity * entity() const { return _dbEntity; }
 
     void removeData();
+    // Runs in connection's thread, see loading*() signals
     void loadData(bool force = false);
     void refresh();
+    bool isLoading() const {
+        return _loadingTask != nullptr || _fetchingTask != nullptr;
+    }
+    void cancelLoading();
     void invalidateData();
 
     void setNoRowsCountLimit();
@@ -52,11 +69,21 @@ public:
     bool isFiltered() const;
     bool allDataLoaded() const;
 
+    // Virtual scrolling: rows of any count, only windows of rows around
+    // viewport are loaded (read-only), see RowWindowCache
+    void setVirtualScrolling(bool enabled);
+    bool isVirtualScrolling() const { return _virtualScrolling; }
+    // rows visible in view, loads missing windows around them
+    void setViewport(int firstRow, int lastRow);
+
     void applyWhereFilter(const QString & whereFilter);
     void resetWhereFilter();
 
     QString rowCountStats() const;
 
+    // SELECT of all rows by current filter and sort, e.g. to export them
+    QString selectAllSQL() const;
+
     bool isEditable() const;
     bool isEditing();
     bool isModified();
@@ -75,25 +102,33 @@ public:
 
     QAbstractItemModel * createSortFilterModel();
 
+    // Quick filter and sort are applied together after a short pause, see
+    // applyCriteria()
     void setFilterPattern(const QString & pattern, bool regexp);
     QString filterPattern() const;
     bool filterPatternIsRegexp() const { return _filterPatternIsRegexp; }
 
     int filterMatchedRowCount() const;
 
-    QList<db::TableColumn *> selectedTableColumns();
+    QList<db::TableColumn *> selectedTableColumns() const;
 
     Q_SIGNAL void editingStarted();
-    Q_SIGNAL void dataRefreshed();
+    Q_SIGNAL void loadingStarted();
+    Q_SIGNAL void loadingProgress(int rowsReceived);
+    Q_SIGNAL void loadingFinished(bool appended);
+    Q_SIGNAL void loadingFailed(const QString & error);
+    Q_SIGNAL void loadingCancelled();
+    // quick filter/sort were applied to loaded rows
+    Q_SIGNAL void criteriaApplied();
 
     void changeColumnSort(int columnIndex);
     bool isColumnSorted(int columnIndex) const;
     Qt::SortOrder columnSortOrder(int columnIndex) const;
     void resetAllColumnsSort();
-    void applyColumnSort();
+    void applyColumnSort(); // see setFilterPattern()
 
     QModelIndex mapToSource(const QModelIndex &proxyIndex) const {
-        if (_sortFilterModel) {
+        if (hasSortFilterModel()) {
             return _sortFilterModel->mapToSource(proxyIndex);
         } else {
             return proxyIndex;
@@ -101,7 +136,7 @@ public:
     }
 
     QModelIndexList mapToSource(const QModelIndexList &proxyIndexList) const {
-        if (_sortFilterModel) {
+        if (hasSortFilterModel()) {
             QModelIndexList result = proxyIndexList;
             for (auto & index : result) {
                 index = _sortFilterModel->mapToSource(index);
@@ -113,7 +148,7 @@ public:
     }
 
     QModelIndex mapFromSource(const QModelIndex &sourceIndex) const {
-        if (_sortFilterModel) {
+        if (hasSortFilterModel()) {
             return _sortFilterModel->mapFromSource(sourceIndex);
         } else {
             return sourceIndex;
@@ -121,7 +156,7 @@ public:
     }
 
     QModelIndexList mapFromSource(const QModelIndexList &sourceIndexList) const {
-        if (_sortFilterModel) {
+        if (hasSortFilterModel()) {
             QModelIndexList result = sourceIndexList;
             for (auto & index : result) {
                 index = _sortFilterModel->mapFromSource(index);
@@ -138,6 +173,46 @@ public:
 
 private:
 
+    // proxy is detached from this model while scrolling virtually
+    bool hasSortFilterModel() const {
+        return _sortFilterModel != nullptr && !_virtualScrolling;
+    }
+
+    bool canStreamData() const;
+
+    // Sorts and filters loaded rows if all rows of the query are here,
+    // else reloads them with ORDER BY and quick filter as LIKE in WHERE
+    Q_SLOT void applyCriteria();
+    bool canApplyCriteriaOnClient() const;
+    // True if quick filter pattern can be pushed to server as LIKE
+    bool filterPatternMatchesLike() const;
+    // columns searched by pushed quick filter: binary ones are matched as
+    // hex on client, not by LIKE
+    QList<db::TableColumn *> quickFilterColumns() const;
+    // where filter and pushed quick filter
+    QString whereWithQuickFilter() const;
+
+    // receives rows from streaming result until rowCount() == upToRowCount
+    // in connection's thread, they are appended when the task is finished
+    void fetchStreamedRows(meow::db::ulonglong upToRowCount);
+    Q_SLOT void onFetchingTaskFinished();
+
+    Q_SLOT void onLoadingTaskFinished();
+    // values of keyset columns in last row of query, see QueryCriteria
+    void rememberLastKeyValues(meow::db::Query * query);
+    // ORDER BY of columns sorted by user, primary key breaks ties
+    void appendSortColumns(meow::db::QueryCriteria * criteria) const;
+    // forgets running task, its result is dropped. Killing stops a
+    // superseded query on server
+    void abandonLoading(bool killQuery = false);
+
+    // missing windows by need: visible, ahead and behind of scrolling
+    std::vector<int> wantedWindows() const;
+    void loadNextWindow();
+    Q_SLOT void onWindowTaskFinished();
+    // drops loading of a window which was scrolled away
+    void cancelStaleWindowLoading();
+
     QueryDataSortFilterProxyModel * _sortFilterModel;
     QString _filterPattern;
     bool _filterPatternIsRegexp;
@@ -147,6 +222,13 @@ private:
     meow::db::ulonglong _wantedRowsCount;
     QString _whereFilter;
 
+    std::shared_ptr<threads::QueryDataTask> _loadingTask;
+    bool _loadingAppends;
+    std::shared_ptr<threads::FetchRowsTask> _fetchingTask;
+
+    QStringList _keysetColumnNames; // empty if paging with offset
+    QStringList _lastKeyValues;
+
     struct SortColumn
     {
         int columnIndex = -1;
@@ -154,6 +236,19 @@ private:
     };
 
     std::vector<SortColumn> _columnsSort;
+
+    QTimer _criteriaTimer; // coalesces quick filter/sort changes
+    bool _sortChanged;
+    QString _serverFilterPattern; // quick filter in WHERE of loaded rows
+
+    bool _virtualScrolling;
+    meow::db::RowWindowCache _rowWindows;
+    int _loadingWindow;
+    int _viewportFirstRow;
+    int _viewportLastRow;
+    bool _scrollsDown;
+    bool _rowCountIsExact; // else estimated or grown by windows
+    bool _windowsLoadingStopped; // by memory budget, till loadData(true)
 };
 
 
@@ -220,6 +220,8 @@ void DatabaseEntitiesTableModel::setDataBase(
                    &meow::db::SessionEntity::entityInserted,
                    this,
                    &DatabaseEntitiesTableModel::onEntityInserted);
+
+        disconnect(prevDb, nullptr, this, nullptr);
     }
 
     // retain database and its session
@@ -235,6 +237,24 @@ void DatabaseEntitiesTableModel::setDataBase(
                    &meow::db::SessionEntity::entityInserted,
                    this,
                    &DatabaseEntitiesTableModel::onEntityInserted);
+
+        connect(_database.get(),
+                &meow::db::DataBaseEntity::entitiesFetched,
+                this,
+                &DatabaseEntitiesTableModel::onEntitiesFetched);
+        connect(_database.get(),
+                &meow::db::DataBaseEntity::entitiesReset,
+                this,
+                &DatabaseEntitiesTableModel::onEntitiesReset);
+        connect(_database.get(),
+                &meow::db::DataBaseEntity::entitiesFetchFailed,
+                this,
+                &DatabaseEntitiesTableModel::onEntitiesReset); // cleared
+    }
+
+    if (_database) {
+        // rows come by batches, see onEntitiesFetched()
+        _database->fetchEntitiesAsync();
     }
 
     insertAllRows();
@@ -253,7 +273,8 @@ void DatabaseEntitiesTableModel::insertAllRows()
 {
     // Listening: Arch Enemy - Cruelty Without Beauty
 
-    int rowsCount = _database ? _database->childCount() : 0;
+    // not childCount(): entities may be fetching yet
+    int rowsCount = _database ? _database->entities().size() : 0;
     if (rowsCount) {
         beginInsertRows(QModelIndex(), 0, rowsCount-1);
         _entities = _database->entities();
@@ -261,6 +282,23 @@ void DatabaseEntitiesTableModel::insertAllRows()
     }
 }
 
+void DatabaseEntitiesTableModel::onEntitiesFetched()
+{
+    const QList<meow::db::EntityPtr> & entities = _database->entities();
+    int firstNewRow = entitiesCount();
+    if (entities.size() <= firstNewRow) return;
+
+    beginInsertRows(QModelIndex(), firstNewRow, entities.size() - 1);
+    _entities = entities;
+    endInsertRows();
+}
+
+void DatabaseEntitiesTableModel::onEntitiesReset()
+{
+    removeAllRows(); // disk cache was outdated, replace all
+    insertAllRows();
+}
+
 void DatabaseEntitiesTableModel::afterEntityRemoved(
         const meow::db::EntityPtr & entity)
 {
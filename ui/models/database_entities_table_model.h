@@ -62,6 +62,8 @@ private:
 
     Q_SLOT void afterEntityRemoved(const meow::db::EntityPtr & entity);
     Q_SLOT void onEntityInserted(const meow::db::EntityPtr & entity);
+    Q_SLOT void onEntitiesFetched();
+    Q_SLOT void onEntitiesReset();
 
     int entitiesCount() const;
 
@@ -517,6 +517,8 @@ EntitiesTreeModel::itemForEntity(meow::db::Entity * entity)
         return sessionItem;
     }
 
+    if (!sessionItem) return nullptr;
+
     // database
     meow::db::Entity * database =
                 meow::db::findParentEntityOfType(entity,
@@ -589,6 +591,25 @@ void EntitiesTreeModel::fetchMore(const QModelIndex & parent)
     const meow::db::EntityPtr & entity = item->entity;
     if (!entity) return;
 
+    if (entity->type() == meow::db::Entity::Type::Database) {
+        // can take a while for big schemas, rows are inserted by batches
+        auto database = static_cast<meow::db::DataBaseEntity *>(entity.get());
+        if (!database->childrenFetched()) {
+            item->childrenAdded = true;
+            connect(database, &meow::db::DataBaseEntity::entitiesFetched,
+                    this, &EntitiesTreeModel::onDatabaseEntitiesFetched,
+                    Qt::UniqueConnection);
+            connect(database, &meow::db::DataBaseEntity::entitiesReset,
+                    this, &EntitiesTreeModel::onDatabaseEntitiesReset,
+                    Qt::UniqueConnection);
+            connect(database, &meow::db::DataBaseEntity::entitiesFetchFailed,
+                    this, &EntitiesTreeModel::onDatabaseEntitiesFetchFailed,
+                    Qt::UniqueConnection);
+            database->fetchEntitiesAsync();
+            return;
+        }
+    }
+
     if (entity->type() == meow::db::Entity::Type::Session
         || entity->type() == meow::db::Entity::Type::Database) {
         int childCount = 0;
@@ -609,6 +630,62 @@ void EntitiesTreeModel::fetchMore(const QModelIndex & parent)
     item->childrenAdded = true;
 }
 
+void EntitiesTreeModel::onDatabaseEntitiesFetched()
+{
+    auto database = qobject_cast<meow::db::DataBaseEntity *>(sender());
+    if (!database) return;
+
+    TreeItem * item = itemForEntity(database);
+    if (!item || !item->childrenAdded) return; // e.g. data was reloaded
+
+    const QList<meow::db::EntityPtr> & entities = database->entities();
+    int firstNewRow = item->children.size();
+    if (entities.size() <= firstNewRow) return;
+
+    QModelIndex parent = createIndex(item->row(), 0, item);
+    beginInsertRows(parent, firstNewRow, entities.size() - 1);
+    for (int i = firstNewRow; i < entities.size(); ++i) {
+        item->appendChild(entities.at(i));
+    }
+    endInsertRows();
+}
+
+void EntitiesTreeModel::onDatabaseEntitiesReset()
+{
+    auto database = qobject_cast<meow::db::DataBaseEntity *>(sender());
+    if (!database) return;
+
+    TreeItem * item = itemForEntity(database);
+    if (!item || !item->childrenAdded) return;
+
+    // disk cache was outdated, replace all
+    QModelIndex parent = createIndex(item->row(), 0, item);
+    if (!item->children.isEmpty()) {
+        beginRemoveRows(parent, 0, item->children.size() - 1);
+        item->removeChildren(0, item->children.size());
+        endRemoveRows();
+    }
+
+    onDatabaseEntitiesFetched();
+}
+
+void EntitiesTreeModel::onDatabaseEntitiesFetchFailed(const QString & error)
+{
+    auto database = qobject_cast<meow::db::DataBaseEntity *>(sender());
+    TreeItem * item = database ? itemForEntity(database) : nullptr;
+
+    if (item) {
+        if (!item->children.isEmpty()) {
+            QModelIndex parent = createIndex(item->row(), 0, item);
+            beginRemoveRows(parent, 0, item->children.size() - 1);
+            item->removeChildren(0, item->children.size());
+            endRemoveRows();
+        }
+        item->childrenAdded = false; // allow to retry
+    }
+
+    emit loadDataError(error);
+}
 
 void EntitiesTreeModel::reinitItems()
 {
@@ -86,6 +86,10 @@ private:
 
     Q_SLOT void onDatabasesDataChanged();
 
+    Q_SLOT void onDatabaseEntitiesFetched();
+    Q_SLOT void onDatabaseEntitiesReset();
+    Q_SLOT void onDatabaseEntitiesFetchFailed(const QString & error);
+
     void reinitItems();
     void removeData();
     void insertData();
@@ -1,16 +1,36 @@
 #include "query_data_sort_filter_proxy_model.h"
 #include "db/query_data.h"
 
+#include <algorithm>
+
 namespace meow {
 namespace ui {
 namespace models {
 
+namespace {
+
+template <typename T>
+void eraseRows(std::vector<T> & rows, int first, int last)
+{
+    std::size_t begin = static_cast<std::size_t>(first);
+    std::size_t end = std::min(static_cast<std::size_t>(last + 1),
+                               rows.size());
+    if (begin < end) {
+        rows.erase(rows.begin() + static_cast<std::ptrdiff_t>(begin),
+                   rows.begin() + static_cast<std::ptrdiff_t>(end));
+    }
+}
+
+} // namespace
+
 QueryDataSortFilterProxyModel::QueryDataSortFilterProxyModel(
         meow::db::QueryData * queryData,
         QObject *parent)
 
-    : QSortFilterProxyModel(parent)
+    : QAbstractProxyModel(parent)
     , _queryData(queryData)
+    , _filter(queryData)
+    , _useFilterMatches(false)
 {
 
 }
@@ -20,14 +40,513 @@ QueryDataSortFilterProxyModel::~QueryDataSortFilterProxyModel()
 
 }
 
-bool QueryDataSortFilterProxyModel::filterAcceptsRow(
-        int sourceRow,
-        const QModelIndex &sourceParent) const
+void QueryDataSortFilterProxyModel::setSourceModel(
+        QAbstractItemModel * sourceModel)
+{
+    beginResetModel();
+
+    if (this->sourceModel()) {
+        disconnect(this->sourceModel(), nullptr, this, nullptr);
+    }
+
+    QAbstractProxyModel::setSourceModel(sourceModel);
+
+    if (sourceModel) {
+        connect(sourceModel, &QAbstractItemModel::rowsInserted,
+                this, [=](const QModelIndex &, int first, int last) {
+            onSourceRowsInserted(first, last);
+        });
+        connect(sourceModel, &QAbstractItemModel::rowsAboutToBeRemoved,
+                this, [=](const QModelIndex &, int first, int last) {
+            onSourceRowsAboutToBeRemoved(first, last);
+        });
+        connect(sourceModel, &QAbstractItemModel::rowsRemoved,
+                this, [=](const QModelIndex &, int first, int last) {
+            onSourceRowsRemoved(first, last);
+        });
+        connect(sourceModel, &QAbstractItemModel::columnsAboutToBeInserted,
+                this, [=](const QModelIndex &, int first, int last) {
+            beginInsertColumns(QModelIndex(), first, last);
+        });
+        connect(sourceModel, &QAbstractItemModel::columnsInserted,
+                this, [=]() {
+            endInsertColumns();
+        });
+        connect(sourceModel, &QAbstractItemModel::columnsAboutToBeRemoved,
+                this, [=](const QModelIndex &, int first, int last) {
+            beginRemoveColumns(QModelIndex(), first, last);
+        });
+        connect(sourceModel, &QAbstractItemModel::columnsRemoved,
+                this, [=]() {
+            endRemoveColumns();
+        });
+        connect(sourceModel, &QAbstractItemModel::dataChanged,
+                this, &QueryDataSortFilterProxyModel::onSourceDataChanged);
+        connect(sourceModel, &QAbstractItemModel::headerDataChanged,
+                this, [=](Qt::Orientation orientation, int first, int last) {
+            if (orientation == Qt::Horizontal) {
+                emit headerDataChanged(orientation, first, last);
+            } else if (rowCount() > 0) {
+                emit headerDataChanged(orientation, 0, rowCount() - 1);
+            }
+        });
+        // source rows are not mapped in between, so reset
+        connect(sourceModel, &QAbstractItemModel::modelAboutToBeReset,
+                this, [=]() {
+            beginResetModel();
+        });
+        connect(sourceModel, &QAbstractItemModel::modelReset,
+                this, [=]() {
+            resetMapping();
+            endResetModel();
+        });
+        connect(sourceModel, &QAbstractItemModel::layoutAboutToBeChanged,
+                this, [=]() {
+            beginResetModel();
+        });
+        connect(sourceModel, &QAbstractItemModel::layoutChanged,
+                this, [=]() {
+            resetMapping();
+            endResetModel();
+        });
+    }
+
+    resetMapping();
+
+    endResetModel();
+}
+
+QModelIndex QueryDataSortFilterProxyModel::index(
+        int row, int column, const QModelIndex &parent) const
+{
+    if (parent.isValid() || row < 0 || row >= rowCount()
+            || column < 0 || column >= columnCount()) {
+        return QModelIndex();
+    }
+    return createIndex(row, column);
+}
+
+QModelIndex QueryDataSortFilterProxyModel::parent(const QModelIndex &child) const
+{
+    Q_UNUSED(child);
+    return QModelIndex(); // flat table
+}
+
+int QueryDataSortFilterProxyModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) {
+        return 0;
+    }
+    return static_cast<int>(_proxyToSource.size());
+}
+
+int QueryDataSortFilterProxyModel::columnCount(const QModelIndex &parent) const
+{
+    if (parent.isValid() || sourceModel() == nullptr) {
+        return 0;
+    }
+    return sourceModel()->columnCount();
+}
+
+QModelIndex QueryDataSortFilterProxyModel::mapToSource(
+        const QModelIndex &proxyIndex) const
+{
+    if (!proxyIndex.isValid() || sourceModel() == nullptr) {
+        return QModelIndex();
+    }
+    std::size_t row = static_cast<std::size_t>(proxyIndex.row());
+    if (row >= _proxyToSource.size()) {
+        return QModelIndex();
+    }
+    return sourceModel()->index(_proxyToSource[row], proxyIndex.column());
+}
+
+QModelIndex QueryDataSortFilterProxyModel::mapFromSource(
+        const QModelIndex &sourceIndex) const
+{
+    if (!sourceIndex.isValid()) {
+        return QModelIndex();
+    }
+    std::size_t row = static_cast<std::size_t>(sourceIndex.row());
+    if (row >= _sourceToProxy.size() || _sourceToProxy[row] < 0) {
+        return QModelIndex();
+    }
+    return createIndex(_sourceToProxy[row], sourceIndex.column());
+}
+
+void QueryDataSortFilterProxyModel::sort(int column, Qt::SortOrder order)
+{
+    if (column < 0) {
+        setOrder({});
+        return;
+    }
+
+    db::QueryDataSorter::SortColumn sortColumn;
+    sortColumn.index = column;
+    sortColumn.isAsc = (order == Qt::AscendingOrder);
+
+    sortByColumns({sortColumn});
+}
+
+void QueryDataSortFilterProxyModel::sortByColumns(
+        const std::vector<db::QueryDataSorter::SortColumn> & columns)
+{
+    if (columns.empty()) {
+        setOrder({});
+        return;
+    }
+
+    db::QueryDataSorter sorter(_queryData);
+    std::vector<int> order = sorter.sortedRows(columns);
+
+    if (static_cast<int>(order.size()) != sourceRowCount()) {
+        return; // data and model are out of sync, nothing to install
+    }
+
+    setOrder(std::move(order));
+}
+
+void QueryDataSortFilterProxyModel::setOrder(std::vector<int> && order)
+{
+    if (order.empty() && _order.empty()) {
+        return; // already in source order
+    }
+
+    emit layoutAboutToBeChanged(QList<QPersistentModelIndex>(),
+                                QAbstractItemModel::VerticalSortHint);
+
+    const QModelIndexList fromIndexes = persistentIndexList();
+    std::vector<int> sourceRows;
+    sourceRows.reserve(static_cast<std::size_t>(fromIndexes.size()));
+    for (const QModelIndex & index : fromIndexes) {
+        std::size_t row = static_cast<std::size_t>(index.row());
+        sourceRows.push_back(row < _proxyToSource.size()
+                             ? _proxyToSource[row] : -1);
+    }
+
+    _order = std::move(order);
+    _proxyToSource = visibleRows(); // same rows, new order
+    updateSourceToProxy();
+
+    QModelIndexList toIndexes;
+    toIndexes.reserve(fromIndexes.size());
+    for (int i = 0; i < fromIndexes.size(); ++i) {
+        int sourceRow = sourceRows[static_cast<std::size_t>(i)];
+        int proxyRow = sourceRow >= 0
+                ? _sourceToProxy[static_cast<std::size_t>(sourceRow)] : -1;
+        toIndexes << (proxyRow >= 0
+                      ? createIndex(proxyRow, fromIndexes[i].column())
+                      : QModelIndex());
+    }
+    changePersistentIndexList(fromIndexes, toIndexes);
+
+    emit layoutChanged(QList<QPersistentModelIndex>(),
+                       QAbstractItemModel::VerticalSortHint);
+}
+
+void QueryDataSortFilterProxyModel::setQuickFilter(const QString & pattern,
+                                                   bool regexp)
+{
+    QString prevPattern = _filter.pattern();
+    bool prevRegexp = _filter.patternIsRegexp();
+
+    _filter.setPattern(pattern, regexp);
+
+    _fallbackFilter = QRegExp(pattern,
+                              Qt::CaseInsensitive,
+                              regexp ? QRegExp::RegExp : QRegExp::Wildcard);
+
+    if (_filter.canMatch()) {
+        if (_useFilterMatches && _filter.narrows(prevPattern, prevRegexp)) {
+            _filterMatches = _filter.matchRows(_filterMatches);
+        } else {
+            _filterMatches = _filter.matchRows();
+        }
+        _useFilterMatches = true;
+    } else { // e.g. editing
+        _filterMatches.clear();
+        _useFilterMatches = false;
+    }
+
+    if (sourceModel()) {
+        refilter(); // rows are removed/inserted, not reset
+    }
+}
+
+void QueryDataSortFilterProxyModel::refilter()
+{
+    std::vector<int> rows = visibleRows();
+
+    std::vector<char> isVisible(static_cast<std::size_t>(sourceRowCount()), 0);
+    for (int row : rows) {
+        isVisible[static_cast<std::size_t>(row)] = 1;
+    }
+
+    auto isHidden = [&](int proxyRow) {
+        return !isVisible[
+            static_cast<std::size_t>(_proxyToSource[
+                static_cast<std::size_t>(proxyRow)])];
+    };
+
+    // remove from the end, so positions of runs before stay valid
+    for (int proxyRow = rowCount() - 1; proxyRow >= 0; ) {
+        if (!isHidden(proxyRow)) {
+            --proxyRow;
+            continue;
+        }
+        int last = proxyRow;
+        while (proxyRow >= 0 && isHidden(proxyRow)) {
+            --proxyRow;
+        }
+        int first = proxyRow + 1;
+        beginRemoveRows(QModelIndex(), first, last);
+        _proxyToSource.erase(_proxyToSource.begin() + first,
+                             _proxyToSource.begin() + last + 1);
+        updateSourceToProxy();
+        endRemoveRows();
+    }
+
+    // what's left is a subsequence of rows, so rows before a missing run
+    // are in place and the run goes right at its position in rows
+    for (std::size_t i = 0; i < rows.size(); ) {
+        if (_sourceToProxy[static_cast<std::size_t>(rows[i])] >= 0) {
+            ++i;
+            continue;
+        }
+        std::size_t first = i;
+        while (i < rows.size()
+               && _sourceToProxy[static_cast<std::size_t>(rows[i])] < 0) {
+            ++i;
+        }
+        int position = static_cast<int>(first);
+        beginInsertRows(QModelIndex(),
+                        position,
+                        position + static_cast<int>(i - first) - 1);
+        _proxyToSource.insert(_proxyToSource.begin() + position,
+                              rows.begin() + static_cast<std::ptrdiff_t>(first),
+                              rows.begin() + static_cast<std::ptrdiff_t>(i));
+        updateSourceToProxy();
+        endInsertRows();
+    }
+}
+
+bool QueryDataSortFilterProxyModel::acceptsRow(int sourceRow) const
+{
+    if (_queryData->isRowInsertedButNotSaved(sourceRow)) {
+        return true; // always show new inserted rows for editing
+    }
+    std::size_t row = static_cast<std::size_t>(sourceRow);
+    if (_useFilterMatches && row < _filterMatches.size()) {
+        return _filterMatches[row];
+    }
+    if (_fallbackFilter.isEmpty()) {
+        return true;
+    }
+    int columnCount = sourceModel()->columnCount();
+    for (int column = 0; column < columnCount; ++column) {
+        QString text = sourceModel()->index(sourceRow, column).data().toString();
+        if (text.contains(_fallbackFilter)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int QueryDataSortFilterProxyModel::sourceRowCount() const
+{
+    return sourceModel() ? sourceModel()->rowCount() : 0;
+}
+
+std::vector<int> QueryDataSortFilterProxyModel::visibleRows() const
+{
+    std::vector<int> rows;
+    int count = sourceRowCount();
+    rows.reserve(static_cast<std::size_t>(count));
+    if (_order.empty()) {
+        for (int row = 0; row < count; ++row) {
+            if (acceptsRow(row)) {
+                rows.push_back(row);
+            }
+        }
+    } else {
+        for (int row : _order) {
+            if (acceptsRow(row)) {
+                rows.push_back(row);
+            }
+        }
+    }
+    return rows;
+}
+
+void QueryDataSortFilterProxyModel::updateSourceToProxy()
+{
+    _sourceToProxy.assign(static_cast<std::size_t>(sourceRowCount()), -1);
+    for (std::size_t i = 0; i < _proxyToSource.size(); ++i) {
+        _sourceToProxy[static_cast<std::size_t>(_proxyToSource[i])]
+            = static_cast<int>(i);
+    }
+}
+
+void QueryDataSortFilterProxyModel::resetMapping()
+{
+    _order.clear();
+    if (_useFilterMatches && sourceModel()) {
+        _filterMatches = _filter.matchRows();
+    }
+    _proxyToSource = visibleRows();
+    updateSourceToProxy();
+}
+
+void QueryDataSortFilterProxyModel::updateFilterMatches(int first, int last)
+{
+    std::size_t size = _filterMatches.size();
+    std::size_t count = static_cast<std::size_t>(last - first + 1);
+
+    if (static_cast<std::size_t>(first) < size) {
+        // new rows for editing are always shown
+        _filterMatches.insert(_filterMatches.begin() + first, count, 1);
+    } else if (static_cast<std::size_t>(first) == size
+               && _filter.canMatch()) {
+        // loaded rows are already in data
+        std::vector<char> matches = _filter.matchRowsFrom(size);
+        std::size_t end = std::min(matches.size(),
+                                   static_cast<std::size_t>(last + 1));
+        if (end > size) {
+            _filterMatches.insert(_filterMatches.end(),
+                                  matches.begin() + size,
+                                  matches.begin() + end);
+        }
+    }
+}
+
+void QueryDataSortFilterProxyModel::onSourceRowsInserted(int first, int last)
+{
+    int count = last - first + 1;
+
+    for (int & row : _proxyToSource) {
+        if (row >= first) {
+            row += count;
+        }
+    }
+    if (!_order.empty()) {
+        for (int & row : _order) {
+            if (row >= first) {
+                row += count;
+            }
+        }
+        for (int row = first; row <= last; ++row) {
+            _order.push_back(row); // inserted after sort go last
+        }
+    }
+    if (_useFilterMatches) {
+        updateFilterMatches(first, last);
+    }
+    updateSourceToProxy(); // positions are the same, rows are shifted
+
+    std::vector<int> rows;
+    for (int row = first; row <= last; ++row) {
+        if (acceptsRow(row)) {
+            rows.push_back(row);
+        }
+    }
+    if (rows.empty()) {
+        return;
+    }
+
+    int position = rowCount();
+    if (_order.empty()) { // source order: before first row after inserted
+        position = static_cast<int>(
+            std::lower_bound(_proxyToSource.begin(), _proxyToSource.end(),
+                             first) - _proxyToSource.begin());
+    }
+
+    beginInsertRows(QModelIndex(),
+                    position,
+                    position + static_cast<int>(rows.size()) - 1);
+    _proxyToSource.insert(_proxyToSource.begin() + position,
+                          rows.begin(), rows.end());
+    updateSourceToProxy();
+    endInsertRows();
+}
+
+void QueryDataSortFilterProxyModel::onSourceRowsAboutToBeRemoved(int first,
+                                                                 int last)
+{
+    std::vector<int> proxyRows;
+    for (int row = first; row <= last; ++row) {
+        std::size_t i = static_cast<std::size_t>(row);
+        if (i < _sourceToProxy.size() && _sourceToProxy[i] >= 0) {
+            proxyRows.push_back(_sourceToProxy[i]);
+        }
+    }
+    std::sort(proxyRows.begin(), proxyRows.end());
+
+    // remove contiguous runs from the end
+    while (!proxyRows.empty()) {
+        int runLast = proxyRows.back();
+        int runFirst = runLast;
+        proxyRows.pop_back();
+        while (!proxyRows.empty() && proxyRows.back() == runFirst - 1) {
+            runFirst = proxyRows.back();
+            proxyRows.pop_back();
+        }
+        beginRemoveRows(QModelIndex(), runFirst, runLast);
+        _proxyToSource.erase(_proxyToSource.begin() + runFirst,
+                             _proxyToSource.begin() + runLast + 1);
+        updateSourceToProxy();
+        endRemoveRows();
+    }
+}
+
+void QueryDataSortFilterProxyModel::onSourceRowsRemoved(int first, int last)
+{
+    int count = last - first + 1;
+
+    for (int & row : _proxyToSource) {
+        if (row > last) {
+            row -= count;
+        }
+    }
+    if (!_order.empty()) {
+        _order.erase(std::remove_if(_order.begin(), _order.end(),
+                                    [=](int row) {
+                                        return row >= first && row <= last;
+                                    }),
+                     _order.end());
+        for (int & row : _order) {
+            if (row > last) {
+                row -= count;
+            }
+        }
+    }
+    eraseRows(_filterMatches, first, last);
+    eraseRows(_sourceToProxy, first, last);
+}
+
+void QueryDataSortFilterProxyModel::onSourceDataChanged(
+        const QModelIndex &topLeft,
+        const QModelIndex &bottomRight,
+        const QVector<int> &roles)
 {
-     if (_queryData->isRowInsertedButNotSaved(sourceRow)) {
-         return true; // always show new inserted rows for editing
-     }
-     return QSortFilterProxyModel::filterAcceptsRow(sourceRow, sourceParent);
+    int firstProxyRow = -1;
+    int lastProxyRow = -1;
+    for (int row = topLeft.row(); row <= bottomRight.row(); ++row) {
+        std::size_t i = static_cast<std::size_t>(row);
+        if (i >= _sourceToProxy.size() || _sourceToProxy[i] < 0) {
+            continue;
+        }
+        int proxyRow = _sourceToProxy[i];
+        if (firstProxyRow < 0 || proxyRow < firstProxyRow) {
+            firstProxyRow = proxyRow;
+        }
+        lastProxyRow = std::max(lastProxyRow, proxyRow);
+    }
+    if (firstProxyRow < 0) {
+        return;
+    }
+    emit dataChanged(index(firstProxyRow, topLeft.column()),
+                     index(lastProxyRow, bottomRight.column()),
+                     roles);
 }
 
 } // namespace models
@@ -1,7 +1,11 @@
 #ifndef QUERY_DATA_SORT_FILTER_PROXY_MODEL_H
 #define QUERY_DATA_SORT_FILTER_PROXY_MODEL_H
 
-#include <QSortFilterProxyModel>
+#include <vector>
+#include <QAbstractProxyModel>
+#include <QRegExp>
+#include "db/query_data_filter.h"
+#include "db/query_data_sorter.h"
 
 namespace meow {
 
@@ -12,19 +16,73 @@ namespace db {
 namespace ui {
 namespace models {
 
-class QueryDataSortFilterProxyModel : public QSortFilterProxyModel
+// Intent: sorts and filters rows of a flat table model over QueryData.
+// Sorted order is the permutation of QueryDataSorter installed as is (no
+// re-sort by comparing rows), filter keeps the order and hides rows
+class QueryDataSortFilterProxyModel : public QAbstractProxyModel
 {
 public:
     QueryDataSortFilterProxyModel(meow::db::QueryData * queryData,
                                   QObject *parent = nullptr);
     virtual ~QueryDataSortFilterProxyModel() override;
 
-protected:
-    bool filterAcceptsRow(int sourceRow,
-                          const QModelIndex &sourceParent) const override;
+    virtual void setSourceModel(QAbstractItemModel * sourceModel) override;
+
+    virtual QModelIndex index(int row, int column,
+                        const QModelIndex &parent = QModelIndex()) const override;
+    virtual QModelIndex parent(const QModelIndex &child) const override;
+    virtual int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    virtual int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    virtual QModelIndex mapToSource(const QModelIndex &proxyIndex) const override;
+    virtual QModelIndex mapFromSource(const QModelIndex &sourceIndex) const override;
+
+    // Sorts by QueryDataSorter, column < 0 restores source order
+    virtual void sort(int column,
+                      Qt::SortOrder order = Qt::AscendingOrder) override;
+    // Multi-column sort, empty list restores source order
+    void sortByColumns(
+            const std::vector<db::QueryDataSorter::SortColumn> & columns);
+
+    // Filters rows by QueryDataFilter, wildcard or regexp (case insensitive,
+    // any column). When a pattern narrows the previous one only its matched
+    // rows are scanned
+    void setQuickFilter(const QString & pattern, bool regexp);
 
 private:
+    bool acceptsRow(int sourceRow) const;
+    int sourceRowCount() const;
+    // accepted source rows in current order
+    std::vector<int> visibleRows() const;
+    void updateSourceToProxy();
+    void resetMapping();
+
+    // installs order (source order if empty) as a layout change
+    void setOrder(std::vector<int> && order);
+    // hides/shows rows by removing/inserting them, order is kept
+    void refilter();
+
+    // keeps filter matches for inserted rows
+    void updateFilterMatches(int first, int last);
+
+    void onSourceRowsInserted(int first, int last);
+    void onSourceRowsAboutToBeRemoved(int first, int last);
+    void onSourceRowsRemoved(int first, int last);
+    void onSourceDataChanged(const QModelIndex &topLeft,
+                             const QModelIndex &bottomRight,
+                             const QVector<int> &roles);
+
     meow::db::QueryData * _queryData;
+    // all source rows in sorted order, empty: source order.
+    // Rows inserted after sort go last
+    std::vector<int> _order;
+    std::vector<int> _proxyToSource;
+    std::vector<int> _sourceToProxy; // -1 if filtered out
+    db::QueryDataFilter _filter;
+    // source row -> accepted, rows out of it are matched by _fallbackFilter
+    std::vector<char> _filterMatches;
+    bool _useFilterMatches;
+    QRegExp _fallbackFilter; // matches display text
 };
 
 } // namespace models
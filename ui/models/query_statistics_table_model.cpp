@@ -0,0 +1,240 @@
+#include "query_statistics_table_model.h"
+#include "db/connection.h"
+#include "helpers/formatting.h"
+
+namespace meow {
+namespace ui {
+namespace models {
+
+QueryStatisticsTableModel::QueryStatisticsTableModel(QObject *parent)
+    : QAbstractTableModel(parent)
+    , _session(nullptr)
+    , _snapshotVersion(0)
+{
+
+}
+
+int QueryStatisticsTableModel::columnCount(const QModelIndex &parent) const
+{
+    Q_UNUSED(parent);
+    return static_cast<int>(Columns::Count);
+}
+
+int QueryStatisticsTableModel::rowCount(const QModelIndex &parent) const
+{
+    Q_UNUSED(parent);
+    return _session ? static_cast<int>(Rows::Count) : 0;
+}
+
+Qt::ItemFlags QueryStatisticsTableModel::flags(const QModelIndex &index) const
+{
+    if (!index.isValid()) {
+        return Qt::ItemIsEnabled;
+    }
+
+    return QAbstractItemModel::flags(index);
+}
+
+QVariant QueryStatisticsTableModel::headerData(int section,
+                                               Qt::Orientation orientation,
+                                               int role) const
+{
+    if (role != Qt::DisplayRole) {
+        return QVariant();
+    }
+
+    if (orientation == Qt::Horizontal) {
+        switch (static_cast<Columns>(section)) {
+        case Columns::Phase:
+            return QString(tr("Phase"));
+
+        case Columns::LastQuery:
+            return QString(tr("Last query, ms"));
+
+        case Columns::Total:
+            return QString(tr("Total, ms"));
+
+        case Columns::Average:
+            return QString(tr("Average per query, ms"));
+
+        case Columns::Share:
+            return QString(tr("Share of total"));
+
+        default:
+            break;
+        }
+    }
+
+    return QVariant();
+}
+
+QVariant QueryStatisticsTableModel::data(const QModelIndex &index,
+                                         int role) const
+{
+    if (!index.isValid() || index.row() >= rowCount()) {
+        return QVariant();
+    }
+
+    Rows row = static_cast<Rows>(index.row());
+    Columns column = static_cast<Columns>(index.column());
+
+    if (role == Qt::TextAlignmentRole) {
+        if (column != Columns::Phase) {
+            return static_cast<int>(Qt::AlignRight | Qt::AlignVCenter);
+        }
+        return QVariant();
+    }
+
+    if (role == Qt::ToolTipRole && row == Rows::FirstByte) {
+        return tr("From sending of query till the first row is received."
+                  " Overlaps execution and transfer, not a part of total");
+    }
+
+    if (role != Qt::DisplayRole) {
+        return QVariant();
+    }
+
+    switch (column) {
+
+    case Columns::Phase:
+        switch (row) {
+        case Rows::Exec:
+            return tr("Server execution");
+        case Rows::FirstByte:
+            return tr("First row");
+        case Rows::Fetch:
+            return tr("Transfer");
+        case Rows::Decode:
+            return tr("Decoding");
+        case Rows::EditablePrepare:
+            return tr("Editable copy");
+        case Rows::ModelPopulate:
+            return tr("Grid population");
+        case Rows::Total:
+            return tr("Total");
+        default:
+            break;
+        }
+        break;
+
+    case Columns::LastQuery:
+        return helpers::formatAsMilliseconds(
+            phaseDuration(_snapshot.last, row));
+
+    case Columns::Total:
+        return helpers::formatAsMilliseconds(
+            phaseDuration(_snapshot.total, row));
+
+    case Columns::Average:
+        if (_snapshot.queryCount > 0) {
+            return helpers::formatAsMilliseconds(
+                phaseDuration(_snapshot.total, row)
+                    / static_cast<int64_t>(_snapshot.queryCount));
+        }
+        break;
+
+    case Columns::Share: {
+        if (row == Rows::FirstByte) {
+            break;
+        }
+        int64_t total = _snapshot.total.total().count();
+        if (total > 0) {
+            double share = phaseDuration(_snapshot.total, row).count()
+                    * 100.0 / total;
+            return QString("%1 %").arg(share, 0, 'f', 1);
+        }
+        break;
+    }
+
+    default:
+        break;
+    }
+
+    return QVariant();
+}
+
+int QueryStatisticsTableModel::columnWidth(int column) const
+{
+    switch (static_cast<Columns>(column)) {
+    case Columns::Phase:
+        return 180;
+    case Columns::Average:
+        return 170;
+    default:
+        return 130;
+    }
+}
+
+void QueryStatisticsTableModel::setSession(meow::db::SessionEntity * session)
+{
+    if (_session == session) {
+        return;
+    }
+
+    beginResetModel();
+    _session = session;
+    _snapshot = meow::db::QueryStatistics::Snapshot();
+    _snapshotVersion = 0;
+    if (statistics()) {
+        _snapshot = statistics()->snapshot();
+        _snapshotVersion = statistics()->version();
+    }
+    endResetModel();
+}
+
+void QueryStatisticsTableModel::refresh()
+{
+    meow::db::QueryStatistics * stats = statistics();
+    if (!stats || stats->version() == _snapshotVersion) {
+        return;
+    }
+
+    _snapshotVersion = stats->version();
+    _snapshot = stats->snapshot();
+
+    emit dataChanged(index(0, static_cast<int>(Columns::LastQuery)),
+                     index(rowCount() - 1, columnCount() - 1));
+}
+
+void QueryStatisticsTableModel::reset()
+{
+    if (statistics()) {
+        statistics()->reset();
+    }
+    refresh();
+}
+
+meow::db::QueryStatistics * QueryStatisticsTableModel::statistics() const
+{
+    if (_session) {
+        return _session->connection()->queryStatistics();
+    }
+    return nullptr;
+}
+
+std::chrono::microseconds QueryStatisticsTableModel::phaseDuration(
+        const meow::db::QueryTimings & timings, Rows row)
+{
+    switch (row) {
+    case Rows::Exec:
+        return timings.exec;
+    case Rows::FirstByte:
+        return timings.firstByte;
+    case Rows::Fetch:
+        return timings.fetch;
+    case Rows::Decode:
+        return timings.decode;
+    case Rows::EditablePrepare:
+        return timings.editablePrepare;
+    case Rows::ModelPopulate:
+        return timings.modelPopulate;
+    case Rows::Total:
+        return timings.total();
+    default:
+        return std::chrono::microseconds(0);
+    }
+}
+
+} // namespace models
+} // namespace ui
+} // namespace meow
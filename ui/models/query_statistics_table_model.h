@@ -0,0 +1,79 @@
+#ifndef MODELS_QUERY_STATISTICS_TABLE_MODEL_H
+#define MODELS_QUERY_STATISTICS_TABLE_MODEL_H
+
+#include <QAbstractTableModel>
+#include "db/entity/session_entity.h"
+#include "db/query_statistics.h"
+
+// Main Window
+//   Central Right Widget
+//     Host Tab
+//       Statistics Tab
+//         Query Statistics Model
+
+namespace meow {
+namespace ui {
+namespace models {
+
+// Intent: timings of session's queries by phases
+class QueryStatisticsTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+public:
+
+    enum class Columns {
+        Phase = 0,
+        LastQuery,
+        Total,
+        Average,
+        Share,
+        Count
+    };
+
+    enum class Rows {
+        Exec = 0,
+        FirstByte,
+        Fetch,
+        Decode,
+        EditablePrepare,
+        ModelPopulate,
+        Total,
+        Count
+    };
+
+    QueryStatisticsTableModel(QObject *parent = nullptr);
+
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+    QVariant data(const QModelIndex &index, int role) const override;
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    int columnWidth(int column) const;
+    void setSession(meow::db::SessionEntity * session);
+    // takes new snapshot if statistics changed
+    void refresh();
+    void reset();
+
+    const meow::db::QueryStatistics::Snapshot & snapshot() const {
+        return _snapshot;
+    }
+
+private:
+
+    meow::db::QueryStatistics * statistics() const;
+
+    static std::chrono::microseconds phaseDuration(
+            const meow::db::QueryTimings & timings, Rows row);
+
+    meow::db::SessionEntity * _session;
+    meow::db::QueryStatistics::Snapshot _snapshot;
+    uint64_t _snapshotVersion;
+};
+
+} // namespace models
+} // namespace ui
+} // namespace meow
+
+#endif // MODELS_QUERY_STATISTICS_TABLE_MODEL_H
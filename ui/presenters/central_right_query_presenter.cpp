@@ -2,7 +2,9 @@
 #include "db/user_query/user_query.h"
 #include "db/user_query/sentences_parser.h"
 #include "db/connection_query_killer.h"
+#include "threads/file_queries_task.h"
 #include "helpers/formatting.h"
+#include <QFileInfo>
 
 namespace meow {
 namespace ui {
@@ -47,6 +49,68 @@ bool CentralRightQueryPresenter::execQueries(
     return true;
 }
 
+void CentralRightQueryPresenter::execFile(const QString & fileName)
+{
+    _query->runFileInCurrentConnection(fileName);
+}
+
+bool CentralRightQueryPresenter::isFileRun() const
+{
+    return _query->fileQueriesTask() != nullptr;
+}
+
+bool CentralRightQueryPresenter::canResumeFile() const
+{
+    threads::FileQueriesTask * task = _query->fileQueriesTask();
+    return task && !isRunning() && task->canResume();
+}
+
+void CentralRightQueryPresenter::resumeFile(bool skipFailed)
+{
+    threads::FileQueriesTask * task = _query->fileQueriesTask();
+    Q_ASSERT(task);
+    QString fileName = task->fileName();
+    db::user_query::ScriptPosition start = skipFailed
+            ? task->nextPosition()
+            : task->failedPosition();
+    _query->runFileInCurrentConnection(fileName, start); // task is gone
+}
+
+int CentralRightQueryPresenter::fileFailedStatementNumber() const
+{
+    threads::FileQueriesTask * task = _query->fileQueriesTask();
+    return task ? task->failedPosition().statementIndex + 1 : 0;
+}
+
+QString CentralRightQueryPresenter::fileProgressText() const
+{
+    threads::FileQueriesTask * task = _query->fileQueriesTask();
+    if (!task) return QString();
+
+    QString text = QObject::tr("%1: %2 statements, %3 of %4")
+        .arg(QFileInfo(task->fileName()).fileName())
+        .arg(helpers::formatNumber(
+                 static_cast<unsigned long long>(task->statementsDone())))
+        .arg(helpers::formatByteSize(
+                 static_cast<helpers::byteSize>(task->bytesDone())))
+        .arg(helpers::formatByteSize(
+                 static_cast<helpers::byteSize>(task->fileSize())));
+
+    if (task->fileSize() > 0) {
+        text += QString(" (%1%)").arg(task->bytesDone() * 100
+                                      / task->fileSize());
+    }
+
+    text += QObject::tr(", %1 statements/s, %2/s, %3 sec.")
+        .arg(helpers::formatNumber(
+                 static_cast<unsigned long long>(task->statementsPerSecond())))
+        .arg(helpers::formatByteSize(
+                 static_cast<helpers::byteSize>(task->bytesPerSecond())))
+        .arg(helpers::formatAsSeconds(task->elapsed()));
+
+    return text;
+}
+
 bool CentralRightQueryPresenter::hasError() const
 {
     return !_query->lastError().isEmpty();
@@ -67,6 +131,16 @@ db::QueryDataPtr CentralRightQueryPresenter::resultsDataAt(int index) const
     return _query->resultsDataAt(index);
 }
 
+bool CentralRightQueryPresenter::isRunInParallel() const
+{
+    return _query->isRunInParallel();
+}
+
+void CentralRightQueryPresenter::setRunInParallel(bool parallel)
+{
+    _query->setRunInParallel(parallel);
+}
+
 QString CentralRightQueryPresenter::resultTabCaption(int index) const
 {
     meow::db::QueryDataPtr queryData = _query->resultsDataAt(index);
@@ -98,10 +172,11 @@ bool CentralRightQueryPresenter::cancelQueries()
 
     if (!connection) return true;
 
-    db::ConnectionQueryKillerPtr killer = connection->createQueryKiller();
-
     try {
-        killer->run();
+        connection->createQueryKiller()->run();
+        for (const db::ConnectionPtr & sibling : _query->parallelConnections()) {
+            sibling->createQueryKiller()->run();
+        }
     } catch(meow::db::Exception & ex) {
         _lastCancelError = ex.message();
         return false;
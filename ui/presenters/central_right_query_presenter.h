@@ -35,6 +35,16 @@ public:
 
     bool execQueries(const QString & SQL, int charPosition = -1);
 
+    // Runs SQL script file in place, without loading into editor
+    void execFile(const QString & fileName);
+    bool isFileRun() const;
+    // last file run stopped on error and can go on from failed statement
+    bool canResumeFile() const;
+    // skipFailed: go on after failed statement instead of running it again
+    void resumeFile(bool skipFailed);
+    int fileFailedStatementNumber() const;
+    QString fileProgressText() const;
+
     bool hasError() const;
 
     QString lastError() const;
@@ -55,6 +65,17 @@ public:
 
     bool isCancelQueryActionEnabled() const;
 
+    bool isExecFileActionEnabled() const {
+        return !isRunning();
+    }
+
+    bool isRunInParallelActionEnabled() const {
+        return !isRunning();
+    }
+
+    bool isRunInParallel() const;
+    void setRunInParallel(bool parallel);
+
     // false on error
     bool cancelQueries();
 
@@ -1,4 +1,5 @@
 #include "export_database_form.h"
+#include "db/common.h"
 #include "db/connection.h"
 #include "db/entity/session_entity.h"
 
@@ -13,11 +14,14 @@ namespace presenters {
 
 ExportDatabaseForm::ExportDatabaseForm(db::SessionEntity * session)
     : _session(session)
-    , _dumper(new meow::utils::exporting::MySQLDumpConsole(this))
-    , _filename(generateFilename())
+    , _dumper(new meow::utils::exporting::MySQLDumper(this))
     , _filenameChangedByUser(false)
+    , _compress(false)
+    , _rowsPerInsert(1000)
+    , _parallelConnections(db::PARALLEL_QUERIES_CONNECTIONS)
     , _options(0)
 {
+    _filename = generateFilename();
     resetOptionsToDefault();
 }
 
@@ -41,6 +45,37 @@ void ExportDatabaseForm::setFilename(const QString & name)
     }
 }
 
+void ExportDatabaseForm::setCompress(bool compress)
+{
+    if (_compress != compress) {
+        _compress = compress;
+        if (_filenameChangedByUser == false) {
+            _filename = generateFilename();
+        } else if (compress && !_filename.endsWith(".gz")) {
+            _filename += ".gz";
+        } else if (!compress && _filename.endsWith(".gz")) {
+            _filename.chop(3);
+        }
+        emit optionsChanged();
+    }
+}
+
+void ExportDatabaseForm::setRowsPerInsert(int rows)
+{
+    if (_rowsPerInsert != rows) {
+        _rowsPerInsert = rows;
+        emit optionsChanged();
+    }
+}
+
+void ExportDatabaseForm::setParallelConnections(int count)
+{
+    if (_parallelConnections != count) {
+        _parallelConnections = count;
+        emit optionsChanged();
+    }
+}
+
 const QStringList ExportDatabaseForm::databases() const
 {
     QStringList list;
@@ -71,7 +106,7 @@ QString ExportDatabaseForm::generateFilename() const
     // add datetime for uniqueness and sorting
     dumpName += QDateTime::currentDateTime().toString("-yyyy-MM-dd-HH-mm-ss");
 
-    dumpName += ".sql";
+    dumpName += _compress ? ".sql.gz" : ".sql";
 
     return QDir::toNativeSeparators(
         QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation)
@@ -81,16 +116,19 @@ QString ExportDatabaseForm::generateFilename() const
 
 void ExportDatabaseForm::startExport()
 {
-    // TODO: need to reset each time?
-    _dumper.reset(new meow::utils::exporting::MySQLDumpConsole(this));
+    if (_dumper->isRunning()) {
+        return;
+    }
+
+    _dumper.reset(new meow::utils::exporting::MySQLDumper(this));
 
     connect(_dumper.get(),
-            &meow::utils::exporting::MySQLDumpConsole::finished,
+            &meow::utils::exporting::MySQLDumper::finished,
             this,
             &ExportDatabaseForm::finished);
 
     connect(_dumper.get(),
-            &meow::utils::exporting::MySQLDumpConsole::progressMessage,
+            &meow::utils::exporting::MySQLDumper::progressMessage,
             this,
             &ExportDatabaseForm::progressMessage);
 
@@ -232,13 +270,11 @@ void ExportDatabaseForm::resetOptionsToDefault()
     //setOption(MySQLDumpOption::NoData, false);
     setOption(MySQLDumpOption::Routines, true);
     setOption(MySQLDumpOption::Triggers, true);
-    setOption(MySQLDumpOption::NoColumnStatistics,
-              _dumper->supportsColumnStatisticsOption());
 }
 
-QString ExportDatabaseForm::currentCommand() const
+QString ExportDatabaseForm::description() const
 {
-    return _dumper->currentCommand();
+    return _dumper->description();
 }
 
 } // namespace presenters
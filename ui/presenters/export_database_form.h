@@ -2,7 +2,7 @@
 #define MODELS_EXPORT_DATABASE_FORM_H
 
 #include <memory>
-#include "utils/exporting/mysql_dump_console.h"
+#include "utils/exporting/mysql_dumper.h"
 
 namespace meow {
 
@@ -12,7 +12,7 @@ namespace db {
 
 namespace utils {
 namespace exporting {
-    class MySQLDumpConsole;
+    class MySQLDumper;
 }
 }
 
@@ -35,7 +35,7 @@ enum class MySQLDumpOption
     //NoData           = (1 << 11), // --no-data // TODO
     Routines           = (1 << 12), // --routines
     Triggers           = (1 << 13), // --triggers (enabled by default)
-    NoColumnStatistics = (1 << 14), // --column-statistics=0 (v8 and higher)
+    //NoColumnStatistics = (1 << 14), // mysqldump v8+ only, not needed now
 
     // internal options:
 
@@ -77,6 +77,17 @@ public:
     void setFilename(const QString & name);
     const QString & filename() const { return _filename; }
 
+    // gzip output, changes extension of generated filename
+    void setCompress(bool compress);
+    bool compress() const { return _compress; }
+
+    // when ExtendedInsert is on
+    void setRowsPerInsert(int rows);
+    int rowsPerInsert() const { return _rowsPerInsert; }
+
+    // tables are dumped in parallel, one per connection
+    void setParallelConnections(int count);
+    int parallelConnections() const { return _parallelConnections; }
 
     meow::db::SessionEntity * session() const { return _session; }
 
@@ -89,8 +100,9 @@ public:
     }
 
     void setOption(MySQLDumpOption opt, bool enabled);
+    uint32_t options() const { return _options; }
 
-    QString currentCommand() const;
+    QString description() const;
 
     Q_SIGNAL void finished(bool success);
     Q_SIGNAL void progressMessage(const QString & str);
@@ -107,12 +119,16 @@ private:
     void setOptionPrivate(MySQLDumpOption opt, bool enabled);
 
     meow::db::SessionEntity * const _session;
-    std::unique_ptr<meow::utils::exporting::MySQLDumpConsole> _dumper;
+    std::unique_ptr<meow::utils::exporting::MySQLDumper> _dumper;
 
     QString _database;
 
     QString _filename;
     bool _filenameChangedByUser;
+    bool _compress;
+
+    int _rowsPerInsert;
+    int _parallelConnections;
 
     uint32_t _options;
 };
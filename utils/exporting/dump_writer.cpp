@@ -0,0 +1,159 @@
+#include "dump_writer.h"
+#include <QMutexLocker>
+#include <QObject>
+#include <zlib.h>
+
+namespace meow {
+namespace utils {
+namespace exporting {
+
+namespace {
+
+// fastest level, compression must keep up with the server
+const int GZIP_COMPRESSION_LEVEL = Z_BEST_SPEED;
+const int GZIP_WINDOW_BITS = 15 + 16; // +16: gzip header instead of zlib
+
+} // namespace
+
+DumpWriter::DumpWriter()
+    : _compress(false)
+    , _failed(false)
+    , _bytesWritten(0)
+    , _fileBytesWritten(0)
+{
+
+}
+
+DumpWriter::~DumpWriter()
+{
+    cancel();
+}
+
+bool DumpWriter::open(const QString & fileName, bool compress)
+{
+    _compress = compress;
+    _failed = false;
+    _error.clear();
+    _bytesWritten = 0;
+    _fileBytesWritten = 0;
+
+    _file.setFileName(fileName);
+    if (!_file.open(QIODevice::WriteOnly)) {
+        setError(_file.errorString());
+        return false;
+    }
+    return true;
+}
+
+bool DumpWriter::write(const QByteArray & chunk)
+{
+    if (chunk.isEmpty()) {
+        return true;
+    }
+
+    QByteArray compressed;
+    if (_compress && !gzip(chunk, &compressed)) { // outside of lock
+        setError(QObject::tr("Compression failed"));
+        return false;
+    }
+    const QByteArray & data = _compress ? compressed : chunk;
+
+    QMutexLocker locker(&_mutex);
+
+    if (_failed) {
+        return false;
+    }
+
+    if (_file.write(data) != data.size()) {
+        _failed = true;
+        _error = _file.errorString();
+        return false;
+    }
+
+    _bytesWritten += chunk.size();
+    _fileBytesWritten += data.size();
+
+    return true;
+}
+
+bool DumpWriter::close()
+{
+    QMutexLocker locker(&_mutex);
+
+    if (!_file.isOpen()) {
+        return !_failed;
+    }
+
+    if (_failed) {
+        _file.cancelWriting();
+        _file.commit(); // just closes
+        return false;
+    }
+
+    if (!_file.commit()) {
+        _failed = true;
+        _error = _file.errorString();
+        return false;
+    }
+
+    return true;
+}
+
+void DumpWriter::cancel()
+{
+    QMutexLocker locker(&_mutex);
+
+    if (_file.isOpen()) {
+        _file.cancelWriting();
+        _file.commit();
+    }
+}
+
+QString DumpWriter::errorString() const
+{
+    QMutexLocker locker(&_mutex);
+    return _error;
+}
+
+bool DumpWriter::gzip(const QByteArray & data, QByteArray * compressed)
+{
+    z_stream stream;
+    stream.zalloc = Z_NULL;
+    stream.zfree = Z_NULL;
+    stream.opaque = Z_NULL;
+
+    if (deflateInit2(&stream, GZIP_COMPRESSION_LEVEL, Z_DEFLATED,
+                     GZIP_WINDOW_BITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return false;
+    }
+
+    uLong sourceSize = static_cast<uLong>(data.size());
+    compressed->resize(static_cast<int>(deflateBound(&stream, sourceSize)));
+
+    stream.next_in = reinterpret_cast<Bytef *>(
+                const_cast<char *>(data.constData()));
+    stream.avail_in = static_cast<uInt>(sourceSize);
+    stream.next_out = reinterpret_cast<Bytef *>(compressed->data());
+    stream.avail_out = static_cast<uInt>(compressed->size());
+
+    int status = deflate(&stream, Z_FINISH);
+    deflateEnd(&stream);
+
+    if (status != Z_STREAM_END) {
+        return false;
+    }
+
+    compressed->resize(static_cast<int>(stream.total_out));
+    return true;
+}
+
+void DumpWriter::setError(const QString & error)
+{
+    QMutexLocker locker(&_mutex);
+    _failed = true;
+    _error = error;
+}
+
+} // namespace exporting
+} // namespace utils
+} // namespace meow
@@ -0,0 +1,56 @@
+#ifndef UTILS_EXPORTING_DUMP_WRITER_H
+#define UTILS_EXPORTING_DUMP_WRITER_H
+
+#include <atomic>
+#include <QByteArray>
+#include <QMutex>
+#include <QSaveFile>
+
+namespace meow {
+namespace utils {
+namespace exporting {
+
+// Intent: output file of dump, can be written from several threads.
+// Compressed chunks are separate gzip members (RFC 1952 allows to concatenate
+// them), so every thread compresses own chunks and only writes are
+// serialized. The file appears on close() only, nothing is left on failure
+class DumpWriter
+{
+public:
+    DumpWriter();
+    ~DumpWriter();
+
+    bool open(const QString & fileName, bool compress);
+    // thread-safe, chunk is a complete part of SQL
+    bool write(const QByteArray & chunk);
+    // false on failure, file is not created then
+    bool close();
+    // removes what was written
+    void cancel();
+
+    QString errorString() const;
+
+    // uncompressed
+    qint64 bytesWritten() const { return _bytesWritten; }
+    qint64 fileBytesWritten() const { return _fileBytesWritten; }
+
+private:
+
+    static bool gzip(const QByteArray & data, QByteArray * compressed);
+
+    void setError(const QString & error);
+
+    QSaveFile _file;
+    bool _compress;
+    bool _failed;
+    QString _error;
+    std::atomic<qint64> _bytesWritten;
+    std::atomic<qint64> _fileBytesWritten;
+    mutable QMutex _mutex;
+};
+
+} // namespace exporting
+} // namespace utils
+} // namespace meow
+
+#endif // UTILS_EXPORTING_DUMP_WRITER_H
@@ -0,0 +1,459 @@
+#include "grid_exporter.h"
+#include "db/connection_query_killer.h"
+#include "db/db_thread_initializer.h"
+#include "helpers/formatting.h"
+#include "helpers/logger.h"
+#include <algorithm>
+#include <QCoreApplication>
+
+namespace meow {
+namespace utils {
+namespace exporting {
+
+namespace {
+
+// written to file at once, compressed as one gzip member
+const int CHUNK_SIZE = 1024 * 1024;
+
+const qint64 PROGRESS_INTERVAL_MS = 250;
+
+// rows between UI updates when exported in main thread
+const qint64 MAIN_THREAD_EVENTS_ROWS = 1000;
+
+// QString::toUtf8() without allocation per cell
+void appendUtf8(const QChar * data, int length, QByteArray * out)
+{
+    int start = out->size();
+    out->resize(start + length * 3); // the most per UTF-16 unit
+    char * dest = out->data() + start;
+
+    const ushort * src = reinterpret_cast<const ushort *>(data);
+    const ushort * end = src + length;
+
+    while (src < end) {
+        uint c = *src++;
+        if (c < 0x80) {
+            *dest++ = static_cast<char>(c);
+        } else if (c < 0x800) {
+            *dest++ = static_cast<char>(0xC0 | (c >> 6));
+            *dest++ = static_cast<char>(0x80 | (c & 0x3F));
+        } else if (QChar::isHighSurrogate(c)
+                   && src < end && QChar::isLowSurrogate(*src)) {
+            uint code = QChar::surrogateToUcs4(static_cast<ushort>(c), *src++);
+            *dest++ = static_cast<char>(0xF0 | (code >> 18));
+            *dest++ = static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            *dest++ = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            *dest++ = static_cast<char>(0x80 | (code & 0x3F));
+        } else {
+            if (QChar::isSurrogate(c)) { // broken pair
+                c = QChar::ReplacementCharacter;
+            }
+            *dest++ = static_cast<char>(0xE0 | (c >> 12));
+            *dest++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+            *dest++ = static_cast<char>(0x80 | (c & 0x3F));
+        }
+    }
+
+    out->resize(static_cast<int>(dest - out->data()));
+}
+
+// binary cells are decoded as Latin-1, see MySQLQueryResult
+void appendLatin1(const QChar * data, int length, QByteArray * out)
+{
+    int start = out->size();
+    out->resize(start + length);
+    char * dest = out->data() + start;
+    for (int i = 0; i < length; ++i) {
+        dest[i] = static_cast<char>(data[i].unicode());
+    }
+}
+
+} // namespace
+
+GridExporter::GridExporter(const db::QueryDataPtr & data,
+                           const QString & wholeQuerySQL,
+                           const GridExportSettings & settings)
+    : QObject()
+    , _data(data)
+    , _wholeQuerySQL(wholeQuerySQL)
+    , _settings(settings)
+    , _sessionConnection(data->query()->connection())
+    , _editableData(nullptr)
+    , _runInMainThread(false)
+    , _isRunning(false)
+    , _isCancelled(false)
+    , _failed(false)
+    , _rowCount(0)
+    , _totalRowCount(0)
+    , _lastProgressMs(0)
+{
+    _settings.serverType
+        = _sessionConnection->connectionParams()->serverType();
+
+    connect(this, &GridExporter::exportFinished,
+            this, &GridExporter::onExportFinished,
+            Qt::QueuedConnection);
+}
+
+GridExporter::~GridExporter()
+{
+    cancel();
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+}
+
+void GridExporter::start()
+{
+    if (_isRunning) {
+        return;
+    }
+
+    // columns of loaded rows, the query gives the same ones
+    _columns.clear();
+    QStringList columnNames;
+    for (int i = 0; i < _data->columnCount(); ++i) {
+        db::RawColumn column;
+        column.name = _data->columnName(i);
+        db::DataTypeCategoryIndex category
+            = _data->columnDataTypeCategory(i);
+        column.isNumeric = category == db::DataTypeCategoryIndex::Integer
+                || category == db::DataTypeCategoryIndex::Float;
+        column.isBinary = category == db::DataTypeCategoryIndex::Binary;
+        _columns.push_back(column);
+        columnNames << column.name;
+    }
+    _settings.quotedColumns = _sessionConnection->quoteIdentifiers(
+        columnNames);
+
+    _chunks.clear();
+    _editableData = nullptr;
+    _totalRowCount = 0;
+
+    if (!_settings.wholeQuery) {
+        // the grid doesn't fetch while modal export dialog is shown, so
+        // storage stays as is till the end
+        db::QueryResultPt result = _data->currentResult();
+        if (result->isEditing()) {
+            _editableData = result->editableData();
+        } else {
+            _chunks = result->dataChunks();
+        }
+        _totalRowCount = _data->rowCount();
+    }
+
+    _format = GridFormat::create(_settings);
+    _buffer.clear();
+    _buffer.reserve(CHUNK_SIZE + CHUNK_SIZE / 4);
+    _runInMainThread = false;
+
+    _isCancelled = false;
+    _failed = false;
+    _rowCount = 0;
+    _lastProgressMs = 0;
+
+    if (_settings.wholeQuery) {
+        emit progressMessage(tr("Export all rows of: %1")
+                             .arg(_wholeQuerySQL) + QChar::LineFeed);
+    } else {
+        emit progressMessage(tr("Export %1 loaded row(s)")
+                             .arg(helpers::formatNumber(
+                                static_cast<unsigned long long>(
+                                    _totalRowCount))) + QChar::LineFeed);
+    }
+
+    if (_settings.wholeQuery && !openConnection()) {
+        emit finished(false);
+        return;
+    }
+
+    if (!_writer.open(_settings.fileName, _settings.compress)) {
+        emit progressMessage(tr("Unable to create %1: %2")
+                             .arg(_settings.fileName)
+                             .arg(_writer.errorString()) + QChar::LineFeed);
+        _connection.reset();
+        emit finished(false);
+        return;
+    }
+
+    _isRunning = true;
+    _timer.start();
+
+    if (_thread.joinable()) {
+        _thread.join(); // previous, already finished
+    }
+
+    if (_runInMainThread) {
+        run();
+    } else {
+        _thread = std::thread(&GridExporter::run, this);
+    }
+}
+
+bool GridExporter::cancel()
+{
+    if (!_isRunning) {
+        return false;
+    }
+
+    _isCancelled = true;
+
+    if (_connection) {
+        try {
+            _connection->createQueryKiller()->run();
+        } catch(meow::db::Exception & ex) {
+            meowLogC(Log::Category::Error) << "Export cancel failed: "
+                                           << ex.message();
+        }
+    }
+
+    return true;
+}
+
+bool GridExporter::openConnection()
+{
+    _connection.reset();
+
+    // single-threaded connection can't have a sibling (e.g. SQLite file
+    // handle is per session), its own thread is the main one then
+    _runInMainThread
+        = !_sessionConnection->features()->supportsMultithreading();
+
+    if (_runInMainThread) {
+        return true;
+    }
+
+    // connect in main thread as UserQuery does for parallel queries
+    _connection = _sessionConnection->connectionParams()->createConnection();
+    try {
+        _connection->setActive(true);
+        // unqualified names of query are in the current database
+        if (!_sessionConnection->database().isEmpty()) {
+            _connection->setDatabase(_sessionConnection->database());
+        }
+        // get id before export to allow KILL QUERY ID on cancel
+        _connection->connectionIdOnServer();
+    } catch(meow::db::Exception & ex) {
+        emit progressMessage(tr("Connection failed: %1").arg(ex.message())
+                             + QChar::LineFeed);
+        _connection.reset();
+        return false;
+    }
+
+    return true;
+}
+
+void GridExporter::onExportFinished(bool success)
+{
+    if (!_isRunning) {
+        return;
+    }
+
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+
+    _connection.reset(); // closes in main thread
+
+    _isRunning = false;
+
+    std::chrono::milliseconds elapsed(_timer.elapsed());
+
+    if (success) {
+        qint64 bytes = _writer.bytesWritten();
+        double seconds = std::max<qint64>(1, elapsed.count()) / 1000.0;
+        QString message = tr("Done: %1 rows, %2")
+            .arg(helpers::formatNumber(
+                     static_cast<unsigned long long>(_rowCount.load())))
+            .arg(helpers::formatByteSize(static_cast<helpers::byteSize>(
+                     bytes)));
+        if (_settings.compress) {
+            message += tr(" (%1 compressed)").arg(
+                helpers::formatByteSize(static_cast<helpers::byteSize>(
+                     _writer.fileBytesWritten())));
+        }
+        message += tr(" in %1 sec., %2 rows/s")
+            .arg(helpers::formatAsSeconds(elapsed))
+            .arg(helpers::formatNumber(static_cast<unsigned long long>(
+                     _rowCount.load() / seconds)));
+        emit progressMessage(message + QChar::LineFeed);
+        meowLogC(Log::Category::Info) << message;
+        emit progress(_rowCount, _totalRowCount > 0 ? _totalRowCount
+                                                    : _rowCount.load());
+    } else if (_isCancelled) {
+        emit progressMessage(tr("Cancelled") + QChar::LineFeed);
+    }
+
+    emit finished(success || _isCancelled);
+}
+
+void GridExporter::run()
+{
+    std::unique_ptr<db::DbThreadInitializer> initializer;
+    if (_connection) {
+        initializer = _connection->createThreadInitializer();
+        initializer->init();
+    }
+
+    if (_settings.wholeQuery) {
+        exportWholeQuery();
+    } else {
+        _format->begin(_columns, &_buffer);
+        exportLoadedRows();
+    }
+
+    if (!_failed && !_isCancelled) {
+        _format->end(&_buffer);
+        flush(true);
+    }
+
+    if (initializer) {
+        initializer->deinit();
+    }
+
+    bool success = !_failed && !_isCancelled;
+
+    if (success) {
+        success = _writer.close();
+        if (!success) {
+            fail(_writer.errorString());
+        }
+    } else {
+        _writer.cancel();
+    }
+
+    emit exportFinished(success);
+}
+
+void GridExporter::exportLoadedRows()
+{
+    const std::size_t columnCount = _columns.size();
+
+    // UTF-8 of current row, buffers are reused for all rows
+    std::vector<QByteArray> cells(columnCount);
+    for (QByteArray & cell : cells) {
+        cell.reserve(64); // and resize(0) keeps capacity
+    }
+    std::vector<const char *> values(columnCount);
+    std::vector<unsigned long> lengths(columnCount);
+
+    auto encodeCell = [&](std::size_t column, const QChar * data, int length) {
+        if (data == nullptr) {
+            values[column] = nullptr;
+            lengths[column] = 0;
+            return;
+        }
+        QByteArray & cell = cells[column];
+        cell.resize(0);
+        if (_columns[column].isBinary) {
+            appendLatin1(data, length, &cell);
+        } else {
+            appendUtf8(data, length, &cell);
+        }
+        values[column] = cell.constData();
+        lengths[column] = static_cast<unsigned long>(cell.size());
+    };
+
+    if (_editableData) {
+        for (int row = 0; row < _editableData->rowsCount(); ++row) {
+            for (std::size_t col = 0; col < columnCount; ++col) {
+                int length = 0;
+                const QChar * data = _editableData->cellDataAt(
+                            row, static_cast<int>(col), &length);
+                encodeCell(col, data, length);
+            }
+            if (!writeRow(values.data(), lengths.data())) {
+                return;
+            }
+        }
+        return;
+    }
+
+    for (const db::NativeQueryResult::DataChunk & chunk : _chunks) {
+        const db::ColumnarResultData * data = chunk.data;
+        for (db::ulonglong row = 0; row < data->rowCount(); ++row) {
+            for (std::size_t col = 0; col < columnCount; ++col) {
+                encodeCell(col, data->cellData(row, col),
+                           data->length(row, col));
+            }
+            if (!writeRow(values.data(), lengths.data())) {
+                return;
+            }
+        }
+    }
+}
+
+void GridExporter::exportWholeQuery()
+{
+    db::Connection * connection = _connection ? _connection.get()
+                                              : _sessionConnection;
+    try {
+        connection->streamRawRows(
+            _wholeQuerySQL,
+            [this](const std::vector<db::RawColumn> & columns) {
+                _format->begin(columns, &_buffer);
+            },
+            [this](const char * const * values,
+                   const unsigned long * lengths) {
+                return writeRow(values, lengths);
+            });
+    } catch(meow::db::Exception & ex) {
+        if (!_isCancelled) { // killed query fails as well
+            fail(ex.message());
+        }
+    }
+}
+
+bool GridExporter::writeRow(const char * const * values,
+                            const unsigned long * lengths)
+{
+    _format->writeRow(values, lengths, &_buffer);
+    ++_rowCount;
+
+    if (!flush(false)) {
+        return false;
+    }
+
+    if (_runInMainThread
+            && (_rowCount % MAIN_THREAD_EVENTS_ROWS) == 0) {
+        reportProgress();
+        QCoreApplication::processEvents(); // keep Cancel working
+    }
+
+    return !_isCancelled && !_failed;
+}
+
+bool GridExporter::flush(bool force)
+{
+    if (_buffer.isEmpty() || (!force && _buffer.size() < CHUNK_SIZE)) {
+        return true;
+    }
+    if (!_writer.write(_buffer)) {
+        fail(_writer.errorString());
+        return false;
+    }
+    _buffer.resize(0); // keeps reserved capacity
+    reportProgress();
+    return true;
+}
+
+void GridExporter::fail(const QString & error)
+{
+    if (!_failed.exchange(true)) { // the first one is the reason
+        meowLogC(Log::Category::Error) << "Export failed: " << error;
+        emit progressMessage(error + QChar::LineFeed);
+    }
+}
+
+void GridExporter::reportProgress()
+{
+    qint64 elapsedMs = _timer.elapsed();
+    if (elapsedMs - _lastProgressMs >= PROGRESS_INTERVAL_MS) {
+        _lastProgressMs = elapsedMs;
+        emit progress(_rowCount, _totalRowCount);
+    }
+}
+
+} // namespace exporting
+} // namespace utils
+} // namespace meow
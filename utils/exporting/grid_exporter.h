@@ -0,0 +1,94 @@
+#ifndef UTILS_EXPORTING_GRID_EXPORTER_H
+#define UTILS_EXPORTING_GRID_EXPORTER_H
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <QElapsedTimer>
+#include <QObject>
+#include "db/query_data.h"
+#include "dump_writer.h"
+#include "grid_formats.h"
+
+namespace meow {
+namespace utils {
+namespace exporting {
+
+// Intent: writes rows of a grid to file in a worker thread.
+// Loaded rows are read right from column buffers of result (or editable
+// data), a whole query is executed again on own connection and its rows go
+// from network to file without being stored, so any count of rows takes
+// the same memory. Cells are never converted to QVariant/QString
+class GridExporter : public QObject
+{
+    Q_OBJECT
+
+public:
+    // wholeQuerySQL selects all rows of grid, used if settings.wholeQuery
+    GridExporter(const db::QueryDataPtr & data,
+                 const QString & wholeQuerySQL,
+                 const GridExportSettings & settings);
+
+    ~GridExporter() override;
+
+    void start();
+    bool cancel();
+
+    bool isRunning() const { return _isRunning; }
+
+    Q_SIGNAL void finished(bool success);
+    Q_SIGNAL void progressMessage(const QString & str);
+    // rowsTotal is 0 if unknown
+    Q_SIGNAL void progress(qint64 rowsDone, qint64 rowsTotal);
+
+private:
+
+    // main thread
+    bool openConnection();
+    Q_SLOT void onExportFinished(bool success);
+
+    // worker thread (or main one when connection is single-threaded)
+    void run();
+    void exportLoadedRows();
+    void exportWholeQuery();
+    bool writeRow(const char * const * values, const unsigned long * lengths);
+    bool flush(bool force);
+    void fail(const QString & error);
+    void reportProgress();
+
+    Q_SIGNAL void exportFinished(bool success);
+
+    db::QueryDataPtr _data; // keeps rows alive
+    const QString _wholeQuerySQL;
+    GridExportSettings _settings;
+    db::Connection * _sessionConnection;
+
+    // of loaded rows, taken in main thread
+    std::vector<db::RawColumn> _columns;
+    std::vector<db::NativeQueryResult::DataChunk> _chunks;
+    const db::EditableGridData * _editableData; // instead of chunks
+
+    db::ConnectionPtr _connection; // own one when multi-threaded
+    bool _runInMainThread;
+
+    std::unique_ptr<GridFormat> _format;
+    DumpWriter _writer;
+    QByteArray _buffer;
+
+    std::thread _thread;
+
+    std::atomic<bool> _isRunning;
+    std::atomic<bool> _isCancelled;
+    std::atomic<bool> _failed;
+    std::atomic<qint64> _rowCount;
+    qint64 _totalRowCount;
+    qint64 _lastProgressMs; // worker only
+    QElapsedTimer _timer;
+};
+
+} // namespace exporting
+} // namespace utils
+} // namespace meow
+
+#endif // UTILS_EXPORTING_GRID_EXPORTER_H
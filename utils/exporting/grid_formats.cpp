@@ -0,0 +1,430 @@
+#include "grid_formats.h"
+#include "sql_literals.h"
+#include <algorithm>
+#include <QtEndian>
+
+namespace meow {
+namespace utils {
+namespace exporting {
+
+namespace {
+
+// as mysqldump's net_buffer_length: fits default max_allowed_packet
+const int MAX_INSERT_SIZE = 1024 * 1024 - 1024;
+
+const int COLUMNAR_MAX_GROUP_ROWS = 64 * 1024;
+const qint64 COLUMNAR_MAX_GROUP_SIZE = 16 * 1024 * 1024;
+const char COLUMNAR_MAGIC[] = "MEOWCOL1";
+
+template <typename T>
+inline void appendLittleEndian(QByteArray * out, T value)
+{
+    char bytes[sizeof(T)];
+    qToLittleEndian(value, bytes);
+    out->append(bytes, static_cast<int>(sizeof(T)));
+}
+
+inline void appendHexString(const char * value,
+                            unsigned long length,
+                            QByteArray * out)
+{
+    *out += '"';
+    appendHexDigits(*out, value, length);
+    *out += '"';
+}
+
+void appendJSONString(const char * value,
+                      unsigned long length,
+                      QByteArray * out)
+{
+    static const char DIGITS[] = "0123456789abcdef";
+
+    *out += '"';
+    unsigned long runStart = 0;
+    for (unsigned long i = 0; i < length; ++i) {
+        unsigned char c = static_cast<unsigned char>(value[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        out->append(value + runStart, static_cast<int>(i - runStart));
+        switch (c) {
+        case '"':  *out += "\\\""; break;
+        case '\\': *out += "\\\\"; break;
+        case '\n': *out += "\\n"; break;
+        case '\r': *out += "\\r"; break;
+        case '\t': *out += "\\t"; break;
+        default:
+            *out += "\\u00";
+            *out += DIGITS[c >> 4];
+            *out += DIGITS[c & 0x0F];
+        }
+        runStart = i + 1;
+    }
+    out->append(value + runStart, static_cast<int>(length - runStart));
+    *out += '"';
+}
+
+// numbers of server are JSON ones except NaN, Infinity
+inline bool isJSONNumber(const char * value, unsigned long length)
+{
+    return length > 0
+            && (value[0] == '-' || (value[0] >= '0' && value[0] <= '9'));
+}
+
+} // namespace
+
+std::unique_ptr<GridFormat> GridFormat::create(
+        const GridExportSettings & settings)
+{
+    switch (settings.format) {
+    case GridExportFormat::JSONLines:
+        return std::unique_ptr<GridFormat>(new JSONLinesGridFormat());
+    case GridExportFormat::SQLInserts:
+        return std::unique_ptr<GridFormat>(new SQLInsertsGridFormat(
+            settings.quotedTable,
+            settings.quotedColumns,
+            settings.rowsPerInsert,
+            settings.serverType));
+    case GridExportFormat::Columnar:
+        return std::unique_ptr<GridFormat>(new ColumnarGridFormat());
+    case GridExportFormat::CSV:
+    default:
+        return std::unique_ptr<GridFormat>(new CSVGridFormat(
+            settings.delimiter,
+            settings.includeHeader));
+    }
+}
+
+// CSVGridFormat ---------------------------------------------------------------
+
+CSVGridFormat::CSVGridFormat(char delimiter, bool includeHeader)
+    : _delimiter(delimiter)
+    , _includeHeader(includeHeader)
+{
+
+}
+
+void CSVGridFormat::begin(const std::vector<db::RawColumn> & columns,
+                          QByteArray * out)
+{
+    _columns = columns;
+
+    if (!_includeHeader) {
+        return;
+    }
+
+    for (std::size_t i = 0; i < _columns.size(); ++i) {
+        if (i > 0) {
+            *out += _delimiter;
+        }
+        QByteArray name = _columns[i].name.toUtf8();
+        appendField(name.constData(),
+                    static_cast<unsigned long>(name.size()), out);
+    }
+    *out += "\r\n";
+}
+
+void CSVGridFormat::writeRow(const char * const * values,
+                             const unsigned long * lengths,
+                             QByteArray * out)
+{
+    for (std::size_t i = 0; i < _columns.size(); ++i) {
+        if (i > 0) {
+            *out += _delimiter;
+        }
+        if (values[i] == nullptr) {
+            continue; // NULL
+        }
+        if (_columns[i].isBinary) {
+            appendHexDigits(*out, values[i], lengths[i]);
+        } else {
+            appendField(values[i], lengths[i], out);
+        }
+    }
+    *out += "\r\n";
+}
+
+void CSVGridFormat::appendField(const char * value,
+                                unsigned long length,
+                                QByteArray * out) const
+{
+    bool needsQuotes = (length == 0);
+    for (unsigned long i = 0; i < length && !needsQuotes; ++i) {
+        char c = value[i];
+        needsQuotes = c == _delimiter || c == '"' || c == '\n' || c == '\r';
+    }
+
+    if (!needsQuotes) {
+        out->append(value, static_cast<int>(length));
+        return;
+    }
+
+    *out += '"';
+    unsigned long runStart = 0;
+    for (unsigned long i = 0; i < length; ++i) {
+        if (value[i] != '"') {
+            continue;
+        }
+        out->append(value + runStart, static_cast<int>(i + 1 - runStart));
+        *out += '"';
+        runStart = i + 1;
+    }
+    out->append(value + runStart, static_cast<int>(length - runStart));
+    *out += '"';
+}
+
+// JSONLinesGridFormat ---------------------------------------------------------
+
+void JSONLinesGridFormat::begin(const std::vector<db::RawColumn> & columns,
+                                QByteArray * out)
+{
+    Q_UNUSED(out);
+
+    _columns = columns;
+
+    // keys are the same in every row
+    _keys.clear();
+    for (std::size_t i = 0; i < _columns.size(); ++i) {
+        QByteArray name = _columns[i].name.toUtf8();
+        QByteArray key(i == 0 ? "{" : ",");
+        appendJSONString(name.constData(),
+                         static_cast<unsigned long>(name.size()), &key);
+        key += ':';
+        _keys.push_back(key);
+    }
+}
+
+void JSONLinesGridFormat::writeRow(const char * const * values,
+                                   const unsigned long * lengths,
+                                   QByteArray * out)
+{
+    if (_columns.empty()) {
+        *out += "{}\n";
+        return;
+    }
+
+    for (std::size_t i = 0; i < _columns.size(); ++i) {
+        *out += _keys[i];
+
+        const char * value = values[i];
+        if (value == nullptr) {
+            *out += "null";
+        } else if (_columns[i].isBinary) {
+            appendHexString(value, lengths[i], out);
+        } else if (_columns[i].isNumeric && isJSONNumber(value, lengths[i])) {
+            out->append(value, static_cast<int>(lengths[i]));
+        } else {
+            appendJSONString(value, lengths[i], out);
+        }
+    }
+    *out += "}\n";
+}
+
+// SQLInsertsGridFormat --------------------------------------------------------
+
+SQLInsertsGridFormat::SQLInsertsGridFormat(const QString & quotedTable,
+                                           const QStringList & quotedColumns,
+                                           int rowsPerInsert,
+                                           db::ServerType serverType)
+    : _quotedTable(quotedTable)
+    , _quotedColumns(quotedColumns)
+    , _rowsPerInsert(std::max(1, rowsPerInsert))
+    , _serverType(serverType)
+    , _rowsInInsert(0)
+    , _insertSize(0)
+{
+
+}
+
+void SQLInsertsGridFormat::begin(const std::vector<db::RawColumn> & columns,
+                                 QByteArray * out)
+{
+    Q_UNUSED(out);
+
+    _columns = columns;
+    _rowsInInsert = 0;
+
+    _insertPrefix = ("INSERT INTO " + _quotedTable
+                     + " (" + _quotedColumns.join(", ") + ") VALUES\n")
+            .toUtf8();
+}
+
+void SQLInsertsGridFormat::writeRow(const char * const * values,
+                                    const unsigned long * lengths,
+                                    QByteArray * out)
+{
+    // out may be flushed by caller between rows, count size of statement
+    int sizeBefore = out->size();
+
+    if (_rowsInInsert == 0) {
+        *out += _insertPrefix;
+        _insertSize = 0;
+    } else {
+        *out += ",\n";
+    }
+
+    *out += '(';
+    for (std::size_t i = 0; i < _columns.size(); ++i) {
+        if (i > 0) {
+            *out += ',';
+        }
+        appendValue(values[i], lengths[i], _columns[i], out);
+    }
+    *out += ')';
+
+    _insertSize += out->size() - sizeBefore;
+    ++_rowsInInsert;
+
+    if (_rowsInInsert >= _rowsPerInsert || _insertSize >= MAX_INSERT_SIZE) {
+        *out += ";\n";
+        _rowsInInsert = 0;
+    }
+}
+
+void SQLInsertsGridFormat::end(QByteArray * out)
+{
+    if (_rowsInInsert > 0) {
+        *out += ";\n";
+        _rowsInInsert = 0;
+    }
+}
+
+void SQLInsertsGridFormat::appendValue(const char * value,
+                                       unsigned long length,
+                                       const db::RawColumn & column,
+                                       QByteArray * out) const
+{
+    if (value == nullptr) {
+        *out += "NULL";
+        return;
+    }
+
+    if (column.isNumeric && length > 0) {
+        out->append(value, static_cast<int>(length));
+        return;
+    }
+
+    if (column.isBinary) {
+        if (_serverType == db::ServerType::PostgreSQL) {
+            *out += "'\\x";
+            appendHexDigits(*out, value, length);
+            *out += "'::bytea";
+        } else {
+            *out += "X'";
+            appendHexDigits(*out, value, length);
+            *out += '\'';
+        }
+        return;
+    }
+
+    if (_serverType == db::ServerType::MySQL) {
+        appendMySQLEscaped(*out, value, length);
+    } else {
+        appendStandardQuoted(*out, value, length);
+    }
+}
+
+// ColumnarGridFormat ----------------------------------------------------------
+
+ColumnarGridFormat::ColumnarGridFormat()
+    : _groupRowCount(0)
+    , _groupDataSize(0)
+    , _totalRowCount(0)
+{
+
+}
+
+void ColumnarGridFormat::begin(const std::vector<db::RawColumn> & columns,
+                               QByteArray * out)
+{
+    _buffers.clear();
+    _buffers.resize(columns.size());
+    for (ColumnBuffer & buffer : _buffers) {
+        // and resize(0) keeps capacity
+        buffer.nulls.reserve(COLUMNAR_MAX_GROUP_ROWS / 8);
+        buffer.ends.reserve(COLUMNAR_MAX_GROUP_ROWS * 4);
+    }
+    _groupRowCount = 0;
+    _groupDataSize = 0;
+    _totalRowCount = 0;
+
+    out->append(COLUMNAR_MAGIC, sizeof(COLUMNAR_MAGIC) - 1);
+    appendLittleEndian<quint32>(out, static_cast<quint32>(columns.size()));
+
+    for (const db::RawColumn & column : columns) {
+        quint8 kind = column.isBinary ? 2 : (column.isNumeric ? 1 : 0);
+        appendLittleEndian<quint8>(out, kind);
+        QByteArray name = column.name.toUtf8();
+        appendLittleEndian<quint32>(out, static_cast<quint32>(name.size()));
+        out->append(name);
+    }
+}
+
+void ColumnarGridFormat::writeRow(const char * const * values,
+                                  const unsigned long * lengths,
+                                  QByteArray * out)
+{
+    const int bit = static_cast<int>(_groupRowCount % 8);
+
+    for (std::size_t i = 0; i < _buffers.size(); ++i) {
+        ColumnBuffer & buffer = _buffers[i];
+        if (bit == 0) {
+            buffer.nulls += '\0';
+        }
+        if (values[i] == nullptr) {
+            buffer.nulls.data()[buffer.nulls.size() - 1]
+                    |= static_cast<char>(1 << bit);
+        } else {
+            buffer.data.append(values[i], static_cast<int>(lengths[i]));
+            _groupDataSize += static_cast<qint64>(lengths[i]);
+        }
+        appendLittleEndian<quint32>(&buffer.ends,
+                                    static_cast<quint32>(buffer.data.size()));
+    }
+
+    ++_groupRowCount;
+
+    if (_groupRowCount >= COLUMNAR_MAX_GROUP_ROWS
+            || _groupDataSize >= COLUMNAR_MAX_GROUP_SIZE) {
+        flushRowGroup(out);
+    }
+}
+
+void ColumnarGridFormat::end(QByteArray * out)
+{
+    flushRowGroup(out);
+
+    appendLittleEndian<quint32>(out, 0);
+    appendLittleEndian<quint64>(out, _totalRowCount);
+    out->append(COLUMNAR_MAGIC, sizeof(COLUMNAR_MAGIC) - 1);
+}
+
+void ColumnarGridFormat::flushRowGroup(QByteArray * out)
+{
+    if (_groupRowCount == 0) {
+        return;
+    }
+
+    appendLittleEndian<quint32>(out, _groupRowCount);
+
+    for (ColumnBuffer & buffer : _buffers) {
+        quint64 blockSize = static_cast<quint64>(buffer.nulls.size())
+                + static_cast<quint64>(buffer.ends.size())
+                + static_cast<quint64>(buffer.data.size());
+        appendLittleEndian<quint64>(out, blockSize);
+        out->append(buffer.nulls);
+        out->append(buffer.ends);
+        out->append(buffer.data);
+        buffer.nulls.resize(0);
+        buffer.ends.resize(0);
+        buffer.data.resize(0);
+    }
+
+    _totalRowCount += _groupRowCount;
+    _groupRowCount = 0;
+    _groupDataSize = 0;
+}
+
+} // namespace exporting
+} // namespace utils
+} // namespace meow
@@ -0,0 +1,167 @@
+#ifndef UTILS_EXPORTING_GRID_FORMATS_H
+#define UTILS_EXPORTING_GRID_FORMATS_H
+
+#include <memory>
+#include <vector>
+#include <QByteArray>
+#include <QStringList>
+#include "db/connection.h"
+
+namespace meow {
+namespace utils {
+namespace exporting {
+
+enum class GridExportFormat
+{
+    CSV,
+    JSONLines,
+    SQLInserts,
+    Columnar
+};
+
+struct GridExportSettings
+{
+    QString fileName;
+    GridExportFormat format = GridExportFormat::CSV;
+    bool wholeQuery = false; // execute query again instead of loaded rows
+    bool compress = false; // gzip
+    char delimiter = ','; // CSV
+    bool includeHeader = true; // CSV
+    int rowsPerInsert = 1000; // SQL
+    QString quotedTable; // SQL
+    QStringList quotedColumns; // SQL
+    db::ServerType serverType = db::ServerType::MySQL; // SQL dialect
+};
+
+// Intent: formats rows of grid export to bytes of file.
+// Values come as UTF-8 (binary columns as is) straight from column buffers
+// or network, the output is appended to the given buffer which the caller
+// flushes when it's big enough
+class GridFormat
+{
+public:
+    virtual ~GridFormat() {}
+
+    virtual void begin(const std::vector<db::RawColumn> & columns,
+                       QByteArray * out) = 0;
+    // values[i] is nullptr for NULL
+    virtual void writeRow(const char * const * values,
+                          const unsigned long * lengths,
+                          QByteArray * out) = 0;
+    virtual void end(QByteArray * out) = 0;
+
+    static std::unique_ptr<GridFormat> create(
+            const GridExportSettings & settings);
+};
+
+// RFC 4180, NULL is empty unquoted and empty string is "", so they differ
+// on import; binary values are hex
+class CSVGridFormat : public GridFormat
+{
+public:
+    CSVGridFormat(char delimiter, bool includeHeader);
+
+    void begin(const std::vector<db::RawColumn> & columns,
+               QByteArray * out) override;
+    void writeRow(const char * const * values,
+                  const unsigned long * lengths,
+                  QByteArray * out) override;
+    void end(QByteArray * out) override { Q_UNUSED(out); }
+
+private:
+    void appendField(const char * value, unsigned long length,
+                     QByteArray * out) const;
+
+    const char _delimiter;
+    const bool _includeHeader;
+    std::vector<db::RawColumn> _columns;
+};
+
+// JSON object per line, numbers are unquoted, binary values are hex strings
+class JSONLinesGridFormat : public GridFormat
+{
+public:
+    void begin(const std::vector<db::RawColumn> & columns,
+               QByteArray * out) override;
+    void writeRow(const char * const * values,
+                  const unsigned long * lengths,
+                  QByteArray * out) override;
+    void end(QByteArray * out) override { Q_UNUSED(out); }
+
+private:
+    std::vector<db::RawColumn> _columns;
+    std::vector<QByteArray> _keys; // {"name": and ,"name":
+};
+
+// Multi-row INSERTs in dialect of server type
+class SQLInsertsGridFormat : public GridFormat
+{
+public:
+    SQLInsertsGridFormat(const QString & quotedTable,
+                         const QStringList & quotedColumns,
+                         int rowsPerInsert,
+                         db::ServerType serverType);
+
+    void begin(const std::vector<db::RawColumn> & columns,
+               QByteArray * out) override;
+    void writeRow(const char * const * values,
+                  const unsigned long * lengths,
+                  QByteArray * out) override;
+    void end(QByteArray * out) override;
+
+private:
+    void appendValue(const char * value, unsigned long length,
+                     const db::RawColumn & column, QByteArray * out) const;
+
+    const QString _quotedTable;
+    const QStringList _quotedColumns;
+    const int _rowsPerInsert;
+    const db::ServerType _serverType;
+    std::vector<db::RawColumn> _columns;
+    QByteArray _insertPrefix;
+    int _rowsInInsert;
+    int _insertSize; // of current statement
+};
+
+// Self-describing columnar binary file, little-endian:
+//   "MEOWCOL1", u32 column count, per column: u8 kind (0 text, 1 number as
+//   text, 2 binary), u32 name size, UTF-8 name;
+//   row groups: u32 row count, per column: u64 block size (to skip it),
+//   NULL bitmap of (rows + 7) / 8 bytes, u32 end offset of every value,
+//   bytes of values;
+//   footer: u32 0, u64 total row count, "MEOWCOL1".
+// A reader takes only columns it needs, as with Parquet
+class ColumnarGridFormat : public GridFormat
+{
+public:
+    ColumnarGridFormat();
+
+    void begin(const std::vector<db::RawColumn> & columns,
+               QByteArray * out) override;
+    void writeRow(const char * const * values,
+                  const unsigned long * lengths,
+                  QByteArray * out) override;
+    void end(QByteArray * out) override;
+
+private:
+
+    struct ColumnBuffer
+    {
+        QByteArray nulls;
+        QByteArray ends;
+        QByteArray data;
+    };
+
+    void flushRowGroup(QByteArray * out);
+
+    std::vector<ColumnBuffer> _buffers;
+    quint32 _groupRowCount;
+    qint64 _groupDataSize;
+    quint64 _totalRowCount;
+};
+
+} // namespace exporting
+} // namespace utils
+} // namespace meow
+
+#endif // UTILS_EXPORTING_GRID_FORMATS_H
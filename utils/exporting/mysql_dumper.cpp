@@ -0,0 +1,888 @@
+#include "mysql_dumper.h"
+#include "sql_literals.h"
+#include "ui/presenters/export_database_form.h"
+#include "db/entity/session_entity.h"
+#include "db/connection_query_killer.h"
+#include "db/db_thread_initializer.h"
+#include "helpers/formatting.h"
+#include "helpers/logger.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <QDateTime>
+#include <QRegularExpression>
+
+namespace meow {
+namespace utils {
+namespace exporting {
+
+namespace {
+
+// written to file at once, compressed as one gzip member
+const int CHUNK_SIZE = 1024 * 1024;
+// as mysqldump's net_buffer_length: fits default max_allowed_packet
+const int MAX_INSERT_SIZE = 1024 * 1024 - 1024;
+
+// these are not restorable
+const QStringList SYSTEM_DATABASES = {
+    "information_schema", "performance_schema", "sys"
+};
+
+// position of ')' closing the column list of SHOW CREATE TABLE, -1 if
+// none. Brackets in strings (e.g. COMMENT 'a)') and in quoted identifiers
+// are skipped as StatementSplitter does
+int columnListEnd(const QString & createCode)
+{
+    int depth = 0;
+    QChar stringEncloser; // null if not in string
+    bool inEscape = false;
+
+    for (int i = 0; i < createCode.length(); ++i) {
+        const QChar c = createCode.at(i);
+        if (!stringEncloser.isNull()) {
+            if (inEscape) {
+                inEscape = false;
+            } else if (c == '\\' && stringEncloser != '`') {
+                inEscape = true;
+            } else if (c == stringEncloser) {
+                stringEncloser = QChar(); // '' is two strings, that's ok
+            }
+            continue;
+        }
+        if (c == '\'' || c == '"' || c == '`') {
+            stringEncloser = c;
+        } else if (c == '(') {
+            ++depth;
+        } else if (c == ')' && --depth == 0) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+inline void appendValue(QByteArray & out,
+                        const char * value,
+                        unsigned long length,
+                        const db::RawColumn & column)
+{
+    if (value == nullptr) {
+        out += "NULL";
+    } else if (column.isNumeric) {
+        out.append(value, static_cast<int>(length));
+    } else if (column.isBinary && length > 0) {
+        out += "0x";
+        appendHexDigits(out, value, length);
+    } else {
+        appendMySQLEscaped(out, value, length);
+    }
+}
+
+} // namespace
+
+using Option = ui::presenters::MySQLDumpOption;
+
+MySQLDumper::MySQLDumper(ui::presenters::ExportDatabaseForm * form)
+    : QObject()
+    , _form(form)
+    , _options(0)
+    , _compress(false)
+    , _rowsPerInsert(1)
+    , _isRunning(false)
+    , _isCancelled(false)
+    , _failed(false)
+    , _rowCount(0)
+{
+    connect(this, &MySQLDumper::dumpFinished,
+            this, &MySQLDumper::onDumpFinished,
+            Qt::QueuedConnection);
+}
+
+MySQLDumper::~MySQLDumper()
+{
+    cancel();
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+}
+
+void MySQLDumper::start()
+{
+    if (_isRunning) {
+        return;
+    }
+
+    _options = _form->options();
+    _fileName = _form->filename();
+    _compress = _form->compress();
+    _rowsPerInsert = isOptionEnabled(Option::ExtendedInsert)
+            ? std::max(1, _form->rowsPerInsert()) : 1;
+
+    db::Connection * sessionConnection = _form->session()->connection();
+    if (_form->allDatabases()) {
+        _databases.clear();
+        for (const QString & database : sessionConnection->allDatabases()) {
+            if (!SYSTEM_DATABASES.contains(database, Qt::CaseInsensitive)) {
+                _databases << database;
+            }
+        }
+    } else {
+        _databases = QStringList() << _form->database();
+    }
+
+    _isCancelled = false;
+    _failed = false;
+    _rowCount = 0;
+
+    emit progressMessage(description() + QChar::LineFeed);
+
+    if (!openConnections(_form->parallelConnections())) {
+        emit finished(false);
+        return;
+    }
+
+    if (!_writer.open(_fileName, _compress)) {
+        emit progressMessage(tr("Unable to create %1: %2")
+                             .arg(_fileName).arg(_writer.errorString())
+                             + QChar::LineFeed);
+        _connections.clear();
+        emit finished(false);
+        return;
+    }
+
+    _isRunning = true;
+    _timer.start();
+
+    if (_thread.joinable()) {
+        _thread.join(); // previous, already finished
+    }
+    _thread = std::thread(&MySQLDumper::run, this);
+}
+
+bool MySQLDumper::cancel()
+{
+    if (!_isRunning) {
+        return false;
+    }
+
+    _isCancelled = true;
+
+    // rows are checked for cancel, but a query may wait for server
+    for (const db::ConnectionPtr & connection : _connections) {
+        try {
+            connection->createQueryKiller()->run();
+        } catch(meow::db::Exception & ex) {
+            meowLogC(Log::Category::Error) << "Dump cancel failed: "
+                                           << ex.message();
+        }
+    }
+
+    return true;
+}
+
+QString MySQLDumper::description() const
+{
+    QString what = _form->allDatabases()
+            ? tr("all databases")
+            : tr("database %1").arg(_form->database());
+
+    QString text = tr("Dump %1 to %2").arg(what).arg(_form->filename());
+
+    if (_form->compress()) {
+        text += tr(" (gzip)");
+    }
+
+    text += tr(", %1 connection(s)").arg(_form->parallelConnections());
+
+    if (_form->isOptionEnabled(Option::ExtendedInsert)) {
+        text += tr(", up to %1 rows per INSERT").arg(_form->rowsPerInsert());
+    } else {
+        text += tr(", one row per INSERT");
+    }
+
+    return text;
+}
+
+bool MySQLDumper::openConnections(int count)
+{
+    // connect in main thread as UserQuery does for parallel queries
+    db::Connection * sessionConnection = _form->session()->connection();
+
+    _connections.clear();
+
+    for (int i = 0; i < std::max(1, count); ++i) {
+        db::ConnectionPtr connection
+            = sessionConnection->connectionParams()->createConnection();
+        try {
+            connection->setActive(true);
+            // get id before dump to allow KILL QUERY ID on cancel
+            connection->connectionIdOnServer();
+        } catch(meow::db::Exception & ex) {
+            if (_connections.isEmpty()) {
+                emit progressMessage(tr("Connection failed: %1")
+                                     .arg(ex.message()) + QChar::LineFeed);
+                return false;
+            }
+            // take what we can
+            emit progressMessage(
+                tr("Only %1 connection(s) opened: %2")
+                    .arg(_connections.size()).arg(ex.message())
+                + QChar::LineFeed);
+            break;
+        }
+        _connections << connection;
+    }
+
+    return true;
+}
+
+void MySQLDumper::run()
+{
+    db::Connection * connection = _connections.first().get();
+
+    std::unique_ptr<db::DbThreadInitializer> initializer
+            = connection->createThreadInitializer();
+    initializer->init();
+
+    try {
+        startConsistentSnapshot();
+
+        write(headerSQL());
+
+        for (const QString & database : _databases) {
+            if (_isCancelled || _failed) break;
+            dumpDatabase(database);
+        }
+
+        write(footerSQL());
+
+        // end of read only transactions
+        for (const db::ConnectionPtr & dumpConnection : _connections) {
+            dumpConnection->query("COMMIT");
+        }
+
+    } catch(meow::db::Exception & ex) {
+        fail(ex.message());
+    }
+
+    initializer->deinit();
+
+    bool success = !_failed && !_isCancelled;
+
+    if (success) {
+        success = _writer.close();
+        if (!success) {
+            fail(_writer.errorString());
+        }
+    } else {
+        _writer.cancel();
+    }
+
+    emit dumpFinished(success);
+}
+
+void MySQLDumper::onDumpFinished(bool success)
+{
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+
+    _connections.clear(); // closes in main thread
+
+    _isRunning = false;
+
+    std::chrono::milliseconds elapsed(_timer.elapsed());
+
+    if (success) {
+        qint64 bytes = _writer.bytesWritten();
+        double seconds = std::max<qint64>(1, elapsed.count()) / 1000.0;
+        QString message = tr("Done: %1 rows, %2")
+            .arg(helpers::formatNumber(
+                     static_cast<unsigned long long>(_rowCount.load())))
+            .arg(helpers::formatByteSize(static_cast<helpers::byteSize>(
+                     bytes)));
+        if (_compress) {
+            message += tr(" (%1 compressed)").arg(
+                helpers::formatByteSize(static_cast<helpers::byteSize>(
+                     _writer.fileBytesWritten())));
+        }
+        message += tr(" in %1 sec., %2/s")
+            .arg(helpers::formatAsSeconds(elapsed))
+            .arg(helpers::formatByteSize(static_cast<helpers::byteSize>(
+                     bytes / seconds)));
+        emit progressMessage(message + QChar::LineFeed);
+        meowLogC(Log::Category::Info) << message;
+    } else if (_isCancelled) {
+        emit progressMessage(tr("Cancelled") + QChar::LineFeed);
+    }
+
+    emit finished(success || _isCancelled);
+}
+
+void MySQLDumper::startConsistentSnapshot()
+{
+    // All connections see the same data: their transactions are started
+    // while nobody can write (as mydumper does). Without RELOAD privilege
+    // every connection still has own consistent view of InnoDB tables.
+
+    db::Connection * main = _connections.first().get();
+
+    bool globalLock = false;
+    if (_connections.size() > 1) {
+        try {
+            main->query("FLUSH TABLES WITH READ LOCK");
+            globalLock = true;
+        } catch(meow::db::Exception & ex) {
+            emit progressMessage(
+                tr("Snapshots of connections may differ: %1")
+                    .arg(ex.message()) + QChar::LineFeed);
+        }
+    }
+
+    for (const db::ConnectionPtr & connection : _connections) {
+        // TIMESTAMP values are written in UTC, see headerSQL()
+        connection->query("/*!40103 SET TIME_ZONE='+00:00' */");
+        connection->query(
+            "SET SESSION TRANSACTION ISOLATION LEVEL REPEATABLE READ");
+        connection->query(
+            "START TRANSACTION /*!40100 WITH CONSISTENT SNAPSHOT */");
+    }
+
+    if (globalLock) {
+        main->query("UNLOCK TABLES");
+    }
+}
+
+void MySQLDumper::dumpDatabase(const QString & database)
+{
+    db::Connection * connection = _connections.first().get();
+
+    QString quotedDatabase = connection->quoteIdentifier(database);
+
+    emit progressMessage(tr("Database %1").arg(quotedDatabase)
+                         + QChar::LineFeed);
+
+    // SHOW CREATE omits names of current database
+    connection->query("USE " + quotedDatabase);
+
+    QString SQL = "\n--\n-- Database: " + quotedDatabase + "\n--\n\n";
+
+    if (isOptionEnabled(Option::CreateDatabase)) {
+        if (isOptionEnabled(Option::AddDropDatabase)) {
+            SQL += "/*!40000 DROP DATABASE IF EXISTS "
+                    + quotedDatabase + "*/;\n\n";
+        }
+        QString createCode = connection->getCell(
+                    "SHOW CREATE DATABASE " + quotedDatabase, 1);
+        createCode.replace(QRegularExpression("^CREATE DATABASE "),
+                           "CREATE DATABASE /*!32312 IF NOT EXISTS*/ ");
+        SQL += createCode + ";\n\n";
+    }
+    SQL += "USE " + quotedDatabase + ";\n";
+
+    QList<Table> tables = fetchTables(database);
+    QList<Table> baseTables;
+
+    for (const Table & table : tables) {
+        if (table.isView) {
+            SQL += viewStructureSQL(table);
+        } else {
+            SQL += tableStructureSQL(table);
+            baseTables << table;
+        }
+    }
+
+    if (!write(SQL)) return;
+
+    if (!baseTables.isEmpty()) {
+        // all at once: rows of tables go interleaved
+        if (isOptionEnabled(Option::AddLocks)) {
+            QStringList locks;
+            for (const Table & table : baseTables) {
+                locks << connection->quoteIdentifier(table.name) + " WRITE";
+            }
+            write("\nLOCK TABLES " + locks.join(", ") + ";\n");
+        }
+
+        dumpTablesData(database, baseTables);
+
+        if (isOptionEnabled(Option::AddLocks)) {
+            write(QString("UNLOCK TABLES;\n"));
+        }
+    }
+
+    if (_isCancelled || _failed) return;
+
+    SQL.clear();
+
+    if (isOptionEnabled(Option::Triggers)) {
+        SQL += triggersSQL(database);
+    }
+
+    // replace stand-ins when all tables exist
+    if (isOptionEnabled(Option::CreateTable)) {
+        for (const Table & table : tables) {
+            if (!table.isView) continue;
+            QString quotedView = connection->quoteIdentifier(table.name);
+            SQL += "\n--\n-- View structure for view " + quotedView
+                    + "\n--\n\n";
+            SQL += "/*!50001 DROP VIEW IF EXISTS " + quotedView + "*/;\n";
+            SQL += "/*!50001 " + connection->getCell(
+                        "SHOW CREATE VIEW " + quotedView, 1) + " */;\n";
+        }
+    }
+
+    if (isOptionEnabled(Option::Routines)) {
+        SQL += routinesSQL(database);
+    }
+
+    if (isOptionEnabled(Option::Events)) {
+        SQL += eventsSQL(database);
+    }
+
+    write(SQL);
+}
+
+QList<MySQLDumper::Table> MySQLDumper::fetchTables(const QString & database)
+{
+    db::Connection * connection = _connections.first().get();
+
+    QList<Table> tables;
+
+    QList<QStringList> rows = connection->getRows(
+        "SELECT TABLE_NAME, TABLE_TYPE, DATA_LENGTH"
+        " FROM information_schema.TABLES"
+        " WHERE TABLE_SCHEMA = " + connection->escapeString(database)
+        + " ORDER BY TABLE_NAME");
+
+    for (const QStringList & row : rows) {
+        Table table;
+        table.name = row.value(0);
+        table.isView = row.value(1) == QLatin1String("VIEW");
+        table.dataSize = row.value(2).toLongLong();
+        tables << table;
+    }
+
+    return tables;
+}
+
+QString MySQLDumper::tableStructureSQL(const Table & table)
+{
+    db::Connection * connection = _connections.first().get();
+
+    QString quotedTable = connection->quoteIdentifier(table.name);
+
+    QString SQL = "\n--\n-- Table structure for table " + quotedTable
+            + "\n--\n\n";
+
+    if (isOptionEnabled(Option::AddDropTable)) {
+        SQL += "DROP TABLE IF EXISTS " + quotedTable + ";\n";
+    }
+
+    if (isOptionEnabled(Option::CreateTable)) {
+        QString createCode = connection->getCell(
+                    "SHOW CREATE TABLE " + quotedTable, 1);
+        if (!isOptionEnabled(Option::CreateOptions)) {
+            // table options after closing bracket are MySQL specific,
+            // the full code is kept if the bracket is not found
+            int optionsPosition = columnListEnd(createCode);
+            if (optionsPosition != -1) {
+                createCode.truncate(optionsPosition + 1);
+            }
+        }
+        SQL += createCode + ";\n";
+    }
+
+    return SQL;
+}
+
+QString MySQLDumper::viewStructureSQL(const Table & view)
+{
+    if (!isOptionEnabled(Option::CreateTable)) {
+        return QString();
+    }
+
+    // As mysqldump does: a view may select from views which are not created
+    // yet, so stand-in view with same columns is created here and replaced
+    // at the end of database
+
+    db::Connection * connection = _connections.first().get();
+
+    QString quotedView = connection->quoteIdentifier(view.name);
+
+    QStringList columns;
+    try {
+        for (const QString & column : connection->getColumn(
+                 "SHOW COLUMNS FROM " + quotedView)) {
+            columns << "1 AS " + connection->quoteIdentifier(column);
+        }
+    } catch(meow::db::Exception & ex) {
+        // e.g. view of dropped table, the real one will fail too
+        emit progressMessage(tr("View %1: %2").arg(quotedView)
+                             .arg(ex.message()) + QChar::LineFeed);
+    }
+    if (columns.isEmpty()) {
+        columns << "1";
+    }
+
+    QString SQL = "\n--\n-- Temporary view structure for view " + quotedView
+            + "\n--\n\n";
+
+    if (isOptionEnabled(Option::AddDropTable)) {
+        SQL += "DROP TABLE IF EXISTS " + quotedView + ";\n";
+        SQL += "/*!50001 DROP VIEW IF EXISTS " + quotedView + "*/;\n";
+    }
+
+    SQL += "/*!50001 CREATE VIEW " + quotedView + " AS SELECT "
+            + columns.join(", ") + " */;\n";
+
+    return SQL;
+}
+
+QString MySQLDumper::triggersSQL(const QString & database)
+{
+    db::Connection * connection = _connections.first().get();
+
+    QString SQL;
+
+    QStringList triggers = connection->getColumn(
+        "SHOW TRIGGERS FROM " + connection->quoteIdentifier(database));
+
+    for (const QString & trigger : triggers) {
+        QString quotedTrigger = connection->quoteIdentifier(trigger);
+        QString createCode = connection->getCell(
+                    "SHOW CREATE TRIGGER " + quotedTrigger, 2);
+        if (createCode.isEmpty()) continue;
+
+        SQL += "\n--\n-- Trigger " + quotedTrigger + "\n--\n\n";
+        if (isOptionEnabled(Option::AddDropTrigger)) {
+            SQL += "/*!50032 DROP TRIGGER IF EXISTS " + quotedTrigger
+                    + " */;\n";
+        }
+        SQL += "DELIMITER ;;\n" + createCode + " ;;\nDELIMITER ;\n";
+    }
+
+    return SQL;
+}
+
+QString MySQLDumper::routinesSQL(const QString & database)
+{
+    db::Connection * connection = _connections.first().get();
+
+    QString SQL;
+
+    for (const QString & type : {QString("PROCEDURE"), QString("FUNCTION")}) {
+
+        QStringList routines = connection->getColumn(
+            "SHOW " + type + " STATUS WHERE Db = "
+                + connection->escapeString(database), 1);
+
+        for (const QString & routine : routines) {
+            QString quotedRoutine = connection->quoteIdentifier(routine);
+            QString createCode = connection->getCell(
+                        "SHOW CREATE " + type + " " + quotedRoutine, 2);
+            if (createCode.isEmpty()) { // no privileges to see the body
+                emit progressMessage(tr("Skipped %1 %2: no access to code")
+                                     .arg(type.toLower())
+                                     .arg(quotedRoutine) + QChar::LineFeed);
+                continue;
+            }
+
+            SQL += "\n--\n-- " + type.toLower() + " " + quotedRoutine
+                    + "\n--\n\n";
+            SQL += "/*!50003 DROP " + type + " IF EXISTS "
+                    + quotedRoutine + " */;\n";
+            SQL += "DELIMITER ;;\n" + createCode + " ;;\nDELIMITER ;\n";
+        }
+    }
+
+    return SQL;
+}
+
+QString MySQLDumper::eventsSQL(const QString & database)
+{
+    db::Connection * connection = _connections.first().get();
+
+    QString SQL;
+
+    QStringList events = connection->getColumn(
+        "SHOW EVENTS FROM " + connection->quoteIdentifier(database), 1);
+
+    for (const QString & event : events) {
+        QString quotedEvent = connection->quoteIdentifier(event);
+        QString createCode = connection->getCell(
+                    "SHOW CREATE EVENT " + quotedEvent, 3);
+        if (createCode.isEmpty()) continue;
+
+        SQL += "\n--\n-- Event " + quotedEvent + "\n--\n\n";
+        SQL += "/*!50106 DROP EVENT IF EXISTS " + quotedEvent + " */;\n";
+        SQL += "DELIMITER ;;\n" + createCode + " ;;\nDELIMITER ;\n";
+    }
+
+    return SQL;
+}
+
+void MySQLDumper::dumpTablesData(const QString & database,
+                                 const QList<Table> & tables)
+{
+    // Every connection takes the next not started table. Biggest tables go
+    // first, so the last one doesn't keep others waiting
+
+    std::vector<const Table *> order;
+    order.reserve(static_cast<std::size_t>(tables.size()));
+    for (const Table & table : tables) {
+        order.push_back(&table);
+    }
+    std::stable_sort(order.begin(), order.end(),
+        [](const Table * left, const Table * right) {
+            return left->dataSize > right->dataSize;
+        });
+
+    std::atomic<std::size_t> nextIndex(0);
+
+    auto worker = [&](db::Connection * connection, bool initThread) {
+
+        std::unique_ptr<db::DbThreadInitializer> initializer;
+        if (initThread) {
+            initializer = connection->createThreadInitializer();
+            initializer->init();
+        }
+
+        while (!_isCancelled && !_failed) {
+            std::size_t index = nextIndex++;
+            if (index >= order.size()) {
+                break;
+            }
+            try {
+                dumpTableData(connection, database, *order[index]);
+            } catch(meow::db::Exception & ex) {
+                fail(ex.message());
+            }
+        }
+
+        if (initializer) {
+            initializer->deinit();
+        }
+    };
+
+    std::size_t threadCount = std::min(
+                static_cast<std::size_t>(_connections.size()), order.size());
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < threadCount; ++i) {
+        threads.emplace_back(worker, _connections[static_cast<int>(i)].get(),
+                             true);
+    }
+
+    worker(_connections.first().get(), false); // this one is initialized
+
+    for (std::thread & thread : threads) {
+        thread.join();
+    }
+}
+
+void MySQLDumper::dumpTableData(db::Connection * connection,
+                                const QString & database,
+                                const Table & table)
+{
+    QString quotedTable = connection->quoteIdentifier(table.name);
+    QString fullName = connection->quoteIdentifier(database)
+            + '.' + quotedTable;
+
+    // generated columns can't be inserted, list the rest then
+    QStringList columns;
+    bool hasGeneratedColumns = false;
+    for (const QStringList & column : connection->getRows(
+             "SHOW COLUMNS FROM " + fullName)) {
+        const QString & extra = column.value(5);
+        if (extra.contains("GENERATED", Qt::CaseInsensitive)
+                || extra.compare("VIRTUAL", Qt::CaseInsensitive) == 0
+                || extra.compare("PERSISTENT", Qt::CaseInsensitive) == 0) {
+            hasGeneratedColumns = true;
+        } else {
+            columns << connection->quoteIdentifier(column.value(0));
+        }
+    }
+
+    QByteArray insertPrefix = "INSERT INTO " + quotedTable.toUtf8();
+    if (hasGeneratedColumns) {
+        insertPrefix += " (" + columns.join(", ").toUtf8() + ")";
+    }
+    insertPrefix += " VALUES ";
+
+    QString selectColumns = hasGeneratedColumns ? columns.join(", ") : "*";
+
+    QByteArray chunk;
+    chunk.reserve(CHUNK_SIZE + MAX_INSERT_SIZE);
+
+    chunk += "\n--\n-- Dumping data for table " + quotedTable.toUtf8()
+            + "\n--\n\n";
+
+    bool disableKeys = isOptionEnabled(Option::DisableKeys);
+    if (disableKeys) {
+        chunk += "/*!40000 ALTER TABLE " + quotedTable.toUtf8()
+                + " DISABLE KEYS */;\n";
+    }
+
+    std::vector<db::RawColumn> rawColumns;
+    int statementRows = 0;
+    int statementStart = 0;
+    qint64 tableRows = 0;
+    bool writeFailed = false;
+
+    connection->streamRawRows(
+        "SELECT " + selectColumns + " FROM " + fullName,
+        [&](const std::vector<db::RawColumn> & received) {
+            rawColumns = received;
+        },
+        [&](const char * const * values, const unsigned long * lengths) {
+
+            if (_isCancelled || _failed) {
+                return false;
+            }
+
+            if (statementRows == 0) {
+                statementStart = chunk.size();
+                chunk += insertPrefix;
+            } else {
+                chunk += ',';
+            }
+
+            chunk += '(';
+            for (std::size_t i = 0; i < rawColumns.size(); ++i) {
+                if (i > 0) {
+                    chunk += ',';
+                }
+                appendValue(chunk, values[i], lengths[i], rawColumns[i]);
+            }
+            chunk += ')';
+
+            ++statementRows;
+            ++tableRows;
+
+            if (statementRows >= _rowsPerInsert
+                    || chunk.size() - statementStart >= MAX_INSERT_SIZE) {
+                chunk += ";\n";
+                statementRows = 0;
+                if (chunk.size() >= CHUNK_SIZE) {
+                    if (!write(chunk)) {
+                        writeFailed = true;
+                        return false;
+                    }
+                    chunk.clear();
+                }
+            }
+
+            return true;
+        });
+
+    if (writeFailed || _isCancelled || _failed) {
+        return;
+    }
+
+    if (statementRows > 0) {
+        chunk += ";\n";
+    }
+
+    if (disableKeys) {
+        chunk += "/*!40000 ALTER TABLE " + quotedTable.toUtf8()
+                + " ENABLE KEYS */;\n";
+    }
+
+    if (!write(chunk)) {
+        return;
+    }
+
+    _rowCount += tableRows;
+
+    emit progressMessage(tr("  %1: %2 rows").arg(fullName)
+                         .arg(helpers::formatNumber(
+                             static_cast<unsigned long long>(tableRows)))
+                         + QChar::LineFeed);
+}
+
+bool MySQLDumper::write(const QString & SQL)
+{
+    return write(SQL.toUtf8());
+}
+
+bool MySQLDumper::write(const QByteArray & SQL)
+{
+    if (!_writer.write(SQL)) {
+        fail(tr("Unable to write %1: %2")
+             .arg(_fileName).arg(_writer.errorString()));
+        return false;
+    }
+    return true;
+}
+
+void MySQLDumper::fail(const QString & error)
+{
+    bool wasFailed = _failed.exchange(true);
+    if (!wasFailed) { // the first one is the reason, others are consequences
+        meowLogC(Log::Category::Error) << "Dump failed: " << error;
+        emit progressMessage(error + QChar::LineFeed);
+    }
+}
+
+QString MySQLDumper::headerSQL()
+{
+    db::Connection * connection = _connections.first().get();
+
+    QString SQL;
+
+    SQL += "-- MeowSQL dump\n--\n";
+    SQL += "-- Host: " + connection->connectionParams()->hostName();
+    if (_databases.size() == 1) {
+        SQL += "    Database: " + _databases.first();
+    }
+    SQL += "\n-- Server version: " + connection->getCell("SELECT VERSION()");
+    SQL += "\n-- Date: "
+            + QDateTime::currentDateTime().toString(Qt::ISODate) + "\n\n";
+
+    SQL += "/*!40101 SET @OLD_CHARACTER_SET_CLIENT=@@CHARACTER_SET_CLIENT */;\n"
+           "/*!40101 SET @OLD_CHARACTER_SET_RESULTS=@@CHARACTER_SET_RESULTS */;\n"
+           "/*!40101 SET @OLD_COLLATION_CONNECTION=@@COLLATION_CONNECTION */;\n";
+
+    if (isOptionEnabled(Option::SetCharset)) {
+        // values are written as the server sends them
+        SQL += "/*!40101 SET NAMES " + connection->characterSet() + " */;\n";
+    }
+
+    SQL += "/*!40103 SET @OLD_TIME_ZONE=@@TIME_ZONE */;\n"
+           "/*!40103 SET TIME_ZONE='+00:00' */;\n"
+           "/*!40014 SET @OLD_UNIQUE_CHECKS=@@UNIQUE_CHECKS,"
+           " UNIQUE_CHECKS=0 */;\n"
+           "/*!40014 SET @OLD_FOREIGN_KEY_CHECKS=@@FOREIGN_KEY_CHECKS,"
+           " FOREIGN_KEY_CHECKS=0 */;\n"
+           "/*!40101 SET @OLD_SQL_MODE=@@SQL_MODE,"
+           " SQL_MODE='NO_AUTO_VALUE_ON_ZERO' */;\n"
+           "/*!40111 SET @OLD_SQL_NOTES=@@SQL_NOTES, SQL_NOTES=0 */;\n";
+
+    return SQL;
+}
+
+QString MySQLDumper::footerSQL() const
+{
+    return "\n"
+           "/*!40103 SET TIME_ZONE=@OLD_TIME_ZONE */;\n"
+           "/*!40101 SET SQL_MODE=@OLD_SQL_MODE */;\n"
+           "/*!40014 SET FOREIGN_KEY_CHECKS=@OLD_FOREIGN_KEY_CHECKS */;\n"
+           "/*!40014 SET UNIQUE_CHECKS=@OLD_UNIQUE_CHECKS */;\n"
+           "/*!40101 SET CHARACTER_SET_CLIENT=@OLD_CHARACTER_SET_CLIENT */;\n"
+           "/*!40101 SET CHARACTER_SET_RESULTS=@OLD_CHARACTER_SET_RESULTS */;\n"
+           "/*!40101 SET COLLATION_CONNECTION=@OLD_COLLATION_CONNECTION */;\n"
+           "/*!40111 SET SQL_NOTES=@OLD_SQL_NOTES */;\n\n"
+           "-- Dump completed on "
+           + QDateTime::currentDateTime().toString(Qt::ISODate) + "\n";
+}
+
+bool MySQLDumper::isOptionEnabled(ui::presenters::MySQLDumpOption option) const
+{
+    return (_options & static_cast<uint32_t>(option))
+            == static_cast<uint32_t>(option);
+}
+
+} // namespace exporting
+} // namespace utils
+} // namespace meow
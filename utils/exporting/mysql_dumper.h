@@ -0,0 +1,112 @@
+#ifndef UTILS_EXPORTING_MYSQL_DUMPER_H
+#define UTILS_EXPORTING_MYSQL_DUMPER_H
+
+#include <atomic>
+#include <thread>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QObject>
+#include <QStringList>
+#include "db/connection.h"
+#include "dump_writer.h"
+
+namespace meow {
+
+namespace ui {
+namespace presenters {
+
+class ExportDatabaseForm;
+enum class MySQLDumpOption;
+
+}
+}
+
+namespace utils {
+namespace exporting {
+
+// Intent: dumps databases into SQL file without external mysqldump.
+// Own connections read tables in one consistent snapshot, several tables at
+// once, rows are streamed (never stored) into multi-row INSERTs, output may
+// be gzip'ed on the fly. The result is loadable by mysql client as well
+class MySQLDumper : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit MySQLDumper(ui::presenters::ExportDatabaseForm * form);
+
+    ~MySQLDumper() override;
+
+    void start();
+    bool cancel();
+
+    bool isRunning() const { return _isRunning; }
+
+    // what will be done with current options of form
+    QString description() const;
+
+    Q_SIGNAL void finished(bool success);
+    Q_SIGNAL void progressMessage(const QString & str);
+
+private:
+
+    struct Table
+    {
+        QString name;
+        bool isView = false;
+        qint64 dataSize = 0;
+    };
+
+    // main thread
+    bool openConnections(int count);
+    Q_SLOT void onDumpFinished(bool success);
+
+    // dump thread
+    void run();
+    void startConsistentSnapshot();
+    void dumpDatabase(const QString & database);
+    QList<Table> fetchTables(const QString & database);
+    QString tableStructureSQL(const Table & table);
+    QString viewStructureSQL(const Table & view);
+    QString triggersSQL(const QString & database);
+    QString routinesSQL(const QString & database);
+    QString eventsSQL(const QString & database);
+    void dumpTablesData(const QString & database, const QList<Table> & tables);
+    // any connection thread
+    void dumpTableData(db::Connection * connection,
+                       const QString & database,
+                       const Table & table);
+    bool write(const QString & SQL);
+    bool write(const QByteArray & SQL);
+    void fail(const QString & error);
+    QString headerSQL();
+    QString footerSQL() const;
+
+    Q_SIGNAL void dumpFinished(bool success);
+
+    bool isOptionEnabled(ui::presenters::MySQLDumpOption option) const;
+
+    ui::presenters::ExportDatabaseForm * _form;
+
+    // copy of form's options while running
+    QStringList _databases;
+    uint32_t _options;
+    QString _fileName;
+    bool _compress;
+    int _rowsPerInsert;
+
+    QList<db::ConnectionPtr> _connections;
+    DumpWriter _writer;
+    std::thread _thread;
+    std::atomic<bool> _isRunning;
+    std::atomic<bool> _isCancelled;
+    std::atomic<bool> _failed;
+    std::atomic<qint64> _rowCount;
+    QElapsedTimer _timer;
+};
+
+} // namespace exporting
+} // namespace utils
+} // namespace meow
+
+#endif // UTILS_EXPORTING_MYSQL_DUMPER_H
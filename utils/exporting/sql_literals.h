@@ -0,0 +1,78 @@
+#ifndef UTILS_EXPORTING_SQL_LITERALS_H
+#define UTILS_EXPORTING_SQL_LITERALS_H
+
+#include <QByteArray>
+
+namespace meow {
+namespace utils {
+namespace exporting {
+
+// Raw values (UTF-8 or binary) to SQL literals of exported files
+
+// as mysql_real_escape_string() for ASCII compatible charsets
+inline void appendMySQLEscaped(QByteArray & out,
+                               const char * value,
+                               unsigned long length)
+{
+    out += '\'';
+    unsigned long runStart = 0;
+    for (unsigned long i = 0; i < length; ++i) {
+        char replacement;
+        switch (value[i]) {
+        case '\0':   replacement = '0'; break;
+        case '\n':   replacement = 'n'; break;
+        case '\r':   replacement = 'r'; break;
+        case '\\':   replacement = '\\'; break;
+        case '\'':   replacement = '\''; break;
+        case '"':    replacement = '"'; break;
+        case '\032': replacement = 'Z'; break;
+        default: continue;
+        }
+        out.append(value + runStart, static_cast<int>(i - runStart));
+        out += '\\';
+        out += replacement;
+        runStart = i + 1;
+    }
+    out.append(value + runStart, static_cast<int>(length - runStart));
+    out += '\'';
+}
+
+// standard SQL: only quote is doubled
+inline void appendStandardQuoted(QByteArray & out,
+                                 const char * value,
+                                 unsigned long length)
+{
+    out += '\'';
+    unsigned long runStart = 0;
+    for (unsigned long i = 0; i < length; ++i) {
+        if (value[i] != '\'') {
+            continue;
+        }
+        out.append(value + runStart, static_cast<int>(i + 1 - runStart));
+        out += '\'';
+        runStart = i + 1;
+    }
+    out.append(value + runStart, static_cast<int>(length - runStart));
+    out += '\'';
+}
+
+inline void appendHexDigits(QByteArray & out,
+                            const char * value,
+                            unsigned long length)
+{
+    static const char DIGITS[] = "0123456789ABCDEF";
+    int start = out.size();
+    out.resize(start + static_cast<int>(length) * 2);
+    char * hex = out.data() + start;
+    for (unsigned long i = 0; i < length; ++i) {
+        unsigned char c = static_cast<unsigned char>(value[i]);
+        *hex++ = DIGITS[c >> 4];
+        *hex++ = DIGITS[c & 0x0F];
+    }
+}
+
+} // namespace exporting
+} // namespace utils
+} // namespace meow
+
+#endif // UTILS_EXPORTING_SQL_LITERALS_H
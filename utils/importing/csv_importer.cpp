@@ -0,0 +1,560 @@
+#include "csv_importer.h"
+#include "db/entity/table_entity.h"
+#include "db/table_structure.h"
+#include "db/connection_query_killer.h"
+#include "db/db_thread_initializer.h"
+#include "helpers/formatting.h"
+#include "helpers/logger.h"
+#include <algorithm>
+#include <QFile>
+#include <QFileInfo>
+
+namespace meow {
+namespace utils {
+namespace importing {
+
+namespace {
+
+// the parser gets ahead of the server by this much at most
+const std::size_t MAX_QUEUED_BATCHES = 2;
+// even when rowsPerBatch is big
+const int MAX_BATCH_SIZE = 16 * 1024 * 1024;
+
+const qint64 PROGRESS_INTERVAL_MS = 250;
+
+} // namespace
+
+CSVImporter::CSVImporter(db::TableEntity * table,
+                         const CSVImportSettings & settings)
+    : QObject()
+    , _settings(settings)
+    , _quotedTable(db::quotedFullName(table))
+    , _sessionConnection(table->connection())
+    , _fieldCount(0)
+    , _loadInMainThread(false)
+    , _queueFinished(false)
+    , _isRunning(false)
+    , _isCancelled(false)
+    , _failed(false)
+    , _rowsParsed(0)
+    , _rowsMalformed(0)
+    , _rowsSent(0)
+    , _rowsInserted(0)
+    , _rowsFailed(0)
+    , _warningCount(0)
+    , _fileSize(0)
+    , _lastProgressMs(0)
+{
+    _sessionConnection->parseTableStructure(table);
+    _tableColumns = table->structure()->columnNames();
+
+    connect(this, &CSVImporter::batchQueued,
+            this, &CSVImporter::onBatchQueued,
+            Qt::QueuedConnection);
+
+    connect(this, &CSVImporter::loadFinished,
+            this, &CSVImporter::onLoadFinished,
+            Qt::QueuedConnection);
+}
+
+CSVImporter::~CSVImporter()
+{
+    cancel();
+    if (_parserThread.joinable()) {
+        _parserThread.join();
+    }
+    if (_loaderThread.joinable()) {
+        _loaderThread.join();
+    }
+}
+
+void CSVImporter::start()
+{
+    if (_isRunning) {
+        return;
+    }
+
+    _fileSize = QFileInfo(_settings.fileName).size();
+
+    if (!openConnection()) {
+        emit finished(false);
+        return;
+    }
+
+    _queue.clear();
+    _queueFinished = false;
+    _isCancelled = false;
+    _failed = false;
+    _rowsParsed = 0;
+    _rowsMalformed = 0;
+    _rowsSent = 0;
+    _rowsInserted = 0;
+    _rowsFailed = 0;
+    _warningCount = 0;
+    _lastProgressMs = 0;
+
+    _isRunning = true;
+    _timer.start();
+
+    emit progressMessage(tr("Import %1 into %2")
+                         .arg(_settings.fileName).arg(_quotedTable)
+                         + QChar::LineFeed);
+
+    _parserThread = std::thread(&CSVImporter::parse, this);
+    if (!_loadInMainThread) {
+        _loaderThread = std::thread(&CSVImporter::load, this);
+    }
+}
+
+bool CSVImporter::cancel()
+{
+    if (!_isRunning) {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_queueMutex);
+        _isCancelled = true;
+    }
+    _queueChanged.notify_all();
+
+    if (_connection) {
+        try {
+            _connection->createQueryKiller()->run();
+        } catch(meow::db::Exception & ex) {
+            meowLogC(Log::Category::Error) << "Import cancel failed: "
+                                           << ex.message();
+        }
+    }
+
+    return true;
+}
+
+bool CSVImporter::openConnection()
+{
+    _connection.reset();
+
+    // single-threaded connection can't have a sibling (e.g. SQLite file
+    // handle is per session), its own thread is the main one then
+    _loadInMainThread
+        = !_sessionConnection->features()->supportsMultithreading();
+
+    if (_loadInMainThread) {
+        return true;
+    }
+
+    // connect in main thread as UserQuery does for parallel queries
+    _connection = _sessionConnection->connectionParams()->createConnection();
+    try {
+        _connection->setActive(true);
+        // get id before import to allow KILL QUERY ID on cancel
+        _connection->connectionIdOnServer();
+    } catch(meow::db::Exception & ex) {
+        emit progressMessage(tr("Connection failed: %1").arg(ex.message())
+                             + QChar::LineFeed);
+        _connection.reset();
+        return false;
+    }
+
+    return true;
+}
+
+void CSVImporter::onBatchQueued()
+{
+    if (!_isRunning || !_loadInMainThread) {
+        return;
+    }
+
+    Batch batch;
+    while (popBatch(&batch, false)) {
+        if (!loadBatch(batch)) {
+            break;
+        }
+    }
+
+    if (_failed || _isCancelled || isQueueDone()) {
+        onLoadFinished(!_failed && !_isCancelled);
+    }
+}
+
+void CSVImporter::onLoadFinished(bool success)
+{
+    if (!_isRunning) {
+        return; // pending signals of finished import
+    }
+
+    if (_parserThread.joinable()) {
+        _parserThread.join();
+    }
+    if (_loaderThread.joinable()) {
+        _loaderThread.join();
+    }
+
+    _connection.reset(); // closes in main thread
+
+    _isRunning = false;
+
+    std::chrono::milliseconds elapsed(_timer.elapsed());
+    double seconds = std::max<qint64>(1, elapsed.count()) / 1000.0;
+
+    if (_rowsMalformed > 0) {
+        emit progressMessage(
+            tr("%1 row(s) had other count of values than the first one")
+                .arg(helpers::formatNumber(static_cast<unsigned long long>(
+                    _rowsMalformed.load()))) + QChar::LineFeed);
+    }
+
+    QString message = tr("%1 row(s) imported")
+        .arg(helpers::formatNumber(
+                 static_cast<unsigned long long>(_rowsInserted)));
+
+    if (_rowsSent > _rowsInserted) {
+        // LOAD DATA LOCAL skips duplicates
+        message += tr(", %1 skipped by server").arg(
+            helpers::formatNumber(static_cast<unsigned long long>(
+                _rowsSent - _rowsInserted)));
+    }
+    if (_rowsFailed > 0) {
+        message += tr(", %1 failed").arg(
+            helpers::formatNumber(static_cast<unsigned long long>(
+                _rowsFailed)));
+    }
+    if (_warningCount > 0) {
+        // e.g. LOAD DATA truncates values which don't fit the column
+        message += tr(", %1 warning(s) of server").arg(
+            helpers::formatNumber(static_cast<unsigned long long>(
+                _warningCount)));
+    }
+
+    message += tr(" in %1 sec., %2 rows/s, %3/s")
+        .arg(helpers::formatAsSeconds(elapsed))
+        .arg(helpers::formatNumber(static_cast<unsigned long long>(
+                 _rowsSent / seconds)))
+        .arg(helpers::formatByteSize(static_cast<helpers::byteSize>(
+                 (success ? _fileSize : 0) / seconds)));
+
+    if (_isCancelled) {
+        message = tr("Cancelled: ") + message;
+    }
+
+    emit progressMessage(message + QChar::LineFeed);
+    meowLogC(Log::Category::Info) << message;
+
+    if (success) {
+        emit progress(_fileSize, _fileSize);
+    }
+
+    emit finished(success || _isCancelled);
+}
+
+void CSVImporter::parse()
+{
+    QFile file(_settings.fileName);
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        fail(tr("Unable to open %1: %2")
+             .arg(_settings.fileName).arg(file.errorString()));
+        finishQueue();
+        return;
+    }
+
+    CSVParser parser(&file, _settings.format);
+    std::vector<CSVField> fields;
+
+    Batch batch;
+    qint64 rowNumber = 0;
+    bool isMapped = false;
+
+    while (!_isCancelled && !_failed && parser.next(&fields)) {
+
+        ++rowNumber;
+
+        if (!isMapped) {
+            if (!mapColumns(fields)) {
+                break;
+            }
+            isMapped = true;
+            if (_settings.hasHeader) {
+                continue;
+            }
+        }
+
+        if (batch.rows.count == 0) {
+            batch.firstRowNumber = rowNumber;
+        }
+
+        appendRow(fields, &batch);
+
+        if (batch.rows.count >= _settings.rowsPerBatch
+                || batch.rows.data.size() >= MAX_BATCH_SIZE) {
+            batch.endPosition = parser.position();
+            if (!pushBatch(std::move(batch))) {
+                break;
+            }
+            batch = Batch();
+        }
+    }
+
+    if (batch.rows.count > 0) {
+        batch.endPosition = parser.position();
+        pushBatch(std::move(batch));
+    }
+
+    finishQueue();
+}
+
+bool CSVImporter::mapColumns(const std::vector<CSVField> & firstRow)
+{
+    // as LOAD DATA: by names of header or by positions
+
+    _fieldIndexes.clear();
+    _quotedColumns.clear();
+
+    if (_settings.hasHeader) {
+        QStringList skipped;
+        QStringList mapped;
+        for (std::size_t i = 0; i < firstRow.size(); ++i) {
+            QString name = QString::fromUtf8(firstRow[i].data,
+                                             firstRow[i].size).trimmed();
+            auto it = std::find_if(_tableColumns.begin(), _tableColumns.end(),
+                [&name](const QString & column) {
+                    return column.compare(name, Qt::CaseInsensitive) == 0;
+                });
+            if (it == _tableColumns.end() || mapped.contains(*it)) {
+                skipped << name;
+                continue;
+            }
+            mapped << *it;
+            _fieldIndexes.push_back(static_cast<int>(i));
+        }
+        if (!skipped.isEmpty()) {
+            emit progressMessage(tr("Skipped, not in table: %1")
+                                 .arg(skipped.join(", ")) + QChar::LineFeed);
+        }
+        _quotedColumns = _sessionConnection->quoteIdentifiers(mapped);
+    } else {
+        int count = std::min(static_cast<int>(firstRow.size()),
+                             _tableColumns.size());
+        for (int i = 0; i < count; ++i) {
+            _fieldIndexes.push_back(i);
+            _quotedColumns << _sessionConnection->quoteIdentifier(
+                                  _tableColumns[i]);
+        }
+        if (static_cast<int>(firstRow.size()) > count) {
+            emit progressMessage(
+                tr("Skipped, not in table: %1 last value(s) of every row")
+                    .arg(firstRow.size() - count) + QChar::LineFeed);
+        }
+    }
+
+    if (_quotedColumns.isEmpty()) {
+        fail(tr("No columns of the file match columns of %1")
+             .arg(_quotedTable));
+        return false;
+    }
+
+    _fieldCount = static_cast<int>(firstRow.size());
+
+    emit progressMessage(tr("Columns: %1").arg(_quotedColumns.join(", "))
+                         + QChar::LineFeed);
+
+    return true;
+}
+
+void CSVImporter::appendRow(const std::vector<CSVField> & fields,
+                            Batch * batch)
+{
+    if (static_cast<int>(fields.size()) != _fieldCount) {
+        ++_rowsMalformed; // missing values are NULL
+    }
+
+    QByteArray & data = batch->rows.data;
+
+    for (std::size_t k = 0; k < _fieldIndexes.size(); ++k) {
+        if (k > 0) {
+            data += '\t';
+        }
+        std::size_t index = static_cast<std::size_t>(_fieldIndexes[k]);
+        if (index < fields.size()) {
+            appendValue(fields[index], &data);
+        } else {
+            data += "\\N";
+        }
+    }
+    data += '\n';
+
+    ++batch->rows.count;
+    ++_rowsParsed;
+}
+
+void CSVImporter::appendValue(const CSVField & field, QByteArray * data) const
+{
+    if (!field.isQuoted) {
+        if ((field.size == 0 && _settings.emptyIsNull)
+                || (field.size == 2
+                    && field.data[0] == '\\' && field.data[1] == 'N')) {
+            *data += "\\N";
+            return;
+        }
+    }
+
+    // CSV has no escapes, backslash is a char
+    int runStart = 0;
+    for (int i = 0; i < field.size; ++i) {
+        char escaped;
+        switch (field.data[i]) {
+        case '\\': escaped = '\\'; break;
+        case '\t': escaped = 't'; break;
+        case '\n': escaped = 'n'; break;
+        case '\r': escaped = 'r'; break;
+        default: continue;
+        }
+        data->append(field.data + runStart, i - runStart);
+        *data += '\\';
+        *data += escaped;
+        runStart = i + 1;
+    }
+    data->append(field.data + runStart, field.size - runStart);
+}
+
+void CSVImporter::load()
+{
+    std::unique_ptr<db::DbThreadInitializer> initializer
+            = _connection->createThreadInitializer();
+    initializer->init();
+
+    Batch batch;
+    while (popBatch(&batch, true)) {
+        if (!loadBatch(batch)) {
+            break;
+        }
+    }
+
+    initializer->deinit();
+
+    emit loadFinished(!_failed && !_isCancelled);
+}
+
+bool CSVImporter::loadBatch(const Batch & batch)
+{
+    db::Connection * connection = _loadInMainThread
+            ? _sessionConnection : _connection.get();
+
+    try {
+        db::ulonglong warningCount = 0;
+        _rowsInserted += static_cast<qint64>(connection->bulkInsert(
+                            _quotedTable, _quotedColumns, batch.rows,
+                            &warningCount));
+        _warningCount += static_cast<qint64>(warningCount);
+    } catch(meow::db::Exception & ex) {
+        if (_isCancelled) {
+            return false; // killed
+        }
+        _rowsFailed += batch.rows.count;
+        QString error = tr("Rows %1-%2: %3")
+                .arg(batch.firstRowNumber)
+                .arg(batch.firstRowNumber + batch.rows.count - 1)
+                .arg(ex.message());
+        if (_settings.stopOnError) {
+            fail(error);
+            return false;
+        }
+        emit progressMessage(error + QChar::LineFeed);
+    }
+
+    _rowsSent += batch.rows.count;
+
+    reportProgress(batch.endPosition);
+
+    return !_isCancelled;
+}
+
+void CSVImporter::fail(const QString & error)
+{
+    bool wasFailed;
+    {
+        std::lock_guard<std::mutex> lock(_queueMutex);
+        wasFailed = _failed.exchange(true);
+    }
+    _queueChanged.notify_all();
+
+    if (!wasFailed) { // the first one is the reason
+        meowLogC(Log::Category::Error) << "Import failed: " << error;
+        emit progressMessage(error + QChar::LineFeed);
+    }
+}
+
+bool CSVImporter::pushBatch(Batch && batch)
+{
+    {
+        std::unique_lock<std::mutex> lock(_queueMutex);
+        _queueChanged.wait(lock, [this] {
+            return _queue.size() < MAX_QUEUED_BATCHES
+                    || _isCancelled || _failed;
+        });
+        if (_isCancelled || _failed) {
+            return false;
+        }
+        _queue.push_back(std::move(batch));
+    }
+    _queueChanged.notify_all();
+
+    if (_loadInMainThread) {
+        emit batchQueued();
+    }
+
+    return true;
+}
+
+bool CSVImporter::popBatch(Batch * batch, bool wait)
+{
+    {
+        std::unique_lock<std::mutex> lock(_queueMutex);
+        if (wait) {
+            _queueChanged.wait(lock, [this] {
+                return !_queue.empty() || _queueFinished
+                        || _isCancelled || _failed;
+            });
+        }
+        if (_queue.empty() || _isCancelled || _failed) {
+            return false;
+        }
+        *batch = std::move(_queue.front());
+        _queue.pop_front();
+    }
+    _queueChanged.notify_all();
+
+    return true;
+}
+
+void CSVImporter::finishQueue()
+{
+    {
+        std::lock_guard<std::mutex> lock(_queueMutex);
+        _queueFinished = true;
+    }
+    _queueChanged.notify_all();
+
+    if (_loadInMainThread) {
+        emit batchQueued();
+    }
+}
+
+bool CSVImporter::isQueueDone()
+{
+    std::lock_guard<std::mutex> lock(_queueMutex);
+    return _queueFinished && _queue.empty();
+}
+
+void CSVImporter::reportProgress(qint64 position)
+{
+    qint64 elapsedMs = _timer.elapsed();
+    if (elapsedMs - _lastProgressMs >= PROGRESS_INTERVAL_MS) {
+        _lastProgressMs = elapsedMs;
+        emit progress(position, _fileSize);
+    }
+}
+
+} // namespace importing
+} // namespace utils
+} // namespace meow
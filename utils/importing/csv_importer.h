@@ -0,0 +1,134 @@
+#ifndef UTILS_IMPORTING_CSV_IMPORTER_H
+#define UTILS_IMPORTING_CSV_IMPORTER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <QElapsedTimer>
+#include <QObject>
+#include <QStringList>
+#include "db/connection.h"
+#include "csv_parser.h"
+
+namespace meow {
+
+namespace db {
+class TableEntity;
+}
+
+namespace utils {
+namespace importing {
+
+struct CSVImportSettings
+{
+    QString fileName;
+    CSVFormat format;
+    bool hasHeader = true; // columns are mapped by names, or by positions
+    bool emptyIsNull = true; // unquoted empty value, \N is NULL always
+    int rowsPerBatch = 10000; // rows of failed batch are skipped all
+    bool stopOnError = true;
+};
+
+// Intent: loads CSV/TSV file of any size into a table.
+// One thread parses the file into batches in text format of COPY, another
+// one loads them with Connection::bulkInsert() (LOAD DATA LOCAL INFILE,
+// COPY FROM STDIN or multi-row INSERTs in a transaction), so parsing of next
+// batch goes while server is busy with previous one
+class CSVImporter : public QObject
+{
+    Q_OBJECT
+
+public:
+    CSVImporter(db::TableEntity * table, const CSVImportSettings & settings);
+
+    ~CSVImporter() override;
+
+    void start();
+    bool cancel();
+
+    bool isRunning() const { return _isRunning; }
+
+    Q_SIGNAL void finished(bool success);
+    Q_SIGNAL void progressMessage(const QString & str);
+    Q_SIGNAL void progress(qint64 bytesDone, qint64 bytesTotal);
+
+private:
+
+    struct Batch
+    {
+        db::BulkRows rows;
+        qint64 firstRowNumber = 0; // in file, 1-based, header included
+        qint64 endPosition = 0; // in file
+    };
+
+    // main thread
+    bool openConnection();
+    Q_SLOT void onBatchQueued();
+    Q_SLOT void onLoadFinished(bool success);
+
+    // parser thread
+    void parse();
+    bool mapColumns(const std::vector<CSVField> & firstRow);
+    void appendRow(const std::vector<CSVField> & fields, Batch * batch);
+    void appendValue(const CSVField & field, QByteArray * data) const;
+
+    // loader thread (or main one when connection is single-threaded)
+    void load();
+    bool loadBatch(const Batch & batch);
+    void fail(const QString & error);
+
+    // bounded queue between threads
+    bool pushBatch(Batch && batch);
+    bool popBatch(Batch * batch, bool wait); // false when no more
+    void finishQueue();
+    bool isQueueDone();
+
+    Q_SIGNAL void batchQueued();
+    Q_SIGNAL void loadFinished(bool success);
+
+    void reportProgress(qint64 position);
+
+    const CSVImportSettings _settings;
+
+    QString _quotedTable;
+    QStringList _tableColumns;
+    db::Connection * _sessionConnection;
+
+    // set by parser before the first batch
+    std::vector<int> _fieldIndexes; // of file row per target column
+    int _fieldCount; // in the first row
+    QStringList _quotedColumns;
+
+    db::ConnectionPtr _connection; // own one when multi-threaded
+    bool _loadInMainThread;
+
+    std::thread _parserThread;
+    std::thread _loaderThread;
+
+    std::deque<Batch> _queue;
+    bool _queueFinished; // parser is done
+    std::mutex _queueMutex;
+    std::condition_variable _queueChanged;
+
+    std::atomic<bool> _isRunning;
+    std::atomic<bool> _isCancelled;
+    std::atomic<bool> _failed;
+    std::atomic<qint64> _rowsParsed;
+    std::atomic<qint64> _rowsMalformed;
+    qint64 _rowsSent; // loader only
+    qint64 _rowsInserted;
+    qint64 _rowsFailed;
+    qint64 _warningCount; // of server, values may be changed
+    qint64 _fileSize;
+    qint64 _lastProgressMs;
+    QElapsedTimer _timer;
+};
+
+} // namespace importing
+} // namespace utils
+} // namespace meow
+
+#endif // UTILS_IMPORTING_CSV_IMPORTER_H
@@ -0,0 +1,258 @@
+#include "csv_parser.h"
+#include <QIODevice>
+#include <QtAlgorithms> // qCountTrailingZeroBits
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MEOW_CSV_PARSER_SSE2
+#endif
+
+namespace meow {
+namespace utils {
+namespace importing {
+
+namespace {
+
+const int DEFAULT_CHUNK_SIZE = 1024 * 1024;
+
+// Returns index of first a, b or c in [from, to) or -1
+inline int findAny(const char * data, int from, int to,
+                   char a, char b, char c)
+{
+    int i = from;
+
+#ifdef MEOW_CSV_PARSER_SSE2
+    const __m128i allA = _mm_set1_epi8(a);
+    const __m128i allB = _mm_set1_epi8(b);
+    const __m128i allC = _mm_set1_epi8(c);
+
+    for (; i + 16 <= to; i += 16) {
+        __m128i bytes = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i *>(data + i));
+        __m128i found = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(bytes, allA),
+                                 _mm_cmpeq_epi8(bytes, allB)),
+                    _mm_cmpeq_epi8(bytes, allC));
+        int mask = _mm_movemask_epi8(found);
+        if (mask != 0) {
+            return i + static_cast<int>(
+                        qCountTrailingZeroBits(static_cast<quint32>(mask)));
+        }
+    }
+#endif
+
+    for (; i < to; ++i) {
+        char current = data[i];
+        if (current == a || current == b || current == c) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+} // namespace
+
+CSVParser::CSVParser(QIODevice * device, const CSVFormat & format)
+    : _device(device)
+    , _format(format)
+    , _bufferOffset(device->pos())
+    , _pos(0)
+    , _chunkSize(DEFAULT_CHUNK_SIZE)
+    , _atEnd(false)
+    , _atStart(device->pos() == 0)
+{
+
+}
+
+bool CSVParser::next(std::vector<CSVField> * fields)
+{
+    compact();
+
+    if (_atStart) {
+        _atStart = false;
+        if (ensure(0, 3)
+                && memcmp(_buffer.constData(), "\xEF\xBB\xBF", 3) == 0) {
+            _pos = 3; // UTF-8 BOM
+        }
+    }
+
+    // empty lines
+    while (ensure(_pos, 1)
+           && (_buffer.at(_pos) == '\n' || _buffer.at(_pos) == '\r')) {
+        ++_pos;
+    }
+    if (!ensure(_pos, 1)) {
+        return false;
+    }
+
+    _spans.clear();
+    _unquoted.clear();
+
+    int i = _pos;
+
+    for (;;) { // fields
+
+        Span span;
+
+        if (_format.quote != 0 && ensure(i, 1)
+                && _buffer.at(i) == _format.quote) {
+
+            span.isQuoted = true;
+            int start = ++i;
+
+            for (;;) {
+                int quote = findQuote(i);
+                if (quote == -1) { // not closed till end of data, take all
+                    quote = _buffer.size();
+                }
+                bool isDoubled = quote < _buffer.size()
+                        && ensure(quote, 2)
+                        && _buffer.at(quote + 1) == _format.quote;
+
+                if (isDoubled || span.isUnquoted) {
+                    if (!span.isUnquoted) {
+                        span.isUnquoted = true;
+                        span.offset = _unquoted.size();
+                    }
+                    // with one of two quotes
+                    _unquoted.append(_buffer.constData() + start,
+                                     quote - start + (isDoubled ? 1 : 0));
+                }
+
+                if (isDoubled) {
+                    i = quote + 2;
+                    start = i;
+                    continue;
+                }
+
+                if (span.isUnquoted) {
+                    span.size = _unquoted.size() - span.offset;
+                } else {
+                    span.offset = start;
+                    span.size = quote - start;
+                }
+                i = std::min(quote + 1, _buffer.size());
+                break;
+            }
+
+            // anything between closing quote and delimiter is ignored
+            i = findFieldEnd(i);
+
+        } else {
+            int start = i;
+            i = findFieldEnd(i);
+            span.offset = start;
+            span.size = i - start;
+        }
+
+        _spans.push_back(span);
+
+        if (!ensure(i, 1)) { // end of data
+            _pos = i;
+            break;
+        }
+
+        char separator = _buffer.at(i++);
+        if (separator == _format.delimiter) {
+            continue;
+        }
+
+        // \n, \r\n or \r
+        if (separator == '\r' && ensure(i, 1) && _buffer.at(i) == '\n') {
+            ++i;
+        }
+        _pos = i;
+        break;
+    }
+
+    // buffers don't change any more, give pointers
+    fields->resize(_spans.size());
+    for (std::size_t k = 0; k < _spans.size(); ++k) {
+        const Span & span = _spans[k];
+        CSVField & field = (*fields)[k];
+        field.data = (span.isUnquoted ? _unquoted.constData()
+                                      : _buffer.constData()) + span.offset;
+        field.size = span.size;
+        field.isQuoted = span.isQuoted;
+    }
+
+    return true;
+}
+
+int CSVParser::findFieldEnd(int index)
+{
+    for (;;) {
+        int found = findAny(_buffer.constData(), index, _buffer.size(),
+                            _format.delimiter, '\n', '\r');
+        if (found != -1) {
+            return found;
+        }
+        index = _buffer.size();
+        if (!readChunk()) {
+            return index;
+        }
+    }
+}
+
+int CSVParser::findQuote(int index)
+{
+    for (;;) {
+        if (index < _buffer.size()) {
+            // memchr is vectorized by C library
+            const void * found = memchr(
+                _buffer.constData() + index,
+                _format.quote,
+                static_cast<std::size_t>(_buffer.size() - index));
+            if (found != nullptr) {
+                return static_cast<int>(
+                    static_cast<const char *>(found) - _buffer.constData());
+            }
+        }
+        index = _buffer.size();
+        if (!readChunk()) {
+            return -1;
+        }
+    }
+}
+
+bool CSVParser::ensure(int index, int count)
+{
+    while (index + count > _buffer.size()) {
+        if (!readChunk()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CSVParser::readChunk()
+{
+    if (_atEnd) {
+        return false;
+    }
+    QByteArray chunk = _device->read(_chunkSize);
+    if (chunk.isEmpty()) {
+        _atEnd = true;
+        return false;
+    }
+    _buffer.append(chunk);
+    return true;
+}
+
+void CSVParser::compact()
+{
+    // bounded memory: drop what was returned already
+    if (_pos < _chunkSize) {
+        return;
+    }
+    _buffer.remove(0, _pos);
+    _bufferOffset += _pos;
+    _pos = 0;
+}
+
+} // namespace importing
+} // namespace utils
+} // namespace meow
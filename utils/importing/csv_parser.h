@@ -0,0 +1,88 @@
+#ifndef UTILS_IMPORTING_CSV_PARSER_H
+#define UTILS_IMPORTING_CSV_PARSER_H
+
+#include <vector>
+#include <QByteArray>
+
+class QIODevice;
+
+namespace meow {
+namespace utils {
+namespace importing {
+
+struct CSVFormat
+{
+    char delimiter = ','; // '\t' for TSV
+    char quote = '"'; // 0: fields are never quoted
+};
+
+// Field of CSVParser::next(), valid till the next call
+struct CSVField
+{
+    const char * data = nullptr;
+    int size = 0;
+    bool isQuoted = false;
+};
+
+// Intent: splits delimited text (RFC 4180: quoted fields may have
+// delimiters, doubled quotes and line breaks) into rows in a single pass.
+// Reads device by chunks and keeps only the current row in memory. Fields
+// point into the read buffer, only fields with doubled quotes are copied.
+// Delimiters are searched 16 bytes at once with SSE2 where available
+class CSVParser
+{
+public:
+    // reads device from its current position
+    explicit CSVParser(QIODevice * device,
+                       const CSVFormat & format = CSVFormat());
+
+    // Returns false when there are no more rows, skips empty lines
+    bool next(std::vector<CSVField> * fields);
+
+    // bytes consumed, end of last returned row
+    qint64 position() const { return _bufferOffset + _pos; }
+
+    void setChunkSize(int size) { _chunkSize = size; }
+
+private:
+
+    struct Span
+    {
+        int offset = 0; // in buffer or _unquoted
+        int size = 0;
+        bool isQuoted = false;
+        bool isUnquoted = false; // was copied to _unquoted
+    };
+
+    // Returns index of delimiter or line end from index, or buffer end if
+    // there is none till end of data
+    int findFieldEnd(int index);
+
+    // Returns index of quote from index or -1 at end of data
+    int findQuote(int index);
+
+    // Makes sure buffer has count bytes from index if not at end of data
+    bool ensure(int index, int count);
+
+    bool readChunk();
+
+    void compact();
+
+    QIODevice * _device;
+    const CSVFormat _format;
+    QByteArray _buffer;
+    qint64 _bufferOffset; // position of buffer start in data
+    int _pos; // in buffer, start of next row
+    int _chunkSize;
+    bool _atEnd; // nothing more to read
+    bool _atStart; // BOM is not checked yet
+
+    std::vector<Span> _spans;
+    QByteArray _unquoted; // fields with doubled quotes of current row
+};
+
+} // namespace importing
+} // namespace utils
+} // namespace meow
+
+#endif // UTILS_IMPORTING_CSV_PARSER_H